@@ -0,0 +1,147 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/*
+   Benchmark bulk ECDSA key share generation.
+ */
+
+#include "bench.h"
+#include "amcl/keygen.h"
+#include "amcl/mpc.h"
+
+#define MIN_TIME 5.0
+#define MIN_ITERS 10
+
+#define N (4 * KEYGEN_CHUNK)
+
+// The table is too large for the stack
+static KEYGEN_table table;
+
+int main()
+{
+    int i;
+    int rc;
+
+    int iterations;
+    clock_t start;
+    double elapsed;
+
+    char s[N * EGS_SECP256K1];
+    octet S = {0, sizeof(s), s};
+
+    char w[N * KEYGEN_W_SIZE];
+    octet W = {0, sizeof(w), w};
+
+    char c[N * KEYGEN_W_SIZE];
+    octet C = {0, sizeof(c), c};
+
+    char p[N * EGS_SECP256K1];
+    octet P = {0, sizeof(p), p};
+
+    char si[EGS_SECP256K1];
+    octet SI = {0, sizeof(si), si};
+
+    char wi[KEYGEN_W_SIZE];
+    octet WI = {0, sizeof(wi), wi};
+
+    char ri[EGS_SECP256K1];
+    octet RI = {0, sizeof(ri), ri};
+
+    char ci[KEYGEN_W_SIZE];
+    octet CI = {0, sizeof(ci), ci};
+
+    char e[EGS_SECP256K1];
+    octet E = {0, sizeof(e), e};
+
+    char pi[EGS_SECP256K1];
+    octet PI = {0, sizeof(pi), pi};
+
+    char id[32];
+    octet ID = {0, sizeof(id), id};
+
+    // Deterministic RNG for benchmarking
+    char seed[32] = {0};
+    csprng RNG;
+    RAND_seed(&RNG, 32, seed);
+
+    OCT_rand(&ID, &RNG, ID.len);
+
+    print_system_info();
+
+    printf("Timing info\n");
+    printf("===========\n");
+
+    iterations = 0;
+    start = clock();
+    do
+    {
+        KEYGEN_table_init(&table);
+        iterations++;
+        elapsed = (clock() - start) / (double)CLOCKS_PER_SEC;
+    }
+    while (elapsed < MIN_TIME || iterations < MIN_ITERS);
+
+    elapsed = MILLISECOND * elapsed / iterations;
+    printf("\tKEYGEN_table_init\t%8d iterations\t", iterations);
+    printf("%8.2lf ms per iteration\n", elapsed);
+
+    printf("\n%d shares\n", N);
+
+    iterations = 0;
+    start = clock();
+    do
+    {
+        for (i = 0; i < N; i++)
+        {
+            MPC_ECDSA_KEY_PAIR_GENERATE(&RNG, &SI, &WI);
+            SCHNORR_commit(&RNG, &RI, &CI);
+            SCHNORR_challenge(&WI, &CI, &ID, NULL, &E);
+            SCHNORR_prove(&RI, &E, &SI, &PI);
+        }
+        iterations++;
+        elapsed = (clock() - start) / (double)CLOCKS_PER_SEC;
+    }
+    while (elapsed < MIN_TIME || iterations < MIN_ITERS);
+
+    elapsed = MILLISECOND * elapsed / iterations;
+    printf("\tone share at a time\t%8d iterations\t", iterations);
+    printf("%8.2lf ms per iteration\n", elapsed);
+
+    iterations = 0;
+    start = clock();
+    do
+    {
+        rc = KEYGEN_generate(&RNG, &table, N, &ID, NULL, &S, &W, &C, &P);
+        iterations++;
+        elapsed = (clock() - start) / (double)CLOCKS_PER_SEC;
+    }
+    while (elapsed < MIN_TIME || iterations < MIN_ITERS);
+
+    if (rc != KEYGEN_OK)
+    {
+        printf("FAILURE KEYGEN_generate: %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    elapsed = MILLISECOND * elapsed / iterations;
+    printf("\tKEYGEN_generate\t\t%8d iterations\t", iterations);
+    printf("%8.2lf ms per iteration\n", elapsed);
+
+    exit(EXIT_SUCCESS);
+}
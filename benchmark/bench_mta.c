@@ -98,6 +98,19 @@ int main()
     printf("MPC_MTA_CLIENT1\t%8d iterations\t",iterations);
     printf("%8.2lf ms per iteration\n",elapsed);
 
+    iterations=0;
+    start=clock();
+    do
+    {
+        MPC_MTA_CLIENT1_CRT(&RNG, &PRIV, &A, &CA, NULL);
+        iterations++;
+        elapsed=(clock()-start)/(double)CLOCKS_PER_SEC;
+    }
+    while (elapsed<MIN_TIME || iterations<MIN_ITERS);
+    elapsed=1000.0*elapsed/iterations;
+    printf("MPC_MTA_CLIENT1_CRT\t%8d iterations\t",iterations);
+    printf("%8.2lf ms per iteration\n",elapsed);
+
     iterations=0;
     start=clock();
     do
@@ -0,0 +1,399 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/*
+   Benchmark the OT based MtA against the Paillier MtA.
+
+   Both sides are timed with the checks they need against a malicious
+   counterparty: the KOS check for the OT MtA, the Range Proof of the
+   client and the Receiver ZKP of the server for the Paillier MtA.
+ */
+
+#include "bench.h"
+#include <amcl/randapi.h>
+#include <amcl/mta.h>
+#include <amcl/mta_ot.h>
+
+#define MIN_TIME 5.0
+#define MIN_ITERS 10
+
+// Size in bytes of the MTA proofs. Commitment and proof, see the toOctets functions
+#define RP_SIZE (FS_4096 + 2 * FS_2048 + 2 * FS_2048 + 2 * HFS_2048)
+#define ZK_SIZE (FS_4096 + 4 * FS_2048 + 4 * FS_2048 + 3 * HFS_2048)
+
+// Primes for Paillier key
+char *P_hex = "94f689d07ba20cf7c7ca7ccbed22ae6b40c426db74eaee4ce0ced2b6f52a5e136663f5f1ef379cdbb0c4fdd6e4074d6cff21082d4803d43d89e42fd8dfa82b135aa31a8844ffea25f255f956cbc1b9d8631d01baf1010d028a190b94ce40f3b72897e8196df19edf1ff62e6556f2701d52cef1442e3301db7608ecbdcca703db";
+char *Q_hex = "9a9ad73f246df853e129c589925fdad9df05606a61081e62e72be4fb33f6e5ec492cc734f28bfb71fbe2ba9a11e4c02e2c0d103a5cbb0a9d6402c07de63b1b995dd72ac8f29825d66923a088b421fb4d52b0b855d2f5dde2be9b0ca0cee6f7a94e5566735fe6cff1fcad3199602f88528d19aa8d0263adff8f5053c38254a2a3";
+
+// Safe primes for BC setup
+char *PT_hex = "CA5F37B7C0DDF6530B30A41116588218DE95F1F36B807FD7C28E4C467EE3F35967BC01D28B71F8A627A353675A81C86A1FF03DCECAF1686891183FA317BA34A4A1148D40A89F1F3AC0C200511C6CFE02342CD75354C25A2E069886DD4FB73BD365660D163F1282B143119AB8F375A73875EC16B634F52593B73BC6D875F2D3EF";
+char *QT_hex = "C2FC545C1C803F6C7625FBC4ECF9355734D6B6058FD714816D3ECFB93F1F705C9CE90D4F8796A05148AB5ABC201F90889231CC6BF5F68ED15EE4D901F603930A280EEABF10C613BFCB67A816363C839EB902B02607EB48AB8325E2B72620D4D294A232803217090DFB50AF8C620D4679E77CE3053437ED518F4F68840DCF1AA3";
+
+char* a_hex = "0000000000000000000000000000000000000000000000000000000000000002";
+
+char* b_hex = "0000000000000000000000000000000000000000000000000000000000000003";
+
+// Setup and state of the pair
+MTA_OT_client client;
+MTA_OT_server server;
+MTA_OT_client_state state;
+
+char ot_ca[MTA_OT_CA_SIZE];
+char ot_cb[MTA_OT_CB_SIZE];
+char ot_cbm[2 * MTA_OT_CB_SIZE];
+
+int main()
+{
+    int rc;
+    int iterations;
+    clock_t start;
+    double elapsed;
+
+    // Paillier Keys and BC modulus of the verifier
+    PAILLIER_private_key PRIV;
+    PAILLIER_public_key PUB;
+    COMMITMENTS_BC_priv_modulus priv_mod;
+    COMMITMENTS_BC_pub_modulus pub_mod;
+
+    MTA_RP_commitment rp_c;
+    MTA_RP_commitment_rv rp_rv;
+    MTA_RP_proof rp_p;
+
+    MTA_ZK_commitment zk_c;
+    MTA_ZK_commitment_rv zk_rv;
+    MTA_ZK_proof zk_p;
+
+    char a[EGS_SECP256K1];
+    octet A = {0,sizeof(a),a};
+
+    char b[EGS_SECP256K1];
+    octet B = {0,sizeof(b),b};
+
+    char s[MTA_OT_S_SIZE];
+    octet S = {0,sizeof(s),s};
+
+    char r[MTA_OT_R_SIZE];
+    octet R = {0,sizeof(r),r};
+
+    octet OT_CA = {0,sizeof(ot_ca),ot_ca};
+    octet OT_CB = {0,sizeof(ot_cb),ot_cb};
+    octet OT_CBM = {0,sizeof(ot_cbm),ot_cbm};
+
+    char p[HFS_2048];
+    octet P = {0,sizeof(p),p};
+
+    char pq[HFS_2048];
+    octet Q = {0,sizeof(pq),pq};
+
+    char ra[FS_4096];
+    octet RA = {0,sizeof(ra),ra};
+
+    char rb[FS_4096];
+    octet RB = {0,sizeof(rb),rb};
+
+    char z[EGS_SECP256K1];
+    octet Z = {0,sizeof(z),z};
+
+    char e[EGS_SECP256K1];
+    octet E = {0,sizeof(e),e};
+
+    char alpha2[EGS_SECP256K1];
+    octet ALPHA2 = {0,sizeof(alpha2),alpha2};
+
+    char beta2[EGS_SECP256K1];
+    octet BETA2 = {0,sizeof(beta2),beta2};
+
+
+    char ca[FS_4096];
+    octet CA = {0,sizeof(ca),ca};
+
+    char cb[FS_4096];
+    octet CB = {0,sizeof(cb),cb};
+
+    char alpha[EGS_SECP256K1];
+    octet ALPHA = {0,sizeof(alpha),alpha};
+
+    char beta[EGS_SECP256K1];
+    octet BETA = {0,sizeof(beta),beta};
+
+    octet *PB[2] = {&B, &B};
+    octet *PALPHA[2] = {&ALPHA, &ALPHA2};
+    octet *PBETA[2] = {&BETA, &BETA2};
+
+    // Load values
+    OCT_fromHex(&A,a_hex);
+    OCT_fromHex(&B,b_hex);
+
+    print_system_info();
+
+    printf("Timing info\n");
+    printf("===========\n");
+
+    char* seedHex = "78d0fb6705ce77dee47d03eb5b9c5d30";
+    char seed[16] = {0};
+    octet SEED = {sizeof(seed),sizeof(seed),seed};
+
+    // CSPRNG
+    csprng RNG;
+
+    // fake random source
+    OCT_fromHex(&SEED,seedHex);
+
+    // initialise strong RNG
+    CREATE_CSPRNG(&RNG,&SEED);
+
+    // OT setup. Run once for each pair of parties
+    iterations=0;
+    start=clock();
+    do
+    {
+        MTA_OT_setup_client1(&RNG, &client, &S);
+        rc = MTA_OT_setup_server(&RNG, &server, &S, &R);
+        rc |= MTA_OT_setup_client2(&client, &R);
+        iterations++;
+        elapsed=(clock()-start)/(double)CLOCKS_PER_SEC;
+    }
+    while (elapsed<MIN_TIME || iterations<MIN_ITERS);
+
+    if (rc != MTA_OT_OK)
+    {
+        fprintf(stderr, "FAILURE MTA_OT setup rc: %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    elapsed=1000.0*elapsed/iterations;
+    printf("MTA_OT_setup\t%8d iterations\t",iterations);
+    printf("%8.2lf ms per iteration\n",elapsed);
+
+    iterations=0;
+    start=clock();
+    do
+    {
+        MPC_MTA_OT_CLIENT1(&RNG, &client, &A, &state, &OT_CA);
+        iterations++;
+        elapsed=(clock()-start)/(double)CLOCKS_PER_SEC;
+    }
+    while (elapsed<MIN_TIME || iterations<MIN_ITERS);
+    elapsed=1000.0*elapsed/iterations;
+    printf("MPC_MTA_OT_CLIENT1\t%8d iterations\t",iterations);
+    printf("%8.2lf ms per iteration\n",elapsed);
+
+    // The server only accepts fresh extensions, so each
+    // iteration times both the client and the server pass
+    iterations=0;
+    start=clock();
+    do
+    {
+        MPC_MTA_OT_CLIENT1(&RNG, &client, &A, &state, &OT_CA);
+        rc = MPC_MTA_OT_SERVER(&server, &B, &OT_CA, &OT_CB, &BETA);
+        iterations++;
+        elapsed=(clock()-start)/(double)CLOCKS_PER_SEC;
+    }
+    while (rc == MTA_OT_OK && (elapsed<MIN_TIME || iterations<MIN_ITERS));
+
+    if (rc != MTA_OT_OK)
+    {
+        fprintf(stderr, "FAILURE MPC_MTA_OT_SERVER rc: %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    elapsed=1000.0*elapsed/iterations;
+    printf("MPC_MTA_OT_CLIENT1+SERVER\t%8d iterations\t",iterations);
+    printf("%8.2lf ms per iteration\n",elapsed);
+
+    iterations=0;
+    start=clock();
+    do
+    {
+        rc = MPC_MTA_OT_CLIENT2(&state, &OT_CB, &ALPHA);
+        iterations++;
+        elapsed=(clock()-start)/(double)CLOCKS_PER_SEC;
+    }
+    while (rc == MTA_OT_OK && (elapsed<MIN_TIME || iterations<MIN_ITERS));
+
+    if (rc != MTA_OT_OK)
+    {
+        fprintf(stderr, "FAILURE MPC_MTA_OT_CLIENT2 rc: %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    elapsed=1000.0*elapsed/iterations;
+    printf("MPC_MTA_OT_CLIENT2\t%8d iterations\t",iterations);
+    printf("%8.2lf ms per iteration\n",elapsed);
+
+    // The signing protocol runs k.gamma and k.w on one extension
+    iterations=0;
+    start=clock();
+    do
+    {
+        MPC_MTA_OT_CLIENT1(&RNG, &client, &A, &state, &OT_CA);
+        rc = MPC_MTA_OT_SERVER_MULTI(&server, 2, PB, &OT_CA, &OT_CBM, PBETA);
+        rc |= MPC_MTA_OT_CLIENT2_MULTI(&state, 2, &OT_CBM, PALPHA);
+        iterations++;
+        elapsed=(clock()-start)/(double)CLOCKS_PER_SEC;
+    }
+    while (rc == MTA_OT_OK && (elapsed<MIN_TIME || iterations<MIN_ITERS));
+
+    if (rc != MTA_OT_OK)
+    {
+        fprintf(stderr, "FAILURE MPC_MTA_OT_MULTI rc: %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    elapsed=1000.0*elapsed/iterations;
+    printf("MPC_MTA_OT two products\t%8d iterations\t",iterations);
+    printf("%8.2lf ms per iteration\n",elapsed);
+
+    // Paillier MtA
+    OCT_fromHex(&P, P_hex);
+    OCT_fromHex(&Q, Q_hex);
+    PAILLIER_KEY_PAIR(NULL, &P, &Q, &PUB, &PRIV);
+
+    OCT_fromHex(&P, PT_hex);
+    OCT_fromHex(&Q, QT_hex);
+    COMMITMENTS_BC_setup(&RNG, &priv_mod, &P, &Q, NULL, NULL);
+    COMMITMENTS_BC_export_public_modulus(&pub_mod, &priv_mod);
+
+    iterations=0;
+    start=clock();
+    do
+    {
+        MPC_MTA_CLIENT1(&RNG, &PUB, &A, &CA, &RA);
+        iterations++;
+        elapsed=(clock()-start)/(double)CLOCKS_PER_SEC;
+    }
+    while (elapsed<MIN_TIME || iterations<MIN_ITERS);
+    elapsed=1000.0*elapsed/iterations;
+    printf("MPC_MTA_CLIENT1\t%8d iterations\t",iterations);
+    printf("%8.2lf ms per iteration\n",elapsed);
+
+    iterations=0;
+    start=clock();
+    do
+    {
+        MPC_MTA_SERVER(&RNG, &PUB, &B, &CA, &Z, &RB, &CB, &BETA);
+        iterations++;
+        elapsed=(clock()-start)/(double)CLOCKS_PER_SEC;
+    }
+    while (elapsed<MIN_TIME || iterations<MIN_ITERS);
+    elapsed=1000.0*elapsed/iterations;
+    printf("MPC_MTA_SERVER\t%8d iterations\t",iterations);
+    printf("%8.2lf ms per iteration\n",elapsed);
+
+    iterations=0;
+    start=clock();
+    do
+    {
+        MPC_MTA_CLIENT2(&PRIV, &CB, &ALPHA);
+        iterations++;
+        elapsed=(clock()-start)/(double)CLOCKS_PER_SEC;
+    }
+    while (elapsed<MIN_TIME || iterations<MIN_ITERS);
+    elapsed=1000.0*elapsed/iterations;
+    printf("MPC_MTA_CLIENT2\t%8d iterations\t",iterations);
+    printf("%8.2lf ms per iteration\n",elapsed);
+
+    // Proofs of the Paillier MtA
+    iterations=0;
+    start=clock();
+    do
+    {
+        MTA_RP_commit(&RNG, &PRIV, &pub_mod, &A, &rp_c, &rp_rv);
+        MTA_RP_challenge(&PUB, &pub_mod, &CA, &rp_c, &E);
+        MTA_RP_prove(&PRIV, &rp_rv, &A, &RA, &E, &rp_p);
+        iterations++;
+        elapsed=(clock()-start)/(double)CLOCKS_PER_SEC;
+    }
+    while (elapsed<MIN_TIME || iterations<MIN_ITERS);
+    elapsed=1000.0*elapsed/iterations;
+    printf("MTA_RP prover\t%8d iterations\t",iterations);
+    printf("%8.2lf ms per iteration\n",elapsed);
+
+    iterations=0;
+    start=clock();
+    do
+    {
+        rc = MTA_RP_verify(&PUB, &priv_mod, &CA, &E, &rp_c, &rp_p);
+        iterations++;
+        elapsed=(clock()-start)/(double)CLOCKS_PER_SEC;
+    }
+    while (rc == MTA_OK && (elapsed<MIN_TIME || iterations<MIN_ITERS));
+
+    if (rc != MTA_OK)
+    {
+        fprintf(stderr, "FAILURE MTA_RP_verify rc: %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    elapsed=1000.0*elapsed/iterations;
+    printf("MTA_RP_verify\t%8d iterations\t",iterations);
+    printf("%8.2lf ms per iteration\n",elapsed);
+
+    iterations=0;
+    start=clock();
+    do
+    {
+        MTA_ZK_commit(&RNG, &PUB, &pub_mod, &B, &Z, &CA, &zk_c, &zk_rv);
+        MTA_ZK_challenge(&PUB, &pub_mod, &CA, &CB, &zk_c, &E);
+        MTA_ZK_prove(&PUB, &zk_rv, &B, &Z, &RB, &E, &zk_p);
+        iterations++;
+        elapsed=(clock()-start)/(double)CLOCKS_PER_SEC;
+    }
+    while (elapsed<MIN_TIME || iterations<MIN_ITERS);
+    elapsed=1000.0*elapsed/iterations;
+    printf("MTA_ZK prover\t%8d iterations\t",iterations);
+    printf("%8.2lf ms per iteration\n",elapsed);
+
+    iterations=0;
+    start=clock();
+    do
+    {
+        rc = MTA_ZK_verify(&PRIV, &priv_mod, &CA, &CB, &E, &zk_c, &zk_p);
+        iterations++;
+        elapsed=(clock()-start)/(double)CLOCKS_PER_SEC;
+    }
+    while (rc == MTA_OK && (elapsed<MIN_TIME || iterations<MIN_ITERS));
+
+    if (rc != MTA_OK)
+    {
+        fprintf(stderr, "FAILURE MTA_ZK_verify rc: %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    elapsed=1000.0*elapsed/iterations;
+    printf("MTA_ZK_verify\t%8d iterations\t",iterations);
+    printf("%8.2lf ms per iteration\n",elapsed);
+
+    printf("\nBytes on the wire\n");
+    printf("=================\n");
+    printf("OT setup, once per pair\t%8d bytes\n", MTA_OT_S_SIZE + MTA_OT_R_SIZE);
+    printf("OT MtA\t%8d bytes\n", MTA_OT_CA_SIZE + MTA_OT_CB_SIZE);
+    printf("OT MtA and MtAwc on one extension\t%8d bytes\n", MTA_OT_CA_SIZE + 2 * MTA_OT_CB_SIZE + MTA_OT_BG_SIZE);
+    printf("Paillier MtA with RP and ZK\t%8d bytes\n", 2 * FS_4096 + RP_SIZE + ZK_SIZE);
+
+    MTA_OT_client_kill(&client);
+    MTA_OT_server_kill(&server);
+    MTA_RP_commitment_rv_kill(&rp_rv);
+    MTA_ZK_commitment_rv_kill(&zk_rv);
+    PAILLIER_PRIVATE_KEY_KILL(&PRIV);
+    COMMITMENTS_BC_kill_priv_modulus(&priv_mod);
+    KILL_CSPRNG(&RNG);
+
+    exit(EXIT_SUCCESS);
+}
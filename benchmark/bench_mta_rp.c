@@ -64,6 +64,7 @@ int main()
     MTA_RP_commitment co;
     MTA_RP_commitment_rv rv;
     MTA_RP_proof proof;
+    MTA_RP_verify_ctx ctx;
 
     char c[2*FS_2048];
     octet C = {0, sizeof(c), c};
@@ -191,5 +192,41 @@ int main()
     printf("\tMTA_RP_verify\t\t%8d iterations\t", iterations);
     printf("%8.2lf ms per iteration\n", elapsed);
 
+    iterations = 0;
+    start = clock();
+    do
+    {
+        MTA_RP_verify_prepare(&pub_key, &priv_mod, &C, &co, &ctx);
+        iterations++;
+        elapsed = (clock() - start) / (double)CLOCKS_PER_SEC;
+    }
+    while (elapsed < MIN_TIME || iterations < MIN_ITERS);
+
+    elapsed = MILLISECOND * elapsed / iterations;
+    printf("\tMTA_RP_verify_prepare\t%8d iterations\t", iterations);
+    printf("%8.2lf ms per iteration\n", elapsed);
+
+    iterations = 0;
+    start = clock();
+    do
+    {
+        rc = MTA_RP_verify_finish(&pub_key, &priv_mod, &E, &ctx, &proof);
+        iterations++;
+        elapsed = (clock() - start) / (double)CLOCKS_PER_SEC;
+    }
+    while (elapsed < MIN_TIME || iterations < MIN_ITERS);
+
+    if (rc != MTA_OK)
+    {
+        printf("FAILURE MTA_RP_verify_finish: %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    elapsed = MILLISECOND * elapsed / iterations;
+    printf("\tMTA_RP_verify_finish\t%8d iterations\t", iterations);
+    printf("%8.2lf ms per iteration\n", elapsed);
+
+    MTA_RP_verify_ctx_kill(&ctx);
+
     exit(EXIT_SUCCESS);
 }
@@ -69,6 +69,7 @@ int main()
     MTA_ZK_commitment c;
     MTA_ZK_commitment_rv rv;
     MTA_ZK_proof proof;
+    MTA_ZK_verify_ctx ctx;
 
     char c1[2*FS_2048];
     octet C1 = {0, sizeof(c1), c1};
@@ -213,5 +214,41 @@ int main()
     printf("\tMTA_ZK_verify\t\t%8d iterations\t", iterations);
     printf("%8.2lf ms per iteration\n", elapsed);
 
+    iterations = 0;
+    start = clock();
+    do
+    {
+        MTA_ZK_verify_prepare(&priv_key, &priv_mod, &C1, &C2, &c, &ctx);
+        iterations++;
+        elapsed = (clock() - start) / (double)CLOCKS_PER_SEC;
+    }
+    while (elapsed < MIN_TIME || iterations < MIN_ITERS);
+
+    elapsed = MILLISECOND * elapsed / iterations;
+    printf("\tMTA_ZK_verify_prepare\t%8d iterations\t", iterations);
+    printf("%8.2lf ms per iteration\n", elapsed);
+
+    iterations = 0;
+    start = clock();
+    do
+    {
+        rc = MTA_ZK_verify_finish(&priv_key, &priv_mod, &E, &ctx, &proof);
+        iterations++;
+        elapsed = (clock() - start) / (double)CLOCKS_PER_SEC;
+    }
+    while (elapsed < MIN_TIME || iterations < MIN_ITERS);
+
+    if (rc != MTA_OK)
+    {
+        printf("FAILURE MTA_ZK_verify_finish: %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    elapsed = MILLISECOND * elapsed / iterations;
+    printf("\tMTA_ZK_verify_finish\t%8d iterations\t", iterations);
+    printf("%8.2lf ms per iteration\n", elapsed);
+
+    MTA_ZK_verify_ctx_kill(&ctx);
+
     exit(EXIT_SUCCESS);
 }
@@ -36,6 +36,7 @@ char *V_hex = "032cf4b348c9d00718f01ed98923e164df53b5e8bc4c2250662ed2df784e1784f
 
 int main()
 {
+    int i;
     int rc;
 
     int iterations;
@@ -66,6 +67,16 @@ int main()
     char p[SGS_SECP256K1];
     octet P = {0, sizeof(p), p};
 
+    octet *VS[SCHNORR_BATCH_MAX];
+    octet *CS[SCHNORR_BATCH_MAX];
+    octet *ES[SCHNORR_BATCH_MAX];
+    octet *PS[SCHNORR_BATCH_MAX];
+
+    // Deterministic RNG for testing
+    char seed[32] = {0};
+    csprng RNG;
+    RAND_seed(&RNG, 32, seed);
+
     // Load values
     OCT_jstring(&ID, ID_str);
     OCT_fromHex(&AD, AD_hex);
@@ -141,5 +152,33 @@ int main()
     printf("\tSCHNORR_verify\t\t%8d iterations\t", iterations);
     printf("%8.2lf us per iteration\n", elapsed);
 
+    for (i = 0; i < SCHNORR_BATCH_MAX; i++)
+    {
+        VS[i] = &V;
+        CS[i] = &C;
+        ES[i] = &E;
+        PS[i] = &P;
+    }
+
+    iterations = 0;
+    start = clock();
+    do
+    {
+        rc = SCHNORR_batch_verify(&RNG, SCHNORR_MSM_WINDOW, SCHNORR_BATCH_MAX, VS, CS, ES, PS);
+        iterations++;
+        elapsed = (clock() - start) / (double)CLOCKS_PER_SEC;
+    }
+    while (elapsed < MIN_TIME || iterations < MIN_ITERS);
+
+    if (rc != SCHNORR_OK)
+    {
+        printf("FAILURE SCHNORR_batch_verify: %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    elapsed = MICROSECOND * elapsed / (iterations * SCHNORR_BATCH_MAX);
+    printf("\tSCHNORR_batch_verify\t%8d iterations\t", iterations);
+    printf("%8.2lf us per proof\n", elapsed);
+
     exit(EXIT_SUCCESS);
 }
@@ -0,0 +1,227 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/*
+ * Benchmark the tunable parameters on the host and write a tuning profile.
+ */
+
+#include "bench.h"
+#include "amcl/tuning.h"
+
+#define MIN_TIME    1.0
+#define MIN_ITERS   5
+
+// A batch size is accepted if its cost per proof is within
+// this factor of the cost for the largest batch
+#define SIZE_TOLERANCE 1.1
+
+char *default_path = "mpc_tuning.txt";
+
+char *ID_str = "unique_identifier_123";
+
+int batch_sizes[] = {4, 8, 16, 32, SCHNORR_BATCH_MAX};
+
+octet *VS[SCHNORR_BATCH_MAX];
+octet *CS[SCHNORR_BATCH_MAX];
+octet *ES[SCHNORR_BATCH_MAX];
+octet *PS[SCHNORR_BATCH_MAX];
+
+// Time per proof of SCHNORR_batch_verify in microseconds
+double time_batch(csprng *RNG, int w, int n)
+{
+    int rc;
+    int iterations;
+    clock_t start;
+    double elapsed;
+
+    iterations = 0;
+    start = clock();
+    do
+    {
+        rc = SCHNORR_batch_verify(RNG, w, n, VS, CS, ES, PS);
+        iterations++;
+        elapsed = (clock() - start) / (double)CLOCKS_PER_SEC;
+    }
+    while (elapsed < MIN_TIME || iterations < MIN_ITERS);
+
+    if (rc != SCHNORR_OK)
+    {
+        printf("FAILURE SCHNORR_batch_verify: %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    return MICROSECOND * elapsed / (iterations * n);
+}
+
+// Find the best window size for batches of n proofs
+int tune_window(csprng *RNG, int n)
+{
+    int w;
+    int best = SCHNORR_MSM_WINDOW;
+    double elapsed;
+    double best_time = 0;
+
+    for (w = 1; w <= SCHNORR_MSM_MAX_WINDOW; w++)
+    {
+        elapsed = time_batch(RNG, w, n);
+
+        printf("\tbatch %2d window %d\t%8.2lf us per proof\n", n, w, elapsed);
+
+        if (best_time == 0 || elapsed < best_time)
+        {
+            best = w;
+            best_time = elapsed;
+        }
+    }
+
+    return best;
+}
+
+int main(int argc, char **argv)
+{
+    int i;
+    int w;
+    int n_sizes = sizeof(batch_sizes) / sizeof(batch_sizes[0]);
+    char *path = default_path;
+
+    double elapsed;
+    double best_time;
+
+    BIG_256_56 x;
+    BIG_256_56 q;
+    ECP_SECP256K1 G;
+
+    TUNING_profile profile;
+
+    char id[32];
+    octet ID = {0, sizeof(id), id};
+
+    char x_char[SGS_SECP256K1];
+    octet X = {0, sizeof(x_char), x_char};
+
+    char r[SGS_SECP256K1];
+    octet R = {0, sizeof(r), r};
+
+    char v[SCHNORR_BATCH_MAX][SFS_SECP256K1+1];
+    char c[SCHNORR_BATCH_MAX][SFS_SECP256K1+1];
+    char e[SCHNORR_BATCH_MAX][SGS_SECP256K1];
+    char p[SCHNORR_BATCH_MAX][SGS_SECP256K1];
+
+    octet V[SCHNORR_BATCH_MAX];
+    octet C[SCHNORR_BATCH_MAX];
+    octet E[SCHNORR_BATCH_MAX];
+    octet P[SCHNORR_BATCH_MAX];
+
+    // Deterministic RNG for testing
+    char seed[32] = {0};
+    csprng RNG;
+    RAND_seed(&RNG, 32, seed);
+
+    if (argc > 1)
+    {
+        path = argv[1];
+    }
+
+    OCT_jstring(&ID, ID_str);
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+
+    // Generate independent proofs
+    for (i = 0; i < SCHNORR_BATCH_MAX; i++)
+    {
+        V[i].len = 0;
+        V[i].max = sizeof(v[i]);
+        V[i].val = v[i];
+        VS[i] = &V[i];
+
+        C[i].len = 0;
+        C[i].max = sizeof(c[i]);
+        C[i].val = c[i];
+        CS[i] = &C[i];
+
+        E[i].len = 0;
+        E[i].max = sizeof(e[i]);
+        E[i].val = e[i];
+        ES[i] = &E[i];
+
+        P[i].len = 0;
+        P[i].max = sizeof(p[i]);
+        P[i].val = p[i];
+        PS[i] = &P[i];
+
+        BIG_256_56_randomnum(x, q, &RNG);
+
+        ECP_SECP256K1_generator(&G);
+        ECP_SECP256K1_mul(&G, x);
+
+        BIG_256_56_toBytes(X.val, x);
+        X.len = SGS_SECP256K1;
+
+        ECP_SECP256K1_toOctet(&V[i], &G, 1);
+
+        SCHNORR_commit(&RNG, &R, &C[i]);
+        SCHNORR_challenge(&V[i], &C[i], &ID, NULL, &E[i]);
+        SCHNORR_prove(&R, &E[i], &X, &P[i]);
+    }
+
+    print_system_info();
+
+    TUNING_default(&profile);
+
+    printf("Window size\n");
+    printf("===========\n");
+
+    w = tune_window(&RNG, SCHNORR_BATCH_MAX);
+
+    printf("Batch size\n");
+    printf("==========\n");
+
+    // Cost per proof for the largest batch
+    best_time = time_batch(&RNG, w, SCHNORR_BATCH_MAX);
+
+    // Smallest batch with a comparable cost per proof
+    for (i = 0; i < n_sizes; i++)
+    {
+        elapsed = time_batch(&RNG, w, batch_sizes[i]);
+        printf("\tbatch %2d\t\t%8.2lf us per proof\n", batch_sizes[i], elapsed);
+
+        if (elapsed <= SIZE_TOLERANCE * best_time)
+        {
+            profile.batch_flush_size = batch_sizes[i];
+            break;
+        }
+    }
+
+    printf("Window size for batch %d\n", profile.batch_flush_size);
+    printf("=========================\n");
+
+    profile.schnorr_msm_window = tune_window(&RNG, profile.batch_flush_size);
+
+    if (TUNING_save(&profile, path) != TUNING_OK)
+    {
+        printf("FAILURE writing profile %s\n", path);
+        exit(EXIT_FAILURE);
+    }
+
+    printf("Profile written to %s\n", path);
+    printf("\tSCHNORR_MSM_WINDOW = %d\n", profile.schnorr_msm_window);
+    printf("\tBATCH_FLUSH_SIZE = %d\n", profile.batch_flush_size);
+
+    exit(EXIT_SUCCESS);
+}
@@ -841,9 +841,11 @@ void phase5(csprng *RNG, octet *RP1, octet *RP2, octet *R1, octet *R2, octet *HM
     octet A_AD = {0, sizeof(ad[0]), ad[0]};
     octet B_AD = {0, sizeof(ad[1]), ad[1]};
 
-    // Octets for Non Malleable Commitments
-    char double_ecp[2 * EFS_SECP256K1 + 2];
-    octet DOUBLE_ECP = {0, sizeof(double_ecp), double_ecp};
+    // Segments for Non Malleable Commitments
+    octet *VA1[2] = {&V1, &A1};
+    octet *VA2[2] = {&V2, &A2};
+    octet *UT1[2] = {&U1, &T1};
+    octet *UT2[2] = {&U2, &T2};
 
     char commit_r[2][SHA256];
     octet A_COMMIT_R = {0, sizeof(commit_r[0]), commit_r[0]};
@@ -917,9 +919,7 @@ void phase5(csprng *RNG, octet *RP1, octet *RP2, octet *R1, octet *R2, octet *HM
     // Generate commitment to V, A
     printf("\n\tCommitment\n");
 
-    OCT_copy(&DOUBLE_ECP, &V1);
-    OCT_joctet(&DOUBLE_ECP, &A1);
-    COMMITMENTS_NM_commit(RNG, &DOUBLE_ECP, &A_COMMIT_R, &A_COMMIT_C);
+    COMMITMENTS_NM_commit_v(RNG, 2, VA1, &A_COMMIT_R, &A_COMMIT_C);
 
     printf("\t\tR = ");
     OCT_output(&A_COMMIT_R);
@@ -954,9 +954,7 @@ void phase5(csprng *RNG, octet *RP1, octet *RP2, octet *R1, octet *R2, octet *HM
     // Generate commitment to V, A
     printf("\n\tCommitment\n");
 
-    OCT_copy(&DOUBLE_ECP, &V2);
-    OCT_joctet(&DOUBLE_ECP, &A2);
-    COMMITMENTS_NM_commit(RNG, &DOUBLE_ECP, &B_COMMIT_R, &B_COMMIT_C);
+    COMMITMENTS_NM_commit_v(RNG, 2, VA2, &B_COMMIT_R, &B_COMMIT_C);
 
     printf("\t\tR = ");
     OCT_output(&B_COMMIT_R);
@@ -971,9 +969,7 @@ void phase5(csprng *RNG, octet *RP1, octet *RP2, octet *R1, octet *R2, octet *HM
 
     printf("\n[Alice] Decommit Bob (V, A)\n");
 
-    OCT_copy(&DOUBLE_ECP, &V2);
-    OCT_joctet(&DOUBLE_ECP, &A2);
-    rc = COMMITMENTS_NM_decommit(&DOUBLE_ECP, &B_COMMIT_R, &B_COMMIT_C);
+    rc = COMMITMENTS_NM_decommit_v(2, VA2, &B_COMMIT_R, &B_COMMIT_C);
     if (rc != COMMITMENTS_OK)
     {
         printf("\nFAILURE - Invalid Bob (V, A) commitment\n");
@@ -984,9 +980,7 @@ void phase5(csprng *RNG, octet *RP1, octet *RP2, octet *R1, octet *R2, octet *HM
 
     printf("\n[Bob] Decommit Alice (V, A)\n");
 
-    OCT_copy(&DOUBLE_ECP, &V1);
-    OCT_joctet(&DOUBLE_ECP, &A1);
-    rc = COMMITMENTS_NM_decommit(&DOUBLE_ECP, &A_COMMIT_R, &A_COMMIT_C);
+    rc = COMMITMENTS_NM_decommit_v(2, VA1, &A_COMMIT_R, &A_COMMIT_C);
     if (rc != COMMITMENTS_OK)
     {
         printf("\nFAILURE - Invalid Alice (V, A) commitment\n");
@@ -1140,9 +1134,7 @@ void phase5(csprng *RNG, octet *RP1, octet *RP2, octet *R1, octet *R2, octet *HM
     // Generate commitment to U, T
     printf("\n\tCommitment\n");
 
-    OCT_copy(&DOUBLE_ECP, &U1);
-    OCT_joctet(&DOUBLE_ECP, &T1);
-    COMMITMENTS_NM_commit(RNG, &DOUBLE_ECP, &A_COMMIT_R, &A_COMMIT_C);
+    COMMITMENTS_NM_commit_v(RNG, 2, UT1, &A_COMMIT_R, &A_COMMIT_C);
 
     printf("\t\tR = ");
     OCT_output(&A_COMMIT_R);
@@ -1168,9 +1160,7 @@ void phase5(csprng *RNG, octet *RP1, octet *RP2, octet *R1, octet *R2, octet *HM
     // Generate commitment to U, T
     printf("\n\tCommitment\n");
 
-    OCT_copy(&DOUBLE_ECP, &U2);
-    OCT_joctet(&DOUBLE_ECP, &T2);
-    COMMITMENTS_NM_commit(RNG, &DOUBLE_ECP, &B_COMMIT_R, &B_COMMIT_C);
+    COMMITMENTS_NM_commit_v(RNG, 2, UT2, &B_COMMIT_R, &B_COMMIT_C);
 
     printf("\t\tR = ");
     OCT_output(&B_COMMIT_R);
@@ -1185,9 +1175,7 @@ void phase5(csprng *RNG, octet *RP1, octet *RP2, octet *R1, octet *R2, octet *HM
 
     printf("\n[Alice] Decommit Bob (U, T)\n");
 
-    OCT_copy(&DOUBLE_ECP, &U2);
-    OCT_joctet(&DOUBLE_ECP, &T2);
-    rc = COMMITMENTS_NM_decommit(&DOUBLE_ECP, &B_COMMIT_R, &B_COMMIT_C);
+    rc = COMMITMENTS_NM_decommit_v(2, UT2, &B_COMMIT_R, &B_COMMIT_C);
     if (rc != COMMITMENTS_OK)
     {
         printf("\nFAILURE - Invalid Bob (U, T) commitment\n");
@@ -1198,9 +1186,7 @@ void phase5(csprng *RNG, octet *RP1, octet *RP2, octet *R1, octet *R2, octet *HM
 
     printf("\n[Bob] Decommit Alice (U, T)\n");
 
-    OCT_copy(&DOUBLE_ECP, &U1);
-    OCT_joctet(&DOUBLE_ECP, &T1);
-    rc = COMMITMENTS_NM_decommit(&DOUBLE_ECP, &A_COMMIT_R, &A_COMMIT_C);
+    rc = COMMITMENTS_NM_decommit_v(2, UT1, &A_COMMIT_R, &A_COMMIT_C);
     if (rc != COMMITMENTS_OK)
     {
         printf("\nFAILURE - Invalid Alice (U, T) commitment\n");
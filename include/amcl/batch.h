@@ -0,0 +1,136 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/**
+ * @file batch.h
+ * @brief Cross-session verification scheduler declarations
+ *
+ */
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "amcl/amcl.h"
+#include "amcl/schnorr.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define BATCH_MAX_ENTRIES 256    /**< Maximum number of proofs queued in a scheduler */
+
+#define BATCH_SCHNORR      1     /**< Schnorr's Proof */
+
+/*! \brief Function called with the verification result of a proof
+ *
+ * @param session     Session pointer given when the proof was queued
+ * @param type        Type of the proof verified
+ * @param rc          Return code of the verification function for the proof type
+ */
+typedef void (*BATCH_callback)(void *session, int type, int rc);
+
+/*! \brief Proof queued for verification
+ *
+ * Only pointers to the proof and its inputs are stored, so they must
+ * be kept valid until the callback for the proof is called
+ */
+typedef struct
+{
+    int type;                 /**< Type of the proof */
+    unsigned long arrival;    /**< Time the proof was queued */
+    void *session;            /**< Session the proof belongs to */
+    BATCH_callback cb;        /**< Function called with the result */
+    struct
+    {
+        octet *V;
+        octet *C;
+        octet *E;
+        octet *P;
+    } schnorr;                /**< Inputs of the verification */
+} BATCH_entry;
+
+/*! \brief Verification scheduler
+ *
+ * Schnorr's Proofs from different sessions are queued and checked
+ * together with SCHNORR_batch_verify. The queue is verified when it
+ * reaches flush_size proofs or when its oldest proof has been queued
+ * for deadline time units.
+ *
+ * Only Schnorr's Proofs are scheduled. The MTA and factoring proofs
+ * have no batch verification, so queueing them would only delay them
+ */
+typedef struct
+{
+    csprng *RNG;                           /**< CSPRNG for the batch coefficients */
+    int flush_size;                        /**< Queue size triggering the verification */
+    int msm_window;                        /**< Window size for SCHNORR_batch_verify */
+    unsigned long deadline;                /**< Maximum queueing time. 0 to disable */
+    int n;                                 /**< Number of queued proofs */
+    BATCH_entry entries[BATCH_MAX_ENTRIES]; /**< Queued proofs in arrival order */
+} BATCH_scheduler;
+
+/*! \brief Initialise a scheduler
+ *
+ * @param s             Scheduler to initialise
+ * @param RNG           CSPRNG for the batch coefficients. Must be kept valid for the scheduler lifetime
+ * @param flush_size    Queue size triggering the verification. At most BATCH_MAX_ENTRIES
+ * @param msm_window    Window size for SCHNORR_batch_verify. Between 1 and SCHNORR_MSM_MAX_WINDOW
+ * @param deadline      Maximum queueing time, in the units used by the caller. 0 to disable
+ */
+extern void BATCH_init(BATCH_scheduler *s, csprng *RNG, int flush_size, int msm_window, unsigned long deadline);
+
+/*! \brief Queue a Schnorr's Proof
+ *
+ * The queued proofs are checked together using
+ * SCHNORR_batch_verify. If the batch is invalid
+ * it is split in halves until the invalid proofs are found
+ *
+ * The callback, for this or other proofs, might be called before
+ * this function returns. The callbacks must not use the scheduler.
+ *
+ * @param s             Scheduler
+ * @param now           Current time
+ * @param session       Session pointer passed to the callback
+ * @param cb            Function called with the result of SCHNORR_verify
+ * @param V             Public ECP of the DLOG. V = x.G
+ * @param C             Commitment value received from the prover
+ * @param E             Challenge for the Schnorr Proof
+ * @param P             Proof received from the prover
+ */
+extern void BATCH_add_schnorr(BATCH_scheduler *s, unsigned long now, void *session, BATCH_callback cb, octet *V, octet *C, octet *E, octet *P);
+
+/*! \brief Verify the queued proofs if the oldest is past the deadline
+ *
+ * @param s             Scheduler
+ * @param now           Current time
+ */
+extern void BATCH_poll(BATCH_scheduler *s, unsigned long now);
+
+/*! \brief Verify all the queued proofs
+ *
+ * @param s             Scheduler
+ */
+extern void BATCH_flush(BATCH_scheduler *s);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
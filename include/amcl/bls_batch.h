@@ -0,0 +1,111 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/**
+ * @file bls_batch.h
+ * @brief BLS aggregation and batch verification declarations
+ *
+ */
+
+#ifndef BLS_BATCH_H
+#define BLS_BATCH_H
+
+#include "amcl/amcl.h"
+#include "amcl/ecp_BLS381.h"
+#include "amcl/ecp2_BLS381.h"
+#include "amcl/pair_BLS381.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define BLS_BATCH_OK          0     /**< Execution Successful */
+#define BLS_BATCH_FAIL        161   /**< Invalid signature */
+#define BLS_BATCH_INVALID_ECP 162   /**< Input is not a valid point */
+
+#define BLS_BATCH_SECURITY    128   /**< Bits of the random coefficients for the batch verification */
+
+/*! \brief Aggregate points of G1
+ *
+ * \f$ R = P_1 + \ldots + P_n \f$
+ *
+ * @param n     Number of points
+ * @param P     Points to aggregate, e.g. signatures
+ * @param R     Aggregated point. Compressed form
+ * @return      BLS_BATCH_OK or BLS_BATCH_INVALID_ECP
+ */
+extern int BLS_BATCH_aggregate_G1(int n, octet *P[], octet *R);
+
+/*! \brief Aggregate points of G2
+ *
+ * \f$ R = W_1 + \ldots + W_n \f$
+ *
+ * @param n     Number of points
+ * @param W     Points to aggregate, e.g. public keys
+ * @param R     Aggregated point
+ * @return      BLS_BATCH_OK or BLS_BATCH_INVALID_ECP
+ */
+extern int BLS_BATCH_aggregate_G2(int n, octet *W[], octet *R);
+
+/*! \brief Verify an aggregated signature on n messages
+ *
+ * \f$ e(G_2, -S) \prod_i e(W_i, H(M_i)) \stackrel{?}{=} 1 \f$
+ *
+ * The Miller loops are computed two at a time and their product
+ * goes through a single final exponentiation. The messages are
+ * hashed to G1 as in BLS_BLS381_SIGN.
+ *
+ * The messages must be distinct, unless the public keys come
+ * with a proof of possession of the secret key.
+ *
+ * @param SIG   Aggregated signature
+ * @param n     Number of messages
+ * @param M     Signed messages
+ * @param W     Public keys of the signers
+ * @return      BLS_BATCH_OK if the signature is valid or an error code
+ */
+extern int BLS_BATCH_verify_aggregate(octet *SIG, int n, octet *M[], octet *W[]);
+
+/*! \brief Verify n signatures
+ *
+ * Check a random linear combination of the verification equations
+ * with a single multi-pairing
+ *
+ * \f$ e(G_2, -\sum_i \rho_i S_i) \prod_i e(W_i, \rho_i H(M_i)) \stackrel{?}{=} 1 \f$
+ *
+ * The coefficients are BLS_BATCH_SECURITY bits long. The signatures are
+ * checked to be in the subgroup of order q, since points outside of it
+ * could cancel in the combination. If the batch is invalid, BLS_BLS381_VERIFY
+ * can be used to find the invalid signatures
+ *
+ * @param RNG   CSPRNG for the random coefficients of the combination
+ * @param n     Number of signatures
+ * @param SIG   Signatures
+ * @param M     Signed messages
+ * @param W     Public keys of the signers
+ * @return      BLS_BATCH_OK if all the signatures are valid or an error code
+ */
+extern int BLS_BATCH_verify(csprng *RNG, int n, octet *SIG[], octet *M[], octet *W[]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -57,6 +57,29 @@ extern void COMMITMENTS_NM_commit(csprng *RNG, const octet *X, octet *R, octet *
  */
 extern int COMMITMENTS_NM_decommit(const octet* X, const octet* R, octet* C);
 
+/*! \brief Generate a commitment for the value X_1 || ... || X_n
+ *
+ * The segments are hashed in place, with the same result as
+ * COMMITMENTS_NM_commit on their concatenation.
+ *
+ * @param RNG   CSPRNG to use for commitment
+ * @param n     Number of segments
+ * @param X     Segments of the value to commit to
+ * @param R     Decommitment value. If RNG is null then this value is read and must be 256 bit long
+ * @param C     Commitment value
+ */
+extern void COMMITMENTS_NM_commit_v(csprng *RNG, int n, octet *X[], octet *R, octet *C);
+
+/*! \brief Decommit the value X_1 || ... || X_n
+ *
+ * @param n     Number of segments
+ * @param X     Segments of the committed value
+ * @param R     Decommitment value. Must be 256 bit long
+ * @param C     Commitment value
+ * @return      COMMITMENTS_OK for a valid decommitment, COMMITMENTS_FAIL otherwise
+ */
+extern int COMMITMENTS_NM_decommit_v(int n, octet *X[], const octet *R, octet *C);
+
 /* Bit Commitment Setup API */
 
 #ifndef FS_2048
@@ -119,6 +142,56 @@ extern void COMMITMENTS_BC_kill_priv_modulus(COMMITMENTS_BC_priv_modulus *m);
  */
 extern void COMMITMENTS_BC_export_public_modulus(COMMITMENTS_BC_pub_modulus *pub, COMMITMENTS_BC_priv_modulus *priv);
 
+/* Bit Commitment Modulus Proof API */
+
+#define COMMITMENTS_BC_DLOG_ROUNDS 128                                               /**< Repetitions for each DLOG relation. Soundness error 2^-128 */
+#define COMMITMENTS_BC_DLOG_Z_SIZE (2 * COMMITMENTS_BC_DLOG_ROUNDS * FS_2048)        /**< Size of the proof responses in bytes */
+
+/*! \brief Prove that b0 and b1 generate the same subgroup of Z/NZ
+ *
+ * Prove knowledge of alpha and ialpha for the DLOG relations
+ * \f$ b_1 = b_0^{\alpha} \f$ and \f$ b_0 = b_1^{\alpha^{-1}} \f$
+ * with COMMITMENTS_BC_DLOG_ROUNDS binary challenge repetitions each.
+ *
+ * <ol>
+ * <li> \f$ r_i \in_R [0, \ldots, pq] \f$
+ * <li> \f$ A_i = b^{r_i} \text{ }\mathrm{mod}\text{ }N \f$ where \f$ b \f$ is the base of the relation
+ * <li> \f$ e = H(N, b_0, b_1, A_1, \ldots, A_{2k}, ID, AD) \f$, the i-th bit \f$ c_i \f$ is the challenge for the i-th repetition
+ * <li> \f$ z_i = r_i + c_i x \text{ }\mathrm{mod}\text{ }pq \f$ where \f$ x \f$ is the DLOG of the relation
+ * </ol>
+ *
+ * @param RNG   CSPRNG for the random values of the proof
+ * @param m     Private modulus
+ * @param ID    Prover unique identifier
+ * @param AD    Additional data to bind in the proof - Optional
+ * @param E     Challenge of the proof, SHA256 bytes
+ * @param Z     Responses of the proof, COMMITMENTS_BC_DLOG_Z_SIZE bytes
+ */
+extern void COMMITMENTS_BC_DLOG_prove(csprng *RNG, COMMITMENTS_BC_priv_modulus *m, const octet *ID, const octet *AD, octet *E, octet *Z);
+
+/*! \brief Verify the proof that b0 and b1 generate the same subgroup of Z/NZ
+ *
+ * The commitments are recomputed and the challenge is checked against them
+ *
+ * <ol>
+ * <li> \f$ A_i = b^{z_i} t^{-c_i} \text{ }\mathrm{mod}\text{ }N \f$ where \f$ t \f$ is the target of the relation
+ * <li> \f$ e \stackrel{?}{=} H(N, b_0, b_1, A_1, \ldots, A_{2k}, ID, AD) \f$
+ * </ol>
+ *
+ * Each \f$ A_i \f$ is computed with a single simultaneous exponentiation
+ * \f$ b^{z_{i,lo}} (b^{2^{1024}})^{z_{i,hi}} (t^{-1})^{c_i} \f$ with half
+ * length exponents, sharing \f$ b^{2^{1024}} \f$ and \f$ t^{-1} \f$ among
+ * all the repetitions.
+ *
+ * @param m     Public modulus of the prover
+ * @param ID    Prover unique identifier
+ * @param AD    Additional data to bind in the proof - Optional
+ * @param E     Challenge of the proof
+ * @param Z     Responses of the proof
+ * @return      COMMITMENTS_OK if the proof is valid, COMMITMENTS_FAIL otherwise
+ */
+extern int COMMITMENTS_BC_DLOG_verify(COMMITMENTS_BC_pub_modulus *m, const octet *ID, const octet *AD, octet *E, octet *Z);
+
 #ifdef __cplusplus
 }
 #endif
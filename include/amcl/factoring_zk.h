@@ -71,6 +71,22 @@ typedef struct
  */
 void FACTORING_ZK_prove(csprng *RNG, FACTORING_ZK_modulus *m, const octet *ID, const octet *AD, octet *R, octet *E, octet *Y);
 
+/** \brief Prove knowledge of the modulus m in ZK with segmented additional data
+ *
+ *  Same as FACTORING_ZK_prove with AD = AD_1 || ... || AD_n.
+ *  The segments are hashed in place.
+ *
+ *  @param  RNG         Cryptographically secure PRNG
+ *  @param  m           Modulus to prove knowldege of factoring
+ *  @param  ID          Prover unique identifier
+ *  @param  n           Number of segments of the additional data
+ *  @param  AD          Segments of the additional data to bind in the proof
+ *  @param  R           Random value used in the proof. If RNG is NULL this is read
+ *  @param  E           First component of the ZK proof
+ *  @param  Y           Second component of the ZK proof
+ */
+void FACTORING_ZK_prove_v(csprng *RNG, FACTORING_ZK_modulus *m, const octet *ID, int n, octet *AD[], octet *R, octet *E, octet *Y);
+
 /** \brief Verify ZK proof of knowledge of factoring of N
  *
  *  Verify that (E, Y) is a valid proof of knowledge of factoring of N
@@ -84,6 +100,20 @@ void FACTORING_ZK_prove(csprng *RNG, FACTORING_ZK_modulus *m, const octet *ID, c
  */
 int FACTORING_ZK_verify(octet *N, octet *E, octet *Y, const octet *ID, const octet *AD);
 
+/** \brief Verify ZK proof of knowledge of factoring of N with segmented additional data
+ *
+ *  Same as FACTORING_ZK_verify with AD = AD_1 || ... || AD_n.
+ *
+ *  @param  N           Public integer, the RSA modulus
+ *  @param  E           Fisrt component of the ZK proof
+ *  @param  Y           Second component of the ZK proof
+ *  @param  ID          Prover unique identifier
+ *  @param  n           Number of segments of the additional data
+ *  @param  AD          Segments of the additional data to bind in the proof
+ *  @return             FACTORING_ZK_OK, FACTORING_ZK_FAIL or FACTORING_ZK_OUT_OF_BOUNDS
+ */
+int FACTORING_ZK_verify_v(octet *N, octet *E, octet *Y, const octet *ID, int n, octet *AD[]);
+
 /** \brief Read a modulus from octets
  *
  *  @param  m           The destination modulus
@@ -0,0 +1,74 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/**
+ * @file gcm_batch.h
+ * @brief Batch AES-GCM encryption declarations
+ *
+ */
+
+#ifndef GCM_BATCH_H
+#define GCM_BATCH_H
+
+#include "amcl/amcl.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define GCM_BATCH_TAG_SIZE 16   /**< Size of the authentication tag in bytes */
+
+/*! \brief Encrypt a batch of records under the same AES key
+ *
+ * Each record is encrypted as with AES_GCM_ENCRYPT. The output octets
+ * C[i] must have space for P[i]->len bytes and T[i] for
+ * GCM_BATCH_TAG_SIZE bytes
+ *
+ * @param K     AES key. 16, 24 or 32 bytes
+ * @param n     Number of records
+ * @param IV    Initialisation vectors. Must be unique for each record
+ * @param H     Headers authenticated with the records. Optional
+ * @param P     Plaintexts
+ * @param C     Ciphertexts
+ * @param T     Authentication tags
+ */
+extern void GCM_BATCH_encrypt(octet *K, int n, octet *IV[], octet *H[], octet *P[], octet *C[], octet *T[]);
+
+/*! \brief Decrypt a batch of records under the same AES key
+ *
+ * Each record is decrypted as with AES_GCM_DECRYPT. The tags T[i] are
+ * computed on the ciphertexts and must be compared by the caller with
+ * the received tags
+ *
+ * @param K     AES key. 16, 24 or 32 bytes
+ * @param n     Number of records
+ * @param IV    Initialisation vectors
+ * @param H     Headers authenticated with the records. Optional
+ * @param C     Ciphertexts
+ * @param P     Plaintexts
+ * @param T     Authentication tags
+ */
+extern void GCM_BATCH_decrypt(octet *K, int n, octet *IV[], octet *H[], octet *C[], octet *P[], octet *T[]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
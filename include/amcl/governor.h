@@ -0,0 +1,188 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/**
+ * @file governor.h
+ * @brief Load-adaptive governor for background precomputation declarations
+ *
+ * Offline work, e.g. Paillier randomness, commitments, presignatures
+ * or key shares, is kept in pools that online requests draw from. The
+ * governor decides when offline work may run and which pool it should
+ * refill:
+ *
+ * <ol>
+ * <li> Offline work uses at most budget units of CPU time in each window
+ * <li> Offline work is paused while the online latency is above the target,
+ *      except for pools that ran dry
+ * <li> The pool below target with the shortest time to empty at its
+ *      consumption rate is refilled first
+ * </ol>
+ *
+ * The governor does not run any work and does not read the clock.
+ * The caller passes the current time and the measured CPU time, in
+ * any unit as long as it is used consistently, and serialises the
+ * calls. Microseconds are needed to use GOVERNOR_cgroup_budget.
+ */
+
+#ifndef GOVERNOR_H
+#define GOVERNOR_H
+
+#include "amcl/amcl.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define GOVERNOR_OK   0          /**< Execution Successful */
+#define GOVERNOR_FAIL 201        /**< Invalid parameters or unreadable quota */
+
+#define GOVERNOR_MAX_POOLS 8     /**< Maximum number of pools */
+#define GOVERNOR_IDLE      -1    /**< No offline work should run */
+
+#define GOVERNOR_WEIGHT 0.25     /**< Weight of the last window in the moving averages */
+
+/*! \brief Pool of precomputed items */
+typedef struct
+{
+    const char *name;          /**< Name of the pool, for the stats */
+    int level;                 /**< Items available */
+    int target;                /**< Level to keep the pool at */
+    unsigned long consumed;    /**< Items consumed in the current window */
+    double rate;               /**< Moving average of the consumption, items per time unit */
+    unsigned long refilled;    /**< Items produced since the initialisation */
+    unsigned long dry;         /**< Items requested while the pool was empty */
+} GOVERNOR_pool;
+
+/*! \brief Governor state */
+typedef struct
+{
+    unsigned long budget;      /**< CPU time available to offline work in each window */
+    unsigned long window;      /**< Length of a window */
+    unsigned long target;      /**< Target online latency */
+    unsigned long start;       /**< Start of the current window */
+    unsigned long used;        /**< CPU time used by offline work in the current window */
+    unsigned long requests;    /**< Online requests in the current window */
+    double rate;               /**< Moving average of the online requests, per time unit */
+    double latency;            /**< Moving average of the online latency */
+    int paused;                /**< 1 if offline work is paused because of the online latency */
+    unsigned long throttled;   /**< Calls to GOVERNOR_next denied by the budget */
+    unsigned long pauses;      /**< Number of times offline work was paused */
+    int n;                     /**< Number of pools */
+    GOVERNOR_pool pools[GOVERNOR_MAX_POOLS]; /**< Pools */
+} GOVERNOR_state;
+
+/*! \brief Snapshot of the governor state for monitoring */
+typedef struct
+{
+    unsigned long budget;      /**< CPU time available to offline work in each window */
+    unsigned long used;        /**< CPU time used by offline work in the current window */
+    double rate;               /**< Moving average of the online requests, per time unit */
+    double latency;            /**< Moving average of the online latency */
+    int paused;                /**< 1 if offline work is paused because of the online latency */
+    unsigned long throttled;   /**< Calls to GOVERNOR_next denied by the budget */
+    unsigned long pauses;      /**< Number of times offline work was paused */
+    int next;                  /**< Pool that would be refilled now or GOVERNOR_IDLE */
+    int n;                     /**< Number of pools */
+    GOVERNOR_pool pools[GOVERNOR_MAX_POOLS]; /**< Pools */
+} GOVERNOR_stats;
+
+/*! \brief Initialise a governor
+ *
+ * @param g             Governor to initialise
+ * @param now           Current time
+ * @param budget        CPU time available to offline work in each window
+ * @param window        Length of a window
+ * @param target        Target online latency. Offline work is paused above it
+ * @return              GOVERNOR_OK or GOVERNOR_FAIL if window is zero
+ */
+extern int GOVERNOR_init(GOVERNOR_state *g, unsigned long now, unsigned long budget, unsigned long window, unsigned long target);
+
+/*! \brief Add a pool
+ *
+ * @param g             Governor
+ * @param name          Name of the pool. Must be kept valid for the governor lifetime
+ * @param level         Items already available
+ * @param target        Level to keep the pool at. Positive
+ * @return              Index of the pool or GOVERNOR_IDLE if it can not be added
+ */
+extern int GOVERNOR_add_pool(GOVERNOR_state *g, const char *name, int level, int target);
+
+/*! \brief Record an online request
+ *
+ * @param g             Governor
+ * @param now           Completion time of the request
+ * @param latency       Latency of the request
+ */
+extern void GOVERNOR_online(GOVERNOR_state *g, unsigned long now, unsigned long latency);
+
+/*! \brief Take items from a pool
+ *
+ * @param g             Governor
+ * @param pool          Index of the pool
+ * @param n             Items requested
+ * @return              Items taken, less than n if the pool ran dry
+ */
+extern int GOVERNOR_consume(GOVERNOR_state *g, int pool, int n);
+
+/*! \brief Choose the pool to refill
+ *
+ * @param g             Governor
+ * @param now           Current time
+ * @return              Index of the pool to refill or GOVERNOR_IDLE
+ */
+extern int GOVERNOR_next(GOVERNOR_state *g, unsigned long now);
+
+/*! \brief Record completed offline work
+ *
+ * @param g             Governor
+ * @param pool          Index of the pool refilled
+ * @param n             Items produced
+ * @param cpu           CPU time used to produce them
+ */
+extern void GOVERNOR_done(GOVERNOR_state *g, int pool, int n, unsigned long cpu);
+
+/*! \brief Take a snapshot of the governor state
+ *
+ * @param g             Governor
+ * @param now           Current time
+ * @param s             Destination stats
+ */
+extern void GOVERNOR_get_stats(GOVERNOR_state *g, unsigned long now, GOVERNOR_stats *s);
+
+/*! \brief Derive the budget from a cgroup v2 CPU quota
+ *
+ * The file, usually /sys/fs/cgroup/cpu.max, contains the quota and
+ * the period in microseconds, or max and the period if the group has
+ * no quota. In that case the quota is ncpu periods.
+ *
+ * @param path          Path of the cpu.max file
+ * @param ncpu          Number of CPUs available without a quota
+ * @param permille      Share of the quota for offline work, in thousandths
+ * @param budget        Destination budget in microseconds
+ * @param window        Destination window in microseconds
+ * @return              GOVERNOR_OK or GOVERNOR_FAIL if the file can not be read
+ */
+extern int GOVERNOR_cgroup_budget(const char *path, int ncpu, int permille, unsigned long *budget, unsigned long *window);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,113 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/**
+ * @file keygen.h
+ * @brief Bulk ECDSA key share generation declarations
+ *
+ * Shares are generated with a precomputed table of multiples of the
+ * generator, and the points of a chunk of shares are normalised with
+ * a single field inversion
+ */
+
+#ifndef KEYGEN_H
+#define KEYGEN_H
+
+#include "amcl/amcl.h"
+#include "amcl/big_256_56.h"
+#include "amcl/ecp_SECP256K1.h"
+#include "amcl/schnorr.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define KEYGEN_OK   0     /**< Execution Successful */
+#define KEYGEN_FAIL 191   /**< Invalid number of shares or output too small */
+
+#define KEYGEN_WINDOW  4                                                      /**< Window size of the generator table */
+#define KEYGEN_DIGITS  ((8 * EGS_SECP256K1 + KEYGEN_WINDOW - 1) / KEYGEN_WINDOW) /**< Number of windows of a scalar */
+#define KEYGEN_ENTRIES (1 << KEYGEN_WINDOW)                                   /**< Entries for each window of the table */
+#define KEYGEN_CHUNK   64                                                     /**< Shares normalised with a single inversion */
+
+#define KEYGEN_W_SIZE (EFS_SECP256K1 + 1)  /**< Size of a compressed public share or commitment */
+
+/*! \brief Table of multiples of the generator
+ *
+ * \f$ T_{j,d} = d 2^{wj}.G \f$ for each window j and digit d. The
+ * table is about 150KB, so it should be allocated statically or on
+ * the heap. It only holds public values and can be shared by threads.
+ */
+typedef struct
+{
+    ECP_SECP256K1 T[KEYGEN_DIGITS][KEYGEN_ENTRIES]; /**< Multiples of the generator */
+} KEYGEN_table;
+
+/** \brief Precompute the table of multiples of the generator
+ *
+ *  @param t           Destination table
+ */
+extern void KEYGEN_table_init(KEYGEN_table *t);
+
+/** \brief Compute s.G using the generator table
+ *
+ *  The digits of s select the table entries in constant time
+ *
+ *  @param t           Generator table
+ *  @param P           Destination point. It is not normalised
+ *  @param s           Scalar
+ */
+extern void KEYGEN_table_mul(KEYGEN_table *t, ECP_SECP256K1 *P, BIG_256_56 s);
+
+/** \brief Generate n ECDSA key shares with their Schnorr's Proofs
+ *
+ *  For each share i
+ *
+ *  <ol>
+ *  <li> \f$ s_i, r_i \in_R [0, \ldots, q] \f$
+ *  <li> \f$ W_i = s_i.G \f$, \f$ C_i = r_i.G \f$
+ *  <li> \f$ e_i = H(G, C_i, W_i, ID, AD) \f$ as in SCHNORR_challenge
+ *  <li> \f$ p_i = r_i - e_i s_i \text{ }\mathrm{mod}\text{ }q \f$ as in SCHNORR_prove
+ *  </ol>
+ *
+ *  The outputs are written contiguously. The share i is at offset
+ *  \f$ i \cdot \f$ EGS_SECP256K1 in S and P, and at offset
+ *  \f$ i \cdot \f$ KEYGEN_W_SIZE in W and C. The proof of each share
+ *  can be checked with SCHNORR_challenge and SCHNORR_verify, or with
+ *  SCHNORR_batch_verify.
+ *
+ *  @param RNG         csprng for the shares and the commitments
+ *  @param t           Generator table
+ *  @param n           Number of shares
+ *  @param ID          Prover unique identifier
+ *  @param AD          Additional data to bind in the challenges - Optional
+ *  @param S           Destination secret shares. At least n * EGS_SECP256K1 bytes
+ *  @param W           Destination public shares, compressed. At least n * KEYGEN_W_SIZE bytes
+ *  @param C           Destination Schnorr's commitments, compressed. At least n * KEYGEN_W_SIZE bytes
+ *  @param P           Destination Schnorr's proofs. At least n * EGS_SECP256K1 bytes
+ *  @return            KEYGEN_OK or KEYGEN_FAIL if n is not positive or an output is too small
+ */
+extern int KEYGEN_generate(csprng *RNG, KEYGEN_table *t, int n, const octet *ID, const octet *AD, octet *S, octet *W, octet *C, octet *P);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
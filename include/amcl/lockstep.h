@@ -0,0 +1,425 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/**
+ * @file lockstep.h
+ * @brief Round-batched signing declarations
+ *
+ * Run the signing protocol for n signatures in lockstep. Every
+ * function processes the values of all the signatures for a protocol
+ * step, and the values for a round can be packed in a single message,
+ * so n signatures take the round-trips of a single one.
+ *
+ * The values of the signature i are always at index i of the arrays.
+ */
+
+#ifndef LOCKSTEP_H
+#define LOCKSTEP_H
+
+#include "amcl/amcl.h"
+#include "amcl/mta.h"
+#include "amcl/mta_backend.h"
+#include "amcl/mpc.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define LOCKSTEP_OK   0          /**< Execution Successful */
+#define LOCKSTEP_FAIL 131        /**< Invalid message or number of signatures */
+
+#define LOCKSTEP_MAX_SIGNATURES 64   /**< Maximum number of signatures in lockstep */
+
+/* Message packing API */
+
+/** \brief Pack the values of a round in a single message
+ *
+ *  Each value is encoded with its length in two bytes, big endian,
+ *  followed by its bytes
+ *
+ *  @param n           Number of values
+ *  @param V           Values to pack
+ *  @param M           Destination message
+ *  @return            LOCKSTEP_OK or LOCKSTEP_FAIL if M is too small
+ */
+extern int LOCKSTEP_pack(int n, octet *V[], octet *M);
+
+/** \brief Unpack the values of a round from a message
+ *
+ *  @param M           Message to unpack
+ *  @param n           Number of values expected
+ *  @param V           Destination values
+ *  @return            LOCKSTEP_OK or LOCKSTEP_FAIL if the message is malformed or a value does not fit
+ */
+extern int LOCKSTEP_unpack(octet *M, int n, octet *V[]);
+
+/* MTA API */
+
+/** \brief Client MTA first pass for n signatures
+ *
+ *  See MPC_MTA_CLIENT1_CRT
+ *
+ *  @param RNG         csprng for the encryption randomness
+ *  @param PRIV        Private Paillier key of the client
+ *  @param n           Number of signatures
+ *  @param A           Multiplicative shares of the client
+ *  @param CA          Destination ciphertexts
+ *  @param R           Randomness used in the encryption. If RNG is NULL this is read
+ */
+extern void LOCKSTEP_MTA_CLIENT1(csprng *RNG, PAILLIER_private_key *PRIV, int n, octet *A[], octet *CA[], octet *R[]);
+
+/** \brief Server MTA pass for n signatures
+ *
+ *  See MPC_MTA_SERVER
+ *
+ *  @param RNG         csprng for the random values
+ *  @param PUB         Public Paillier key of the client
+ *  @param n           Number of signatures
+ *  @param B           Multiplicative shares of the server
+ *  @param CA          Ciphertexts received from the client
+ *  @param Z           Random values. If RNG is NULL this is read
+ *  @param R           Randomness used in the encryption. If RNG is NULL this is read
+ *  @param CB          Destination ciphertexts
+ *  @param BETA        Destination additive shares of the server
+ */
+extern void LOCKSTEP_MTA_SERVER(csprng *RNG, PAILLIER_public_key *PUB, int n, octet *B[], octet *CA[], octet *Z[], octet *R[], octet *CB[], octet *BETA[]);
+
+/** \brief Client MTA second pass for n signatures
+ *
+ *  See MPC_MTA_CLIENT2
+ *
+ *  @param PRIV        Private Paillier key of the client
+ *  @param n           Number of signatures
+ *  @param CB          Ciphertexts received from the server
+ *  @param ALPHA       Destination additive shares of the client
+ */
+extern void LOCKSTEP_MTA_CLIENT2(PAILLIER_private_key *PRIV, int n, octet *CB[], octet *ALPHA[]);
+
+/** \brief Range Proofs for n ciphertexts
+ *
+ *  Run MTA_RP_commit, MTA_RP_challenge and MTA_RP_prove for each ciphertext
+ *
+ *  @param RNG         csprng for the commitments
+ *  @param PUB         Public Paillier key of the prover
+ *  @param PRIV        Private Paillier key of the prover
+ *  @param mod         Public BC modulus of the verifier
+ *  @param params      Statistical security parameters. NULL for MTA_PARAMS_DEFAULT
+ *  @param n           Number of ciphertexts
+ *  @param M           Messages encrypted in CT
+ *  @param R           Randomness used in the encryption
+ *  @param CT          Ciphertexts
+ *  @param c           Destination commitments
+ *  @param p           Destination proofs
+ *  @return            MTA_OK, or MTA_FAIL if the parameters are not supported
+ */
+extern int LOCKSTEP_MTA_RP_prove(csprng *RNG, PAILLIER_public_key *PUB, PAILLIER_private_key *PRIV, COMMITMENTS_BC_pub_modulus *mod, const MTA_params *params, int n, octet *M[], octet *R[], octet *CT[], MTA_RP_commitment c[], MTA_RP_proof p[]);
+
+/** \brief Verify Range Proofs for n ciphertexts
+ *
+ *  @param PUB         Public Paillier key of the prover
+ *  @param mod         Private BC modulus of the verifier
+ *  @param params      Statistical security parameters. NULL for MTA_PARAMS_DEFAULT
+ *  @param n           Number of ciphertexts
+ *  @param CT          Ciphertexts
+ *  @param c           Received commitments
+ *  @param p           Received proofs
+ *  @param failed      Index of the first invalid proof. Optional
+ *  @return            MTA_OK if all the proofs are valid, MTA_FAIL otherwise
+ */
+extern int LOCKSTEP_MTA_RP_verify(PAILLIER_public_key *PUB, COMMITMENTS_BC_priv_modulus *mod, const MTA_params *params, int n, octet *CT[], MTA_RP_commitment c[], MTA_RP_proof p[], int *failed);
+
+/** \brief Receiver ZKPs for n MTA server passes
+ *
+ *  Run MTA_ZK_commit, MTA_ZK_challenge and MTA_ZK_prove for each pass
+ *
+ *  @param RNG         csprng for the commitments
+ *  @param PUB         Public Paillier key of the verifier
+ *  @param mod         Public BC modulus of the verifier
+ *  @param params      Statistical security parameters. NULL for MTA_PARAMS_DEFAULT
+ *  @param n           Number of passes
+ *  @param B           Multiplicative shares of the server
+ *  @param Z           Random values used in the passes
+ *  @param R           Randomness used in the encryption
+ *  @param CA          Ciphertexts received from the client
+ *  @param CB          Ciphertexts sent to the client
+ *  @param c           Destination commitments
+ *  @param p           Destination proofs
+ *  @return            MTA_OK, or MTA_FAIL if the parameters are not supported
+ */
+extern int LOCKSTEP_MTA_ZK_prove(csprng *RNG, PAILLIER_public_key *PUB, COMMITMENTS_BC_pub_modulus *mod, const MTA_params *params, int n, octet *B[], octet *Z[], octet *R[], octet *CA[], octet *CB[], MTA_ZK_commitment c[], MTA_ZK_proof p[]);
+
+/** \brief Verify Receiver ZKPs for n MTA server passes
+ *
+ *  @param PUB         Public Paillier key of the verifier
+ *  @param PRIV        Private Paillier key of the verifier
+ *  @param mod         Private BC modulus of the verifier
+ *  @param params      Statistical security parameters. NULL for MTA_PARAMS_DEFAULT
+ *  @param n           Number of passes
+ *  @param CA          Ciphertexts sent to the server
+ *  @param CB          Ciphertexts received from the server
+ *  @param c           Received commitments
+ *  @param p           Received proofs
+ *  @param failed      Index of the first invalid proof. Optional
+ *  @return            MTA_OK if all the proofs are valid, MTA_FAIL otherwise
+ */
+extern int LOCKSTEP_MTA_ZK_verify(PAILLIER_public_key *PUB, PAILLIER_private_key *PRIV, COMMITMENTS_BC_priv_modulus *mod, const MTA_params *params, int n, octet *CA[], octet *CB[], MTA_ZK_commitment c[], MTA_ZK_proof p[], int *failed);
+
+/** \brief Receiver ZKPs with check for n MTAwc server passes
+ *
+ *  Run MTA_ZKWC_commit, MTA_ZKWC_challenge and MTA_ZKWC_prove for each pass
+ *
+ *  @param RNG         csprng for the commitments
+ *  @param PUB         Public Paillier key of the verifier
+ *  @param mod         Public BC modulus of the verifier
+ *  @param params      Statistical security parameters. NULL for MTA_PARAMS_DEFAULT
+ *  @param n           Number of passes
+ *  @param B           Multiplicative shares of the server
+ *  @param Z           Random values used in the passes
+ *  @param R           Randomness used in the encryption
+ *  @param CA          Ciphertexts received from the client
+ *  @param CB          Ciphertexts sent to the client
+ *  @param X           Public ECPs of the shares B
+ *  @param c           Destination commitments
+ *  @param p           Destination proofs
+ *  @return            MTA_OK, or MTA_FAIL if the parameters are not supported
+ */
+extern int LOCKSTEP_MTA_ZKWC_prove(csprng *RNG, PAILLIER_public_key *PUB, COMMITMENTS_BC_pub_modulus *mod, const MTA_params *params, int n, octet *B[], octet *Z[], octet *R[], octet *CA[], octet *CB[], octet *X[], MTA_ZKWC_commitment c[], MTA_ZKWC_proof p[]);
+
+/** \brief Verify Receiver ZKPs with check for n MTAwc server passes
+ *
+ *  @param PUB         Public Paillier key of the verifier
+ *  @param PRIV        Private Paillier key of the verifier
+ *  @param mod         Private BC modulus of the verifier
+ *  @param params      Statistical security parameters. NULL for MTA_PARAMS_DEFAULT
+ *  @param n           Number of passes
+ *  @param CA          Ciphertexts sent to the server
+ *  @param CB          Ciphertexts received from the server
+ *  @param X           Public ECPs of the server shares
+ *  @param c           Received commitments
+ *  @param p           Received proofs
+ *  @param failed      Index of the first invalid proof. Optional
+ *  @return            MTA_OK if all the proofs are valid, MTA_FAIL otherwise
+ */
+extern int LOCKSTEP_MTA_ZKWC_verify(PAILLIER_public_key *PUB, PAILLIER_private_key *PRIV, COMMITMENTS_BC_priv_modulus *mod, const MTA_params *params, int n, octet *CA[], octet *CB[], octet *X[], MTA_ZKWC_commitment c[], MTA_ZKWC_proof p[], int *failed);
+
+/* Backend MTA API */
+
+/** \brief Client MTA first pass for n signatures with an encryption backend
+ *
+ *  @param backend     Encryption backend. NULL for MTA_BACKEND_DEFAULT
+ *  @param RNG         csprng for the encryption randomness
+ *  @param pub         Public key of the client for the backend
+ *  @param n           Number of signatures
+ *  @param A           Multiplicative shares of the client
+ *  @param CA          Destination ciphertexts
+ *  @param R           Randomness used in the encryption. If RNG is NULL this is read
+ */
+extern void LOCKSTEP_MTA_BACKEND_CLIENT1(const MTA_BACKEND *backend, csprng *RNG, void *pub, int n, octet *A[], octet *CA[], octet *R[]);
+
+/** \brief Server MTA pass for n signatures with an encryption backend
+ *
+ *  @param backend     Encryption backend. NULL for MTA_BACKEND_DEFAULT
+ *  @param RNG         csprng for the random values
+ *  @param pub         Public key of the client for the backend
+ *  @param n           Number of signatures
+ *  @param B           Multiplicative shares of the server
+ *  @param CA          Ciphertexts received from the client
+ *  @param Z           Random values. If RNG is NULL this is read
+ *  @param R           Randomness used in the encryption. If RNG is NULL this is read
+ *  @param CB          Destination ciphertexts
+ *  @param BETA        Destination additive shares of the server
+ */
+extern void LOCKSTEP_MTA_BACKEND_SERVER(const MTA_BACKEND *backend, csprng *RNG, void *pub, int n, octet *B[], octet *CA[], octet *Z[], octet *R[], octet *CB[], octet *BETA[]);
+
+/** \brief Client MTA second pass for n signatures with an encryption backend
+ *
+ *  @param backend     Encryption backend. NULL for MTA_BACKEND_DEFAULT
+ *  @param priv        Private key of the client for the backend
+ *  @param n           Number of signatures
+ *  @param CB          Ciphertexts received from the server
+ *  @param ALPHA       Destination additive shares of the client
+ */
+extern void LOCKSTEP_MTA_BACKEND_CLIENT2(const MTA_BACKEND *backend, void *priv, int n, octet *CB[], octet *ALPHA[]);
+
+/** \brief Client proofs for n MTA first passes with an encryption backend
+ *
+ *  @param backend     Encryption backend. NULL for MTA_BACKEND_DEFAULT
+ *  @param RNG         csprng for the commitments
+ *  @param pub         Public key of the client for the backend
+ *  @param priv        Private key of the client for the backend
+ *  @param vpub        Public proof setup of the verifier
+ *  @param params      Statistical security parameters. NULL for MTA_PARAMS_DEFAULT
+ *  @param n           Number of signatures
+ *  @param A           Multiplicative shares of the client
+ *  @param R           Randomness used in the encryption
+ *  @param CA          Ciphertexts sent to the server
+ *  @param P           Destination proofs. cproof_size bytes each
+ *  @return            MTA_OK, or MTA_FAIL if the parameters are not supported
+ */
+extern int LOCKSTEP_MTA_BACKEND_CLIENT1_prove(const MTA_BACKEND *backend, csprng *RNG, void *pub, void *priv, void *vpub, const MTA_params *params, int n, octet *A[], octet *R[], octet *CA[], void *P[]);
+
+/** \brief Verify the client proofs for n MTA first passes with an encryption backend
+ *
+ *  @param backend     Encryption backend. NULL for MTA_BACKEND_DEFAULT
+ *  @param pub         Public key of the client for the backend
+ *  @param vpriv       Private proof setup of the verifier
+ *  @param params      Statistical security parameters. NULL for MTA_PARAMS_DEFAULT
+ *  @param n           Number of signatures
+ *  @param CA          Ciphertexts received from the client
+ *  @param P           Received proofs
+ *  @param failed      Index of the first invalid proof. Optional
+ *  @return            MTA_OK if all the proofs are valid, MTA_FAIL otherwise
+ */
+extern int LOCKSTEP_MTA_BACKEND_CLIENT1_verify(const MTA_BACKEND *backend, void *pub, void *vpriv, const MTA_params *params, int n, octet *CA[], void *P[], int *failed);
+
+/** \brief Server proofs for n MTA server passes with an encryption backend
+ *
+ *  @param backend     Encryption backend. NULL for MTA_BACKEND_DEFAULT
+ *  @param RNG         csprng for the commitments
+ *  @param pub         Public key of the client for the backend
+ *  @param vpub        Public proof setup of the verifier
+ *  @param params      Statistical security parameters. NULL for MTA_PARAMS_DEFAULT
+ *  @param n           Number of signatures
+ *  @param B           Multiplicative shares of the server
+ *  @param Z           Random values used in the passes
+ *  @param R           Randomness used in the encryption
+ *  @param CA          Ciphertexts received from the client
+ *  @param CB          Ciphertexts sent to the client
+ *  @param X           Public ECPs of the shares B for the MTAwc. NULL for the MTA
+ *  @param P           Destination proofs. sproof_size bytes each
+ *  @return            MTA_OK, or MTA_FAIL if the parameters are not supported
+ */
+extern int LOCKSTEP_MTA_BACKEND_SERVER_prove(const MTA_BACKEND *backend, csprng *RNG, void *pub, void *vpub, const MTA_params *params, int n, octet *B[], octet *Z[], octet *R[], octet *CA[], octet *CB[], octet *X[], void *P[]);
+
+/** \brief Verify the server proofs for n MTA server passes with an encryption backend
+ *
+ *  @param backend     Encryption backend. NULL for MTA_BACKEND_DEFAULT
+ *  @param pub         Public key of the client for the backend
+ *  @param priv        Private key of the client for the backend
+ *  @param vpriv       Private proof setup of the verifier
+ *  @param params      Statistical security parameters. NULL for MTA_PARAMS_DEFAULT
+ *  @param n           Number of signatures
+ *  @param CA          Ciphertexts sent to the server
+ *  @param CB          Ciphertexts received from the server
+ *  @param X           Public ECPs of the server shares for the MTAwc. NULL for the MTA
+ *  @param P           Received proofs
+ *  @param failed      Index of the first invalid proof. Optional
+ *  @return            MTA_OK if all the proofs are valid, MTA_FAIL otherwise
+ */
+extern int LOCKSTEP_MTA_BACKEND_SERVER_verify(const MTA_BACKEND *backend, void *pub, void *priv, void *vpriv, const MTA_params *params, int n, octet *CA[], octet *CB[], octet *X[], void *P[], int *failed);
+
+/* MPC API */
+
+/** \brief Calculate the inverse of the sum of kgamma values for n signatures
+ *
+ *  The sums are inverted together with a single modular inversion.
+ *  See MPC_INVKGAMMA
+ *
+ *  @param n           Number of signatures
+ *  @param KGAMMA1     Actor 1 additive shares
+ *  @param KGAMMA2     Actor 2 additive shares
+ *  @param INVKGAMMA   Destination inverses of the sums
+ *  @return            LOCKSTEP_OK or LOCKSTEP_FAIL if n is not valid or a sum is zero
+ */
+extern int LOCKSTEP_INVKGAMMA(int n, octet *KGAMMA1[], octet *KGAMMA2[], octet *INVKGAMMA[]);
+
+/** \brief R component for n signatures
+ *
+ *  See MPC_R
+ *
+ *  @param n           Number of signatures
+ *  @param INVKGAMMA   Inverses of k times gamma
+ *  @param GAMMAPT1    Actor 1 gamma points
+ *  @param GAMMAPT2    Actor 2 gamma points
+ *  @param R           Destination R components
+ *  @param RP          Destination ECPs associated to the R components. Optional
+ *  @param failed      Index of the first failure. Optional
+ *  @return            MPC_OK or the error code of MPC_R
+ */
+extern int LOCKSTEP_R(int n, octet *INVKGAMMA[], octet *GAMMAPT1[], octet *GAMMAPT2[], octet *R[], octet *RP[], int *failed);
+
+/** \brief S component for n signatures
+ *
+ *  See MPC_S
+ *
+ *  @param n           Number of signatures
+ *  @param HM          Hashes of the messages
+ *  @param R           R components
+ *  @param K           Nonce values
+ *  @param SIGMA       Additive shares of k.w
+ *  @param S           Destination S components
+ *  @param failed      Index of the first failure. Optional
+ *  @return            MPC_OK or the error code of MPC_S
+ */
+extern int LOCKSTEP_S(int n, octet *HM[], octet *R[], octet *K[], octet *SIGMA[], octet *S[], int *failed);
+
+/** \brief Phase 5 commitments for n signatures
+ *
+ *  See MPC_PHASE5_commit
+ *
+ *  @param RNG         csprng for the random values
+ *  @param n           Number of signatures
+ *  @param R           Reconciled R for the signatures
+ *  @param S           Player signature shares
+ *  @param PHI         Random values. If RNG is NULL these are read
+ *  @param RHO         Random values. If RNG is NULL these are read
+ *  @param V           Destination first components of the commitments
+ *  @param A           Destination second components of the commitments
+ *  @param failed      Index of the first failure. Optional
+ *  @return            MPC_OK or the error code of MPC_PHASE5_commit
+ */
+extern int LOCKSTEP_PHASE5_commit(csprng *RNG, int n, octet *R[], octet *S[], octet *PHI[], octet *RHO[], octet *V[], octet *A[], int *failed);
+
+/** \brief Phase 5 proofs for n signatures
+ *
+ *  See MPC_PHASE5_prove
+ *
+ *  @param n           Number of signatures
+ *  @param PHI         Random values used in the commitments
+ *  @param RHO         Random values used in the commitments
+ *  @param V           Commitments V from both players for each signature
+ *  @param A           Commitments A from both players for each signature
+ *  @param PK          Shared public key
+ *  @param HM          Hashes of the messages
+ *  @param RX          x components of the reconciled R
+ *  @param U           Destination first components of the proofs
+ *  @param T           Destination second components of the proofs
+ *  @param failed      Index of the first failure. Optional
+ *  @return            MPC_OK or the error code of MPC_PHASE5_prove
+ */
+extern int LOCKSTEP_PHASE5_prove(int n, octet *PHI[], octet *RHO[], octet *V[][2], octet *A[][2], octet *PK, octet *HM[], octet *RX[], octet *U[], octet *T[], int *failed);
+
+/** \brief Verify the Phase 5 proofs for n signatures
+ *
+ *  See MPC_PHASE5_verify
+ *
+ *  @param n           Number of signatures
+ *  @param U           Proofs U from both players for each signature
+ *  @param T           Proofs T from both players for each signature
+ *  @param failed      Index of the first invalid proof. Optional
+ *  @return            MPC_OK or the error code of MPC_PHASE5_verify
+ */
+extern int LOCKSTEP_PHASE5_verify(int n, octet *U[][2], octet *T[][2], int *failed);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -132,6 +132,30 @@ void MPC_INVKGAMMA(const octet *KGAMMA1, const octet *KGAMMA2, octet *INVKGAMMA)
  */
 int MPC_R(const octet *INVKGAMMA, octet *GAMMAPT1, octet *GAMMAPT2, octet *R, octet *RP);
 
+/** \brief R component with recovery id
+ *
+ *  Same as MPC_R, also outputs the recovery id of the signature
+ *  from the ECP associated to the R component
+ *
+ *  <ol>
+ *  <li> \f$ r_x, r_y = k^{-1}G \f$ where G is the group generator
+ *  <li> \f$ r = rx \text{ }\mathrm{mod}\text{ }q \f$
+ *  <li> \f$ v = (r_y \text{ }\mathrm{mod}\text{ }2) + 2 (r_x \geq q) \f$
+ *  </ol>
+ *
+ *  The recovery id refers to (r, s) before the low-s normalisation
+ *  and must be updated with MPC_SUM_S_RECID
+ *
+ *  @param  INVKGAMMA         Inverse of k times gamma
+ *  @param  GAMMAPT1          Actor 1 gamma point
+ *  @param  GAMMAPT2          Actor 2 gamma point
+ *  @param  R                 R component of the signature
+ *  @param  RP                ECP associated to the R component of the signature. Optional
+ *  @param  RECID             Recovery id of the signature
+ *  @return                   Returns 0 or else error code
+ */
+int MPC_R_RECID(const octet *INVKGAMMA, octet *GAMMAPT1, octet *GAMMAPT2, octet *R, octet *RP, int *RECID);
+
 /** \brief Hash the message value
  *
  *  Hash the message value
@@ -176,6 +200,27 @@ int MPC_S(const octet *HM, const octet *R, const octet *K, const octet *SIGMA, o
  */
 void MPC_SUM_S(const octet *S1, const octet *S2, octet *S);
 
+/** \brief Sum of ECDSA s components with low-s normalisation
+ *
+ *  Calculate the sum of the s components of the ECDSA signature and
+ *  normalise it to the lower half of the range, updating the recovery
+ *  id computed by MPC_R_RECID
+ *
+ *  <ol>
+ *  <li> \f$ s = s1 + s2 \text{ }\mathrm{mod}\text{ }q \f$
+ *  <li> if \f$ s > q/2 \f$ then \f$ s = q - s \f$ and \f$ v = v \oplus 1 \f$
+ *  </ol>
+ *
+ *  The shares of s can not be normalised individually, since the
+ *  normalisation depends on their sum.
+ *
+ *  @param  S1                Actor 1 ECDSA s component
+ *  @param  S2                Actor 2 ECDSA s component
+ *  @param  S                 S component sum
+ *  @param  RECID             Recovery id from MPC_R_RECID. Updated in place
+ */
+void MPC_SUM_S_RECID(const octet *S1, const octet *S2, octet *S, int *RECID);
+
 /** \brief Sum of ECDSA public key shares
  *
  *  Calculate the sum of the ECDSA public key shares
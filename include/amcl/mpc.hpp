@@ -0,0 +1,637 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/**
+ * @file mpc.hpp
+ * @brief C++17 header only wrappers declarations
+ *
+ * Buffers with inline storage replace the octet boilerplate,
+ * secrets are move only and zeroised on destruction, and
+ * public data is passed to the C API as views with no copies.
+ * Nothing is allocated on the heap.
+ */
+
+#ifndef MPC_HPP
+#define MPC_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#if __cplusplus >= 202002L && __has_include(<span>)
+#include <span>
+#endif
+
+#include "amcl/randapi.h"
+#include "amcl/mpc.h"
+#include "amcl/mta.h"
+#include "amcl/schnorr.h"
+#include "amcl/commitments.h"
+#include "amcl/factoring_zk.h"
+
+namespace amcl
+{
+namespace mpc
+{
+
+/* Sizes */
+
+constexpr std::size_t fs_2048  = FS_2048;            /**< 2048 field size in bytes */
+constexpr std::size_t hfs_2048 = HFS_2048;           /**< Half 2048 field size in bytes */
+constexpr std::size_t fs_4096  = FS_4096;            /**< 4096 field size in bytes */
+constexpr std::size_t egs      = EGS_SECP256K1;      /**< Size of a SECP256K1 scalar in bytes */
+constexpr std::size_t efs      = EFS_SECP256K1;      /**< Size of a SECP256K1 field element in bytes */
+constexpr std::size_t ecp      = EFS_SECP256K1 + 1;  /**< Size of a compressed SECP256K1 point in bytes */
+constexpr std::size_t sha256   = SHA256;             /**< Size of a SHA256 digest in bytes */
+
+/* Views */
+
+#ifdef __cpp_lib_span
+template <class T>
+using span = std::span<T>;
+#else
+/*! \brief Contiguous view. Subset of std::span for C++17 */
+template <class T>
+class span
+{
+public:
+    constexpr span() noexcept : p(nullptr), n(0) {}
+
+    constexpr span(T *data, std::size_t size) noexcept : p(data), n(size) {}
+
+    template <std::size_t N>
+    constexpr span(T (&a)[N]) noexcept : p(a), n(N) {}
+
+    template <class C, class = std::enable_if_t<std::is_convertible<decltype(std::declval<C &>().data()), T *>::value>>
+    constexpr span(C &c) noexcept : p(c.data()), n(c.size()) {}
+
+    constexpr T *data() const noexcept
+    {
+        return p;
+    }
+
+    constexpr std::size_t size() const noexcept
+    {
+        return n;
+    }
+
+    constexpr T *begin() const noexcept
+    {
+        return p;
+    }
+
+    constexpr T *end() const noexcept
+    {
+        return p + n;
+    }
+
+private:
+    T *p;
+    std::size_t n;
+};
+#endif
+
+/*! \brief Public bytes */
+using bytes = span<const char>;
+
+/*! \brief View unsigned bytes as public bytes
+ *
+ * @param s     Unsigned bytes
+ * @return      View of the same memory
+ */
+inline bytes to_bytes(span<const unsigned char> s) noexcept
+{
+    return bytes(reinterpret_cast<const char *>(s.data()), s.size());
+}
+
+/*! \brief Octet over public bytes
+ *
+ * The C API does not modify its input octets, so the
+ * octet points straight to the bytes
+ *
+ * @param s     Public bytes
+ * @return      Octet for the bytes
+ */
+inline octet in(bytes s) noexcept
+{
+    return octet{static_cast<int>(s.size()), static_cast<int>(s.size()), const_cast<char *>(s.data())};
+}
+
+/* Buffers */
+
+/*! \brief Octet over a buffer, for the duration of a C call
+ *
+ * The length of the octet is written back to the buffer on destruction
+ */
+template <class B>
+class octet_ref
+{
+public:
+    explicit octet_ref(B &buf) noexcept : b(buf), o{static_cast<int>(buf.size()), static_cast<int>(B::capacity()), buf.data()} {}
+
+    ~octet_ref()
+    {
+        b.resize(static_cast<std::size_t>(o.len));
+    }
+
+    octet_ref(const octet_ref &) = delete;
+    octet_ref &operator=(const octet_ref &) = delete;
+
+    operator octet *() noexcept
+    {
+        return &o;
+    }
+
+private:
+    B &b;
+    octet o;
+};
+
+/*! \brief Buffer of at most N bytes with inline storage */
+template <std::size_t N>
+class buffer
+{
+public:
+    buffer() noexcept : v{}, n(0) {}
+
+    /*! \brief Copy public bytes in a new buffer. At most N are copied */
+    explicit buffer(bytes s) noexcept : v{}, n(0)
+    {
+        for (; n < N && n < s.size(); n++)
+        {
+            v[n] = s.data()[n];
+        }
+    }
+
+    static constexpr std::size_t capacity() noexcept
+    {
+        return N;
+    }
+
+    char *data() noexcept
+    {
+        return v;
+    }
+
+    const char *data() const noexcept
+    {
+        return v;
+    }
+
+    std::size_t size() const noexcept
+    {
+        return n;
+    }
+
+    void resize(std::size_t len) noexcept
+    {
+        n = len < N ? len : N;
+    }
+
+    char *begin() noexcept
+    {
+        return v;
+    }
+
+    char *end() noexcept
+    {
+        return v + n;
+    }
+
+    const char *begin() const noexcept
+    {
+        return v;
+    }
+
+    const char *end() const noexcept
+    {
+        return v + n;
+    }
+
+    /*! \brief Octet to pass the buffer to the C API, as input or output */
+    octet_ref<buffer> oct() noexcept
+    {
+        return octet_ref<buffer>(*this);
+    }
+
+protected:
+    char v[N];
+    std::size_t n;
+};
+
+// Zeroise memory, preventing the compiler from removing the writes
+inline void zeroise(void *p, std::size_t len) noexcept
+{
+    volatile char *c = static_cast<volatile char *>(p);
+
+    while (len--)
+    {
+        *c++ = 0;
+    }
+}
+
+/*! \brief Move only buffer for secret bytes, zeroised on destruction */
+template <std::size_t N>
+class secret_buffer : public buffer<N>
+{
+public:
+    secret_buffer() noexcept = default;
+
+    secret_buffer(const secret_buffer &) = delete;
+    secret_buffer &operator=(const secret_buffer &) = delete;
+
+    secret_buffer(secret_buffer &&o) noexcept : buffer<N>(o)
+    {
+        o.clear();
+    }
+
+    secret_buffer &operator=(secret_buffer &&o) noexcept
+    {
+        if (this != &o)
+        {
+            buffer<N>::operator=(o);
+            o.clear();
+        }
+
+        return *this;
+    }
+
+    ~secret_buffer()
+    {
+        clear();
+    }
+
+    /*! \brief Zeroise the buffer */
+    void clear() noexcept
+    {
+        zeroise(this->v, N);
+        this->n = 0;
+    }
+
+    octet_ref<secret_buffer> oct() noexcept
+    {
+        return octet_ref<secret_buffer>(*this);
+    }
+};
+
+/* Secrets */
+
+/*! \brief Move only owner of a secret C structure
+ *
+ * The structure is cleaned with Kill on destruction
+ * and when it is moved from
+ */
+template <class T, void (*Kill)(T *)>
+class secret
+{
+public:
+    secret() noexcept
+    {
+        zeroise(&v, sizeof(v));
+    }
+
+    secret(const secret &) = delete;
+    secret &operator=(const secret &) = delete;
+
+    secret(secret &&o) noexcept : v(o.v)
+    {
+        Kill(&o.v);
+    }
+
+    secret &operator=(secret &&o) noexcept
+    {
+        if (this != &o)
+        {
+            Kill(&v);
+            v = o.v;
+            Kill(&o.v);
+        }
+
+        return *this;
+    }
+
+    ~secret()
+    {
+        Kill(&v);
+    }
+
+    T *get() noexcept
+    {
+        return &v;
+    }
+
+    const T *get() const noexcept
+    {
+        return &v;
+    }
+
+private:
+    T v;
+};
+
+using rng                  = secret<csprng, KILL_CSPRNG>;                                            /**< CSPRNG */
+using paillier_private_key = secret<PAILLIER_private_key, PAILLIER_PRIVATE_KEY_KILL>;                /**< Paillier private key */
+using bc_priv_modulus      = secret<COMMITMENTS_BC_priv_modulus, COMMITMENTS_BC_kill_priv_modulus>;  /**< Private BC modulus */
+using factoring_zk_modulus = secret<FACTORING_ZK_modulus, FACTORING_ZK_modulus_kill>;                /**< Modulus for the ZK proof of factoring */
+using mta_rp_rv            = secret<MTA_RP_commitment_rv, MTA_RP_commitment_rv_kill>;                /**< Range Proof commitment random values */
+using mta_zk_rv            = secret<MTA_ZK_commitment_rv, MTA_ZK_commitment_rv_kill>;                /**< Receiver ZKP commitment random values */
+using mta_zkwc_rv          = secret<MTA_ZKWC_commitment_rv, MTA_ZKWC_commitment_rv_kill>;            /**< Receiver ZKP with check commitment random values */
+
+using scalar         = buffer<egs>;          /**< Public SECP256K1 scalar */
+using secret_scalar  = secret_buffer<egs>;   /**< Secret SECP256K1 scalar */
+using point          = buffer<ecp>;          /**< Compressed SECP256K1 point */
+using ciphertext     = buffer<fs_4096>;      /**< Paillier ciphertext */
+using plaintext      = secret_buffer<fs_2048>; /**< Paillier plaintext */
+using digest         = buffer<sha256>;       /**< SHA256 digest */
+using nm_commitment  = buffer<sha256>;       /**< NM commitment */
+using nm_rv          = secret_buffer<sha256>; /**< NM commitment decommitment value */
+
+/* Functions */
+
+/*! \brief Seed a CSPRNG
+ *
+ * @param r     CSPRNG to seed
+ * @param seed  Seed bytes
+ */
+inline void seed(rng &r, bytes seed) noexcept
+{
+    RAND_seed(r.get(), static_cast<int>(seed.size()), const_cast<char *>(seed.data()));
+}
+
+/*! \brief Generate a NM commitment for the value X. See COMMITMENTS_NM_commit */
+inline void nm_commit(rng &r, bytes x, nm_rv &R, nm_commitment &C) noexcept
+{
+    octet X = in(x);
+    COMMITMENTS_NM_commit(r.get(), &X, R.oct(), C.oct());
+}
+
+/*! \brief Decommit the value X. See COMMITMENTS_NM_decommit */
+inline int nm_decommit(bytes x, bytes rv, bytes c) noexcept
+{
+    octet X = in(x);
+    octet R = in(rv);
+    octet C = in(c);
+
+    return COMMITMENTS_NM_decommit(&X, &R, &C);
+}
+
+/*! \brief Generate a Schnorr's Proof commitment. See SCHNORR_commit */
+inline void schnorr_commit(rng &r, secret_scalar &R, point &C) noexcept
+{
+    SCHNORR_commit(r.get(), R.oct(), C.oct());
+}
+
+/*! \brief Generate a Schnorr's Proof challenge. See SCHNORR_challenge */
+inline void schnorr_challenge(bytes v, bytes c, bytes id, bytes ad, scalar &E) noexcept
+{
+    octet V = in(v);
+    octet C = in(c);
+    octet ID = in(id);
+    octet AD = in(ad);
+
+    SCHNORR_challenge(&V, &C, &ID, ad.size() ? &AD : nullptr, E.oct());
+}
+
+/*! \brief Generate a Schnorr's Proof. See SCHNORR_prove */
+inline void schnorr_prove(const secret_scalar &R, bytes e, const secret_scalar &X, scalar &P) noexcept
+{
+    octet OR = in(R);
+    octet E = in(e);
+    octet OX = in(X);
+
+    SCHNORR_prove(&OR, &E, &OX, P.oct());
+}
+
+/*! \brief Verify a Schnorr's Proof. See SCHNORR_verify */
+inline int schnorr_verify(bytes v, bytes c, bytes e, bytes p) noexcept
+{
+    octet V = in(v);
+    octet C = in(c);
+    octet E = in(e);
+    octet P = in(p);
+
+    return SCHNORR_verify(&V, &C, &E, &P);
+}
+
+/*! \brief Generate a Paillier key pair. See PAILLIER_KEY_PAIR
+ *
+ * @param r     CSPRNG
+ * @param p     Prime P. Generated if empty
+ * @param q     Prime Q. Generated if empty
+ * @param pub   Public key
+ * @param priv  Private key
+ */
+inline void paillier_key_pair(rng &r, bytes p, bytes q, PAILLIER_public_key &pub, paillier_private_key &priv) noexcept
+{
+    octet P = in(p);
+    octet Q = in(q);
+
+    PAILLIER_KEY_PAIR(r.get(), p.size() ? &P : nullptr, q.size() ? &Q : nullptr, &pub, priv.get());
+}
+
+/*! \brief Set up a BC modulus. See COMMITMENTS_BC_setup
+ *
+ * @param r     CSPRNG
+ * @param p     Safe prime P. Generated if empty
+ * @param q     Safe prime Q. Generated if empty
+ * @param m     Private modulus
+ */
+inline void bc_setup(rng &r, bytes p, bytes q, bc_priv_modulus &m) noexcept
+{
+    octet P = in(p);
+    octet Q = in(q);
+
+    COMMITMENTS_BC_setup(r.get(), m.get(), p.size() ? &P : nullptr, q.size() ? &Q : nullptr, nullptr, nullptr);
+}
+
+/*! \brief Encrypt a plaintext. See PAILLIER_ENCRYPT
+ *
+ * @param r     CSPRNG
+ * @param pub   Public key
+ * @param pt    Plaintext, at most fs_2048 bytes
+ * @param ct    Ciphertext
+ */
+inline void paillier_encrypt(rng &r, const PAILLIER_public_key &pub, bytes pt, ciphertext &ct) noexcept
+{
+    octet PT = in(pt);
+
+    PAILLIER_ENCRYPT(r.get(), const_cast<PAILLIER_public_key *>(&pub), &PT, ct.oct(), nullptr);
+}
+
+/*! \brief Decrypt a ciphertext. See PAILLIER_DECRYPT
+ *
+ * @param priv  Private key
+ * @param ct    Ciphertext
+ * @param pt    Plaintext
+ */
+inline void paillier_decrypt(paillier_private_key &priv, bytes ct, plaintext &pt) noexcept
+{
+    octet CT = in(ct);
+
+    PAILLIER_DECRYPT(priv.get(), &CT, pt.oct());
+}
+
+/*! \brief Client MtA first pass. See MPC_MTA_CLIENT1
+ *
+ * @param r     CSPRNG
+ * @param pub   Paillier public key of the client
+ * @param a     Multiplicative share of the client
+ * @param ca    Ciphertext of a
+ */
+inline void mta_client1(rng &r, const PAILLIER_public_key &pub, const secret_scalar &a, ciphertext &ca) noexcept
+{
+    octet A = in(a);
+
+    MPC_MTA_CLIENT1(r.get(), const_cast<PAILLIER_public_key *>(&pub), &A, ca.oct(), nullptr);
+}
+
+/*! \brief Server MtA. See MPC_MTA_SERVER
+ *
+ * @param r     CSPRNG
+ * @param pub   Paillier public key of the client
+ * @param b     Multiplicative share of the server
+ * @param ca    Ciphertext from the client
+ * @param cb    Ciphertext for the client
+ * @param beta  Additive share of the server
+ */
+inline void mta_server(rng &r, const PAILLIER_public_key &pub, const secret_scalar &b, bytes ca, ciphertext &cb, secret_scalar &beta) noexcept
+{
+    octet B = in(b);
+    octet CA = in(ca);
+
+    MPC_MTA_SERVER(r.get(), const_cast<PAILLIER_public_key *>(&pub), &B, &CA, nullptr, nullptr, cb.oct(), beta.oct());
+}
+
+/*! \brief Client MtA second pass. See MPC_MTA_CLIENT2
+ *
+ * @param priv  Paillier private key of the client
+ * @param cb    Ciphertext from the server
+ * @param alpha Additive share of the client
+ */
+inline void mta_client2(paillier_private_key &priv, bytes cb, secret_scalar &alpha) noexcept
+{
+    octet CB = in(cb);
+
+    MPC_MTA_CLIENT2(priv.get(), &CB, alpha.oct());
+}
+
+/*! \brief Sum of the MtA shares. See MPC_SUM_MTA */
+inline void sum_mta(const secret_scalar &a, const secret_scalar &b, const secret_scalar &alpha, const secret_scalar &beta, secret_scalar &sum) noexcept
+{
+    octet A = in(a);
+    octet B = in(b);
+    octet ALPHA = in(alpha);
+    octet BETA = in(beta);
+
+    MPC_SUM_MTA(&A, &B, &ALPHA, &BETA, sum.oct());
+}
+
+/*! \brief Generate an ECDSA key pair. See MPC_ECDSA_KEY_PAIR_GENERATE */
+inline void ecdsa_key_pair(rng &r, secret_scalar &sk, point &pk) noexcept
+{
+    MPC_ECDSA_KEY_PAIR_GENERATE(r.get(), sk.oct(), pk.oct());
+}
+
+/*! \brief Sign a message with SHA256. See MPC_ECDSA_SIGN */
+inline int ecdsa_sign(const secret_scalar &k, const secret_scalar &sk, bytes m, scalar &R, scalar &S) noexcept
+{
+    octet K = in(k);
+    octet SK = in(sk);
+    octet M = in(m);
+
+    return MPC_ECDSA_SIGN(SHA256, &K, &SK, &M, R.oct(), S.oct());
+}
+
+/*! \brief Verify an ECDSA signature. See MPC_ECDSA_VERIFY */
+inline int ecdsa_verify(bytes hm, bytes pk, bytes r, bytes s) noexcept
+{
+    octet HM = in(hm);
+    octet PK = in(pk);
+    octet R = in(r);
+    octet S = in(s);
+
+    return MPC_ECDSA_VERIFY(&HM, &PK, &R, &S);
+}
+
+/*! \brief Hash a message with SHA256. See MPC_HASH */
+inline void hash(bytes m, digest &hm) noexcept
+{
+    octet M = in(m);
+
+    MPC_HASH(SHA256, &M, hm.oct());
+}
+
+/*! \brief Generate a random K. See MPC_K_GENERATE */
+inline void k_generate(rng &r, secret_scalar &k) noexcept
+{
+    MPC_K_GENERATE(r.get(), k.oct());
+}
+
+/*! \brief Inverse of the sum of the kgamma shares. See MPC_INVKGAMMA */
+inline void invkgamma(bytes kgamma1, bytes kgamma2, scalar &inv) noexcept
+{
+    octet KGAMMA1 = in(kgamma1);
+    octet KGAMMA2 = in(kgamma2);
+
+    MPC_INVKGAMMA(&KGAMMA1, &KGAMMA2, inv.oct());
+}
+
+/*! \brief R component of the signature. See MPC_R */
+inline int r_component(bytes inv, bytes gammapt1, bytes gammapt2, scalar &R, point &RP) noexcept
+{
+    octet INV = in(inv);
+    octet GAMMAPT1 = in(gammapt1);
+    octet GAMMAPT2 = in(gammapt2);
+
+    return MPC_R(&INV, &GAMMAPT1, &GAMMAPT2, R.oct(), RP.oct());
+}
+
+/*! \brief S component share of the signature. See MPC_S */
+inline int s_component(bytes hm, bytes r, const secret_scalar &k, const secret_scalar &sigma, scalar &S) noexcept
+{
+    octet HM = in(hm);
+    octet R = in(r);
+    octet K = in(k);
+    octet SIGMA = in(sigma);
+
+    return MPC_S(&HM, &R, &K, &SIGMA, S.oct());
+}
+
+/*! \brief Sum of the S component shares. See MPC_SUM_S */
+inline void sum_s(bytes s1, bytes s2, scalar &S) noexcept
+{
+    octet S1 = in(s1);
+    octet S2 = in(s2);
+
+    MPC_SUM_S(&S1, &S2, S.oct());
+}
+
+/*! \brief Sum of the public key shares. See MPC_SUM_PK */
+inline int sum_pk(bytes pk1, bytes pk2, point &pk) noexcept
+{
+    octet PK1 = in(pk1);
+    octet PK2 = in(pk2);
+
+    return MPC_SUM_PK(&PK1, &PK2, pk.oct());
+}
+
+} // namespace mpc
+} // namespace amcl
+
+#endif
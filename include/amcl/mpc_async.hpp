@@ -0,0 +1,386 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/**
+ * @file mpc_async.hpp
+ * @brief C++20 coroutine awaitables declarations
+ *
+ * The expensive primitives run on a compute pool and the awaiting
+ * coroutine is resumed on the executor it was running on.
+ *
+ * The inputs and outputs are used by a pool thread while the
+ * coroutine is suspended, so they must not be touched by other
+ * code until the awaitable completes. A csprng must not be shared
+ * between concurrent operations.
+ */
+
+#ifndef MPC_ASYNC_HPP
+#define MPC_ASYNC_HPP
+
+#if __cplusplus < 202002L || !defined(__cpp_impl_coroutine)
+#error "mpc_async.hpp requires C++20 coroutines"
+#endif
+
+#include <atomic>
+#include <concepts>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "amcl/mpc.hpp"
+
+namespace amcl
+{
+namespace mpc
+{
+
+constexpr int ASYNC_CANCELLED = 151;  /**< The operation was cancelled before it started */
+
+/*! \brief Executor the awaiting coroutines are resumed on */
+template <class E>
+concept executor = requires(E &e, std::function<void()> f)
+{
+    e.post(std::move(f));
+};
+
+/*! \brief Executor resuming the coroutine on the pool thread */
+struct inline_executor
+{
+    void post(std::function<void()> f)
+    {
+        f();
+    }
+};
+
+/*! \brief Pool of threads for the expensive primitives */
+class compute_pool
+{
+public:
+    /*! \brief Start the pool
+     *
+     * @param n     Number of threads. Hardware concurrency if 0
+     */
+    explicit compute_pool(unsigned int n = 0)
+    {
+        if (n == 0)
+        {
+            n = std::thread::hardware_concurrency();
+        }
+
+        if (n == 0)
+        {
+            n = 1;
+        }
+
+        for (unsigned int i = 0; i < n; i++)
+        {
+            workers.emplace_back([this] { work(); });
+        }
+    }
+
+    /*! \brief Run the queued jobs and stop the pool */
+    ~compute_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            stopping = true;
+        }
+
+        cv.notify_all();
+
+        for (auto &w : workers)
+        {
+            w.join();
+        }
+    }
+
+    compute_pool(const compute_pool &) = delete;
+    compute_pool &operator=(const compute_pool &) = delete;
+
+    /*! \brief Queue a job */
+    void submit(std::function<void()> job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            jobs.push_back(std::move(job));
+        }
+
+        cv.notify_one();
+    }
+
+private:
+    void work()
+    {
+        std::function<void()> job;
+
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m);
+                cv.wait(lock, [this] { return stopping || !jobs.empty(); });
+
+                if (jobs.empty())
+                {
+                    return;
+                }
+
+                job = std::move(jobs.front());
+                jobs.pop_front();
+            }
+
+            job();
+        }
+    }
+
+    std::mutex m;
+    std::condition_variable cv;
+    std::deque<std::function<void()>> jobs;
+    bool stopping = false;
+    std::vector<std::thread> workers;
+};
+
+/*! \brief Awaitable for a job run on a compute pool
+ *
+ * The result is the return code of the job, or ASYNC_CANCELLED if
+ * a stop was requested before the job started. A running job is
+ * not interrupted: the coroutine is resumed when it completes
+ */
+template <executor E>
+class awaitable
+{
+public:
+    awaitable(compute_pool &cp, E &e, std::stop_token t, std::function<int()> job) :
+        pool(cp), exec(e), st(std::move(t)), s(std::make_shared<state>())
+    {
+        s->job = std::move(job);
+    }
+
+    bool await_ready() noexcept
+    {
+        if (st.stop_requested())
+        {
+            s->rc = ASYNC_CANCELLED;
+            return true;
+        }
+
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> h)
+    {
+        s->h = h;
+        s->post = [&e = exec](std::function<void()> f) { e.post(std::move(f)); };
+
+        cb.emplace(st, cancel{s});
+
+        pool.submit([p = s]
+        {
+            int expected = QUEUED;
+
+            if (!p->phase.compare_exchange_strong(expected, RUNNING))
+            {
+                return;
+            }
+
+            p->finish(p->job());
+        });
+
+        // The coroutine is resumed once it is suspended and the job is finished.
+        // It might be resumed and the awaitable destroyed before arrive returns
+        std::shared_ptr<state> p = s;
+        p->arrive();
+    }
+
+    int await_resume() noexcept
+    {
+        cb.reset();
+        return s->rc;
+    }
+
+private:
+    enum { QUEUED, RUNNING, DONE };
+
+    struct state
+    {
+        std::atomic<int> phase{QUEUED};
+        std::atomic<int> pending{2};
+        int rc = 0;
+        std::coroutine_handle<> h;
+        std::function<void(std::function<void()>)> post;
+        std::function<int()> job;
+
+        void finish(int r)
+        {
+            rc = r;
+            phase.store(DONE);
+            arrive();
+        }
+
+        void arrive()
+        {
+            if (pending.fetch_sub(1) == 1)
+            {
+                post([c = h] { c.resume(); });
+            }
+        }
+    };
+
+    struct cancel
+    {
+        std::shared_ptr<state> p;
+
+        void operator()()
+        {
+            int expected = QUEUED;
+
+            // The callback is destroyed when the coroutine is resumed
+            std::shared_ptr<state> keep = p;
+
+            if (keep->phase.compare_exchange_strong(expected, DONE))
+            {
+                keep->rc = ASYNC_CANCELLED;
+                keep->arrive();
+            }
+        }
+    };
+
+    compute_pool &pool;
+    E &exec;
+    std::stop_token st;
+    std::shared_ptr<state> s;
+    std::optional<std::stop_callback<cancel>> cb;
+};
+
+/*! \brief Run a function on a compute pool
+ *
+ * @param pool  Compute pool
+ * @param exec  Executor to resume the coroutine on
+ * @param st    Stop token for the cancellation
+ * @param f     Function to run. Returning an int return code or void
+ * @return      Awaitable for the return code, MPC_OK for void functions
+ */
+template <executor E, std::invocable F>
+awaitable<E> offload(compute_pool &pool, E &exec, std::stop_token st, F f)
+{
+    return awaitable<E>(pool, exec, std::move(st), [f = std::move(f)]() mutable -> int
+    {
+        if constexpr (std::is_void_v<std::invoke_result_t<F &>>)
+        {
+            f();
+            return MPC_OK;
+        }
+        else
+        {
+            return f();
+        }
+    });
+}
+
+/* Awaitables for the expensive primitives. See the C API for the parameters */
+
+template <executor E>
+awaitable<E> mta_rp_commit(compute_pool &pool, E &exec, std::stop_token st, csprng *RNG, PAILLIER_private_key *key, COMMITMENTS_BC_pub_modulus *mod, const MTA_params *params, octet *M, MTA_RP_commitment *c, MTA_RP_commitment_rv *rv)
+{
+    return offload(pool, exec, std::move(st), [=] { return MTA_RP_commit_params(RNG, key, mod, params, M, c, rv); });
+}
+
+template <executor E>
+awaitable<E> mta_rp_prove(compute_pool &pool, E &exec, std::stop_token st, PAILLIER_private_key *key, MTA_RP_commitment_rv *rv, octet *M, octet *R, octet *EC, MTA_RP_proof *p)
+{
+    return offload(pool, exec, std::move(st), [=] { MTA_RP_prove(key, rv, M, R, EC, p); });
+}
+
+template <executor E>
+awaitable<E> mta_rp_verify(compute_pool &pool, E &exec, std::stop_token st, PAILLIER_public_key *key, COMMITMENTS_BC_priv_modulus *mod, const MTA_params *params, octet *CT, octet *EC, MTA_RP_commitment *c, MTA_RP_proof *p)
+{
+    return offload(pool, exec, std::move(st), [=] { return MTA_RP_verify_params(key, mod, params, CT, EC, c, p); });
+}
+
+template <executor E>
+awaitable<E> mta_zk_commit(compute_pool &pool, E &exec, std::stop_token st, csprng *RNG, PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod, const MTA_params *params, octet *X, octet *Y, octet *C1, MTA_ZK_commitment *c, MTA_ZK_commitment_rv *rv)
+{
+    return offload(pool, exec, std::move(st), [=] { return MTA_ZK_commit_params(RNG, key, mod, params, X, Y, C1, c, rv); });
+}
+
+template <executor E>
+awaitable<E> mta_zk_prove(compute_pool &pool, E &exec, std::stop_token st, PAILLIER_public_key *key, MTA_ZK_commitment_rv *rv, octet *X, octet *Y, octet *R, octet *EC, MTA_ZK_proof *p)
+{
+    return offload(pool, exec, std::move(st), [=] { MTA_ZK_prove(key, rv, X, Y, R, EC, p); });
+}
+
+template <executor E>
+awaitable<E> mta_zk_verify(compute_pool &pool, E &exec, std::stop_token st, PAILLIER_private_key *key, COMMITMENTS_BC_priv_modulus *mod, const MTA_params *params, octet *C1, octet *C2, octet *EC, MTA_ZK_commitment *c, MTA_ZK_proof *p)
+{
+    return offload(pool, exec, std::move(st), [=] { return MTA_ZK_verify_params(key, mod, params, C1, C2, EC, c, p); });
+}
+
+template <executor E>
+awaitable<E> mta_zkwc_commit(compute_pool &pool, E &exec, std::stop_token st, csprng *RNG, PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod, const MTA_params *params, octet *X, octet *Y, octet *C1, MTA_ZKWC_commitment *c, MTA_ZKWC_commitment_rv *rv)
+{
+    return offload(pool, exec, std::move(st), [=] { return MTA_ZKWC_commit_params(RNG, key, mod, params, X, Y, C1, c, rv); });
+}
+
+template <executor E>
+awaitable<E> mta_zkwc_prove(compute_pool &pool, E &exec, std::stop_token st, PAILLIER_public_key *key, MTA_ZKWC_commitment_rv *rv, octet *X, octet *Y, octet *R, octet *EC, MTA_ZKWC_proof *p)
+{
+    return offload(pool, exec, std::move(st), [=] { MTA_ZKWC_prove(key, rv, X, Y, R, EC, p); });
+}
+
+template <executor E>
+awaitable<E> mta_zkwc_verify(compute_pool &pool, E &exec, std::stop_token st, PAILLIER_private_key *key, COMMITMENTS_BC_priv_modulus *mod, const MTA_params *params, octet *C1, octet *C2, octet *X, octet *EC, MTA_ZKWC_commitment *c, MTA_ZKWC_proof *p)
+{
+    return offload(pool, exec, std::move(st), [=] { return MTA_ZKWC_verify_params(key, mod, params, C1, C2, X, EC, c, p); });
+}
+
+template <executor E>
+awaitable<E> factoring_zk_prove(compute_pool &pool, E &exec, std::stop_token st, csprng *RNG, FACTORING_ZK_modulus *m, const octet *ID, const octet *AD, octet *R, octet *EC, octet *Y)
+{
+    return offload(pool, exec, std::move(st), [=] { FACTORING_ZK_prove(RNG, m, ID, AD, R, EC, Y); });
+}
+
+template <executor E>
+awaitable<E> factoring_zk_verify(compute_pool &pool, E &exec, std::stop_token st, octet *N, octet *EC, octet *Y, const octet *ID, const octet *AD)
+{
+    return offload(pool, exec, std::move(st), [=] { return FACTORING_ZK_verify(N, EC, Y, ID, AD); });
+}
+
+template <executor E>
+awaitable<E> bc_setup(compute_pool &pool, E &exec, std::stop_token st, csprng *RNG, COMMITMENTS_BC_priv_modulus *m, octet *P, octet *Q, octet *B0, octet *ALPHA)
+{
+    return offload(pool, exec, std::move(st), [=] { COMMITMENTS_BC_setup(RNG, m, P, Q, B0, ALPHA); });
+}
+
+template <executor E>
+awaitable<E> paillier_decrypt(compute_pool &pool, E &exec, std::stop_token st, PAILLIER_private_key *priv, octet *CT, octet *PT)
+{
+    return offload(pool, exec, std::move(st), [=] { PAILLIER_DECRYPT(priv, CT, PT); });
+}
+
+} // namespace mpc
+} // namespace amcl
+
+#endif
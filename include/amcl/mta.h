@@ -54,6 +54,26 @@ extern "C" {
  */
 void MPC_MTA_CLIENT1(csprng *RNG, PAILLIER_public_key* PUB, octet* A, octet* CA, octet* R);
 
+/*! \brief Client MTA first pass using the Paillier private key
+ *
+ *  Encrypt multiplicative share, \f$ a \f$, of secret \f$ s = a.b \f$.
+ *  The output is the same as MPC_MTA_CLIENT1, but the knowledge of the
+ *  factorisation of N is used to compute \f$ r^N \f$ using CRT
+ *
+ *  <ol>
+ *  <li> \f$ r^N = ((r \text{ }\mathrm{mod}\text{ }p)^q \text{ }\mathrm{mod}\text{ }p)^p \text{ }\mathrm{mod}\text{ }p^2 \f$
+ *  <li> \f$ r^N = ((r \text{ }\mathrm{mod}\text{ }q)^p \text{ }\mathrm{mod}\text{ }q)^q \text{ }\mathrm{mod}\text{ }q^2 \f$
+ *  <li> \f$ ca = (1 + aN)r^N \text{ }\mathrm{mod}\text{ }N^2 \f$
+ *  </ol>
+ *
+ *  @param  RNG              Pointer to a cryptographically secure random number generator
+ *  @param  PRIV             Paillier Private key
+ *  @param  A                Multiplicative share of secret
+ *  @param  CA               Ciphertext
+ *  @param  R                R value for testing. If RNG is NULL then this value is read. FS_4096 long
+ */
+void MPC_MTA_CLIENT1_CRT(csprng *RNG, PAILLIER_private_key *PRIV, octet *A, octet *CA, octet *R);
+
 /*! \brief Client MtA second pass
  *
  *  Calculate additive share, \f$ \alpha \f$, of secret \f$ s = a.b \f$
@@ -111,6 +131,54 @@ void MPC_SUM_MTA(const octet *A, const octet *B, const octet *ALPHA, const octet
 
 // The protocols require a BC modulus (Pt, Qt, Nt, h1, h2) and a Paillier PK (N, g)
 
+/* Statistical security parameters API */
+
+#define MTA_PARAMS_BITS_Q     (8 * EGS_SECP256K1)  /**< Bit length standing for the curve order q */
+#define MTA_PARAMS_MIN_CHALLENGE 80                /**< Minimum challenge length. Soundness error 2^-80 */
+#define MTA_PARAMS_MIN_SLACK     40                /**< Minimum slack length. Statistical distance 2^-40 */
+
+/*! \brief Statistical security parameters of the MTA range proofs
+ *
+ * The challenge is in \f$ [0, \ldots, E] \f$ and the random values
+ * that hide the secrets in \f$ [0, \ldots, qES] \f$ and
+ * \f$ [0, \ldots, \tilde{N}qES] \f$, where \f$ E \f$ and \f$ S \f$
+ * are the powers of two of the challenge and slack lengths. The verifier
+ * checks \f$ s_1 \leq qES \f$.
+ *
+ * A length of MTA_PARAMS_BITS_Q stands for the curve order q itself,
+ * so MTA_PARAMS_DEFAULT gives the original bound \f$ q^3 \f$ and
+ * challenges reduced modulo q.
+ *
+ * The parameters are passed to the *_params variants of the commit,
+ * challenge and verify functions, so links with different parameters
+ * can share a process. The functions without parameters use
+ * MTA_PARAMS_DEFAULT. The variants check the parameters with
+ * MTA_params_check and return MTA_FAIL if they are not supported.
+ * Prover and verifier must use the same parameters. Parameters other
+ * than the default are bound to the challenges, so a mismatch makes
+ * the proofs fail.
+ */
+typedef struct
+{
+    int challenge_bits;   /**< Length of the challenge */
+    int slack_bits;       /**< Length of the statistical slack */
+    int modulus_bits;     /**< Length of the Paillier and Bit Commitment moduli. Only 2048 is supported */
+} MTA_params;
+
+/*! \brief Default parameters. \f$ E = S = q \f$ */
+extern const MTA_params MTA_PARAMS_DEFAULT;
+
+/*! \brief Reduced parameters for links where a lower soundness is
+ * acceptable. 128 bit challenges and 80 bits of slack */
+extern const MTA_params MTA_PARAMS_REDUCED;
+
+/*! \brief Check the consistency of a parameter set
+ *
+ *  @param  p                Parameter set
+ *  @return                  MTA_OK if the parameters are supported, MTA_FAIL otherwise
+ */
+extern int MTA_params_check(const MTA_params *p);
+
 /** \brief Random challenge for any of the ZK Proofs
  *
  *  Generate a random challenge for any of the ZK Proofs
@@ -119,7 +187,7 @@ void MPC_SUM_MTA(const octet *A, const octet *B, const octet *ALPHA, const octet
  *  interactive and be interoperable with other implementations.
  *
  *  <ol>
- *  <li> \f$ e \in_R [0, \ldots, q] \f$
+ *  <li> \f$ e \in_R [0, \ldots, E] \f$
  *  </ol>
  *
  *  @param RNG               csprng for random generation
@@ -127,14 +195,26 @@ void MPC_SUM_MTA(const octet *A, const octet *B, const octet *ALPHA, const octet
  */
 void MTA_ZK_random_challenge(csprng *RNG, octet *E);
 
+/** \brief Random challenge for any of the ZK Proofs with explicit parameters
+ *
+ *  Same as MTA_ZK_random_challenge with the statistical security parameters given
+ *  explicitly. MTA_ZK_random_challenge uses MTA_PARAMS_DEFAULT
+ *
+ *  @param RNG               csprng for random generation
+ *  @param params            Statistical security parameters. NULL for MTA_PARAMS_DEFAULT
+ *  @param E                 Destination octet for the challenge.
+ *  @return                  MTA_OK, or MTA_FAIL if the parameters are not supported
+ */
+int MTA_ZK_random_challenge_params(csprng *RNG, const MTA_params *params, octet *E);
+
 /* Range Proof API */
 
 /** \brief Secret random values for the Range Proof commitment */
 typedef struct
 {
-    BIG_1024_58 alpha[FFLEN_2048];              /**< Random value in \f$ [0, \ldots, q^3]          \f$ */
+    BIG_1024_58 alpha[FFLEN_2048];              /**< Random value in \f$ [0, \ldots, qES]          \f$ */
     BIG_1024_58 beta[FFLEN_2048];               /**< Random value in \f$ [0, \ldots, N]            \f$ */
-    BIG_1024_58 gamma[FFLEN_2048 + HFLEN_2048]; /**< Random value in \f$ [0, \ldots, \tilde{N}q^3] \f$ */
+    BIG_1024_58 gamma[FFLEN_2048 + HFLEN_2048]; /**< Random value in \f$ [0, \ldots, \tilde{N}qES] \f$ */
     BIG_1024_58 rho[FFLEN_2048 + HFLEN_2048];   /**< Random value in \f$ [0, \ldots, \tilde{N}q]   \f$ */
 } MTA_RP_commitment_rv;
 
@@ -150,16 +230,32 @@ typedef struct
 typedef struct
 {
     BIG_512_60  s[FFLEN_4096];                /**< Proof of knowledge of the Paillier r value */
-    BIG_1024_58 s1[FFLEN_2048];               /**< Proof of knowledge of the message. It must be less than q^3 */
+    BIG_1024_58 s1[FFLEN_2048];               /**< Proof of knowledge of the message. It must be less than qES */
     BIG_1024_58 s2[FFLEN_2048 + HFLEN_2048];  /**< Auxiliary proof of knowledge for the message */
 } MTA_RP_proof;
 
+/** \brief Verifier state precomputed from the Range Proof commitment */
+typedef struct
+{
+    BIG_1024_58 b0p[HFLEN_2048];  /**< b0 reduced modulo P */
+    BIG_1024_58 b1p[HFLEN_2048];  /**< b1 reduced modulo P */
+    BIG_1024_58 zp[HFLEN_2048];   /**< z reduced modulo P */
+    BIG_1024_58 wp[HFLEN_2048];   /**< w reduced modulo P */
+    BIG_1024_58 b0q[HFLEN_2048];  /**< b0 reduced modulo Q */
+    BIG_1024_58 b1q[HFLEN_2048];  /**< b1 reduced modulo Q */
+    BIG_1024_58 zq[HFLEN_2048];   /**< z reduced modulo Q */
+    BIG_1024_58 wq[HFLEN_2048];   /**< w reduced modulo Q */
+    BIG_512_60  ctinv[FFLEN_4096]; /**< Inverse of the ciphertext modulo N^2 */
+    BIG_512_60  u[FFLEN_4096];     /**< u component of the commitment */
+    MTA_params  params;            /**< Statistical security parameters */
+} MTA_RP_verify_ctx;
+
 /** \brief Commitment Generation
  *
  *  Generate a commitment for the message M
  *
  *  <ol>
- *  <li> \f$ \alpha \in_R [0, \ldots, q^3]\f$
+ *  <li> \f$ \alpha \in_R [0, \ldots, qES]\f$
  *  <li> \f$ \beta  \in_R [0, \ldots, N]\f$
  *  <li> \f$ \gamma \in_R [0, \ldots, q^{3}\tilde{N}]\f$
  *  <li> \f$ \rho   \in_R [0, \ldots, q\tilde{N}]\f$
@@ -175,7 +271,23 @@ typedef struct
  *  @param c           Destination commitment
  *  @param rv          Random values associated to the commitment. If RNG is NULL this is read
  */
-extern void MTA_RP_commit(csprng *RNG, PAILLIER_private_key *key, COMMITMENTS_BC_pub_modulus *mod,  octet *M, MTA_RP_commitment *c, MTA_RP_commitment_rv *rv);
+extern void MTA_RP_commit(csprng *RNG, PAILLIER_private_key *key, COMMITMENTS_BC_pub_modulus *mod, octet *M, MTA_RP_commitment *c, MTA_RP_commitment_rv *rv);
+
+/** \brief Commitment Generation with explicit parameters
+ *
+ *  Same as MTA_RP_commit with the statistical security parameters given
+ *  explicitly. MTA_RP_commit uses MTA_PARAMS_DEFAULT
+ *
+ *  @param RNG         csprng for random generation
+ *  @param key         Paillier key used to encrypt M
+ *  @param mod         Public BC modulus of the verifier
+ *  @param params      Statistical security parameters. NULL for MTA_PARAMS_DEFAULT
+ *  @param M           Message to prove knowledge and range
+ *  @param c           Destination commitment
+ *  @param rv          Random values associated to the commitment. If RNG is NULL this is read
+ *  @return            MTA_OK, or MTA_FAIL if the parameters are not supported
+ */
+extern int MTA_RP_commit_params(csprng *RNG, PAILLIER_private_key *key, COMMITMENTS_BC_pub_modulus *mod, const MTA_params *params, octet *M, MTA_RP_commitment *c, MTA_RP_commitment_rv *rv);
 
 /** \brief Deterministic Challenge generations
  *
@@ -193,6 +305,58 @@ extern void MTA_RP_commit(csprng *RNG, PAILLIER_private_key *key, COMMITMENTS_BC
  */
 extern void MTA_RP_challenge(PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod, const octet *CT, MTA_RP_commitment *c, octet *E);
 
+/** \brief Deterministic Challenge generations with explicit parameters
+ *
+ *  Same as MTA_RP_challenge with the statistical security parameters given
+ *  explicitly. MTA_RP_challenge uses MTA_PARAMS_DEFAULT
+ *
+ *  @param key         Public Paillier key of the prover
+ *  @param mod         Public BC modulus of the verifier
+ *  @param params      Statistical security parameters. NULL for MTA_PARAMS_DEFAULT
+ *  @param CT          Encrypted Message to prove knowledge and range
+ *  @param c           Commitment of the prover
+ *  @param E           Destination challenge
+ *  @return            MTA_OK, or MTA_FAIL if the parameters are not supported
+ */
+extern int MTA_RP_challenge_params(PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod, const MTA_params *params, const octet *CT, MTA_RP_commitment *c, octet *E);
+
+/** \brief Deterministic Challenge generations with additional data
+ *
+ *  Same as the challenge above, additionally binding the segments
+ *  of the additional data. The segments are hashed in place. For
+ *  n = 0 the challenge is the same as the one above.
+ *
+ *  <ol>
+ *  <li> \f$ e = H( g | \tilde{N} | h_1 | h_2 | q | CT | z | u | w | AD_1 | \ldots | AD_n ) \f$
+ *  </ol>
+ *
+ *  @param key         Public Paillier key of the prover
+ *  @param mod         Public BC modulus of the verifier
+ *  @param CT          Encrypted Message to prove knowledge and range
+ *  @param c           Commitment of the prover
+ *  @param n           Number of segments of the additional data
+ *  @param AD          Segments of the additional data
+ *  @param E           Destination challenge
+ */
+extern void MTA_RP_challenge_v(PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod, const octet *CT, MTA_RP_commitment *c, int n, octet *AD[], octet *E);
+
+/** \brief Deterministic Challenge generations with additional data and explicit parameters
+ *
+ *  Same as MTA_RP_challenge_v with the statistical security parameters given
+ *  explicitly. MTA_RP_challenge_v uses MTA_PARAMS_DEFAULT
+ *
+ *  @param key         Public Paillier key of the prover
+ *  @param mod         Public BC modulus of the verifier
+ *  @param params      Statistical security parameters. NULL for MTA_PARAMS_DEFAULT
+ *  @param CT          Encrypted Message to prove knowledge and range
+ *  @param c           Commitment of the prover
+ *  @param n           Number of segments of the additional data
+ *  @param AD          Segments of the additional data
+ *  @param E           Destination challenge
+ *  @return            MTA_OK, or MTA_FAIL if the parameters are not supported
+ */
+extern int MTA_RP_challenge_v_params(PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod, const MTA_params *params, const octet *CT, MTA_RP_commitment *c, int n, octet *AD[], octet *E);
+
 /** \brief Proof generation
  *
  *  Generate a proof of knowledge of m and of its range
@@ -217,7 +381,7 @@ extern void MTA_RP_prove(PAILLIER_private_key *key, MTA_RP_commitment_rv *rv, oc
  *  Verify the proof of knowledge of m associated to CT and of its range
  *
  *  <ol>
- *  <li> \f$ s1 \stackrel{?}{\leq} q^3 \f$
+ *  <li> \f$ s1 \stackrel{?}{\leq} qES \f$
  *  <li> \f$ w \stackrel{?}{=} h_1^{s_1}h_2^{s_2}z^{-e} \text{ }\mathrm{mod}\text{ }\tilde{N} \f$
  *  <li> \f$ u \stackrel{?}{=} g^{s_1}s^{N}c^{-e} \text{ }\mathrm{mod}\text{ }N^2 \f$
  *  </ol>
@@ -232,6 +396,72 @@ extern void MTA_RP_prove(PAILLIER_private_key *key, MTA_RP_commitment_rv *rv, oc
  */
 extern int MTA_RP_verify(PAILLIER_public_key *key, COMMITMENTS_BC_priv_modulus *mod, octet *CT, octet *E, MTA_RP_commitment *c, MTA_RP_proof *p);
 
+/** \brief Verify a Proof with explicit parameters
+ *
+ *  Same as MTA_RP_verify with the statistical security parameters given
+ *  explicitly. MTA_RP_verify uses MTA_PARAMS_DEFAULT
+ *
+ *  @param key         Public Paillier key of the prover
+ *  @param mod         Private BC modulus of the verifier
+ *  @param params      Statistical security parameters. NULL for MTA_PARAMS_DEFAULT
+ *  @param CT          Encrypted Message to prove knowledge and range
+ *  @param E           Generated challenge
+ *  @param c           Received commitment
+ *  @param p           Received proof
+ *  @return            MTA_OK if the proof is valid and the parameters are supported, MTA_FAIL otherwise
+ */
+extern int MTA_RP_verify_params(PAILLIER_public_key *key, COMMITMENTS_BC_priv_modulus *mod, const MTA_params *params, octet *CT, octet *E, MTA_RP_commitment *c, MTA_RP_proof *p);
+
+/** \brief Prepare the verification of a Proof
+ *
+ *  Precompute the part of the verification that only depends on the
+ *  commitment and the public inputs, so it can be run as soon as the
+ *  commitment is received. The verification is completed by MTA_RP_verify_finish
+ *
+ *  @param key         Public Paillier key of the prover
+ *  @param mod         Private BC modulus of the verifier
+ *  @param CT          Encrypted Message to prove knowledge and range
+ *  @param c           Received commitment
+ *  @param ctx         Destination verification context
+ */
+extern void MTA_RP_verify_prepare(PAILLIER_public_key *key, COMMITMENTS_BC_priv_modulus *mod, octet *CT, MTA_RP_commitment *c, MTA_RP_verify_ctx *ctx);
+
+/** \brief Prepare the verification of a Proof with explicit parameters
+ *
+ *  Same as MTA_RP_verify_prepare with the statistical security parameters given
+ *  explicitly. MTA_RP_verify_prepare uses MTA_PARAMS_DEFAULT
+ *
+ *  @param key         Public Paillier key of the prover
+ *  @param mod         Private BC modulus of the verifier
+ *  @param params      Statistical security parameters. NULL for MTA_PARAMS_DEFAULT
+ *  @param CT          Encrypted Message to prove knowledge and range
+ *  @param c           Received commitment
+ *  @param ctx         Destination verification context
+ *  @return            MTA_OK, or MTA_FAIL if the parameters are not supported
+ */
+extern int MTA_RP_verify_prepare_params(PAILLIER_public_key *key, COMMITMENTS_BC_priv_modulus *mod, const MTA_params *params, octet *CT, MTA_RP_commitment *c, MTA_RP_verify_ctx *ctx);
+
+/** \brief Finish the verification of a Proof
+ *
+ *  Verify the proof using the context precomputed by MTA_RP_verify_prepare.
+ *  See MTA_RP_verify for the checks performed. The statistical security
+ *  parameters are the ones given to MTA_RP_verify_prepare
+ *
+ *  @param key         Public Paillier key of the prover
+ *  @param mod         Private BC modulus of the verifier
+ *  @param E           Generated challenge
+ *  @param ctx         Verification context for the received commitment
+ *  @param p           Received proof
+ *  @return            MTA_OK if the proof is valid, MTA_FAIL otherwise
+ */
+extern int MTA_RP_verify_finish(PAILLIER_public_key *key, COMMITMENTS_BC_priv_modulus *mod, octet *E, MTA_RP_verify_ctx *ctx, MTA_RP_proof *p);
+
+/** \brief Clean the memory containing the verification context
+ *
+ *   @param ctx        Verification context to clean
+ */
+extern void MTA_RP_verify_ctx_kill(MTA_RP_verify_ctx *ctx);
+
 /** \brief Dump the commitment to octets
  *
  *  @param Z           Destination Octet for the z component of the commitment. FS_2048 long
@@ -279,11 +509,11 @@ extern void MTA_RP_commitment_rv_kill(MTA_RP_commitment_rv *rv);
 /** \brief Secret random values for the receiver ZKP commitment */
 typedef struct
 {
-    BIG_1024_58 alpha[FFLEN_2048];              /**< Random value in \f$ [0, \ldots, q^3]          \f$ */
+    BIG_1024_58 alpha[FFLEN_2048];              /**< Random value in \f$ [0, \ldots, qES]          \f$ */
     BIG_1024_58 beta[FFLEN_2048];               /**< Random value in \f$ [0, \ldots, N]            \f$ */
     BIG_1024_58 gamma[FFLEN_2048];              /**< Random value in \f$ [0, \ldots, N]            \f$ */
     BIG_1024_58 rho[FFLEN_2048 + HFLEN_2048];   /**< Random value in \f$ [0, \ldots, \tilde{N}q]   \f$ */
-    BIG_1024_58 rho1[FFLEN_2048 + HFLEN_2048];  /**< Random value in \f$ [0, \ldots, \tilde{N}q^3] \f$ */
+    BIG_1024_58 rho1[FFLEN_2048 + HFLEN_2048];  /**< Random value in \f$ [0, \ldots, \tilde{N}qES] \f$ */
     BIG_1024_58 sigma[FFLEN_2048 + HFLEN_2048]; /**< Random value in \f$ [0, \ldots, \tilde{N}q]   \f$ */
     BIG_1024_58 tau[FFLEN_2048 + HFLEN_2048];   /**< Random value in \f$ [0, \ldots, \tilde{N}q]   \f$ */
 } MTA_ZK_commitment_rv;
@@ -302,18 +532,43 @@ typedef struct
 typedef struct
 {
     BIG_1024_58 s[FFLEN_2048];                /**< Proof of knowledge of the Paillier r value */
-    BIG_1024_58 s1[FFLEN_2048];               /**< Proof of knowledge of x. It must be less than q^3 */
+    BIG_1024_58 s1[FFLEN_2048];               /**< Proof of knowledge of x. It must be less than qES */
     BIG_1024_58 s2[FFLEN_2048 + HFLEN_2048];  /**< Auxiliary proof of knowledge for x */
     BIG_1024_58 t1[FFLEN_2048];               /**< Proof of knowledge of y */
     BIG_1024_58 t2[FFLEN_2048 + HFLEN_2048];  /**< Auxiliary proof of knowledge for y */
 } MTA_ZK_proof;
 
+/** \brief Verifier state precomputed from the Receiver ZKP commitment */
+typedef struct
+{
+    BIG_1024_58 b0p[HFLEN_2048];  /**< b0 reduced modulo P */
+    BIG_1024_58 b1p[HFLEN_2048];  /**< b1 reduced modulo P */
+    BIG_1024_58 zp[HFLEN_2048];   /**< z reduced modulo P */
+    BIG_1024_58 z1p[HFLEN_2048];  /**< z1 reduced modulo P */
+    BIG_1024_58 tp[HFLEN_2048];   /**< t reduced modulo P */
+    BIG_1024_58 wp[HFLEN_2048];   /**< w reduced modulo P */
+    BIG_1024_58 b0q[HFLEN_2048];  /**< b0 reduced modulo Q */
+    BIG_1024_58 b1q[HFLEN_2048];  /**< b1 reduced modulo Q */
+    BIG_1024_58 zq[HFLEN_2048];   /**< z reduced modulo Q */
+    BIG_1024_58 z1q[HFLEN_2048];  /**< z1 reduced modulo Q */
+    BIG_1024_58 tq[HFLEN_2048];   /**< t reduced modulo Q */
+    BIG_1024_58 wq[HFLEN_2048];   /**< w reduced modulo Q */
+    BIG_1024_58 n[FFLEN_2048];    /**< Paillier modulus N */
+    BIG_1024_58 c1p[FFLEN_2048];  /**< c1 reduced modulo p^2 */
+    BIG_1024_58 c2p[FFLEN_2048];  /**< c2 reduced modulo p^2 */
+    BIG_1024_58 vp[FFLEN_2048];   /**< v reduced modulo p^2 */
+    BIG_1024_58 c1q[FFLEN_2048];  /**< c1 reduced modulo q^2 */
+    BIG_1024_58 c2q[FFLEN_2048];  /**< c2 reduced modulo q^2 */
+    BIG_1024_58 vq[FFLEN_2048];   /**< v reduced modulo q^2 */
+    MTA_params  params;           /**< Statistical security parameters */
+} MTA_ZK_verify_ctx;
+
 /** \brief Commitment Generation for Receiver ZKP
  *
  *  Generate a commitment for the values x, y and c1
  *
  *  <ol>
- *  <li> \f$ \alpha \in_R [0, \ldots, q^3]\f$
+ *  <li> \f$ \alpha \in_R [0, \ldots, qES]\f$
  *  <li> \f$ \beta  \in_R [0, \ldots, N]\f$
  *  <li> \f$ \gamma \in_R [0, \ldots, N]\f$
  *  <li> \f$ \rho   \in_R [0, \ldots, q\tilde{N}]\f$
@@ -336,7 +591,25 @@ typedef struct
  *  @param c           Destination commitment
  *  @param rv          Random values associated to the commitment. If RNG is NULL this is read
  */
-extern void MTA_ZK_commit(csprng *RNG, PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod,  octet *X, octet *Y, octet *C1, MTA_ZK_commitment *c, MTA_ZK_commitment_rv *rv);
+extern void MTA_ZK_commit(csprng *RNG, PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod, octet *X, octet *Y, octet *C1, MTA_ZK_commitment *c, MTA_ZK_commitment_rv *rv);
+
+/** \brief Commitment Generation for Receiver ZKP with explicit parameters
+ *
+ *  Same as MTA_ZK_commit with the statistical security parameters given
+ *  explicitly. MTA_ZK_commit uses MTA_PARAMS_DEFAULT
+ *
+ *  @param RNG         csprng for random generation
+ *  @param key         Paillier key used to encrypt C1
+ *  @param mod         Public BC modulus of the verifier
+ *  @param params      Statistical security parameters. NULL for MTA_PARAMS_DEFAULT
+ *  @param X           Message to prove knowledge and range
+ *  @param Y           Message to prove knowledge
+ *  @param C1          Base Paillier Ciphertext
+ *  @param c           Destination commitment
+ *  @param rv          Random values associated to the commitment. If RNG is NULL this is read
+ *  @return            MTA_OK, or MTA_FAIL if the parameters are not supported
+ */
+extern int MTA_ZK_commit_params(csprng *RNG, PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod, const MTA_params *params, octet *X, octet *Y, octet *C1, MTA_ZK_commitment *c, MTA_ZK_commitment_rv *rv);
 
 /** \brief Deterministic Challenge generations for Receiver ZKP
  *
@@ -355,6 +628,61 @@ extern void MTA_ZK_commit(csprng *RNG, PAILLIER_public_key *key, COMMITMENTS_BC_
  */
 extern void MTA_ZK_challenge(PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod, const octet *C1, const octet *C2, MTA_ZK_commitment *c, octet *E);
 
+/** \brief Deterministic Challenge generations for Receiver ZKP with explicit parameters
+ *
+ *  Same as MTA_ZK_challenge with the statistical security parameters given
+ *  explicitly. MTA_ZK_challenge uses MTA_PARAMS_DEFAULT
+ *
+ *  @param key         Public Paillier key of the prover
+ *  @param mod         Public BC modulus of the verifier
+ *  @param params      Statistical security parameters. NULL for MTA_PARAMS_DEFAULT
+ *  @param C1          Base Paillier Ciphertext
+ *  @param C2          New Paillier Ciphertext to prove knowledge and range
+ *  @param c           Commitment of the prover
+ *  @param E           Destination challenge
+ *  @return            MTA_OK, or MTA_FAIL if the parameters are not supported
+ */
+extern int MTA_ZK_challenge_params(PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod, const MTA_params *params, const octet *C1, const octet *C2, MTA_ZK_commitment *c, octet *E);
+
+/** \brief Deterministic Challenge generations for Receiver ZKP with additional data
+ *
+ *  Same as the challenge above, additionally binding the segments
+ *  of the additional data. The segments are hashed in place. For
+ *  n = 0 the challenge is the same as the one above.
+ *
+ *  <ol>
+ *  <li> \f$ e = H( g | \tilde{N} | h_1 | h_2 | q | c_1 | c_2 | z | z1 | t | v | w | AD_1 | \ldots | AD_n ) \f$
+ *  </ol>
+ *
+ *  @param key         Public Paillier key of the prover
+ *  @param mod         Public BC modulus of the verifier
+ *  @param C1          Base Paillier Ciphertext
+ *  @param C2          New Paillier Ciphertext to prove knowledge and range
+ *  @param c           Commitment of the prover
+ *  @param n           Number of segments of the additional data
+ *  @param AD          Segments of the additional data
+ *  @param E           Destination challenge
+ */
+extern void MTA_ZK_challenge_v(PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod, const octet *C1, const octet *C2, MTA_ZK_commitment *c, int n, octet *AD[], octet *E);
+
+/** \brief Deterministic Challenge generations for Receiver ZKP with additional data and explicit parameters
+ *
+ *  Same as MTA_ZK_challenge_v with the statistical security parameters given
+ *  explicitly. MTA_ZK_challenge_v uses MTA_PARAMS_DEFAULT
+ *
+ *  @param key         Public Paillier key of the prover
+ *  @param mod         Public BC modulus of the verifier
+ *  @param params      Statistical security parameters. NULL for MTA_PARAMS_DEFAULT
+ *  @param C1          Base Paillier Ciphertext
+ *  @param C2          New Paillier Ciphertext to prove knowledge and range
+ *  @param c           Commitment of the prover
+ *  @param n           Number of segments of the additional data
+ *  @param AD          Segments of the additional data
+ *  @param E           Destination challenge
+ *  @return            MTA_OK, or MTA_FAIL if the parameters are not supported
+ */
+extern int MTA_ZK_challenge_v_params(PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod, const MTA_params *params, const octet *C1, const octet *C2, MTA_ZK_commitment *c, int n, octet *AD[], octet *E);
+
 /** \brief Proof generation for Receiver ZKP
  *
  *  Generate a proof of knowledge of x, y and a range proof for x
@@ -382,7 +710,7 @@ extern void MTA_ZK_prove(PAILLIER_public_key *key, MTA_ZK_commitment_rv *rv, oct
  *  Verify the proof of knowledge of x, y associated to c1, c2 and of x range
  *
  *  <ol>
- *  <li> \f$ s_1 \stackrel{?}{\leq} q^3 \f$
+ *  <li> \f$ s_1 \stackrel{?}{\leq} qES \f$
  *  <li> \f$ z_1 \stackrel{?}{=} h_1^{s_1}h_2^{s_2}z^{-e}    \text{ }\mathrm{mod}\text{ }\tilde{N} \f$
  *  <li> \f$ w  \stackrel{?}{=} h_1^{t_1}h_2^{t_2}t^{-e}    \text{ }\mathrm{mod}\text{ }\tilde{N} \f$
  *  <li> \f$ v  \stackrel{?}{=} c1^{s_1}s^{N}g^{t_1}c2^{-e} \text{ }\mathrm{mod}\text{ }N^2 \f$
@@ -399,6 +727,75 @@ extern void MTA_ZK_prove(PAILLIER_public_key *key, MTA_ZK_commitment_rv *rv, oct
  */
 extern int MTA_ZK_verify(PAILLIER_private_key *key, COMMITMENTS_BC_priv_modulus *mod, octet *C1, octet *C2, octet *E, MTA_ZK_commitment *c, MTA_ZK_proof *p);
 
+/** \brief Verify a Proof for Receiver ZKP with explicit parameters
+ *
+ *  Same as MTA_ZK_verify with the statistical security parameters given
+ *  explicitly. MTA_ZK_verify uses MTA_PARAMS_DEFAULT
+ *
+ *  @param key         Public Paillier key of the prover
+ *  @param mod         Private BC modulus of the verifier
+ *  @param params      Statistical security parameters. NULL for MTA_PARAMS_DEFAULT
+ *  @param C1          Base Paillier Ciphertext
+ *  @param C2          New Paillier Ciphertext to prove knowledge and range
+ *  @param E           Generated challenge
+ *  @param c           Received commitment
+ *  @param p           Received proof
+ *  @return            MTA_OK if the proof is valid and the parameters are supported, MTA_FAIL otherwise
+ */
+extern int MTA_ZK_verify_params(PAILLIER_private_key *key, COMMITMENTS_BC_priv_modulus *mod, const MTA_params *params, octet *C1, octet *C2, octet *E, MTA_ZK_commitment *c, MTA_ZK_proof *p);
+
+/** \brief Prepare the verification of a Proof for Receiver ZKP
+ *
+ *  Precompute the part of the verification that only depends on the
+ *  commitment and the ciphertexts, so it can be run as soon as the
+ *  commitment is received. The verification is completed by MTA_ZK_verify_finish
+ *
+ *  @param key         Private Paillier key of the verifier
+ *  @param mod         Private BC modulus of the verifier
+ *  @param C1          Base Paillier Ciphertext
+ *  @param C2          New Paillier Ciphertext to prove knowledge and range
+ *  @param c           Received commitment
+ *  @param ctx         Destination verification context
+ */
+extern void MTA_ZK_verify_prepare(PAILLIER_private_key *key, COMMITMENTS_BC_priv_modulus *mod, octet *C1, octet *C2, MTA_ZK_commitment *c, MTA_ZK_verify_ctx *ctx);
+
+/** \brief Prepare the verification of a Proof for Receiver ZKP with explicit parameters
+ *
+ *  Same as MTA_ZK_verify_prepare with the statistical security parameters given
+ *  explicitly. MTA_ZK_verify_prepare uses MTA_PARAMS_DEFAULT
+ *
+ *  @param key         Private Paillier key of the verifier
+ *  @param mod         Private BC modulus of the verifier
+ *  @param params      Statistical security parameters. NULL for MTA_PARAMS_DEFAULT
+ *  @param C1          Base Paillier Ciphertext
+ *  @param C2          New Paillier Ciphertext to prove knowledge and range
+ *  @param c           Received commitment
+ *  @param ctx         Destination verification context
+ *  @return            MTA_OK, or MTA_FAIL if the parameters are not supported
+ */
+extern int MTA_ZK_verify_prepare_params(PAILLIER_private_key *key, COMMITMENTS_BC_priv_modulus *mod, const MTA_params *params, octet *C1, octet *C2, MTA_ZK_commitment *c, MTA_ZK_verify_ctx *ctx);
+
+/** \brief Finish the verification of a Proof for Receiver ZKP
+ *
+ *  Verify the proof using the context precomputed by MTA_ZK_verify_prepare.
+ *  See MTA_ZK_verify for the checks performed. The statistical security
+ *  parameters are the ones given to MTA_ZK_verify_prepare
+ *
+ *  @param key         Private Paillier key of the verifier
+ *  @param mod         Private BC modulus of the verifier
+ *  @param E           Generated challenge
+ *  @param ctx         Verification context for the received commitment
+ *  @param p           Received proof
+ *  @return            MTA_OK if the proof is valid, MTA_FAIL otherwise
+ */
+extern int MTA_ZK_verify_finish(PAILLIER_private_key *key, COMMITMENTS_BC_priv_modulus *mod, octet *E, MTA_ZK_verify_ctx *ctx, MTA_ZK_proof *p);
+
+/** \brief Clean the memory containing the verification context
+ *
+ *   @param ctx        Verification context to clean
+ */
+extern void MTA_ZK_verify_ctx_kill(MTA_ZK_verify_ctx *ctx);
+
 /** \brief Dump the commitment to octets
  *
  *  @param Z           Destination Octet for the z component of the commitment. FS_2048 long
@@ -469,7 +866,7 @@ typedef MTA_ZK_proof MTA_ZKWC_proof;
  *  Generate a commitment for the values x, y and c1
  *
  *  <ol>
- *  <li> \f$ \alpha \in_R [0, \ldots, q^3]\f$
+ *  <li> \f$ \alpha \in_R [0, \ldots, qES]\f$
  *  <li> \f$ \beta  \in_R [0, \ldots, N]\f$
  *  <li> \f$ \gamma \in_R [0, \ldots, N]\f$
  *  <li> \f$ \rho   \in_R [0, \ldots, q\tilde{N}]\f$
@@ -493,7 +890,25 @@ typedef MTA_ZK_proof MTA_ZKWC_proof;
  *  @param c           Destination commitment
  *  @param rv          Random values associated to the commitment. If RNG is NULL this is read
  */
-extern void MTA_ZKWC_commit(csprng *RNG, PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod,  octet *X, octet *Y, octet *C1, MTA_ZKWC_commitment *c, MTA_ZKWC_commitment_rv *rv);
+extern void MTA_ZKWC_commit(csprng *RNG, PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod, octet *X, octet *Y, octet *C1, MTA_ZKWC_commitment *c, MTA_ZKWC_commitment_rv *rv);
+
+/** \brief Commitment Generation for Receiver ZKP with check and explicit parameters
+ *
+ *  Same as MTA_ZKWC_commit with the statistical security parameters given
+ *  explicitly. MTA_ZKWC_commit uses MTA_PARAMS_DEFAULT
+ *
+ *  @param RNG         csprng for random generation
+ *  @param key         Paillier key used to encrypt C1
+ *  @param mod         Public BC modulus of the verifier
+ *  @param params      Statistical security parameters. NULL for MTA_PARAMS_DEFAULT
+ *  @param X           Message to prove knowledge and range
+ *  @param Y           Message to prove knowledge
+ *  @param C1          Base Paillier Ciphertext
+ *  @param c           Destination commitment
+ *  @param rv          Random values associated to the commitment. If RNG is NULL this is read
+ *  @return            MTA_OK, or MTA_FAIL if the parameters are not supported
+ */
+extern int MTA_ZKWC_commit_params(csprng *RNG, PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod, const MTA_params *params, octet *X, octet *Y, octet *C1, MTA_ZKWC_commitment *c, MTA_ZKWC_commitment_rv *rv);
 
 /** \brief Deterministic Challenge generations for Receiver ZKP with check
  *
@@ -513,6 +928,64 @@ extern void MTA_ZKWC_commit(csprng *RNG, PAILLIER_public_key *key, COMMITMENTS_B
  */
 extern void MTA_ZKWC_challenge(PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod, const octet *C1, const octet *C2, const octet *X, MTA_ZKWC_commitment *c, octet *E);
 
+/** \brief Deterministic Challenge generations for Receiver ZKP with check and explicit parameters
+ *
+ *  Same as MTA_ZKWC_challenge with the statistical security parameters given
+ *  explicitly. MTA_ZKWC_challenge uses MTA_PARAMS_DEFAULT
+ *
+ *  @param key         Public Paillier key of the prover
+ *  @param mod         Public BC modulus of the verifier
+ *  @param params      Statistical security parameters. NULL for MTA_PARAMS_DEFAULT
+ *  @param C1          Base Paillier Ciphertext
+ *  @param C2          New Paillier Ciphertext to prove knowledge and range
+ *  @param X           Public exponent of the associated DLOG to prove knowledge
+ *  @param c           Commitment of the prover
+ *  @param E           Destination challenge
+ *  @return            MTA_OK, or MTA_FAIL if the parameters are not supported
+ */
+extern int MTA_ZKWC_challenge_params(PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod, const MTA_params *params, const octet *C1, const octet *C2, const octet *X, MTA_ZKWC_commitment *c, octet *E);
+
+/** \brief Deterministic Challenge generations for Receiver ZKP with check with additional data
+ *
+ *  Same as the challenge above, additionally binding the segments
+ *  of the additional data. The segments are hashed in place. For
+ *  n = 0 the challenge is the same as the one above.
+ *
+ *  <ol>
+ *  <li> \f$ e = H( g | \tilde{N} | h_1 | h_2 | q | c_1 | c_2 | X | U | z | z1 | t | v | w | AD_1 | \ldots | AD_n ) \f$
+ *  </ol>
+ *
+ *  @param key         Public Paillier key of the prover
+ *  @param mod         Public BC modulus of the verifier
+ *  @param C1          Base Paillier Ciphertext
+ *  @param C2          New Paillier Ciphertext to prove knowledge and range
+ *  @param X           Public exponent of the associated DLOG to prove knowledge
+ *  @param c           Commitment of the prover
+ *  @param n           Number of segments of the additional data
+ *  @param AD          Segments of the additional data
+ *  @param E           Destination challenge
+ */
+extern void MTA_ZKWC_challenge_v(PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod, const octet *C1, const octet *C2, const octet *X, MTA_ZKWC_commitment *c, int n, octet *AD[], octet *E);
+
+/** \brief Deterministic Challenge generations for Receiver ZKP with check with additional data and explicit parameters
+ *
+ *  Same as MTA_ZKWC_challenge_v with the statistical security parameters given
+ *  explicitly. MTA_ZKWC_challenge_v uses MTA_PARAMS_DEFAULT
+ *
+ *  @param key         Public Paillier key of the prover
+ *  @param mod         Public BC modulus of the verifier
+ *  @param params      Statistical security parameters. NULL for MTA_PARAMS_DEFAULT
+ *  @param C1          Base Paillier Ciphertext
+ *  @param C2          New Paillier Ciphertext to prove knowledge and range
+ *  @param X           Public exponent of the associated DLOG to prove knowledge
+ *  @param c           Commitment of the prover
+ *  @param n           Number of segments of the additional data
+ *  @param AD          Segments of the additional data
+ *  @param E           Destination challenge
+ *  @return            MTA_OK, or MTA_FAIL if the parameters are not supported
+ */
+extern int MTA_ZKWC_challenge_v_params(PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod, const MTA_params *params, const octet *C1, const octet *C2, const octet *X, MTA_ZKWC_commitment *c, int n, octet *AD[], octet *E);
+
 /** \brief Proof generation for Receiver ZKP with check
  *
  *  Generate a proof of knowledge of x, y and a range proof for x.
@@ -544,7 +1017,7 @@ extern void MTA_ZKWC_prove(PAILLIER_public_key *key, MTA_ZKWC_commitment_rv *rv,
  *  Additionally verify the knowledge of X = x.G
  *
  *  <ol>
- *  <li> \f$ s_1 \stackrel{?}{\leq} q^3 \f$
+ *  <li> \f$ s_1 \stackrel{?}{\leq} qES \f$
  *  <li> \f$ z_1 \stackrel{?}{=} h_1^{s_1}h_2^{s_2}z^{-e}   \text{ }\mathrm{mod}\text{ }\tilde{N} \f$
  *  <li> \f$ w  \stackrel{?}{=} h_1^{t_1}h_2^{t_2}t^{-e}    \text{ }\mathrm{mod}\text{ }\tilde{N} \f$
  *  <li> \f$ v  \stackrel{?}{=} c1^{s_1}s^{N}g^{t_1}c2^{-e} \text{ }\mathrm{mod}\text{ }N^2 \f$
@@ -563,6 +1036,24 @@ extern void MTA_ZKWC_prove(PAILLIER_public_key *key, MTA_ZKWC_commitment_rv *rv,
  */
 extern int MTA_ZKWC_verify(PAILLIER_private_key *key, COMMITMENTS_BC_priv_modulus *mod, octet *C1, octet *C2, octet *X, octet *E, MTA_ZKWC_commitment *c, MTA_ZKWC_proof *p);
 
+/** \brief Verify a Proof for Receiver ZKP with check and explicit parameters
+ *
+ *  Same as MTA_ZKWC_verify with the statistical security parameters given
+ *  explicitly. MTA_ZKWC_verify uses MTA_PARAMS_DEFAULT
+ *
+ *  @param key         Public Paillier key of the prover
+ *  @param mod         Private BC modulus of the verifier
+ *  @param params      Statistical security parameters. NULL for MTA_PARAMS_DEFAULT
+ *  @param C1          Base Paillier Ciphertext
+ *  @param C2          New Paillier Ciphertext to prove knowledge and range
+ *  @param X           Public ECP of the DLOG x.G
+ *  @param E           Generated challenge
+ *  @param c           Received commitment
+ *  @param p           Received proof
+ *  @return            MTA_OK if the proof is valid and the parameters are supported, MTA_FAIL otherwise
+ */
+extern int MTA_ZKWC_verify_params(PAILLIER_private_key *key, COMMITMENTS_BC_priv_modulus *mod, const MTA_params *params, octet *C1, octet *C2, octet *X, octet *E, MTA_ZKWC_commitment *c, MTA_ZKWC_proof *p);
+
 /** \brief Dump the commitment to octets
  *
  *  @param U           Octet with the commitment for the DLOG ZKP. EGS_SECP256K1 + 1 long
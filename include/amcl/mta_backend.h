@@ -0,0 +1,146 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/**
+ * @file mta_backend.h
+ * @brief Pluggable encryption backends for the MTA declarations
+ *
+ * The MTA only needs an additively homomorphic encryption scheme
+ * with plaintext space larger than \f$ q^2 \f$. A backend bundles
+ * the key management, the three MTA passes and the proofs of the
+ * passes for one such scheme.
+ *
+ * Only the Paillier backend is provided, and it is the default. This
+ * file defines the interface and the registry, so that another scheme
+ * can be added with MTA_BACKEND_register without changes to the code
+ * written against the backend pointer, e.g. the LOCKSTEP_MTA_BACKEND_*
+ * functions. No class group backend is included. The setup for the
+ * proofs is backend specific and is generated outside this API: for
+ * Paillier it is the BC modulus of the verifier, see COMMITMENTS_BC_setup.
+ *
+ * Keys and proofs are opaque to the caller, which allocates pub_size,
+ * priv_size, cproof_size and sproof_size bytes for them.
+ */
+
+#ifndef MTA_BACKEND_H
+#define MTA_BACKEND_H
+
+#include "amcl/amcl.h"
+#include "amcl/mta.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define MTA_BACKEND_OK   0    /**< Execution Successful */
+#define MTA_BACKEND_FAIL 171  /**< Registry full or duplicate backend name */
+
+#define MTA_BACKEND_MAX  8    /**< Maximum number of registered backends */
+
+/*! \brief Encryption backend for the MTA
+ *
+ * The pass functions have the semantics of MPC_MTA_CLIENT1,
+ * MPC_MTA_SERVER and MPC_MTA_CLIENT2 for the keys of the backend.
+ * Shares and outputs are EGS_SECP256K1 octets, ciphertexts are at
+ * most ct_size bytes.
+ *
+ * The proof functions make the MTA secure against a malicious
+ * counterparty. The client proves that CA is well formed, with the
+ * semantics of MTA_RP_*, and the server proves that CB was computed
+ * from CA, with the semantics of MTA_ZK_* or, if X is given, of
+ * MTA_ZKWC_*. vpub and vpriv are the public and private proof setup
+ * of the verifier.
+ */
+typedef struct
+{
+    const char *name;        /**< Unique name of the backend */
+    int pub_size;            /**< Size in bytes of the public key structure */
+    int priv_size;           /**< Size in bytes of the private key structure */
+    int pk_size;             /**< Size in bytes of the serialized public key */
+    int ct_size;             /**< Size in bytes of a ciphertext */
+    int cproof_size;         /**< Size in bytes of the client proof structure */
+    int sproof_size;         /**< Size in bytes of the server proof structure */
+
+    /** Generate a key pair */
+    void (*keygen)(csprng *RNG, void *pub, void *priv);
+    /** Clean the private key */
+    void (*kill)(void *priv);
+    /** Serialize the public key */
+    void (*pk_toOctet)(octet *PK, void *pub);
+    /** Deserialize the public key */
+    void (*pk_fromOctet)(void *pub, octet *PK);
+
+    /** Client first pass. Encrypt A under the client public key */
+    void (*client1)(csprng *RNG, void *pub, octet *A, octet *CA, octet *R);
+    /** Server pass. Homomorphically compute CB = B.CA + Z under the client public key */
+    void (*server)(csprng *RNG, void *pub, octet *B, octet *CA, octet *Z, octet *R, octet *CB, octet *BETA);
+    /** Client second pass. Decrypt CB into the additive share ALPHA */
+    void (*client2)(void *priv, octet *CB, octet *ALPHA);
+
+    /** Prove that CA encrypts A with randomness R and A is in range. Return MTA_OK, or MTA_FAIL for unsupported params */
+    int (*client1_prove)(csprng *RNG, void *pub, void *priv, void *vpub, const MTA_params *params, octet *A, octet *R, octet *CA, void *proof);
+    /** Verify a client proof. Return MTA_OK or MTA_FAIL */
+    int (*client1_verify)(void *pub, void *vpriv, const MTA_params *params, octet *CA, void *proof);
+    /** Prove that CB = B.CA + Z with randomness R. If X is not NULL also prove that X = B.G. Return MTA_OK, or MTA_FAIL for unsupported params */
+    int (*server_prove)(csprng *RNG, void *pub, void *vpub, const MTA_params *params, octet *B, octet *Z, octet *R, octet *CA, octet *CB, octet *X, void *proof);
+    /** Verify a server proof. X must be NULL if and only if it was NULL for the prover. Return MTA_OK or MTA_FAIL */
+    int (*server_verify)(void *pub, void *priv, void *vpriv, const MTA_params *params, octet *CA, octet *CB, octet *X, void *proof);
+} MTA_BACKEND;
+
+/*! \brief Paillier backend. Wraps the MPC_MTA_* functions */
+extern const MTA_BACKEND MTA_BACKEND_paillier;
+
+#define MTA_BACKEND_DEFAULT (&MTA_BACKEND_paillier)   /**< Default backend */
+
+/*! \brief Register a backend
+ *
+ * The registry is not thread safe. Backends must be registered before
+ * the signing sessions start.
+ *
+ * @param b           Backend to register. It must outlive the registry
+ * @return            MTA_BACKEND_OK or MTA_BACKEND_FAIL
+ */
+extern int MTA_BACKEND_register(const MTA_BACKEND *b);
+
+/*! \brief Number of registered backends, including the default
+ *
+ * @return            Number of registered backends
+ */
+extern int MTA_BACKEND_count(void);
+
+/*! \brief Registered backend by index
+ *
+ * @param i           Index of the backend. The default backend has index 0
+ * @return            The backend or NULL if i is out of range
+ */
+extern const MTA_BACKEND *MTA_BACKEND_get(int i);
+
+/*! \brief Registered backend by name
+ *
+ * @param name        Name of the backend
+ * @return            The backend or NULL if no backend has this name
+ */
+extern const MTA_BACKEND *MTA_BACKEND_find(const char *name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
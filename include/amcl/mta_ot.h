@@ -0,0 +1,329 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/**
+ * @file mta_ot.h
+ * @brief Oblivious transfer based MTA declarations
+ *
+ * Multiplicative to additive share conversion with correlated
+ * oblivious transfers (Gilboa). The client inputs an encoding of
+ * \f$ a \f$ as choice bits, the server inputs \f$ b \f$ as the
+ * correlation, and the shares satisfy \f$ \alpha + \beta = ab \f$.
+ *
+ * The oblivious transfers are extended (IKNP) from MTA_OT_KAPPA base
+ * oblivious transfers (Chou-Orlandi) run once for each pair of
+ * parties. An MTA then only needs hashing and about 34 KB of
+ * messages, plus 21 KB for each further product on the same extension.
+ *
+ * The consistency of the choice bits of the client is checked with
+ * the KOS random linear combination over \f$ GF(2^{128}) \f$, with
+ * the challenge derived from the extension matrix. The outcome of
+ * the check depends on the secret choice bits of the server, so a
+ * failed check disables the server setup: its secrets are cleared
+ * and every later MTA fails until a new setup is run. Otherwise a
+ * client could recover the choice bits one retry at a time and then
+ * read \f$ b \f$ from the corrections.
+ *
+ * The corrections of the server are not checked. A server that
+ * tampers with the correction of one transfer makes the shares wrong
+ * exactly when the matching choice bit is set, and the failure of the
+ * signature tells it the value of that bit. The choice bits are
+ * therefore not the bits of \f$ a \f$ but a random encoding of it
+ * (DKLs18): \f$ a = \langle g, r \rangle \f$ where \f$ g \f$ is a
+ * public gadget vector made of the powers of 2 and MTA_OT_GADGET
+ * pseudorandom elements, and the random part of \f$ r \f$ has
+ * \f$ 2 \cdot \f$ MTA_OT_STAT bits of slack. Each probe makes the
+ * signature fail with probability 1/2, so a server learns only a few
+ * choice bits before it is detected, and those are statistically
+ * independent of \f$ a \f$. A failed signature must still abort the
+ * session.
+ *
+ * Every extension draws a fresh encoding of \f$ a \f$, so the same
+ * \f$ a \f$ can be used in several MTAs with the same server: the
+ * bits a server learns from each encoding are independent of
+ * \f$ a \f$ and of the other encodings. In the signing protocol the
+ * client runs the MTA for \f$ k_i \gamma_j \f$ and the MTAwc for
+ * \f$ k_i w_j \f$ with the same \f$ k_i \f$. Both products are
+ * served by one extension with MPC_MTA_OT_SERVER_MULTI and
+ * MPC_MTA_OT_CLIENT2_MULTI, which use independent hashes of the rows
+ * for each product (DKLs19). The MTAwc binds \f$ b \f$ to
+ * \f$ W = b.G \f$ with MPC_MTA_OT_WC_COMMIT and MPC_MTA_OT_WC_VERIFY.
+ *
+ * The setup state and the counter of the extension are bound to the
+ * pair of parties and must not be shared or rolled back.
+ */
+
+#ifndef MTA_OT_H
+#define MTA_OT_H
+
+#include "amcl/amcl.h"
+#include "amcl/ecp_SECP256K1.h"
+#include "amcl/ecdh_SECP256K1.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define MTA_OT_OK          0      /**< Execution Successful */
+#define MTA_OT_FAIL        181    /**< Invalid extension or counter */
+#define MTA_OT_INVALID_ECP 182    /**< Invalid ECP */
+
+#define MTA_OT_KAPPA  128                              /**< Number of base oblivious transfers */
+#define MTA_OT_KBYTES (MTA_OT_KAPPA / 8)               /**< Size in bytes of the base keys and of a row of the extension */
+#define MTA_OT_STAT   80                               /**< Statistical security parameter of the encoding of the choice bits */
+#define MTA_OT_BITS   (8 * EGS_SECP256K1)              /**< Number of bits of the multiplicative share */
+#define MTA_OT_GADGET (MTA_OT_BITS + 2 * MTA_OT_STAT)  /**< Number of random choice bits of the encoding */
+#define MTA_OT_CHOICE (MTA_OT_BITS + MTA_OT_GADGET)    /**< Number of correlated oblivious transfers for an MTA */
+#define MTA_OT_M      (MTA_OT_CHOICE + MTA_OT_KAPPA)   /**< Number of extended oblivious transfers, including the check padding */
+#define MTA_OT_MBYTES (MTA_OT_M / 8)                   /**< Size in bytes of a column of the extension */
+
+#define MTA_OT_S_SIZE  (EFS_SECP256K1 + 1)                                  /**< Size in bytes of the client setup message */
+#define MTA_OT_R_SIZE  (MTA_OT_KAPPA * (EFS_SECP256K1 + 1))                 /**< Size in bytes of the server setup message */
+#define MTA_OT_CA_SIZE (4 + MTA_OT_KAPPA * MTA_OT_MBYTES + 2 * MTA_OT_KBYTES) /**< Size in bytes of the client message */
+#define MTA_OT_CB_SIZE (MTA_OT_CHOICE * EGS_SECP256K1)                      /**< Size in bytes of the server message for one product */
+#define MTA_OT_BG_SIZE (EFS_SECP256K1 + 1)                                  /**< Size in bytes of the MTAwc commitment of the server */
+
+#define MTA_OT_MAX_PRODUCTS 4    /**< Maximum number of products served by one extension */
+
+/*! \brief Client setup. Base OT sender and extension receiver */
+typedef struct
+{
+    char y[EGS_SECP256K1];                    /**< Secret of the base OT. Cleared after the setup */
+    char k0[MTA_OT_KAPPA][MTA_OT_KBYTES];     /**< Base OT keys for the choice bit 0 */
+    char k1[MTA_OT_KAPPA][MTA_OT_KBYTES];     /**< Base OT keys for the choice bit 1 */
+    unsign32 counter;                         /**< Number of extensions run */
+} MTA_OT_client;
+
+/*! \brief Server setup. Base OT receiver and extension sender */
+typedef struct
+{
+    char s[MTA_OT_KBYTES];                    /**< Choice bits of the base OT */
+    char ks[MTA_OT_KAPPA][MTA_OT_KBYTES];     /**< Base OT keys for the choice bits */
+    unsign32 counter;                         /**< Number of extensions run */
+    int failed;                               /**< Set by a failed consistency check or by MTA_OT_server_kill */
+} MTA_OT_server;
+
+/*! \brief Secret state of the client between the two passes */
+typedef struct
+{
+    char r[MTA_OT_MBYTES];                    /**< Choice bits */
+    char t[MTA_OT_M][MTA_OT_KBYTES];          /**< Rows of the extension */
+    unsign32 counter;                         /**< Counter of the extension */
+} MTA_OT_client_state;
+
+/* Setup API */
+
+/*! \brief Client setup first pass
+ *
+ *  <ol>
+ *  <li> \f$ y \in_R [0, \ldots, q] \f$
+ *  <li> \f$ S = y.G \f$
+ *  </ol>
+ *
+ *  @param  RNG              Pointer to a cryptographically secure random number generator
+ *  @param  c                Client setup
+ *  @param  S                Message for the server
+ */
+extern void MTA_OT_setup_client1(csprng *RNG, MTA_OT_client *c, octet *S);
+
+/*! \brief Server setup
+ *
+ *  For \f$ i = 1, \ldots, \kappa \f$
+ *
+ *  <ol>
+ *  <li> \f$ s \in_R \{0, 1\}^{\kappa} \f$
+ *  <li> \f$ x_i \in_R [0, \ldots, q] \f$
+ *  <li> \f$ R_i = x_i.G + s_i S \f$
+ *  <li> \f$ k_i = H(i, S, R_i, x_i.S) \f$
+ *  </ol>
+ *
+ *  @param  RNG              Pointer to a cryptographically secure random number generator
+ *  @param  s                Server setup
+ *  @param  S                Message from the client
+ *  @param  R                Message for the client
+ *  @return                  MTA_OT_OK or MTA_OT_INVALID_ECP
+ */
+extern int MTA_OT_setup_server(csprng *RNG, MTA_OT_server *s, octet *S, octet *R);
+
+/*! \brief Client setup second pass
+ *
+ *  For \f$ i = 1, \ldots, \kappa \f$
+ *
+ *  <ol>
+ *  <li> \f$ k^0_i = H(i, S, R_i, y.R_i) \f$
+ *  <li> \f$ k^1_i = H(i, S, R_i, y.(R_i - S)) \f$
+ *  </ol>
+ *
+ *  @param  c                Client setup
+ *  @param  R                Message from the server
+ *  @return                  MTA_OT_OK or MTA_OT_INVALID_ECP
+ */
+extern int MTA_OT_setup_client2(MTA_OT_client *c, octet *R);
+
+/*! \brief Clean the secrets of the client setup
+ *
+ *  @param  c                Client setup
+ */
+extern void MTA_OT_client_kill(MTA_OT_client *c);
+
+/*! \brief Clean the secrets of the server setup
+ *
+ *  The setup can not be used again until MTA_OT_setup_server is run
+ *
+ *  @param  s                Server setup
+ */
+extern void MTA_OT_server_kill(MTA_OT_server *s);
+
+/* MTA protocol API */
+
+/*! \brief Client MTA first pass
+ *
+ *  Extend the oblivious transfers with a random encoding of \f$ a \f$ as choice bits
+ *
+ *  <ol>
+ *  <li> \f$ \gamma \in_R \{0, 1\}^{\xi} \f$ where \f$ \xi \f$ is MTA_OT_GADGET
+ *  <li> \f$ a' = a - \sum_j g_j \gamma_j \text{ }\mathrm{mod}\text{ }q \f$ where \f$ g_j = H(j) \text{ }\mathrm{mod}\text{ }q \f$
+ *  <li> \f$ r = a' || \gamma || \rho \f$ with \f$ \rho \in_R \{0, 1\}^{\kappa} \f$
+ *  <li> \f$ t^i = G(k^0_i), u^i = t^i \oplus G(k^1_i) \oplus r \f$
+ *  <li> \f$ \chi_j = H(u) \f$
+ *  <li> \f$ x = \sum_j r_j \chi_j, t = \sum_j \chi_j t_j \f$ where \f$ t_j \f$ is the j-th row of the matrix \f$ t \f$
+ *  </ol>
+ *
+ *  @param  RNG              Pointer to a cryptographically secure random number generator
+ *  @param  c                Client setup
+ *  @param  A                Multiplicative share of secret
+ *  @param  st               Secret state for MPC_MTA_OT_CLIENT2
+ *  @param  CA               Message for the server, MTA_OT_CA_SIZE bytes
+ */
+extern void MPC_MTA_OT_CLIENT1(csprng *RNG, MTA_OT_client *c, const octet *A, MTA_OT_client_state *st, octet *CA);
+
+/*! \brief Server MTA pass
+ *
+ *  Check the consistency of the extension and send the corrections
+ *  of the correlated oblivious transfers
+ *
+ *  <ol>
+ *  <li> \f$ q^i = G(k_i) \oplus s_i u^i \f$
+ *  <li> \f$ \sum_j \chi_j q_j \stackrel{?}{=} t + x s \f$
+ *  <li> \f$ x^0_j = H(k, j, q_j), \tau_j = x^0_j + b - H(k, j, q_j \oplus s) \f$ where \f$ k \f$ is the index of the product
+ *  <li> \f$ \beta = -\sum_j g_j x^0_j \text{ }\mathrm{mod}\text{ }q \f$ where \f$ g \f$ is the gadget vector
+ *  </ol>
+ *
+ *  If the consistency check fails the server setup is cleared with
+ *  MTA_OT_server_kill and all the later calls fail until a new
+ *  setup is run
+ *
+ *  @param  s                Server setup
+ *  @param  B                Multiplicative share of secret
+ *  @param  CA               Message from the client
+ *  @param  CB               Message for the client, MTA_OT_CB_SIZE bytes
+ *  @param  BETA             Additive share of secret
+ *  @return                  MTA_OT_OK or MTA_OT_FAIL
+ */
+extern int MPC_MTA_OT_SERVER(MTA_OT_server *s, const octet *B, const octet *CA, octet *CB, octet *BETA);
+
+/*! \brief Server MTA pass for several products with the same client share
+ *
+ *  Run MPC_MTA_OT_SERVER for the shares \f$ b_1, \ldots, b_n \f$ on
+ *  a single extension. The rows are hashed with the index of the
+ *  product, so the corrections of each product use independent pads.
+ *  See MPC_MTA_OT_SERVER for the handling of a failed check
+ *
+ *  @param  s                Server setup
+ *  @param  n                Number of products, at most MTA_OT_MAX_PRODUCTS
+ *  @param  B                Multiplicative shares of secret
+ *  @param  CA               Message from the client
+ *  @param  CB               Message for the client, n * MTA_OT_CB_SIZE bytes
+ *  @param  BETA             Additive shares of secret
+ *  @return                  MTA_OT_OK or MTA_OT_FAIL
+ */
+extern int MPC_MTA_OT_SERVER_MULTI(MTA_OT_server *s, int n, octet *B[], const octet *CA, octet *CB, octet *BETA[]);
+
+/*! \brief Client MTA second pass
+ *
+ *  <ol>
+ *  <li> \f$ y_j = H(k, j, t_j) + r_j \tau_j \f$ where \f$ k \f$ is the index of the product
+ *  <li> \f$ \alpha = \sum_j g_j y_j \text{ }\mathrm{mod}\text{ }q \f$ where \f$ g \f$ is the gadget vector
+ *  </ol>
+ *
+ *  The state is cleared, also on failure
+ *
+ *  @param  st               Secret state from MPC_MTA_OT_CLIENT1
+ *  @param  CB               Message from the server, MTA_OT_CB_SIZE bytes
+ *  @param  ALPHA            Additive share of secret
+ *  @return                  MTA_OT_OK or MTA_OT_FAIL if the message has the wrong size
+ */
+extern int MPC_MTA_OT_CLIENT2(MTA_OT_client_state *st, const octet *CB, octet *ALPHA);
+
+/*! \brief Client MTA second pass for several products
+ *
+ *  Run MPC_MTA_OT_CLIENT2 for each product of MPC_MTA_OT_SERVER_MULTI.
+ *  The state is cleared, also on failure
+ *
+ *  @param  st               Secret state from MPC_MTA_OT_CLIENT1
+ *  @param  n                Number of products, as given to the server
+ *  @param  CB               Message from the server, n * MTA_OT_CB_SIZE bytes
+ *  @param  ALPHA            Additive shares of secret
+ *  @return                  MTA_OT_OK or MTA_OT_FAIL if n or the size of the message is wrong
+ */
+extern int MPC_MTA_OT_CLIENT2_MULTI(MTA_OT_client_state *st, int n, const octet *CB, octet *ALPHA[]);
+
+/* MTAwc API */
+
+/*! \brief Server commitment of the MTAwc
+ *
+ *  \f$ B = \beta.G \f$. It does not give the client anything new,
+ *  since an honest client can compute it as \f$ a.W - \alpha.G \f$
+ *
+ *  @param  BETA             Additive share of the server
+ *  @param  BG               Commitment for the client, MTA_OT_BG_SIZE bytes
+ */
+extern void MPC_MTA_OT_WC_COMMIT(octet *BETA, octet *BG);
+
+/*! \brief Client check of the MTAwc
+ *
+ *  Check that the server used the share \f$ b \f$ of \f$ W = b.G \f$
+ *
+ *  <ol>
+ *  <li> \f$ \alpha.G + B \stackrel{?}{=} a.W \f$
+ *  </ol>
+ *
+ *  A failure means that the server cheated and the session must be
+ *  aborted, see the selective failure above
+ *
+ *  @param  A                Multiplicative share of the client
+ *  @param  ALPHA            Additive share of the client
+ *  @param  W                Public ECP of the share of the server
+ *  @param  BG               Commitment from the server
+ *  @return                  MTA_OT_OK, MTA_OT_FAIL or MTA_OT_INVALID_ECP
+ */
+extern int MPC_MTA_OT_WC_VERIFY(octet *A, octet *ALPHA, octet *W, octet *BG);
+
+/*! \brief Clean the secret state of the client
+ *
+ *  @param  st               Secret state
+ */
+extern void MTA_OT_client_state_kill(MTA_OT_client_state *st);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,157 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/**
+ * @file pipeline.h
+ * @brief Dependency graph scheduling of protocol messages declarations
+ *
+ * The protocol of a party is described as a graph of values. A value is
+ * either computed locally by a step or received from a peer. A step runs
+ * as soon as all the values it depends on are available, and its output,
+ * if any, is appended to the frame for its peer. All the messages for the
+ * same peer that are ready at the same time travel in a single frame, so
+ * independent exchanges, e.g. the MTA and MTAwc passes and the NM
+ * commitment of Gamma, overlap and the number of round-trips is the
+ * depth of the graph.
+ *
+ * A frame is a sequence of entries: value identifier in one byte,
+ * length of the message in two bytes, big endian, and the message.
+ */
+
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include "amcl/amcl.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define PIPELINE_OK   0          /**< Execution Successful */
+#define PIPELINE_FAIL 141        /**< Invalid graph or frame */
+
+#define PIPELINE_MAX_VALUES 32   /**< Maximum number of values in a graph */
+#define PIPELINE_MAX_PEERS  8    /**< Maximum number of peers */
+#define PIPELINE_LOCAL      -1   /**< Peer of a step whose output is not sent */
+
+/*! \brief Compute the value of a step
+ *
+ * @param session     Session pointer given to PIPELINE_init
+ * @param id          Identifier of the value computed by the step
+ * @param OUT         Destination message for the peer. NULL for local steps
+ * @return            0 or an error code. The error code is returned by PIPELINE_run
+ */
+typedef int (*PIPELINE_function)(void *session, int id, octet *OUT);
+
+/*! \brief Store a value received from a peer
+ *
+ * @param session     Session pointer given to PIPELINE_init
+ * @param id          Identifier of the value
+ * @param IN          Received message
+ * @return            0 or an error code. The error code is returned by PIPELINE_receive
+ */
+typedef int (*PIPELINE_receiver)(void *session, int id, octet *IN);
+
+/*! \brief Node of the graph */
+typedef struct
+{
+    unsigned long deps;      /**< Bit mask of the values the step depends on */
+    int peer;                /**< Peer receiving the output or PIPELINE_LOCAL. Peer sending the value for inputs */
+    PIPELINE_function f;     /**< Step function. NULL for values received from a peer */
+} PIPELINE_value;
+
+/*! \brief Dependency graph of a party */
+typedef struct
+{
+    void *session;                              /**< Session pointer passed to the callbacks */
+    PIPELINE_receiver recv;                     /**< Function storing received values */
+    int n;                                      /**< Number of values */
+    unsigned long available;                    /**< Bit mask of the available values */
+    PIPELINE_value values[PIPELINE_MAX_VALUES]; /**< Values of the graph */
+} PIPELINE_graph;
+
+/*! \brief Initialise an empty graph
+ *
+ * @param g             Graph to initialise
+ * @param session       Session pointer passed to the callbacks
+ * @param recv          Function storing the values received from the peers
+ */
+extern void PIPELINE_init(PIPELINE_graph *g, void *session, PIPELINE_receiver recv);
+
+/*! \brief Add a value computed locally
+ *
+ * @param g             Graph
+ * @param deps          Bit mask of the values the step depends on
+ * @param peer          Peer receiving the output, in [0, PIPELINE_MAX_PEERS), or PIPELINE_LOCAL
+ * @param f             Step function
+ * @return              Identifier of the value or -1 if the graph is full or the step is not valid
+ */
+extern int PIPELINE_add_step(PIPELINE_graph *g, unsigned long deps, int peer, PIPELINE_function f);
+
+/*! \brief Add a value received from a peer
+ *
+ * The identifier must match the one of the step producing it in the
+ * graph of the peer. The value is only accepted in a frame from peer
+ *
+ * @param g             Graph
+ * @param peer          Peer sending the value, in [0, PIPELINE_MAX_PEERS)
+ * @return              Identifier of the value or -1 if the graph is full or the peer is not valid
+ */
+extern int PIPELINE_add_input(PIPELINE_graph *g, int peer);
+
+/*! \brief Run all the steps whose dependencies are available
+ *
+ * Steps are run until no more progress can be made. The outputs are
+ * appended to the frames of the peers, which must be sent before
+ * waiting for new frames
+ *
+ * @param g             Graph
+ * @param FRAMES        Frames for the peers, indexed by peer. Only the frames for the peers in the graph are used
+ * @return              PIPELINE_OK, PIPELINE_FAIL if a frame is too small or the error code of a step
+ */
+extern int PIPELINE_run(PIPELINE_graph *g, octet *FRAMES[]);
+
+/*! \brief Receive a frame from a peer
+ *
+ * Every value in the frame must be an input of the graph declared
+ * for the sending peer. The whole frame is checked before any value
+ * is passed to the receiver, so a malformed frame does not change the
+ * graph. An error from the receiver stops the delivery and the values
+ * already delivered stay available
+ *
+ * @param g             Graph
+ * @param peer          Peer that sent the frame, as authenticated by the transport
+ * @param FRAME         Received frame
+ * @return              PIPELINE_OK, PIPELINE_FAIL if the frame is malformed or the error code of the receiver
+ */
+extern int PIPELINE_receive(PIPELINE_graph *g, int peer, octet *FRAME);
+
+/*! \brief Check if all the values of the graph are available
+ *
+ * @param g             Graph
+ * @return              1 if the graph is complete, 0 otherwise
+ */
+extern int PIPELINE_done(const PIPELINE_graph *g);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,134 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/**
+ * @file refresh.h
+ * @brief Proactive refresh of the ECDSA key shares declarations
+ *
+ * Each party i splits zero in offsets \f$ \delta_{i,1}, \ldots, \delta_{i,n} \f$,
+ * commits to the public offsets \f$ \Delta_{i,j} = \delta_{i,j}.G \f$ using
+ * the NM commitment scheme and sends \f$ \delta_{i,j} \f$ privately to the
+ * party j. After all the commitments are opened, the party j checks the
+ * offsets it received and updates its share to
+ * \f$ s_j + \sum_i \delta_{i,j} \f$. The ECDSA public key does not change
+ * and the new shares are proven with the Schnorr's Proof of knowledge of
+ * the DLOG of the new public shares.
+ *
+ * The Paillier keys and the BC moduli are not affected by the refresh
+ * and are reused for the new shares.
+ */
+
+#ifndef REFRESH_H
+#define REFRESH_H
+
+#include "amcl/amcl.h"
+#include "amcl/big_256_56.h"
+#include "amcl/ecp_SECP256K1.h"
+#include "amcl/commitments.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define REFRESH_OK          0     /**< Execution Successful */
+#define REFRESH_FAIL        121   /**< Invalid offsets */
+#define REFRESH_INVALID_ECP 122   /**< Input is not a valid point on the curve */
+
+#define REFRESH_MAX_PARTIES 32    /**< Maximum number of parties taking part in a refresh */
+
+/** \brief Generate the offsets for a refresh
+ *
+ *  <ol>
+ *  <li> Choose random \f$ \delta_1, \ldots, \delta_{n-1} \in F_q \f$ where \f$q\f$ is the curve order
+ *  <li> \f$ \delta_n = -\sum_{j<n} \delta_j \text{ }\mathrm{mod}\text{ }q \f$
+ *  <li> \f$ \Delta_j = \delta_j.G \f$
+ *  </ol>
+ *
+ *  @param RNG         csprng for the offsets
+ *  @param n           Number of parties. At most REFRESH_MAX_PARTIES
+ *  @param D           Destination offsets. D[j] must be sent privately to the party j
+ *  @param DG          Destination public offsets. DG[j] is broadcast to all the parties
+ *  @return            REFRESH_OK or REFRESH_FAIL if n is not valid
+ */
+extern int REFRESH_offsets(csprng *RNG, int n, octet *D[], octet *DG[]);
+
+/** \brief Commit to the public offsets
+ *
+ *  The public offsets are concatenated and committed using the NM commitment scheme
+ *
+ *  @param RNG         csprng for the decommitment value
+ *  @param n           Number of parties
+ *  @param DG          Public offsets
+ *  @param R           Decommitment value. If RNG is NULL this value is read
+ *  @param C           Commitment value
+ */
+extern void REFRESH_commit(csprng *RNG, int n, octet *DG[], octet *R, octet *C);
+
+/** \brief Decommit the public offsets of a party
+ *
+ *  <ol>
+ *  <li> Check the NM commitment to the public offsets
+ *  <li> \f$ \sum_j \Delta_j = O \f$ where O is the point at infinity
+ *  </ol>
+ *
+ *  @param n           Number of parties
+ *  @param DG          Public offsets received from the party
+ *  @param R           Received decommitment value
+ *  @param C           Received commitment value
+ *  @return            REFRESH_OK, REFRESH_FAIL or REFRESH_INVALID_ECP
+ */
+extern int REFRESH_decommit(int n, octet *DG[], octet *R, octet *C);
+
+/** \brief Verify an offset received privately
+ *
+ *  @param D           Offset received from the party
+ *  @param DG          Public offset of the party for the receiver
+ *  @return            REFRESH_OK, REFRESH_FAIL if \f$ D.G \neq DG \f$ or REFRESH_INVALID_ECP
+ */
+extern int REFRESH_verify_offset(octet *D, octet *DG);
+
+/** \brief Update the key share
+ *
+ *  \f$ s' = s + \sum_i \delta_i \text{ }\mathrm{mod}\text{ }q \f$
+ *
+ *  @param n           Number of parties
+ *  @param S           Current key share
+ *  @param D           Offsets received from all the parties, including the own one
+ *  @param NS          Destination new key share. It can be the same octet as S
+ */
+extern void REFRESH_update_share(int n, octet *S, octet *D[], octet *NS);
+
+/** \brief Update the public key share of a party
+ *
+ *  \f$ X' = X + \sum_i \Delta_i \f$
+ *
+ *  @param n           Number of parties
+ *  @param X           Current public key share of the party
+ *  @param DG          Public offsets for the party from all the parties
+ *  @param NX          Destination new public key share. It can be the same octet as X
+ *  @return            REFRESH_OK or REFRESH_INVALID_ECP
+ */
+extern int REFRESH_update_public(int n, octet *X, octet *DG[], octet *NX);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -44,6 +44,10 @@ extern "C"
 #define SCHNORR_FAIL	      51  /**< Invalid proof */
 #define SCHNORR_INVALID_ECP 52  /**< Not a valid point on the curve */
 
+#define SCHNORR_BATCH_MAX 64    /**< Maximum number of proofs combined in a single check */
+#define SCHNORR_MSM_WINDOW 5    /**< Default window size for the batch verification */
+#define SCHNORR_MSM_MAX_WINDOW 8 /**< Maximum window size for the batch verification */
+
 /*! \brief Generate random challenge for any Schnorr Proof
  *
  * Generate a random challenge that can be used to make any
@@ -74,6 +78,20 @@ extern void SCHNORR_commit(csprng *RNG, octet *R, octet *C);
  */
 extern void SCHNORR_challenge(const octet *V, const octet *C, const octet *ID, const octet *AD, octet *E);
 
+/*! \brief Generate the challenge for the proof with segmented additional data
+ *
+ * Same as SCHNORR_challenge with AD = AD_1 || ... || AD_n. The
+ * segments are hashed in place.
+ *
+ * @param V     Public ECP of the DLOG. V = x.G. Compressed form
+ * @param C     Public commitment value. Compressed form
+ * @param ID    Prover unique identifier
+ * @param n     Number of segments of the additional data
+ * @param AD    Segments of the additional data to bind in the challenge
+ * @param E     Challenge generated
+ */
+extern void SCHNORR_challenge_v(const octet *V, const octet *C, const octet *ID, int n, octet *AD[], octet *E);
+
 /*! \brief Generate the proof for the given commitment and challenge
  *
  * @param R     Secret value used for the commitment
@@ -93,6 +111,94 @@ extern void SCHNORR_prove(const octet *R, const octet *E, const octet *X, octet
  */
 extern int SCHNORR_verify(octet *V, octet *C, const octet *E, const octet *P);
 
+/*! \brief Verify a batch of proofs of knowledge for the DLOG
+ *
+ * Verify n proofs checking a random linear combination of the
+ * verification equations with a single multi-scalar multiplication
+ *
+ * \f$ \sum_i \rho_i C_i = (\sum_i \rho_i p_i).G + \sum_i (\rho_i e_i).V_i \f$
+ *
+ * The proofs are combined in chunks of at most SCHNORR_BATCH_MAX.
+ * If the batch is invalid, SCHNORR_verify can be used to find the
+ * invalid proofs
+ *
+ * The best window size for the multi-scalar multiplication depends
+ * on the batch size and on the host. The mpc_autotune benchmark can
+ * be used to find it, otherwise use SCHNORR_MSM_WINDOW
+ *
+ * @param RNG   CSPRNG for the random coefficients of the combination
+ * @param w     Window size in bits. Between 1 and SCHNORR_MSM_MAX_WINDOW
+ * @param n     Number of proofs
+ * @param V     Public ECPs of the DLOGs
+ * @param C     Commitment values received from the provers
+ * @param E     Challenges for the Schnorr Proofs
+ * @param P     Proofs received from the provers
+ * @return      SCHNORR_OK if all the proofs are valid or an error code
+ */
+extern int SCHNORR_batch_verify(csprng *RNG, int w, int n, octet *V[], octet *C[], octet *E[], octet *P[]);
+
+/* Multi-statement Schnorr's proofs API */
+
+// The multi-statement Schnorr Proof allows to prove knowledge of
+// x_1, ..., x_m s.t. V_i = x_i.G using a single challenge for all
+// the statements
+
+#define SCHNORR_M_MAX SCHNORR_BATCH_MAX  /**< Maximum number of statements in a proof */
+
+/*! \brief Generate the commitments for the proof
+ *
+ * Generate a commitment \f$ C_i = r_i.G \f$ for each statement
+ *
+ * @param RNG   CSPRNG to use for the commitments
+ * @param m     Number of statements
+ * @param R     Secret values used for the commitments. If RNG is NULL these are read
+ * @param C     Public commitment values. ECPs in compressed form
+ */
+extern void SCHNORR_M_commit(csprng *RNG, int m, octet *R[], octet *C[]);
+
+/*! \brief Generate the challenge for the proof
+ *
+ * Returns H(G, C_1, ..., C_m, V_1, ..., V_m, ID[, AD]). For m = 1
+ * this is the same challenge computed by SCHNORR_challenge
+ *
+ * @param m     Number of statements
+ * @param V     Public ECPs of the DLOGs. V_i = x_i.G. Compressed form
+ * @param C     Public commitment values. Compressed form
+ * @param ID    Prover unique identifier
+ * @param AD    Additional data to bind in the challenge - Optional
+ * @param E     Challenge generated
+ */
+extern void SCHNORR_M_challenge(int m, octet *V[], octet *C[], const octet *ID, const octet *AD, octet *E);
+
+/*! \brief Generate the proof for the given commitments and challenge
+ *
+ * \f$ p_i = r_i - e x_i \text{ }\mathrm{mod}\text{ }q \f$
+ *
+ * @param m     Number of statements
+ * @param R     Secret values used for the commitments
+ * @param E     Challenge received from the verifier
+ * @param X     Secret exponents of the DLOGs. V_i = x_i.G
+ * @param P     Proofs of knowledge of the DLOGs
+ */
+extern void SCHNORR_M_prove(int m, octet *R[], const octet *E, octet *X[], octet *P[]);
+
+/*! \brief Verify the proof of knowledge for the DLOGs
+ *
+ * Check a random linear combination of the verification equations
+ * with a single multi-scalar multiplication
+ *
+ * \f$ \sum_i \rho_i C_i = (\sum_i \rho_i p_i).G + e \sum_i \rho_i.V_i \f$
+ *
+ * @param RNG   CSPRNG for the random coefficients of the combination
+ * @param m     Number of statements. At most SCHNORR_M_MAX
+ * @param V     Public ECPs of the DLOGs. V_i = x_i.G
+ * @param C     Commitment values received from the prover
+ * @param E     Challenge for the proof
+ * @param P     Proofs received from the prover
+ * @return      SCHNORR_OK if the proof is valid or an error code
+ */
+extern int SCHNORR_M_verify(csprng *RNG, int m, octet *V[], octet *C[], octet *E, octet *P[]);
+
 /* Double Schnorr's proofs API */
 
 // The double Schnorr Proof allows to prove knowledge of
@@ -124,6 +230,21 @@ extern int SCHNORR_D_commit(csprng *RNG, octet *R, octet *A, octet *B, octet *C)
  */
 extern void SCHNORR_D_challenge(const octet *R, const octet *V, const octet *C, const octet* ID, const octet *AD, octet *E);
 
+/*! \brief Generate the challenge for the proof with segmented additional data
+ *
+ * Same as SCHNORR_D_challenge with AD = AD_1 || ... || AD_n. The
+ * segments are hashed in place.
+ *
+ * @param R     Public ECP base of the DLOG. Compressed form
+ * @param V     Public ECP result of the DLOG. V = s.R + l.G. Compressed form
+ * @param C     Public commitment value. Compressed form
+ * @param ID    Prover unique identifier
+ * @param n     Number of segments of the additional data
+ * @param AD    Segments of the additional data to bind in the challenge
+ * @param E     Challenge generated
+ */
+extern void SCHNORR_D_challenge_v(const octet *R, const octet *V, const octet *C, const octet *ID, int n, octet *AD[], octet *E);
+
 /*! \brief Generate the proof for the given commitment and challenge
  *
  * @param A     Secret value used for the commitment
@@ -148,6 +269,103 @@ extern void SCHNORR_D_prove(const octet *A, const octet *B, const octet *E, cons
  */
 extern int SCHNORR_D_verify(octet *R, octet *V, octet *C, const octet *E, const octet *T, const octet *U);
 
+/* Phase 5 Schnorr's proofs API */
+
+// The Phase 5 Schnorr Proof allows to prove knowledge of
+// s,l,m s.t. V = s.R + l.G and A = m.G for some R ECP,
+// using a single challenge for both relations
+
+#define SCHNORR_P5_RV_SIZE (3 * SGS_SECP256K1)            /**< Length of the secret values of the commitment */
+#define SCHNORR_P5_C_SIZE  (2 * (SFS_SECP256K1 + 1))      /**< Length of the commitment */
+#define SCHNORR_P5_P_SIZE  (3 * SGS_SECP256K1)            /**< Length of the proof */
+
+/*! \brief Generate a commitment for the proof
+ *
+ * <ol>
+ * <li> \f$ a, b, c \in_R [0, \ldots, q] \f$
+ * <li> \f$ C = (a.R + b.G) || c.G \f$
+ * </ol>
+ *
+ * @param RNG   CSPRNG to use for commitment
+ * @param R     Public ECP base of the DLOG. Compressed form
+ * @param RV    Secret values a || b || c used for the commitment. If RNG is NULL this is read
+ * @param C     Public commitment value. Two ECPs in compressed form
+ * @return      SCHNORR_INVALID_ECP if R is not a valid ECP, SCHNORR_OK otherwise
+ */
+extern int SCHNORR_P5_commit(csprng *RNG, octet *R, octet *RV, octet *C);
+
+/*! \brief Generate the challenge for the proof
+ *
+ * Returns H(G, R, C, V, A, ID[, AD])
+ *
+ * @param R     Public ECP base of the DLOG. Compressed form
+ * @param V     Public ECP V = s.R + l.G. Compressed form
+ * @param A     Public ECP A = m.G. Compressed form
+ * @param C     Public commitment value
+ * @param ID    Prover unique identifier
+ * @param AD    Additional data to bind in the challenge - Optional
+ * @param E     Challenge generated
+ */
+extern void SCHNORR_P5_challenge(const octet *R, const octet *V, const octet *A, const octet *C, const octet *ID, const octet *AD, octet *E);
+
+/*! \brief Generate the proof for the given commitment and challenge
+ *
+ * <ol>
+ * <li> \f$ t = a + e s \text{ }\mathrm{mod}\text{ }q \f$
+ * <li> \f$ u = b + e l \text{ }\mathrm{mod}\text{ }q \f$
+ * <li> \f$ w = c + e m \text{ }\mathrm{mod}\text{ }q \f$
+ * </ol>
+ *
+ * @param RV    Secret values used for the commitment
+ * @param E     Challenge received from the verifier
+ * @param S     Secret exponent s. V = s.R + l.G
+ * @param L     Secret exponent l. V = s.R + l.G
+ * @param M     Secret exponent m. A = m.G
+ * @param P     Proof t || u || w
+ */
+extern void SCHNORR_P5_prove(const octet *RV, const octet *E, const octet *S, const octet *L, const octet *M, octet *P);
+
+/*! \brief Verify the proof
+ *
+ * <ol>
+ * <li> \f$ t.R + u.G \stackrel{?}{=} C_1 + e.V \f$
+ * <li> \f$ w.G \stackrel{?}{=} C_2 + e.A \f$
+ * </ol>
+ *
+ * @param R     Public ECP base of the DLOG. Compressed form
+ * @param V     Public ECP V = s.R + l.G. Compressed form
+ * @param A     Public ECP A = m.G. Compressed form
+ * @param C     Commitment value received from the prover
+ * @param E     Challenge for the proof
+ * @param P     Proof received from the prover
+ * @return      SCHNORR_OK if the proof is valid or an error code
+ */
+extern int SCHNORR_P5_verify(octet *R, octet *V, octet *A, octet *C, const octet *E, const octet *P);
+
+/*! \brief Verify the proofs of n players for the same R
+ *
+ * Check a random linear combination of all the verification equations
+ * with a single multi-scalar multiplication. The coefficients for R and
+ * G are accumulated, so the equation has 4n + 2 terms
+ *
+ * \f$ \sum_i \rho_i (t_i.R + u_i.G - e_i.V_i - C_{1,i}) + \sigma_i (w_i.G - e_i.A_i - C_{2,i}) \stackrel{?}{=} O \f$
+ *
+ * The proofs are combined in chunks of at most SCHNORR_BATCH_MAX.
+ * If the batch is invalid, SCHNORR_P5_verify can be used to find the
+ * invalid proofs
+ *
+ * @param RNG   CSPRNG for the random coefficients of the combination
+ * @param n     Number of proofs
+ * @param R     Public ECP base of the DLOG, common to all the proofs
+ * @param V     Public ECPs V of the players
+ * @param A     Public ECPs A of the players
+ * @param C     Commitment values received from the players
+ * @param E     Challenges for the proofs
+ * @param P     Proofs received from the players
+ * @return      SCHNORR_OK if all the proofs are valid or an error code
+ */
+extern int SCHNORR_P5_batch_verify(csprng *RNG, int n, octet *R, octet *V[], octet *A[], octet *C[], octet *E[], octet *P[]);
+
 #ifdef __cplusplus
 }
 #endif
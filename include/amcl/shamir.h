@@ -0,0 +1,148 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/**
+ * @file shamir.h
+ * @brief Shamir secret sharing for t-of-n signing declarations
+ *
+ */
+
+#ifndef SHAMIR_H
+#define SHAMIR_H
+
+#include "amcl/amcl.h"
+#include "amcl/big_256_56.h"
+#include "amcl/ecp_SECP256K1.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define SHAMIR_OK          0     /**< Execution Successful */
+#define SHAMIR_FAIL        111   /**< Invalid signer subset */
+#define SHAMIR_INVALID_ECP 112   /**< Input is not a valid point on the curve */
+
+#define SHAMIR_MAX_PARTIES 32    /**< Maximum number of parties. Party identifiers are in [1, SHAMIR_MAX_PARTIES] */
+#define SHAMIR_CACHE_SIZE  16    /**< Number of signer subsets kept in a cache */
+
+/*! \brief Lagrange coefficients for a signer subset
+ *
+ * A signer with identifier i and Shamir share \f$ s_i \f$ holds the additive
+ * share \f$ \lambda_i s_i \f$ of the secret for the subset, with public
+ * share \f$ \lambda_i X_i \f$ where \f$ X_i = s_i.G \f$
+ */
+typedef struct
+{
+    int n;                                   /**< Number of signers in the subset */
+    unsigned long mask;                      /**< Bit i-1 is set if the signer i is in the subset */
+    int ids[SHAMIR_MAX_PARTIES];             /**< Identifiers of the signers */
+    BIG_256_56 lambda[SHAMIR_MAX_PARTIES];   /**< Lagrange coefficients at 0 */
+    ECP_SECP256K1 LX[SHAMIR_MAX_PARTIES];    /**< Public additive shares \f$ \lambda_i X_i \f$ */
+    int has_pk;                              /**< 1 if LX has been computed from the public shares */
+} SHAMIR_subset;
+
+/*! \brief Cache of signer subsets for a shared key */
+typedef struct
+{
+    int n;                                   /**< Number of subsets in the cache */
+    int next;                                /**< Next subset to evict when the cache is full */
+    SHAMIR_subset subsets[SHAMIR_CACHE_SIZE]; /**< Cached subsets */
+} SHAMIR_cache;
+
+/** \brief Split a secret in Shamir shares
+ *
+ *  <ol>
+ *  <li> Choose random \f$ a_1, \ldots, a_{t-1} \in F_q \f$ where \f$q\f$ is the curve order
+ *  <li> \f$ s_i = s + a_1 i + \ldots + a_{t-1} i^{t-1} \text{ }\mathrm{mod}\text{ }q \f$ for \f$ i = 1, \ldots, n \f$
+ *  </ol>
+ *
+ *  @param RNG         csprng for the polynomial coefficients
+ *  @param t           Threshold. Any t shares recover the secret
+ *  @param n           Number of shares. At most SHAMIR_MAX_PARTIES
+ *  @param S           Secret to share
+ *  @param SHARES      Destination shares. SHARES[i] is the share of the party i+1
+ *  @return            SHAMIR_OK or SHAMIR_FAIL if t and n are not valid
+ */
+extern int SHAMIR_make_shares(csprng *RNG, int t, int n, const octet *S, octet *SHARES[]);
+
+/** \brief Compute the Lagrange coefficients for a signer subset
+ *
+ *  <ol>
+ *  <li> \f$ \lambda_i = \prod_{j \neq i} \frac{j}{j - i} \text{ }\mathrm{mod}\text{ }q \f$
+ *  <li> \f$ LX_i = \lambda_i X_i \f$
+ *  </ol>
+ *
+ *  The denominators are inverted together with a single modular inversion.
+ *
+ *  @param L           Destination subset
+ *  @param n           Number of signers
+ *  @param ids         Identifiers of the signers, distinct and in [1, SHAMIR_MAX_PARTIES]
+ *  @param X           Public shares of the signers \f$ X_i = s_i.G \f$. Optional
+ *  @return            SHAMIR_OK, SHAMIR_FAIL for invalid identifiers or SHAMIR_INVALID_ECP
+ */
+extern int SHAMIR_subset_init(SHAMIR_subset *L, int n, const int ids[], octet *X[]);
+
+/** \brief Convert a Shamir share to an additive share for a subset
+ *
+ *  @param L           Signer subset
+ *  @param id          Identifier of the signer
+ *  @param SHARE       Shamir share of the signer
+ *  @param SK          Destination additive share \f$ \lambda_i s_i \f$
+ *  @return            SHAMIR_OK or SHAMIR_FAIL if the signer is not in the subset
+ */
+extern int SHAMIR_to_additive(const SHAMIR_subset *L, int id, const octet *SHARE, octet *SK);
+
+/** \brief Output the public additive share of a signer
+ *
+ *  The public additive shares can be combined with MPC_SUM_PK
+ *
+ *  @param L           Signer subset initialised with the public shares
+ *  @param id          Identifier of the signer
+ *  @param PK          Destination public additive share \f$ \lambda_i X_i \f$
+ *  @return            SHAMIR_OK or SHAMIR_FAIL if the signer is not in the subset
+ */
+extern int SHAMIR_additive_pk(SHAMIR_subset *L, int id, octet *PK);
+
+/** \brief Initialise an empty cache
+ *
+ *  @param c           Cache to initialise
+ */
+extern void SHAMIR_cache_init(SHAMIR_cache *c);
+
+/** \brief Get the subset for a set of signers
+ *
+ *  Look up the subset in the cache and compute it with SHAMIR_subset_init
+ *  if it is not there, evicting the oldest subset if the cache is full.
+ *  The order of the identifiers is not relevant
+ *
+ *  @param c           Cache of subsets for the shared key
+ *  @param n           Number of signers
+ *  @param ids         Identifiers of the signers
+ *  @param X           Public shares of the signers. Optional
+ *  @param L           Pointer to the subset in the cache. Valid until the next call
+ *  @return            SHAMIR_OK or the error returned by SHAMIR_subset_init
+ */
+extern int SHAMIR_cache_get(SHAMIR_cache *c, int n, const int ids[], octet *X[], SHAMIR_subset **L);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,85 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/**
+ * @file tuning.h
+ * @brief Host tuning profile declarations
+ *
+ */
+
+#ifndef TUNING_H
+#define TUNING_H
+
+#include "amcl/schnorr.h"
+#include "amcl/batch.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define TUNING_OK   0     /**< Profile successfully processed */
+#define TUNING_FAIL 101   /**< Invalid or unreadable profile */
+
+/*! \brief Tunable parameters of the library
+ *
+ * The profile for a host can be generated with the mpc_autotune
+ * benchmark and it is stored as lines of the form NAME = value.
+ * The library keeps no copy of the profile, the values are passed
+ * by the caller to BATCH_init or SCHNORR_batch_verify
+ *
+ * Only the Schnorr's Proof batch verification is tunable. The
+ * Paillier, MTA and SECP256K1 exponentiations use the fixed windows
+ * of the AMCL primitives, so they have no parameter in the profile
+ */
+typedef struct
+{
+    int schnorr_msm_window;    /**< Window size for SCHNORR_batch_verify */
+    int batch_flush_size;      /**< Queue size triggering the verification in the scheduler */
+} TUNING_profile;
+
+/*! \brief Fill a profile with the default parameters
+ *
+ * @param t     Destination profile
+ */
+extern void TUNING_default(TUNING_profile *t);
+
+/*! \brief Read a profile from a file
+ *
+ * Unknown parameters are ignored and missing parameters keep their value
+ *
+ * @param t     Destination profile
+ * @param path  Path of the profile file
+ * @return      TUNING_OK if the file was read and all the parameters are valid, TUNING_FAIL otherwise
+ */
+extern int TUNING_load(TUNING_profile *t, const char *path);
+
+/*! \brief Write a profile to a file
+ *
+ * @param t     Profile to write
+ * @param path  Path of the profile file
+ * @return      TUNING_OK if the file was written, TUNING_FAIL otherwise
+ */
+extern int TUNING_save(const TUNING_profile *t, const char *path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
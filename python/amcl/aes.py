@@ -24,26 +24,52 @@ This module use cffi to access the c functions for the amcl AES-GCM.
 """
 
 from . import core_utils
-import platform
 
 _ffi = core_utils._ffi
-_ffi.cdef("""
+core_utils.cdef("""
+typedef struct
+{
+    int Nk;
+    int Nr;
+    int mode;
+    unsigned int fkey[60];
+    unsigned int rkey[60];
+    char f[16];
+} amcl_aes;
+
+typedef struct
+{
+    unsigned int table[128][4];
+    unsigned char stateX[16];
+    unsigned char Y_0[16];
+    unsigned int lenA[2];
+    unsigned int lenC[2];
+    int status;
+    amcl_aes a;
+} gcm;
+
 extern void AES_GCM_ENCRYPT(octet *K,octet *IV,octet *H,octet *P,octet *C,octet *T);
 extern void AES_GCM_DECRYPT(octet *K,octet *IV,octet *H,octet *C,octet *P,octet *T);
+
+extern void GCM_init(gcm *G,int nk,char *K,int n,char *IV);
+extern int GCM_add_header(gcm *G,char *H,int n);
+extern int GCM_add_plain(gcm *G,char *C,char *P,int n);
+extern int GCM_add_cipher(gcm *G,char *P,char *C,int n);
+extern void GCM_finish(gcm *G,char *T);
+
+extern void GCM_BATCH_encrypt(octet *K, int n, octet *IV[], octet *H[], octet *P[], octet *C[], octet *T[]);
+extern void GCM_BATCH_decrypt(octet *K, int n, octet *IV[], octet *H[], octet *C[], octet *P[], octet *T[]);
 """)
 
-if (platform.system() == 'Windows'):
-    _libamcl_core = _ffi.dlopen("libamcl_core.dll")
-elif (platform.system() == 'Darwin'):
-    _libamcl_core = _ffi.dlopen("libamcl_core.dylib")
-else:
-    _libamcl_core = _ffi.dlopen("libamcl_core.so")
+_libamcl_core = core_utils.dlopen("amcl_core")
+_libamcl_mpc = core_utils.dlopen("amcl_mpc")
 
 
 # Constants
 KEYL = 16 # Length in bytes of an AES key
 TAGL = 16 # Length in bytes of tag
 IVL = 12 # Length in bytes of IV
+BLOCKL = 16 # Length in bytes of an AES block
 
 
 def gcm_encrypt(aes_key, iv, header, plaintext):
@@ -144,3 +170,259 @@ def gcm_decrypt(aes_key, iv, header, ciphertext):
     core_utils.clear_octet(ciphertext1)
 
     return plaintext, tag
+
+
+class _GcmStream:
+    """AES-GCM stream
+
+    Common code for GcmEncryptor and GcmDecryptor. The data is
+    processed in whole AES blocks, a partial block is kept until more
+    data is available or the stream is finalized
+    """
+
+    def __init__(self, aes_key, iv, header=None):
+        self._gcm = _ffi.new("gcm*")
+        self._pending = b''
+        self.tag = None
+
+        key = _ffi.from_buffer(aes_key)
+        iv1 = _ffi.from_buffer(iv)
+        _libamcl_core.GCM_init(self._gcm, len(key), key, len(iv1), iv1)
+
+        if header:
+            header1 = _ffi.from_buffer(header)
+            _libamcl_core.GCM_add_header(self._gcm, header1, len(header1))
+
+    def _process(self, dst, src, n):
+        raise NotImplementedError
+
+    def output_length(self, n):
+        """Number of bytes output by update for n bytes of input"""
+        total = len(self._pending) + n
+        return total - total % BLOCKL
+
+    def update_into(self, data, out):
+        """Process data, writing the output into out
+
+        No copy is made of data and out, except for the partial blocks
+
+        Args::
+
+            data: Input. Object supporting the buffer protocol
+            out: Output. Writable object supporting the buffer protocol,
+                 at least output_length(len(data)) bytes and not overlapping
+                 with data
+
+        Returns::
+
+            n: Number of bytes written in out
+
+        Raises:
+
+            ValueError: the stream is finalized or out is too small
+        """
+        if self._gcm is None:
+            raise ValueError("stream already finalized")
+
+        src = _ffi.from_buffer(data)
+        dst = _ffi.from_buffer(out, require_writable=True)
+        n = len(src)
+
+        if len(dst) < self.output_length(n):
+            raise ValueError("output buffer too small")
+
+        used = 0
+        written = 0
+
+        # Complete the pending block first
+        if self._pending:
+            used = min(BLOCKL - len(self._pending), n)
+            self._pending += _ffi.buffer(src, used)[:]
+
+            if len(self._pending) < BLOCKL:
+                return 0
+
+            self._process(dst, _ffi.from_buffer(self._pending), BLOCKL)
+            self._pending = b''
+            written = BLOCKL
+
+        full = (n - used) - (n - used) % BLOCKL
+        if full:
+            self._process(dst + written, src + used, full)
+            written += full
+
+        self._pending = _ffi.buffer(src + used + full, n - used - full)[:]
+
+        return written
+
+    def update(self, data):
+        """Process data
+
+        Args::
+
+            data: Input. Object supporting the buffer protocol
+
+        Returns::
+
+            out: Output for all the whole blocks processed so far
+
+        Raises:
+
+            ValueError: the stream is finalized
+        """
+        out = bytearray(self.output_length(memoryview(data).nbytes))
+        self.update_into(data, out)
+
+        return bytes(out)
+
+    def finalize(self):
+        """Process the last partial block and compute the tag
+
+        The internal state, including the expanded key, is cleared
+
+        Returns::
+
+            out: Output for the last partial block
+            tag: Authentication tag. Also available as the tag attribute
+
+        Raises:
+
+            ValueError: the stream is finalized
+        """
+        if self._gcm is None:
+            raise ValueError("stream already finalized")
+
+        out = bytearray(len(self._pending))
+        if self._pending:
+            self._process(_ffi.from_buffer(out, require_writable=True), _ffi.from_buffer(self._pending), len(self._pending))
+
+        tag1 = _ffi.new("char []", TAGL)
+        _libamcl_core.GCM_finish(self._gcm, tag1)
+        self.tag = _ffi.buffer(tag1, TAGL)[:]
+
+        # Clear memory
+        _ffi.buffer(self._gcm)[:] = bytes(_ffi.sizeof("gcm"))
+        self._gcm = None
+        self._pending = b''
+
+        return bytes(out), self.tag
+
+
+class GcmEncryptor(_GcmStream):
+    """Streaming AES-GCM Encryption
+
+    Produces the same ciphertext and tag as gcm_encrypt on the
+    concatenation of the data passed to update
+
+    Args::
+
+        aes_key: AES Key
+        iv: Initialization vector
+        header: header. Optional
+    """
+
+    def _process(self, dst, src, n):
+        _libamcl_core.GCM_add_plain(self._gcm, dst, src, n)
+
+
+class GcmDecryptor(_GcmStream):
+    """Streaming AES-GCM Decryption
+
+    Produces the same plaintext and tag as gcm_decrypt on the
+    concatenation of the data passed to update. The plaintext is
+    output before the tag is available, the caller must discard it
+    if the tag returned by finalize does not match
+
+    Args::
+
+        aes_key: AES Key
+        iv: Initialization vector
+        header: header. Optional
+    """
+
+    def _process(self, dst, src, n):
+        _libamcl_core.GCM_add_cipher(self._gcm, dst, src, n)
+
+
+def _gcm_batch(batch, aes_key, ivs, headers, inputs):
+    """Encrypt or decrypt a batch of records in a single C call"""
+    n = len(inputs)
+
+    lengths = [memoryview(x).nbytes for x in inputs]
+
+    # Outputs are views into a single buffer
+    out_buf = memoryview(bytearray(sum(lengths)))
+    tag_buf = memoryview(bytearray(n * TAGL))
+
+    outs = []
+    offset = 0
+    for length in lengths:
+        outs.append(out_buf[offset:offset + length])
+        offset += length
+
+    tags = [tag_buf[i * TAGL:(i + 1) * TAGL] for i in range(n)]
+
+    aes_key1, aes_key1_val = core_utils.buffer_octet(aes_key)
+    iv1, iv1_refs = core_utils.buffer_octet_array(ivs)
+    in1, in1_refs = core_utils.buffer_octet_array(inputs)
+    out1, out1_refs = core_utils.buffer_octet_array(outs, writable=True)
+    tag1, tag1_refs = core_utils.buffer_octet_array(tags, writable=True)
+
+    if headers is None:
+        header1, header1_refs = _ffi.NULL, None
+    else:
+        header1, header1_refs = core_utils.buffer_octet_array(headers)
+
+    _ = aes_key1_val, iv1_refs, in1_refs, out1_refs, tag1_refs, header1_refs # Suppress warnings
+
+    batch(aes_key1, n, iv1, header1, in1, out1, tag1)
+
+    return outs, tags
+
+
+def gcm_encrypt_batch(aes_key, ivs, headers, plaintexts):
+    """AES-GCM Encryption of many records under the same key
+
+    Each record is encrypted as with gcm_encrypt. The inputs are read
+    without copies and the outputs are views into a single buffer
+
+    Args::
+
+        aes_key: AES Key
+        ivs: Initialization vectors. Must be unique for each record
+        headers: headers. Optional
+        plaintexts: Plaintexts to be encrypted
+
+    Returns::
+
+        ciphertexts: list of memoryview of the ciphertexts
+        tags: list of memoryview of the MACs
+
+    Raises:
+
+    """
+    return _gcm_batch(_libamcl_mpc.GCM_BATCH_encrypt, aes_key, ivs, headers, plaintexts)
+
+
+def gcm_decrypt_batch(aes_key, ivs, headers, ciphertexts):
+    """AES-GCM Decryption of many records under the same key
+
+    Each record is decrypted as with gcm_decrypt. The inputs are read
+    without copies and the outputs are views into a single buffer
+
+    Args::
+
+        aes_key: AES Key
+        ivs: Initialization vectors
+        headers: headers. Optional
+        ciphertexts: ciphertexts
+
+    Returns::
+
+        plaintexts: list of memoryview of the plaintexts
+        tags: list of memoryview of the MACs
+
+    Raises:
+
+    """
+    return _gcm_batch(_libamcl_mpc.GCM_BATCH_decrypt, aes_key, ivs, headers, ciphertexts)
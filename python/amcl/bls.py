@@ -29,24 +29,24 @@ There is also an example usage program in this file.
 
 """
 
-import platform
 from . import core_utils
 
 _ffi = core_utils._ffi
-_ffi.cdef("""
+core_utils.cdef("""
 extern int BLS_BLS381_KEY_PAIR_GENERATE(csprng *RNG,octet* S,octet *W);
 extern int BLS_BLS381_SIGN(octet *SIG,octet *m,octet *S);
 extern int BLS_BLS381_VERIFY(octet *SIG,octet *m,octet *W);
 extern int BLS_BLS381_ADD_G1(octet *R1,octet *R2,octet *R);
 extern int BLS_BLS381_ADD_G2(octet *W1,octet *W2,octet *W);
+
+extern int BLS_BATCH_aggregate_G1(int n, octet *P[], octet *R);
+extern int BLS_BATCH_aggregate_G2(int n, octet *W[], octet *R);
+extern int BLS_BATCH_verify_aggregate(octet *SIG, int n, octet *M[], octet *W[]);
+extern int BLS_BATCH_verify(csprng *RNG, int n, octet *SIG[], octet *M[], octet *W[]);
 """)
 
-if (platform.system() == 'Windows'):
-    _libamcl_bls_BLS381 = _ffi.dlopen("libamcl_bls_BLS381.dll")
-elif (platform.system() == 'Darwin'):
-    _libamcl_bls_BLS381 = _ffi.dlopen("libamcl_bls_BLS381.dylib")
-else:
-    _libamcl_bls_BLS381 = _ffi.dlopen("libamcl_bls_BLS381.so")
+_libamcl_bls_BLS381 = core_utils.dlopen("amcl_bls_BLS381")
+_libamcl_mpc = core_utils.dlopen("amcl_mpc")
 
 # Group Size
 BGS = 48
@@ -232,3 +232,115 @@ def add_G2(R1, R2):
 
     return error_code, R
 
+
+def aggregate_G1(points):
+    """Aggregate a list of members of the group G1
+
+    Sum all the points in a single C call
+
+    Args::
+
+        points: list of members of G1, e.g. signatures
+
+    Returns::
+
+        error_code: Zero for success or else an error code
+        R:          member of G1. R = sum of the points
+
+    Raises:
+
+    """
+    P, P_refs = core_utils.buffer_octet_array(points)
+    R1, R1_val = core_utils.make_octet(G1LEN)
+
+    error_code = _libamcl_mpc.BLS_BATCH_aggregate_G1(len(points), P, R1)
+
+    R = core_utils.to_str(R1)
+
+    return error_code, R
+
+
+def aggregate_G2(points):
+    """Aggregate a list of members of the group G2
+
+    Sum all the points in a single C call
+
+    Args::
+
+        points: list of members of G2, e.g. public keys
+
+    Returns::
+
+        error_code: Zero for success or else an error code
+        R:          member of G2. R = sum of the points
+
+    Raises:
+
+    """
+    W, W_refs = core_utils.buffer_octet_array(points)
+    R1, R1_val = core_utils.make_octet(G2LEN)
+
+    error_code = _libamcl_mpc.BLS_BATCH_aggregate_G2(len(points), W, R1)
+
+    R = core_utils.to_str(R1)
+
+    return error_code, R
+
+
+def verify_aggregate(signature, messages, pks):
+    """Verify an aggregated signature on many messages
+
+    Check the signature with a single multi-pairing. The messages
+    must be distinct, unless the public keys come with a proof of
+    possession of the secret key
+
+    Args::
+
+        signature: aggregated BLS signature
+        messages:  list of signed messages
+        pks:       list of BLS public keys of the signers
+
+    Returns::
+
+        error_code: Zero for success or else an error code
+
+    Raises:
+
+    """
+    assert len(messages) == len(pks), "messages and pks must have the same length"
+
+    sig1, sig1_val = core_utils.make_octet(None, signature)
+    M, M_refs = core_utils.buffer_octet_array(messages)
+    W, W_refs = core_utils.buffer_octet_array(pks)
+
+    return _libamcl_mpc.BLS_BATCH_verify_aggregate(sig1, len(messages), M, W)
+
+
+def verify_batch(rng, signatures, messages, pks):
+    """Verify many signatures at once
+
+    Check a random linear combination of the signatures with a
+    single multi-pairing. If the batch is invalid, verify can be
+    used to find the invalid signatures
+
+    Args::
+
+        rng:        Pointer to cryptographically secure pseudo-random number generator instance
+        signatures: list of BLS signatures
+        messages:   list of signed messages
+        pks:        list of BLS public keys of the signers
+
+    Returns::
+
+        error_code: Zero for success or else an error code
+
+    Raises:
+
+    """
+    assert len(signatures) == len(messages) == len(pks), "signatures, messages and pks must have the same length"
+
+    SIG, SIG_refs = core_utils.buffer_octet_array(signatures)
+    M, M_refs = core_utils.buffer_octet_array(messages)
+    W, W_refs = core_utils.buffer_octet_array(pks)
+
+    return _libamcl_mpc.BLS_BATCH_verify(rng, len(signatures), SIG, M, W)
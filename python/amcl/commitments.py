@@ -25,21 +25,15 @@ This module use cffi to access the c functions in the amcl_mpc library.
 
 """
 
-import platform
 from . import core_utils
 
 _ffi = core_utils._ffi
-_ffi.cdef("""
+core_utils.cdef("""
 extern void COMMITMENTS_NM_commit(csprng *RNG, const octet *X, octet *R, octet *C);
 extern int COMMITMENTS_NM_decommit(const octet* X, const octet* R, octet* C);
 """)
 
-if (platform.system() == 'Windows'):
-    _libamcl_mpc = _ffi.dlopen("libamcl_mpc.dll")
-elif (platform.system() == 'Darwin'):
-    _libamcl_mpc = _ffi.dlopen("libamcl_mpc.dylib")
-else:
-    _libamcl_mpc = _ffi.dlopen("libamcl_mpc.so")
+_libamcl_mpc = core_utils.dlopen("amcl_mpc")
 
 # Constants
 SHA256 = 32
@@ -21,15 +21,70 @@ under the License.
 
 This module use cffi to access the c functions in the amcl_core library.
 
+The wrapper uses the compiled cffi extension _amcl_cffi when it has been
+built (API mode) and falls back to loading the shared libraries at
+runtime (ABI mode) otherwise.
+
 """
 
 import cffi
 import platform
+import threading
+
+try:
+    from ._amcl_cffi import ffi as _ffi, lib as _lib
+except ImportError:
+    _ffi = cffi.FFI()
+    _lib = None
+
+
+def cdef(source):
+    """Declare C types and functions
+
+    The declarations are only parsed in ABI mode. The compiled
+    extension is generated from the same declarations at build time
+
+    Args::
+
+        source: C declarations
+
+    Returns::
+
+    Raises:
+
+    """
+    if _lib is None:
+        _ffi.cdef(source)
+
+
+def dlopen(name):
+    """Load an amcl library
+
+    Args::
+
+        name: Name of the library without prefix and suffix, e.g. amcl_mpc
+
+    Returns::
+
+        lib: The compiled extension in API mode, the loaded library otherwise
+
+    Raises:
+
+    """
+    if _lib is not None:
+        return _lib
+
+    if (platform.system() == 'Windows'):
+        return _ffi.dlopen("lib%s.dll" % name)
+    elif (platform.system() == 'Darwin'):
+        return _ffi.dlopen("lib%s.dylib" % name)
+    else:
+        return _ffi.dlopen("lib%s.so" % name)
+
 
-_ffi = cffi.FFI()
-_ffi.cdef("""
-typedef long unsigned int BIG_512_60[9];
-typedef long unsigned int BIG_1024_58[18];
+cdef("""
+typedef int64_t BIG_512_60[9];
+typedef int64_t BIG_1024_58[18];
 
 typedef struct {
 unsigned int ira[21];  /* random number...   */
@@ -52,18 +107,13 @@ extern void OCT_clear(octet *O);
 extern void generateRandom(csprng* RNG, octet* randomValue);
 """)
 
-if (platform.system() == 'Windows'):
-    _libamcl_core = _ffi.dlopen("libamcl_core.dll")
-elif (platform.system() == 'Darwin'):
-    _libamcl_core = _ffi.dlopen("libamcl_core.dylib")
-else:
-    _libamcl_core = _ffi.dlopen("libamcl_core.so")
+_libamcl_core = dlopen("amcl_core")
 
 
 def to_str(octet_value):
     """Converts an octet type into a string
 
-    Add all the values in an octet into an array.
+    Copy the value of the octet with a single buffer copy.
 
     Args::
 
@@ -76,15 +126,7 @@ def to_str(octet_value):
     Raises:
         Exception
     """
-    i = 0
-    val = []
-    while i < octet_value.len:
-        val.append(octet_value.val[i])
-        i = i + 1
-    out = b''
-    for x in val:
-        out = out + x
-    return out
+    return _ffi.buffer(octet_value.val, octet_value.len)[:]
 
 
 def make_octet(length, value=None):
@@ -105,20 +147,162 @@ def make_octet(length, value=None):
     Raises:
 
     """
-    oct_ptr = _ffi.new("octet*")
     if value:
-        val = _ffi.new("char [%s]" % len(value), value)
-        oct_ptr.val = val
-        oct_ptr.max = len(value)
-        oct_ptr.len = len(value)
+        length = len(value)
+        val = _ffi.new("char []", value)
     else:
         val = _ffi.new("char []", length)
-        oct_ptr.val = val
-        oct_ptr.max = length
-        oct_ptr.len = length
+
+    oct_ptr = _ffi.new("octet*", {'len': length, 'max': length, 'val': val})
+
     return oct_ptr, val
 
 
+def buffer_octet(value, writable=False):
+    """Generates an octet pointing to the memory of a buffer object
+
+    No copy is made. The octet is only valid while the buffer object
+    is alive and it is not resized
+
+    Args::
+
+        value:    Object supporting the buffer protocol, e.g. bytes or memoryview
+        writable: Require a writable buffer, for output octets
+
+    Returns::
+
+        oct_ptr: octet pointer
+        val: data associated with octet to prevent garbage collection
+
+    Raises:
+
+    """
+    val = _ffi.from_buffer(value, require_writable=writable)
+    oct_ptr = _ffi.new("octet*", {'len': len(val), 'max': len(val), 'val': val})
+
+    return oct_ptr, val
+
+
+def buffer_octet_array(values, writable=False):
+    """Generates an array of octets pointing to the memory of buffer objects
+
+    No copy is made, see buffer_octet
+
+    Args::
+
+        values:   List of objects supporting the buffer protocol
+        writable: Require writable buffers, for output octets
+
+    Returns::
+
+        octets: array of octet pointers
+        refs: data associated with octets to prevent garbage collection
+
+    Raises:
+
+    """
+    n = len(values)
+    octets = _ffi.new("octet[]", n)
+    ptrs = _ffi.new("octet*[]", n)
+    vals = []
+
+    for i, value in enumerate(values):
+        val = _ffi.from_buffer(value, require_writable=writable)
+        octets[i].len = len(val)
+        octets[i].max = len(val)
+        octets[i].val = val
+        ptrs[i] = octets + i
+        vals.append(val)
+
+    return ptrs, (octets, vals)
+
+
+class OctetPool:
+    """Pool of reusable octets
+
+    Octets are grouped by size and zeroed when they are released, so
+    they can be used for secret values. A pool must not be shared
+    between threads, use octet_pool to get the pool of the current thread
+    """
+
+    def __init__(self):
+        self._free = {}
+
+    def get(self, length, value=None):
+        """Get an octet from the pool
+
+        Same as make_octet, but reuse a released octet of the same size
+        when available
+
+        Args::
+
+            length: Length of empty octet
+            value:  Data to assign to octet
+
+        Returns::
+
+            oct_ptr: octet pointer
+            val: data associated with octet to prevent garbage collection
+
+        Raises:
+
+        """
+        if value:
+            length = len(value)
+
+        free = self._free.get(length)
+        if free:
+            oct_ptr, val = free.pop()
+            oct_ptr.len = length
+        else:
+            val = _ffi.new("char []", length)
+            oct_ptr = _ffi.new("octet*", {'len': length, 'max': length, 'val': val})
+
+        if value:
+            _ffi.memmove(val, value, length)
+
+        return oct_ptr, val
+
+    def release(self, *octets):
+        """Clear octets and return them to the pool
+
+        Args::
+
+            octets: (oct_ptr, val) pairs returned by get
+
+        Returns::
+
+        Raises:
+
+        """
+        for oct_ptr, val in octets:
+            _libamcl_core.OCT_clear(oct_ptr)
+            self._free.setdefault(oct_ptr.max, []).append((oct_ptr, val))
+
+
+_pools = threading.local()
+
+
+def octet_pool():
+    """Get the octet pool of the current thread
+
+    Args::
+
+    Returns::
+
+        pool: OctetPool of the current thread
+
+    Raises:
+
+    """
+    pool = getattr(_pools, "pool", None)
+    if pool is None:
+        pool = OctetPool()
+        _pools.pool = pool
+
+    return pool
+
+
 def clear_octet(octet):
     """ Clear an octet
 
@@ -151,7 +335,7 @@ def create_csprng(seed):
     Raises:
 
     """
-    seed_val = _ffi.new("char [%s]" % len(seed), seed)
+    seed_val = _ffi.new("char []", seed)
     seed_len = len(seed)
 
     # random number generator
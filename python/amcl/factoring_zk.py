@@ -23,11 +23,10 @@ This module use cffi to access the c functions in the amcl_mpc library.
 
 """
 
-import platform
 from . import core_utils
 
 _ffi = core_utils._ffi
-_ffi.cdef("""
+core_utils.cdef("""
 typedef struct
 {
     BIG_1024_58 p[1];
@@ -42,15 +41,8 @@ void FACTORING_ZK_modulus_fromOctets(FACTORING_ZK_modulus *m, octet *P, octet *Q
 void FACTORING_ZK_modulus_kill(FACTORING_ZK_modulus *m);
 """)
 
-if (platform.system() == 'Windows'):
-    _libamcl_mpc = _ffi.dlopen("libamcl_mpc.dll")
-    _libamcl_paillier = _ffi.dlopen("libamcl_paillier.dll")
-elif (platform.system() == 'Darwin'):
-    _libamcl_mpc = _ffi.dlopen("libamcl_mpc.dylib")
-    _libamcl_paillier = _ffi.dlopen("libamcl_paillier.dylib")
-else:
-    _libamcl_mpc = _ffi.dlopen("libamcl_mpc.so")
-    _libamcl_paillier = _ffi.dlopen("libamcl_paillier.so")
+_libamcl_mpc = core_utils.dlopen("amcl_mpc")
+_libamcl_paillier = core_utils.dlopen("amcl_paillier")
 
 # Constants
 B        = 16  # Security parameter - 128 bit
@@ -23,15 +23,14 @@ This module use cffi to access the c functions in the amcl_mpc library.
 
 """
 
-import platform
 from . import core_utils
 
 _ffi = core_utils._ffi
-_ffi.cdef("""
+core_utils.cdef("""
 #define EFS_SECP256K1 32
 
 typedef signed int sign32;
-typedef long unsigned int BIG_256_56[5];
+typedef int64_t BIG_256_56[5];
 
 typedef struct
 {
@@ -84,25 +83,18 @@ extern void MPC_SUM_MTA(octet *A, octet *B, octet *ALPHA, octet *BETA, octet *SU
 extern void MPC_K_GENERATE(csprng *RNG, octet *K);
 extern void MPC_INVKGAMMA(const octet *KGAMMA1, const octet *KGAMMA2, octet *INVKGAMMA);
 extern int MPC_R(const octet *INVKGAMMA, octet *GAMMAPT1, octet *GAMMAPT2, octet *R, octet *RP);
+extern int MPC_R_RECID(const octet *INVKGAMMA, octet *GAMMAPT1, octet *GAMMAPT2, octet *R, octet *RP, int *RECID);
 extern void MPC_HASH(int sha, octet *M, octet *HM);
 extern int MPC_S(const octet *HM, const octet *R, const octet *K, const octet *SIGMA, octet *S);
 extern void MPC_SUM_S(const octet *S1, const octet *S2, octet *S);
+extern void MPC_SUM_S_RECID(const octet *S1, const octet *S2, octet *S, int *RECID);
 extern int MPC_SUM_PK(octet *PK1, octet *PK2, octet *PK);
 extern void MPC_DUMP_PAILLIER_SK(PAILLIER_private_key *PRIV, octet *P, octet *Q);
 """)
 
-if (platform.system() == 'Windows'):
-    _libamcl_mpc = _ffi.dlopen("libamcl_mpc.dll")
-    _libamcl_paillier = _ffi.dlopen("libamcl_paillier.dll")
-    _libamcl_curve_secp256k1 = _ffi.dlopen("libamcl_curve_SECP256K1.dll")
-elif (platform.system() == 'Darwin'):
-    _libamcl_mpc = _ffi.dlopen("libamcl_mpc.dylib")
-    _libamcl_paillier = _ffi.dlopen("libamcl_paillier.dylib")
-    _libamcl_curve_secp256k1 = _ffi.dlopen("libamcl_curve_SECP256K1.dylib")
-else:
-    _libamcl_mpc = _ffi.dlopen("libamcl_mpc.so")
-    _libamcl_paillier = _ffi.dlopen("libamcl_paillier.so")
-    _libamcl_curve_secp256k1 = _ffi.dlopen("libamcl_curve_SECP256K1.so")
+_libamcl_mpc = core_utils.dlopen("amcl_mpc")
+_libamcl_paillier = core_utils.dlopen("amcl_paillier")
+_libamcl_curve_secp256k1 = core_utils.dlopen("amcl_curve_SECP256K1")
 
 # Constants
 FS_2048 = 256      # Size of an FF_2048 in bytes
@@ -311,26 +303,26 @@ def mpc_mta_client1(rng, paillier_pk, a, r=None):
     Raises:
 
     """
+    pool = core_utils.octet_pool()
+
     if r:
-        r1, r1_val = core_utils.make_octet(None, r)
-        _ = r1_val
+        r1 = pool.get(None, r)
         rng = _ffi.NULL
     else:
-        r1 = _ffi.NULL
+        r1 = None
 
-    a1, a1_val = core_utils.make_octet(None, a)
-    ca1, ca1_val = core_utils.make_octet(FS_4096)
-    _ = a1_val, ca1_val
+    a1 = pool.get(None, a)
+    ca1 = pool.get(FS_4096)
 
-    _libamcl_mpc.MPC_MTA_CLIENT1(rng, paillier_pk, a1, ca1, r1)
+    _libamcl_mpc.MPC_MTA_CLIENT1(rng, paillier_pk, a1[0], ca1[0], r1[0] if r1 else _ffi.NULL)
 
-    ca2 = core_utils.to_str(ca1)
+    ca2 = core_utils.to_str(ca1[0])
 
     # Clear memory
-    core_utils.clear_octet(a1)
+    pool.release(a1, ca1)
 
-    if r1 is not _ffi.NULL:
-        core_utils.clear_octet(r1)
+    if r1:
+        pool.release(r1)
 
     return ca2
 
@@ -352,14 +344,17 @@ def mpc_mta_client2(paillier_sk, cb):
     Raises:
 
     """
-    cb1, cb1_val = core_utils.make_octet(None, cb)
-    alpha1, alpha1_val = core_utils.make_octet(EGS_SECP256K1)
-    _ = cb1_val, alpha1_val # Suppress warnings
+    pool = core_utils.octet_pool()
 
-    _libamcl_mpc.MPC_MTA_CLIENT2(paillier_sk, cb1, alpha1)
+    cb1 = pool.get(None, cb)
+    alpha1 = pool.get(EGS_SECP256K1)
 
-    alpha2 = core_utils.to_str(alpha1)
-    core_utils.clear_octet(alpha1)
+    _libamcl_mpc.MPC_MTA_CLIENT2(paillier_sk, cb1[0], alpha1[0])
+
+    alpha2 = core_utils.to_str(alpha1[0])
+
+    # Clear memory
+    pool.release(cb1, alpha1)
 
     return alpha2
 
@@ -386,35 +381,35 @@ def mpc_mta_server(rng, paillier_pk, b, ca, z=None, r=None):
     Raises:
 
     """
+    pool = core_utils.octet_pool()
+
     if r:
-        r1, r1_val = core_utils.make_octet(None, r)
-        z1, z1_val = core_utils.make_octet(None, z)
-        _ = r1_val, z1_val
+        r1 = pool.get(None, r)
+        z1 = pool.get(None, z)
         rng = _ffi.NULL
     else:
-        r1 = _ffi.NULL
-        z1 = _ffi.NULL
+        r1 = None
+        z1 = None
 
-    b1, b1_val = core_utils.make_octet(None, b)
-    ca1, ca1_val = core_utils.make_octet(None, ca)
-    beta1, beta1_val = core_utils.make_octet(EGS_SECP256K1)
-    cb1, cb1_val = core_utils.make_octet(FS_4096)
-    _ = b1_val, ca1_val, beta1_val, cb1_val
+    b1 = pool.get(None, b)
+    ca1 = pool.get(None, ca)
+    beta1 = pool.get(EGS_SECP256K1)
+    cb1 = pool.get(FS_4096)
 
-    _libamcl_mpc.MPC_MTA_SERVER(rng, paillier_pk, b1, ca1, z1, r1, cb1, beta1)
+    _libamcl_mpc.MPC_MTA_SERVER(
+        rng, paillier_pk, b1[0], ca1[0],
+        z1[0] if z1 else _ffi.NULL,
+        r1[0] if r1 else _ffi.NULL,
+        cb1[0], beta1[0])
 
-    beta2 = core_utils.to_str(beta1)
-    cb2 = core_utils.to_str(cb1)
+    beta2 = core_utils.to_str(beta1[0])
+    cb2 = core_utils.to_str(cb1[0])
 
     # Clear memory
-    core_utils.clear_octet(b1)
-    core_utils.clear_octet(beta1)
+    pool.release(b1, ca1, beta1, cb1)
 
-    if r1 is not _ffi.NULL:
-        core_utils.clear_octet(r1)
-
-    if z1 is not _ffi.NULL:
-        core_utils.clear_octet(z1)
+    if r1:
+        pool.release(r1, z1)
 
     return cb2, beta2
 
@@ -546,6 +541,45 @@ def mpc_r(invkgamma, gammapt1, gammapt2):
     return rc, r2, rp_str
 
 
+
+def mpc_r_recid(invkgamma, gammapt1, gammapt2):
+    """R component with recovery id
+
+    Generate the ECDSA signature R component and the recovery id.
+    The recovery id must be updated with mpc_sum_s_recid
+
+    Args::
+
+        invkgamma: Inverse of k times gamma
+        gammapt1: Actor 1 gamma point
+        gammapt2: Actor 2 gamma point
+
+    Returns::
+
+        rc: Zero for success or else an error code
+        r : R component of the signature
+        rp: ECP associated to R component of signature
+        v : Recovery id of the signature
+    Raises:
+
+    """
+    invkgamma1, invkgamma1_val = core_utils.make_octet(None, invkgamma)
+    gammapt11, gammapt11_val = core_utils.make_octet(None, gammapt1)
+    gammapt21, gammapt21_val = core_utils.make_octet(None, gammapt2)
+
+    r1, r1_val = core_utils.make_octet(EGS_SECP256K1)
+    rp, rp_val = core_utils.make_octet(EFS_SECP256K1 + 1)
+    _ = invkgamma1_val, gammapt11_val, gammapt21_val, r1_val, rp_val
+
+    recid = _ffi.new("int*")
+
+    rc = _libamcl_mpc.MPC_R_RECID(invkgamma1, gammapt11, gammapt21, r1, rp, recid)
+
+    r2 = core_utils.to_str(r1)
+    rp_str = core_utils.to_str(rp)
+
+    return rc, r2, rp_str, recid[0]
+
 def mpc_hash(message):
     """Hash the message value
 
@@ -670,6 +704,41 @@ def mpc_sum_s(s1, s2):
     return s2
 
 
+
+def mpc_sum_s_recid(s1, s2, v):
+    """Sum of ECDSA s components with low-s normalisation
+
+    Calculate the sum of the s components of the ECDSA signature,
+    normalised to the lower half of the range
+
+    Args::
+
+        s1: Actor 1 ECDSA s component
+        s2: Actor 2 ECDSA s component
+        v: Recovery id from mpc_r_recid
+
+    Returns::
+
+        s: The sum of all ECDSA s shares
+        v: The recovery id for the normalised signature
+
+    Raises:
+
+    """
+    s11, s11_val = core_utils.make_octet(None, s1)
+    s21, s21_val = core_utils.make_octet(None, s2)
+
+    s1, s1_val = core_utils.make_octet(EGS_SECP256K1)
+    _ = s11_val, s21_val, s1_val
+
+    recid = _ffi.new("int*", v)
+
+    _libamcl_mpc.MPC_SUM_S_RECID(s11, s21, s1, recid)
+
+    s2 = core_utils.to_str(s1)
+
+    return s2, recid[0]
+
 def mpc_sum_pk(pk1, pk2):
     """Sum of ECDSA public key shares
 
@@ -23,27 +23,20 @@ This module use cffi to access the c functions in the amcl_mpc library.
 
 """
 
-import platform
 from . import core_utils
 
 _ffi = core_utils._ffi
-_ffi.cdef("""
+core_utils.cdef("""
 extern void SCHNORR_random_challenge(csprng *RNG, octet *E);
 extern void SCHNORR_commit(csprng *RNG, octet *R, octet *C);
 extern void SCHNORR_challenge(const octet *V, const octet *C, octet *ID, octet *AD, octet *E);
 extern void SCHNORR_prove(const octet *R, const octet *E, const octet *X, octet *P);
 extern int SCHNORR_verify(octet *V, octet *C, const octet *E, const octet *P);
+extern int SCHNORR_batch_verify(csprng *RNG, int w, int n, octet *V[], octet *C[], octet *E[], octet *P[]);
 """)
 
-if (platform.system() == 'Windows'):
-    _libamcl_mpc = _ffi.dlopen("libamcl_mpc.dll")
-    _libamcl_curve_secp256k1 = _ffi.dlopen("libamcl_curve_SECP256K1.dll")
-elif (platform.system() == 'Darwin'):
-    _libamcl_mpc = _ffi.dlopen("libamcl_mpc.dylib")
-    _libamcl_curve_secp256k1 = _ffi.dlopen("libamcl_curve_SECP256K1.dylib")
-else:
-    _libamcl_mpc = _ffi.dlopen("libamcl_mpc.so")
-    _libamcl_curve_secp256k1 = _ffi.dlopen("libamcl_curve_SECP256K1.so")
+_libamcl_mpc = core_utils.dlopen("amcl_mpc")
+_libamcl_curve_secp256k1 = core_utils.dlopen("amcl_curve_SECP256K1")
 
 # Constants
 EGS = 32      # Size of a Z/qZ element in bytes
@@ -54,6 +47,9 @@ OK          = 0
 FAIL        = 51
 INVALID_ECP = 52
 
+BATCH_MAX  = 64 # Maximum number of proofs combined in a single check
+MSM_WINDOW = 5  # Default window size for the batch verification
+
 
 def random_challenge(rng):
     """Generate a random challenge for the Schnorr's Proof
@@ -225,3 +221,36 @@ def verify(V, C, e, p):
     ec = _libamcl_mpc.SCHNORR_verify(V_oct, C_oct, e_oct, p_oct)
 
     return ec
+
+
+def batch_verify(rng, V, C, e, p, window=MSM_WINDOW):
+    """Verify many Schnorr's proofs at once
+
+    Check a random linear combination of the proofs. If the batch
+    is invalid, verify can be used to find the invalid proofs
+
+    Args::
+
+        rng : Pointer to cryptographically secure pseudo-random number generator instance
+        V   : List of public ECPs of the DLOGs
+        C   : List of commitments for the Schnorr's Proofs
+        e   : List of challenges for the Schnorr's Proofs
+        p   : List of proofs
+        window : Window size for the multi-scalar multiplication
+
+    Returns::
+
+        ec : OK if all the proofs are valid, or an error code
+
+    Raises:
+
+    """
+    V_oct, V_refs = core_utils.buffer_octet_array(V)
+    C_oct, C_refs = core_utils.buffer_octet_array(C)
+    e_oct, e_refs = core_utils.buffer_octet_array(e)
+    p_oct, p_refs = core_utils.buffer_octet_array(p)
+    _ = V_refs, C_refs, e_refs, p_refs # Suppress warning
+
+    ec = _libamcl_mpc.SCHNORR_batch_verify(rng, window, len(V), V_oct, C_oct, e_oct, p_oct)
+
+    return ec
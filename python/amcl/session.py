@@ -0,0 +1,527 @@
+"""
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+"""
+
+"""
+
+This module runs the two party key setup and signing protocols on asyncio.
+
+The expensive primitives (Paillier key generation, MtA and ZK proofs) are
+offloaded to an executor so the event loop is never blocked, many
+sessions are multiplexed on the same loop and the verifications of all
+the sessions are batched together.
+
+cffi releases the GIL during the C calls, so a thread pool runs the
+offloaded primitives in parallel. The verification jobs only take bytes
+and can also run in a process pool.
+
+"""
+
+import os
+import time
+import asyncio
+import contextlib
+import concurrent.futures
+
+from . import core_utils, mpc, schnorr, factoring_zk, commitments
+
+# Default batching parameters
+BATCH_SIZE  = schnorr.BATCH_MAX # Flush a batch when it reaches this size
+BATCH_DELAY = 0.002             # Flush a batch after this many seconds
+
+SEED_LENGTH = 32 # Length in bytes of the seed for the per job CSPRNG
+
+
+class ProtocolError(Exception):
+    """ A check of the protocol failed
+
+    Attributes::
+
+        party: Party that detected the failure
+        step:  Failed step
+        rc:    Error code returned by the check
+    """
+
+    def __init__(self, party, step, rc):
+        super().__init__(f"[{party}] {step} failed. rc {rc}")
+        self.party = party
+        self.step = step
+        self.rc = rc
+
+
+class PhaseTimer:
+    """ Wall clock time spent in each phase of the protocol
+
+    The time includes the time spent waiting for the executor and for
+    the batched verifications
+    """
+
+    def __init__(self):
+        self.timings = {}
+
+    @contextlib.contextmanager
+    def phase(self, name):
+        """ Time a phase. Usable inside coroutines """
+        start = time.perf_counter()
+        try:
+            yield
+        finally:
+            elapsed = time.perf_counter() - start
+            self.timings[name] = self.timings.get(name, 0.0) + elapsed
+
+    def merge(self, other):
+        """ Add the timings of other to this timer """
+        for name, elapsed in other.timings.items():
+            self.timings[name] = self.timings.get(name, 0.0) + elapsed
+
+
+# Jobs run in the executor. They are module level functions so they
+# can be pickled for a process pool when they only take bytes
+
+def _rng(seed):
+    return core_utils.create_csprng(seed)
+
+
+def _generate_key_material(seed):
+    rng = _rng(seed)
+
+    paillier_pk, paillier_sk = mpc.paillier_key_pair(rng)
+    ecdsa_pk, ecdsa_sk = mpc.mpc_ecdsa_key_pair_generate(rng)
+
+    core_utils.kill_csprng(rng)
+
+    return {
+        'paillier_pk' : paillier_pk,
+        'paillier_sk' : paillier_sk,
+        'paillier_n'  : mpc.paillier_pk_to_octet(paillier_pk),
+        'ecdsa_pk'    : ecdsa_pk,
+        'ecdsa_sk'    : ecdsa_sk
+    }
+
+
+def _factoring_prove(seed, paillier_sk, ID, AD):
+    rng = _rng(seed)
+
+    p, q = mpc.mpc_dump_paillier_sk(paillier_sk)
+    e, y = factoring_zk.prove(rng, p, q, ID, ad=AD)
+
+    core_utils.kill_csprng(rng)
+
+    return e, y
+
+
+def _mta(seed_client, seed_server, client_pk, client_sk, server_pk, a, b):
+    rng_client = _rng(seed_client)
+    rng_server = _rng(seed_server)
+
+    ca = mpc.mpc_mta_client1(rng_client, client_pk, a)
+    cb, beta = mpc.mpc_mta_server(rng_server, server_pk, b, ca)
+    alpha = mpc.mpc_mta_client2(client_sk, cb)
+
+    core_utils.kill_csprng(rng_client)
+    core_utils.kill_csprng(rng_server)
+
+    return alpha, beta
+
+
+def _verify_schnorr_batch(items):
+    rng = _rng(os.urandom(SEED_LENGTH))
+
+    V, C, e, p = zip(*items)
+    rc = schnorr.batch_verify(rng, V, C, e, p)
+
+    core_utils.kill_csprng(rng)
+
+    if rc == schnorr.OK:
+        return [schnorr.OK] * len(items)
+
+    # Locate the invalid proofs
+    return [schnorr.verify(*item) for item in items]
+
+
+def _verify_factoring_batch(items):
+    return [factoring_zk.verify(n, e, y, ID, ad=AD) for n, e, y, ID, AD in items]
+
+
+def _decommit_batch(items):
+    return [commitments.nm_decommit(*item) for item in items]
+
+
+class _Batcher:
+    """ Collect the verifications submitted by all the sessions
+
+    The batch is run as a single executor job when it reaches the
+    maximum size or after a short delay
+    """
+
+    def __init__(self, runner, job, size, delay):
+        self._runner = runner
+        self._job = job
+        self._size = size
+        self._delay = delay
+        self._pending = []
+        self._timer = None
+
+    def submit(self, *args):
+        loop = asyncio.get_running_loop()
+        future = loop.create_future()
+
+        self._pending.append((args, future))
+
+        if len(self._pending) >= self._size:
+            self.flush()
+        elif self._timer is None:
+            self._timer = loop.call_later(self._delay, self.flush)
+
+        return future
+
+    def flush(self):
+        if self._timer is not None:
+            self._timer.cancel()
+            self._timer = None
+
+        if not self._pending:
+            return
+
+        batch, self._pending = self._pending, []
+        asyncio.get_running_loop().create_task(self._run(batch))
+
+    async def _run(self, batch):
+        try:
+            results = await self._runner.offload(
+                self._job, [args for args, _ in batch], verify=True)
+        except Exception as e:
+            for _, future in batch:
+                if not future.done():
+                    future.set_exception(e)
+            return
+
+        for (_, future), rc in zip(batch, results):
+            if not future.done():
+                future.set_result(rc)
+
+
+class Runner:
+    """ Run many protocol sessions on the current event loop
+
+    Args::
+
+        executor:        Executor for the expensive primitives. A thread
+                         pool with one thread per CPU by default
+        verify_executor: Executor for the batched verifications. A thread
+                         pool with one thread per CPU by default. Can be
+                         a process pool
+        batch_size:      Maximum number of verifications in a batch
+        batch_delay:     Maximum delay in seconds before a batch is run
+    """
+
+    def __init__(self, executor=None, verify_executor=None,
+                 batch_size=BATCH_SIZE, batch_delay=BATCH_DELAY):
+        # Separate pools, so the verifications do not queue behind the
+        # expensive primitives of the other sessions
+        self._own_executors = []
+        if executor is None:
+            executor = concurrent.futures.ThreadPoolExecutor(os.cpu_count())
+            self._own_executors.append(executor)
+
+        if verify_executor is None:
+            verify_executor = concurrent.futures.ThreadPoolExecutor(os.cpu_count())
+            self._own_executors.append(verify_executor)
+
+        self.executor = executor
+        self.verify_executor = verify_executor
+        self.timer = PhaseTimer()
+
+        self._schnorr = _Batcher(self, _verify_schnorr_batch, batch_size, batch_delay)
+        self._factoring = _Batcher(self, _verify_factoring_batch, batch_size, batch_delay)
+        self._decommit = _Batcher(self, _decommit_batch, batch_size, batch_delay)
+
+    async def offload(self, fn, *args, verify=False):
+        """ Run fn(*args) in the executor """
+        executor = self.verify_executor if verify else self.executor
+        return await asyncio.get_running_loop().run_in_executor(executor, fn, *args)
+
+    def verify_schnorr(self, V, C, e, p):
+        """ Batched schnorr.verify. Returns a future for the error code """
+        return self._schnorr.submit(V, C, e, p)
+
+    def verify_factoring(self, n, e, y, ID, AD=None):
+        """ Batched factoring_zk.verify. Returns a future for the error code """
+        return self._factoring.submit(n, e, y, ID, AD)
+
+    def decommit(self, x, r, c):
+        """ Batched commitments.nm_decommit. Returns a future for the error code """
+        return self._decommit.submit(x, r, c)
+
+    async def run(self, sessions):
+        """ Run the sessions concurrently
+
+        Args::
+
+            sessions: Sessions to run
+
+        Returns::
+
+            results: Result of each session, or the exception raised
+
+        """
+        results = await asyncio.gather(*(s.run() for s in sessions), return_exceptions=True)
+
+        for s in sessions:
+            self.timer.merge(s.timer)
+
+        return results
+
+    def close(self):
+        """ Shut down the executors created by the runner """
+        for executor in self._own_executors:
+            executor.shutdown()
+
+
+class Party:
+    """ A party of the protocol and its long term key material
+
+    The key material is set up by KeySetupSession
+
+    Args::
+
+        name: Name of the party for the error reports
+        ID:   Unique identifier of the party
+    """
+
+    def __init__(self, name, ID):
+        self.name = name
+        self.ID = ID
+        self.key_material = None
+        self.counterparty = None
+        self.full_pk = None
+
+
+class _Session:
+    """ Common code for the sessions """
+
+    def __init__(self, runner, alice, bob):
+        self.runner = runner
+        self.alice = alice
+        self.bob = bob
+        self.timer = PhaseTimer()
+
+    @staticmethod
+    def seed():
+        """ Fresh seed for the CSPRNG of a job
+
+        Each job has its own CSPRNG, since a CSPRNG cannot be shared
+        between threads
+        """
+        return os.urandom(SEED_LENGTH)
+
+    @staticmethod
+    def check(party, step, rc, ok=0):
+        if rc != ok:
+            raise ProtocolError(party.name, step, rc)
+
+    async def run(self):
+        raise NotImplementedError
+
+
+class KeySetupSession(_Session):
+    """ Generate and exchange the key material of two parties
+
+    Mirrors the key setup of example_full.py. The result is the
+    full ECDSA public key, also stored in each party
+    """
+
+    async def _generate(self, party):
+        with self.timer.phase("keygen"):
+            party.key_material = await self.runner.offload(_generate_key_material, self.seed())
+
+        km = party.key_material
+
+        with self.timer.phase("prove"):
+            rng = core_utils.create_csprng(self.seed())
+            AD = core_utils.generate_random(rng, 32)
+
+            r, c = commitments.nm_commit(rng, km['ecdsa_pk'])
+
+            sr, sc = schnorr.commit(rng)
+            e = schnorr.challenge(km['ecdsa_pk'], sc, party.ID, AD=AD)
+            sp = schnorr.prove(sr, e, km['ecdsa_sk'])
+
+            core_utils.kill_csprng(rng)
+
+            fe, fy = await self.runner.offload(_factoring_prove, self.seed(), km['paillier_sk'], party.ID, AD)
+
+        return {
+            'paillier_pk' : km['paillier_pk'],
+            'paillier_n'  : km['paillier_n'],
+            'ecdsa_pk'    : km['ecdsa_pk'],
+            'AD' : AD, 'r' : r, 'c' : c, 'sc' : sc, 'sp' : sp, 'fe' : fe, 'fy' : fy
+        }
+
+    async def _verify(self, party, prover, msg):
+        with self.timer.phase("verify"):
+            rc = mpc.ecp_secp256k1_public_key_validate(msg['ecdsa_pk'])
+            self.check(party, "ECDSA PK validation", rc)
+
+            e = schnorr.challenge(msg['ecdsa_pk'], msg['sc'], prover.ID, AD=msg['AD'])
+
+            rcs = await asyncio.gather(
+                self.runner.decommit(msg['ecdsa_pk'], msg['r'], msg['c']),
+                self.runner.verify_schnorr(msg['ecdsa_pk'], msg['sc'], e, msg['sp']),
+                self.runner.verify_factoring(msg['paillier_n'], msg['fe'], msg['fy'], prover.ID, msg['AD']))
+
+        self.check(party, "ECDSA PK decommitment", rcs[0], commitments.OK)
+        self.check(party, "ECDSA PK Schnorr's proof", rcs[1], schnorr.OK)
+        self.check(party, "Factoring ZKP", rcs[2], factoring_zk.OK)
+
+        party.counterparty = {
+            'paillier_pk' : msg['paillier_pk'],
+            'ecdsa_pk'    : msg['ecdsa_pk']
+        }
+
+        rc, party.full_pk = mpc.mpc_sum_pk(party.key_material['ecdsa_pk'], msg['ecdsa_pk'])
+        self.check(party, "ECDSA PK recombination", rc)
+
+    async def run(self):
+        msg_a, msg_b = await asyncio.gather(self._generate(self.alice), self._generate(self.bob))
+
+        await asyncio.gather(
+            self._verify(self.alice, self.bob, msg_b),
+            self._verify(self.bob, self.alice, msg_a))
+
+        return self.alice.full_pk
+
+
+class SigningSession(_Session):
+    """ Sign a message with the key material set up by KeySetupSession
+
+    Mirrors the signature of example_full.py. The result is the
+    signature (R, S)
+
+    Args::
+
+        runner:  Runner for the session
+        alice:   First party
+        bob:     Second party
+        message: Message to sign
+    """
+
+    def __init__(self, runner, alice, bob, message):
+        super().__init__(runner, alice, bob)
+        self.message = message
+
+    def _commit_gamma(self, party):
+        rng = core_utils.create_csprng(self.seed())
+
+        GAMMA, gamma = mpc.mpc_ecdsa_key_pair_generate(rng)
+        k = mpc.mpc_k_generate(rng)
+        GAMMAR, GAMMAC = commitments.nm_commit(rng, GAMMA)
+        AD = core_utils.generate_random(rng, 32)
+
+        core_utils.kill_csprng(rng)
+
+        return {'GAMMA' : GAMMA, 'gamma' : gamma, 'k' : k, 'r' : GAMMAR, 'c' : GAMMAC, 'AD' : AD}
+
+    def _mta(self, client, server, a, b):
+        return self.runner.offload(
+            _mta, self.seed(), self.seed(),
+            client.key_material['paillier_pk'], client.key_material['paillier_sk'],
+            server.counterparty['paillier_pk'], a, b)
+
+    def _prove_gamma(self, party, s):
+        rng = core_utils.create_csprng(self.seed())
+
+        sr, sc = schnorr.commit(rng)
+        e = schnorr.challenge(s['GAMMA'], sc, party.ID, AD=s['AD'])
+        sp = schnorr.prove(sr, e, s['gamma'])
+
+        core_utils.kill_csprng(rng)
+
+        return sc, sp
+
+    async def _verify_gamma(self, party, prover, s, sc, sp):
+        e = schnorr.challenge(s['GAMMA'], sc, prover.ID, AD=s['AD'])
+
+        rcs = await asyncio.gather(
+            self.runner.decommit(s['GAMMA'], s['r'], s['c']),
+            self.runner.verify_schnorr(s['GAMMA'], sc, e, sp))
+
+        self.check(party, "GAMMA decommitment", rcs[0], commitments.OK)
+        self.check(party, "GAMMA Schnorr's proof", rcs[1], schnorr.OK)
+
+    async def run(self):
+        a, b = self.alice, self.bob
+        ska = a.key_material['ecdsa_sk']
+        skb = b.key_material['ecdsa_sk']
+
+        with self.timer.phase("commit"):
+            sa = self._commit_gamma(a)
+            sb = self._commit_gamma(b)
+
+        # The four MtA are independent
+        with self.timer.phase("mta"):
+            (alpha1, beta2), (alpha2, beta1), (alpha3, beta4), (alpha4, beta3) = await asyncio.gather(
+                self._mta(a, b, sa['k'], sb['gamma']),
+                self._mta(b, a, sb['k'], sa['gamma']),
+                self._mta(a, b, sa['k'], skb),
+                self._mta(b, a, sb['k'], ska))
+
+            delta1 = mpc.mpc_sum_mta(sa['k'], sa['gamma'], alpha1, beta1)
+            delta2 = mpc.mpc_sum_mta(sb['k'], sb['gamma'], alpha2, beta2)
+            sigma1 = mpc.mpc_sum_mta(sa['k'], ska, alpha3, beta3)
+            sigma2 = mpc.mpc_sum_mta(sb['k'], skb, alpha4, beta4)
+
+        with self.timer.phase("r"):
+            sca, spa = self._prove_gamma(a, sa)
+            scb, spb = self._prove_gamma(b, sb)
+
+            await asyncio.gather(
+                self._verify_gamma(a, b, sb, scb, spb),
+                self._verify_gamma(b, a, sa, sca, spa))
+
+            ikgamma = mpc.mpc_invkgamma(delta1, delta2)
+            rc, R, _ = mpc.mpc_r(ikgamma, sa['GAMMA'], sb['GAMMA'])
+            self.check(a, "R reconciliation", rc)
+
+        with self.timer.phase("s"):
+            hm = mpc.mpc_hash(self.message)
+
+            rc, s1 = mpc.mpc_s(hm, R, sa['k'], sigma1)
+            self.check(a, "Signature share", rc)
+
+            rc, s2 = mpc.mpc_s(hm, R, sb['k'], sigma2)
+            self.check(b, "Signature share", rc)
+
+            rng = core_utils.create_csprng(self.seed())
+            SR1, SC1 = commitments.nm_commit(rng, s1)
+            SR2, SC2 = commitments.nm_commit(rng, s2)
+            core_utils.kill_csprng(rng)
+
+            rcs = await asyncio.gather(
+                self.runner.decommit(s2, SR2, SC2),
+                self.runner.decommit(s1, SR1, SC1))
+
+            self.check(a, "s2 decommitment", rcs[0], commitments.OK)
+            self.check(b, "s1 decommitment", rcs[1], commitments.OK)
+
+            S = mpc.mpc_sum_s(s1, s2)
+
+            rc = mpc.mpc_ecdsa_verify(hm, a.full_pk, R, S)
+            self.check(a, "Signature verification", rc)
+
+        return R, S
@@ -49,3 +49,28 @@ if __name__ == "__main__":
 
     fncall = lambda: aes.gcm_decrypt(key, iv, header, ciphertext)
     time_func("aes.gcm_decrypt", fncall, unit = 'us')
+
+    # Batch of records under the same key
+    n = 1000
+    ivs = [iv[:-4] + i.to_bytes(4, 'big') for i in range(n)]
+    headers = [header] * n
+    plaintexts = [plaintext] * n
+
+    fncall = lambda: [aes.gcm_encrypt(key, ivs[i], header, plaintext) for i in range(n)]
+    time_func("aes.gcm_encrypt x{}".format(n), fncall, unit = 'ms')
+
+    fncall = lambda: aes.gcm_encrypt_batch(key, ivs, headers, plaintexts)
+    time_func("aes.gcm_encrypt_batch x{}".format(n), fncall, unit = 'ms')
+
+    # Stream of a large record
+    record = bytes(1 << 20)
+
+    def stream():
+        enc = aes.GcmEncryptor(key, iv, header)
+        out = bytearray(len(record))
+        n = enc.update_into(record, out)
+        enc.finalize()
+        return n
+
+    fncall = stream
+    time_func("aes.GcmEncryptor 1MB", fncall, unit = 'ms')
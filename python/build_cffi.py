@@ -0,0 +1,120 @@
+#!/usr/bin/env python3
+
+"""
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+"""
+
+"""
+
+Build the compiled cffi extension amcl._amcl_cffi (API mode).
+
+The C declarations are read from the core_utils.cdef calls in the
+wrapper modules, so the extension always matches the ABI mode wrapper.
+
+usage: build_cffi.py <package dir> <include dirs> <library dirs>
+
+Directories in the lists are separated by ';'
+
+"""
+
+import os
+import sys
+import ast
+import glob
+import cffi
+
+# Headers and libraries needed by each wrapper module
+MODULES = {
+    "core_utils":   (["amcl/amcl.h", "amcl/randapi.h"], ["amcl_core"]),
+    "aes":          (["amcl/amcl.h", "amcl/ecdh_support.h", "amcl/gcm_batch.h"], ["amcl_mpc", "amcl_core"]),
+    "mpc":          (["amcl/paillier.h", "amcl/ecdh_SECP256K1.h", "amcl/mpc.h"],
+                     ["amcl_mpc", "amcl_paillier", "amcl_curve_SECP256K1"]),
+    "schnorr":      (["amcl/schnorr.h"], ["amcl_mpc", "amcl_curve_SECP256K1"]),
+    "commitments":  (["amcl/commitments.h"], ["amcl_mpc"]),
+    "factoring_zk": (["amcl/factoring_zk.h"], ["amcl_mpc", "amcl_paillier"]),
+    "bls":          (["amcl/bls_BLS381.h", "amcl/bls_batch.h"],
+                     ["amcl_mpc", "amcl_bls_BLS381", "amcl_pairing_BLS381", "amcl_curve_BLS381"]),
+}
+
+
+def read_cdefs(path):
+    """Extract the sources of the cdef calls in a wrapper module"""
+    with open(path, "r") as f:
+        tree = ast.parse(f.read(), path)
+
+    sources = []
+    for node in ast.walk(tree):
+        if not isinstance(node, ast.Call) or not node.args:
+            continue
+
+        # Skip the forwarding call in core_utils.cdef
+        if not isinstance(node.args[0], ast.Constant):
+            continue
+
+        func = node.func
+        name = func.attr if isinstance(func, ast.Attribute) else getattr(func, "id", None)
+        if name != "cdef":
+            continue
+
+        sources.append(ast.literal_eval(node.args[0]))
+
+    return sources
+
+
+def main(package_dir, include_dirs, library_dirs):
+    modules = dict(MODULES)
+
+    # RSA wrappers are generated for each configured level
+    for path in glob.glob(os.path.join(package_dir, "rsa_*.py")):
+        tff = os.path.basename(path)[len("rsa_"):-len(".py")]
+        modules["rsa_" + tff] = (
+            ["amcl/rsa_support.h", "amcl/ff_%s.h" % tff, "amcl/rsa_%s.h" % tff],
+            ["amcl_rsa_" + tff, "amcl_core"])
+
+    ffibuilder = cffi.FFI()
+
+    headers = []
+    libraries = []
+
+    # core_utils declares the shared types and goes first
+    for name in sorted(modules, key=lambda m: m != "core_utils"):
+        for source in read_cdefs(os.path.join(package_dir, name + ".py")):
+            ffibuilder.cdef(source, override=True)
+
+        module_headers, module_libraries = modules[name]
+        headers += [h for h in module_headers if h not in headers]
+        libraries += [l for l in module_libraries if l not in libraries]
+
+    ffibuilder.set_source(
+        "amcl._amcl_cffi",
+        "\n".join('#include "%s"' % h for h in headers),
+        include_dirs=include_dirs,
+        library_dirs=library_dirs,
+        libraries=libraries)
+
+    ffibuilder.compile(tmpdir=os.path.dirname(os.path.abspath(package_dir)))
+
+
+if __name__ == "__main__":
+    if len(sys.argv) != 4:
+        print("usage: build_cffi.py <package dir> <include dirs> <library dirs>")
+        sys.exit(1)
+
+    main(sys.argv[1],
+         [d for d in sys.argv[2].split(";") if d],
+         [d for d in sys.argv[3].split(";") if d])
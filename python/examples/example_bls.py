@@ -140,6 +140,51 @@ if __name__ == "__main__":
         raise SystemExit(0)
     print("Success: Aggregated signature is valid")
 
+    # Aggregate in a single call
+    rtn, sig123 = amcl.bls.aggregate_G1([sig1, sig2, sig3])
+    if rtn != 0:
+        print("Error: aggregate_G1 {}".format(rtn))
+        raise SystemExit(0)
+
+    rtn, pk123 = amcl.bls.aggregate_G2([pk1, pk2, pk3])
+    if rtn != 0:
+        print("Error: aggregate_G2 {}".format(rtn))
+        raise SystemExit(0)
+
+    rtn = amcl.bls.verify(sig123, message, pk123)
+    if rtn != 0:
+        print("Error: Invalid aggregated signature {}".format(rtn))
+        raise SystemExit(0)
+    print("Success: Aggregated signature is valid")
+
+    # Aggregate signatures on distinct messages
+    messages = [b"message 1", b"message 2", b"message 3"]
+    sigs = []
+    for m, sk in zip(messages, [sk1, sk2, sk3]):
+        rtn, sig = amcl.bls.sign(m, sk)
+        if rtn != 0:
+            print("Error: sign {}".format(rtn))
+            raise SystemExit(0)
+        sigs.append(sig)
+
+    rtn, agg = amcl.bls.aggregate_G1(sigs)
+    if rtn != 0:
+        print("Error: aggregate_G1 {}".format(rtn))
+        raise SystemExit(0)
+
+    rtn = amcl.bls.verify_aggregate(agg, messages, [pk1, pk2, pk3])
+    if rtn != 0:
+        print("Error: Invalid aggregate signature {}".format(rtn))
+        raise SystemExit(0)
+    print("Success: Aggregate signature is valid")
+
+    # Batch verification
+    rtn = amcl.bls.verify_batch(rng, sigs, messages, [pk1, pk2, pk3])
+    if rtn != 0:
+        print("Error: Invalid batch {}".format(rtn))
+        raise SystemExit(0)
+    print("Success: Batch is valid")
+
     # Clear memory
     amcl.core_utils.kill_csprng(rng)
     del sk1
@@ -0,0 +1,68 @@
+#!/usr/bin/env python3
+
+"""
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+"""
+
+import os
+import sys
+import time
+import asyncio
+
+sys.path.insert(0, os.path.abspath(os.path.join(os.path.dirname(__file__), '..')))
+
+from amcl import session
+
+N_SESSIONS = 16
+
+
+async def main():
+    alice = session.Party("Alice", b"alice_unique_identifier")
+    bob   = session.Party("Bob",   b"bob_unique_identifier")
+
+    runner = session.Runner()
+
+    print("Setup Key Material")
+    await runner.run([session.KeySetupSession(runner, alice, bob)])
+    print(f"\tPK = {alice.full_pk.hex()}")
+
+    print(f"\nSign {N_SESSIONS} messages concurrently")
+    messages = [f"test message {i}".encode('utf-8') for i in range(N_SESSIONS)]
+    sessions = [session.SigningSession(runner, alice, bob, m) for m in messages]
+
+    t = time.perf_counter()
+    results = await runner.run(sessions)
+    elapsed = time.perf_counter() - t
+
+    for m, result in zip(messages, results):
+        assert not isinstance(result, Exception), f"Session for '{m.decode('utf-8')}' failed: {result}"
+
+    R, S = results[0]
+    print(f"\tR = {R.hex()}")
+    print(f"\tS = {S.hex()}")
+
+    print(f"\n{N_SESSIONS} sessions in {elapsed:.3f}s")
+    print("Time per phase, summed over all the sessions")
+    for phase, total in runner.timer.timings.items():
+        print(f"\t{phase:8} {total:.3f}s")
+
+    runner.close()
+
+
+if __name__ == "__main__":
+    asyncio.run(main())
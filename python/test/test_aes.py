@@ -58,6 +58,41 @@ class TestEncrypt(unittest.TestCase):
             self.assertEqual(ct,  vector['ct'])
             self.assertEqual(tag, tag_golden)
 
+    def test_stream(self):
+        """ Test streaming encryption with partial blocks """
+
+        for vector in self.tv:
+            tag_golden = vector['tag']
+
+            enc = aes.GcmEncryptor(vector['key'], vector['iv'], vector['aad'])
+
+            pt = memoryview(vector['pt'])
+            ct = b''
+            for i in range(0, len(pt), 5):
+                ct += enc.update(pt[i:i+5])
+
+            tail, tag = enc.finalize()
+            ct += tail
+
+            self.assertEqual(ct, vector['ct'])
+            self.assertEqual(tag[:len(tag_golden)], tag_golden)
+
+    def test_batch(self):
+        """ Test batch encryption """
+
+        cts, tags = aes.gcm_encrypt_batch(
+            self.tv[0]['key'],
+            [vector['iv'] for vector in self.tv],
+            [vector['aad'] for vector in self.tv],
+            [vector['pt'] for vector in self.tv])
+
+        for vector, ct, tag in zip(self.tv, cts, tags):
+            golden_ct, golden_tag = aes.gcm_encrypt(
+                self.tv[0]['key'], vector['iv'], vector['aad'], vector['pt'])
+
+            self.assertEqual(bytes(ct),  golden_ct)
+            self.assertEqual(bytes(tag), golden_tag)
+
 
 class TestDecrypt(unittest.TestCase):
     """ Test AES-GCM decryption """
@@ -92,6 +127,42 @@ class TestDecrypt(unittest.TestCase):
                 self.assertEqual(pt,  vector['pt'])
                 self.assertEqual(tag, tag_golden)
 
+    def test_stream(self):
+        """ Test streaming decryption into a preallocated buffer """
+
+        for vector in self.tv:
+            tag_golden = vector['tag']
+
+            dec = aes.GcmDecryptor(vector['key'], vector['iv'], vector['aad'])
+
+            ct = vector['ct']
+            out = bytearray(len(ct))
+            n = dec.update_into(ct[:7], out)
+            n += dec.update_into(ct[7:], memoryview(out)[n:])
+
+            tail, tag = dec.finalize()
+            out[n:] = tail
+
+            if not vector.get('fail', False):
+                self.assertEqual(bytes(out), vector['pt'])
+                self.assertEqual(tag[:len(tag_golden)], tag_golden)
+
+    def test_batch(self):
+        """ Test batch decryption """
+
+        pts, tags = aes.gcm_decrypt_batch(
+            self.tv[0]['key'],
+            [vector['iv'] for vector in self.tv],
+            [vector['aad'] for vector in self.tv],
+            [vector['ct'] for vector in self.tv])
+
+        for vector, pt, tag in zip(self.tv, pts, tags):
+            golden_pt, golden_tag = aes.gcm_decrypt(
+                self.tv[0]['key'], vector['iv'], vector['aad'], vector['ct'])
+
+            self.assertEqual(bytes(pt),  golden_pt)
+            self.assertEqual(bytes(tag), golden_tag)
+
 if __name__ == '__main__':
     # Run tests
     unittest.main()
@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+
+"""
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+"""
+
+import os
+import sys
+import unittest
+
+sys.path.insert(0, os.path.abspath(os.path.join(os.path.dirname(__file__), '..')))
+
+from amcl import core_utils
+
+
+class TestOctets(unittest.TestCase):
+    """ Test octet marshalling """
+
+    def setUp(self):
+        self.value = bytes(range(256)) * 2
+
+    def test_make_octet(self):
+        """ Test round trip through an octet """
+
+        oct_ptr, val = core_utils.make_octet(None, self.value)
+        _ = val
+
+        self.assertEqual(oct_ptr.len, len(self.value))
+        self.assertEqual(oct_ptr.max, len(self.value))
+        self.assertEqual(core_utils.to_str(oct_ptr), self.value)
+
+    def test_empty_octet(self):
+        """ Test empty octet of given length """
+
+        oct_ptr, val = core_utils.make_octet(32)
+        _ = val
+
+        self.assertEqual(core_utils.to_str(oct_ptr), bytes(32))
+
+    def test_buffer_octet_array(self):
+        """ Test array of octets over buffers, including an empty one """
+
+        values = [self.value, b'']
+
+        octets, refs = core_utils.buffer_octet_array(values)
+        _ = refs
+
+        self.assertEqual(core_utils.to_str(octets[0]), self.value)
+        self.assertEqual(octets[1].len, 0)
+        self.assertEqual(octets[1].max, 0)
+
+    def test_pool(self):
+        """ Test octets are reused and cleared by the pool """
+
+        pool = core_utils.octet_pool()
+
+        o1 = pool.get(None, self.value)
+        self.assertEqual(core_utils.to_str(o1[0]), self.value)
+
+        pool.release(o1)
+        self.assertEqual(o1[0].len, 0)
+        self.assertEqual(core_utils._ffi.buffer(o1[0].val, o1[0].max)[:], bytes(len(self.value)))
+
+        # Same size reuses the released octet
+        o2 = pool.get(len(self.value))
+        self.assertIs(o2[1], o1[1])
+        self.assertEqual(o2[0].len, len(self.value))
+
+        # Different size does not
+        o3 = pool.get(None, b'BANANA')
+        self.assertIsNot(o3[1], o1[1])
+        self.assertEqual(core_utils.to_str(o3[0]), b'BANANA')
+
+        pool.release(o2, o3)
+
+
+if __name__ == '__main__':
+    # Run tests
+    unittest.main()
@@ -87,6 +87,23 @@ class TestR(unittest.TestCase):
             self.assertEqual(vector['SIG_R'], sig_r)
             self.assertEqual(rc, 0)
 
+    def test_2(self):
+        """test_2 Recovery id test"""
+
+        for vector in self.tv:
+            print(f"Test vector {vector['TEST']}")
+
+            rc, sig_r, rp, v = mpc.mpc_r_recid(vector['INVKGAMMA'], vector['GAMMAPT1'], vector['GAMMAPT2'])
+
+            self.assertEqual(rc, 0)
+            self.assertEqual(vector['SIG_R'], sig_r)
+
+            # The parity of the y coordinate is in the compressed point prefix
+            self.assertEqual(v & 1, rp[0] - 2)
+
+            # x >= q has probability ~2^-128
+            self.assertEqual(v & 2, 0)
+
 
 if __name__ == '__main__':
     # Run tests
@@ -0,0 +1,98 @@
+#!/usr/bin/env python3
+
+"""
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+"""
+
+import os
+import sys
+import asyncio
+import unittest
+
+sys.path.insert(0, os.path.abspath(os.path.join(os.path.dirname(__file__), '..')))
+
+from amcl import core_utils, mpc, schnorr, session
+
+
+class TestSession(unittest.TestCase):
+    """ Test the asyncio session runner """
+
+    @classmethod
+    def setUpClass(cls):
+        cls.alice = session.Party("Alice", b"alice_unique_identifier")
+        cls.bob   = session.Party("Bob",   b"bob_unique_identifier")
+
+        runner = session.Runner()
+        results = asyncio.run(runner.run([session.KeySetupSession(runner, cls.alice, cls.bob)]))
+        runner.close()
+
+        cls.full_pk = results[0]
+
+    def test_key_setup(self):
+        """ Test both parties recombine the same public key """
+
+        self.assertEqual(self.alice.full_pk, self.full_pk)
+        self.assertEqual(self.bob.full_pk,   self.full_pk)
+
+    def test_sign(self):
+        """ Test concurrent signing sessions """
+
+        messages = [b'test message %d' % i for i in range(4)]
+
+        runner = session.Runner(batch_size=4)
+        sessions = [session.SigningSession(runner, self.alice, self.bob, m) for m in messages]
+        results = asyncio.run(runner.run(sessions))
+        runner.close()
+
+        for m, result in zip(messages, results):
+            self.assertNotIsInstance(result, Exception)
+
+            R, S = result
+            rc = mpc.mpc_ecdsa_verify(mpc.mpc_hash(m), self.full_pk, R, S)
+            self.assertEqual(rc, 0)
+
+        for phase in ["commit", "mta", "r", "s"]:
+            self.assertIn(phase, runner.timer.timings)
+
+    def test_verify_schnorr_batch(self):
+        """ Test the invalid proofs are located in a batch """
+
+        rng = core_utils.create_csprng(b'seed')
+
+        items = []
+        for i in range(3):
+            V, x = mpc.mpc_ecdsa_key_pair_generate(rng)
+            r, C = schnorr.commit(rng)
+            e = schnorr.random_challenge(rng)
+            p = schnorr.prove(r, e, x)
+            items.append((V, C, e, p))
+
+        self.assertEqual(session._verify_schnorr_batch(items), [schnorr.OK] * 3)
+
+        V, C, e, p = items[1]
+        items[1] = (V, C, e, items[0][3])
+
+        rcs = session._verify_schnorr_batch(items)
+        self.assertEqual(rcs[0], schnorr.OK)
+        self.assertEqual(rcs[1], schnorr.FAIL)
+        self.assertEqual(rcs[2], schnorr.OK)
+
+
+if __name__ == '__main__':
+    # Run tests
+    unittest.main()
@@ -0,0 +1,165 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/* Cross-session verification scheduler definitions */
+
+#include "amcl/batch.h"
+
+// Verify the Schnorr's Proofs in b. If the batch is invalid
+// split it in halves until the invalid proofs are found
+static void verify_schnorr(BATCH_scheduler *s, BATCH_entry **b, int n)
+{
+    int i;
+    int rc;
+
+    octet *V[SCHNORR_BATCH_MAX];
+    octet *C[SCHNORR_BATCH_MAX];
+    octet *E[SCHNORR_BATCH_MAX];
+    octet *P[SCHNORR_BATCH_MAX];
+
+    if (n == 1)
+    {
+        rc = SCHNORR_verify(b[0]->schnorr.V, b[0]->schnorr.C, b[0]->schnorr.E, b[0]->schnorr.P);
+        b[0]->cb(b[0]->session, BATCH_SCHNORR, rc);
+        return;
+    }
+
+    for (i = 0; i < n; i++)
+    {
+        V[i] = b[i]->schnorr.V;
+        C[i] = b[i]->schnorr.C;
+        E[i] = b[i]->schnorr.E;
+        P[i] = b[i]->schnorr.P;
+    }
+
+    rc = SCHNORR_batch_verify(s->RNG, s->msm_window, n, V, C, E, P);
+    if (rc == SCHNORR_OK)
+    {
+        for (i = 0; i < n; i++)
+        {
+            b[i]->cb(b[i]->session, BATCH_SCHNORR, SCHNORR_OK);
+        }
+
+        return;
+    }
+
+    verify_schnorr(s, b, n / 2);
+    verify_schnorr(s, b + n / 2, n - n / 2);
+}
+
+// Verify all the queued proofs and empty the queue
+static void flush_queue(BATCH_scheduler *s)
+{
+    int i;
+    int j;
+
+    BATCH_entry *b[BATCH_MAX_ENTRIES];
+
+    for (i = 0; i < s->n; i++)
+    {
+        b[i] = &(s->entries[i]);
+    }
+
+    for (i = 0; i < s->n; i += SCHNORR_BATCH_MAX)
+    {
+        j = s->n - i;
+        if (j > SCHNORR_BATCH_MAX)
+        {
+            j = SCHNORR_BATCH_MAX;
+        }
+
+        verify_schnorr(s, b + i, j);
+    }
+
+    s->n = 0;
+}
+
+// Append an entry to the queue, making room if necessary
+static BATCH_entry* queue(BATCH_scheduler *s, int type, unsigned long now, void *session, BATCH_callback cb)
+{
+    BATCH_entry *e;
+
+    if (s->n == BATCH_MAX_ENTRIES)
+    {
+        flush_queue(s);
+    }
+
+    e = &(s->entries[s->n]);
+    s->n++;
+
+    e->type = type;
+    e->arrival = now;
+    e->session = session;
+    e->cb = cb;
+
+    return e;
+}
+
+void BATCH_init(BATCH_scheduler *s, csprng *RNG, int flush_size, int msm_window, unsigned long deadline)
+{
+    if (flush_size < 1 || flush_size > BATCH_MAX_ENTRIES)
+    {
+        flush_size = BATCH_MAX_ENTRIES;
+    }
+
+    if (msm_window < 1 || msm_window > SCHNORR_MSM_MAX_WINDOW)
+    {
+        msm_window = SCHNORR_MSM_WINDOW;
+    }
+
+    s->RNG = RNG;
+    s->flush_size = flush_size;
+    s->msm_window = msm_window;
+    s->deadline = deadline;
+    s->n = 0;
+}
+
+void BATCH_add_schnorr(BATCH_scheduler *s, unsigned long now, void *session, BATCH_callback cb, octet *V, octet *C, octet *E, octet *P)
+{
+    BATCH_entry *e = queue(s, BATCH_SCHNORR, now, session, cb);
+
+    e->schnorr.V = V;
+    e->schnorr.C = C;
+    e->schnorr.E = E;
+    e->schnorr.P = P;
+
+    if (s->n >= s->flush_size)
+    {
+        flush_queue(s);
+    }
+}
+
+void BATCH_poll(BATCH_scheduler *s, unsigned long now)
+{
+    if (s->deadline == 0 || s->n == 0)
+    {
+        return;
+    }
+
+    // The entries are in arrival order
+    if (now - s->entries[0].arrival >= s->deadline)
+    {
+        flush_queue(s);
+    }
+}
+
+void BATCH_flush(BATCH_scheduler *s)
+{
+    flush_queue(s);
+}
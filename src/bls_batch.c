@@ -0,0 +1,252 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/* BLS aggregation and batch verification definitions */
+
+#include "amcl/bls_batch.h"
+
+// Hash a message to G1. This is the hash used by BLS_BLS381_SIGN
+static void hash_to_G1(ECP_BLS381 *P, const octet *M)
+{
+    int i;
+    sha3 hs;
+
+    char h[MODBYTES_384_58];
+    octet HM = {0, sizeof(h), h};
+
+    SHA3_init(&hs, SHAKE256);
+
+    for (i = 0; i < M->len; i++)
+    {
+        SHA3_process(&hs, M->val[i]);
+    }
+
+    SHA3_shake(&hs, HM.val, MODBYTES_384_58);
+    HM.len = MODBYTES_384_58;
+
+    ECP_BLS381_mapit(P, &HM);
+}
+
+// Multiply the Miller loops of the pairs (W[i], H[i]) into v
+static void miller_product(FP12_BLS381 *v, ECP2_BLS381 *W, ECP_BLS381 *H, int n)
+{
+    int i;
+    FP12_BLS381 t;
+
+    for (i = 0; i + 1 < n; i += 2)
+    {
+        PAIR_BLS381_double_ate(&t, &W[i], &H[i], &W[i+1], &H[i+1]);
+        FP12_BLS381_mul(v, &t);
+    }
+
+    if (i < n)
+    {
+        PAIR_BLS381_ate(&t, &W[i], &H[i]);
+        FP12_BLS381_mul(v, &t);
+    }
+}
+
+int BLS_BATCH_aggregate_G1(int n, octet *P[], octet *R)
+{
+    int i;
+
+    ECP_BLS381 S;
+    ECP_BLS381 T;
+
+    ECP_BLS381_inf(&S);
+
+    for (i = 0; i < n; i++)
+    {
+        if (!ECP_BLS381_fromOctet(&T, P[i]))
+        {
+            return BLS_BATCH_INVALID_ECP;
+        }
+
+        ECP_BLS381_add(&S, &T);
+    }
+
+    ECP_BLS381_toOctet(R, &S, true);
+
+    return BLS_BATCH_OK;
+}
+
+int BLS_BATCH_aggregate_G2(int n, octet *W[], octet *R)
+{
+    int i;
+
+    ECP2_BLS381 S;
+    ECP2_BLS381 T;
+
+    ECP2_BLS381_inf(&S);
+
+    for (i = 0; i < n; i++)
+    {
+        if (!ECP2_BLS381_fromOctet(&T, W[i]))
+        {
+            return BLS_BATCH_INVALID_ECP;
+        }
+
+        ECP2_BLS381_add(&S, &T);
+    }
+
+    ECP2_BLS381_toOctet(R, &S);
+
+    return BLS_BATCH_OK;
+}
+
+int BLS_BATCH_verify_aggregate(octet *SIG, int n, octet *M[], octet *W[])
+{
+    int i;
+    int j;
+
+    FP12_BLS381 v;
+
+    // Pairs are processed two at a time, the first pair is (G2, -SIG)
+    ECP2_BLS381 PK[2];
+    ECP_BLS381 HM[2];
+
+    if (n < 1)
+    {
+        return BLS_BATCH_FAIL;
+    }
+
+    if (!ECP_BLS381_fromOctet(&HM[0], SIG))
+    {
+        return BLS_BATCH_INVALID_ECP;
+    }
+
+    ECP_BLS381_neg(&HM[0]);
+    ECP2_BLS381_generator(&PK[0]);
+
+    FP12_BLS381_one(&v);
+    j = 1;
+
+    for (i = 0; i < n; i++)
+    {
+        if (!ECP2_BLS381_fromOctet(&PK[j], W[i]))
+        {
+            return BLS_BATCH_INVALID_ECP;
+        }
+
+        hash_to_G1(&HM[j], M[i]);
+        j++;
+
+        if (j == 2)
+        {
+            miller_product(&v, PK, HM, 2);
+            j = 0;
+        }
+    }
+
+    miller_product(&v, PK, HM, j);
+
+    PAIR_BLS381_fexp(&v);
+
+    if (!FP12_BLS381_isunity(&v))
+    {
+        return BLS_BATCH_FAIL;
+    }
+
+    return BLS_BATCH_OK;
+}
+
+int BLS_BATCH_verify(csprng *RNG, int n, octet *SIG[], octet *M[], octet *W[])
+{
+    int i;
+    int j;
+
+    BIG_384_58 q;
+    BIG_384_58 rho;
+
+    FP12_BLS381 v;
+
+    ECP_BLS381 S;
+    ECP_BLS381 T;
+
+    ECP2_BLS381 PK[2];
+    ECP_BLS381 HM[2];
+
+    if (n < 1)
+    {
+        return BLS_BATCH_FAIL;
+    }
+
+    BIG_384_58_rcopy(q, CURVE_Order_BLS381);
+
+    ECP_BLS381_inf(&S);
+
+    FP12_BLS381_one(&v);
+    j = 0;
+
+    for (i = 0; i < n; i++)
+    {
+        if (!ECP_BLS381_fromOctet(&T, SIG[i]))
+        {
+            return BLS_BATCH_INVALID_ECP;
+        }
+
+        if (!ECP2_BLS381_fromOctet(&PK[j], W[i]))
+        {
+            return BLS_BATCH_INVALID_ECP;
+        }
+
+        // Reject signatures outside of the subgroup of order q
+        ECP_BLS381_copy(&HM[j], &T);
+        ECP_BLS381_mul(&HM[j], q);
+        if (!ECP_BLS381_isinf(&HM[j]))
+        {
+            return BLS_BATCH_INVALID_ECP;
+        }
+
+        BIG_384_58_random(rho, RNG);
+        BIG_384_58_mod2m(rho, BLS_BATCH_SECURITY);
+
+        // Accumulate rho_i * S_i
+        ECP_BLS381_mul(&T, rho);
+        ECP_BLS381_add(&S, &T);
+
+        // Pair W_i with rho_i * H(M_i)
+        hash_to_G1(&HM[j], M[i]);
+        ECP_BLS381_mul(&HM[j], rho);
+        j++;
+
+        if (j == 2)
+        {
+            miller_product(&v, PK, HM, 2);
+            j = 0;
+        }
+    }
+
+    // Pair G2 with the combined signature
+    ECP_BLS381_neg(&S);
+    ECP2_BLS381_generator(&PK[j]);
+    ECP_BLS381_copy(&HM[j], &S);
+    j++;
+
+    miller_product(&v, PK, HM, j);
+
+    PAIR_BLS381_fexp(&v);
+
+    if (!FP12_BLS381_isunity(&v))
+    {
+        return BLS_BATCH_FAIL;
+    }
+
+    return BLS_BATCH_OK;
+}
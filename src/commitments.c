@@ -21,29 +21,50 @@ under the License.
 
 /* NM Commitments Definitions */
 
+// Process an octet in the hash
+static void hash_octet(hash256 *sha256, const octet *O)
+{
+    int i;
+
+    for (i = 0; i < O->len; i++)
+    {
+        HASH256_process(sha256, O->val[i]);
+    }
+}
+
+// Process R and output the digest in C
+static void hash_finish(hash256 *sha256, const octet *R, octet *C)
+{
+    hash_octet(sha256, R);
+
+    HASH256_hash(sha256, C->val);
+    C->len = SHA256;
+}
+
 // Compute the hash of X || R
 static void hash(const octet *X, const octet *R, octet *C)
 {
-    int i;
     hash256 sha256;
 
     HASH256_init(&sha256);
+    hash_octet(&sha256, X);
+    hash_finish(&sha256, R, C);
+}
 
-    // Process X
-    for (i = 0; i < X->len; i++)
-    {
-        HASH256_process(&sha256, X->val[i]);
-    }
+// Compute the hash of X_1 || ... || X_n || R
+static void hash_v(int n, octet *X[], const octet *R, octet *C)
+{
+    int i;
+    hash256 sha256;
+
+    HASH256_init(&sha256);
 
-    // Process R
-    for (i = 0; i < R->len; i++)
+    for (i = 0; i < n; i++)
     {
-        HASH256_process(&sha256, R->val[i]);
+        hash_octet(&sha256, X[i]);
     }
 
-    // Output the digest in C
-    HASH256_hash(&sha256, C->val);
-    C->len = SHA256;
+    hash_finish(&sha256, R, C);
 }
 
 // Compute a commitment for the value X
@@ -57,12 +78,20 @@ void COMMITMENTS_NM_commit(csprng *RNG, const octet *X, octet *R, octet *C)
     hash(X, R, C);
 }
 
-// Verify the commitment for the value X
-int COMMITMENTS_NM_decommit(const octet *X, const octet *R, octet *C)
+// Compute a commitment for the value X_1 || ... || X_n
+void COMMITMENTS_NM_commit_v(csprng *RNG, int n, octet *X[], octet *R, octet *C)
 {
-    char d[SHA256];
-    octet D = {0, sizeof(d), d};
+    if (RNG != NULL)
+    {
+        OCT_rand(R, RNG, SHA256);
+    }
+
+    hash_v(n, X, R, C);
+}
 
+// Check the recomputed commitment D against C
+static int check(const octet *R, octet *C, octet *D)
+{
     // Validate the length of R. This step MUST be performed
     // to make the scheme non malleable
     if (R->len != SHA256)
@@ -70,10 +99,7 @@ int COMMITMENTS_NM_decommit(const octet *X, const octet *R, octet *C)
         return COMMITMENTS_FAIL;
     }
 
-    // Verify the commitment
-    hash(X, R, &D);
-
-    if (!OCT_comp(C, &D))
+    if (!OCT_comp(C, D))
     {
         return COMMITMENTS_FAIL;
     }
@@ -81,6 +107,28 @@ int COMMITMENTS_NM_decommit(const octet *X, const octet *R, octet *C)
     return COMMITMENTS_OK;
 }
 
+// Verify the commitment for the value X
+int COMMITMENTS_NM_decommit(const octet *X, const octet *R, octet *C)
+{
+    char d[SHA256];
+    octet D = {0, sizeof(d), d};
+
+    hash(X, R, &D);
+
+    return check(R, C, &D);
+}
+
+// Verify the commitment for the value X_1 || ... || X_n
+int COMMITMENTS_NM_decommit_v(int n, octet *X[], const octet *R, octet *C)
+{
+    char d[SHA256];
+    octet D = {0, sizeof(d), d};
+
+    hash_v(n, X, R, &D);
+
+    return check(R, C, &D);
+}
+
 /* Bit Commitment Setup Definitions */
 
 /*
@@ -292,3 +340,241 @@ void COMMITMENTS_BC_export_public_modulus(COMMITMENTS_BC_pub_modulus *pub, COMMI
     FF_2048_copy(pub->b1, priv->b1, FFLEN_2048);
     FF_2048_copy(pub->N, priv->N, FFLEN_2048);
 }
+
+/* Bit Commitment Modulus Proof Definitions */
+
+// Process the octet encoding of a 2048 bit integer
+static void hash_ff_2048(hash256 *sha, BIG_1024_58 *x)
+{
+    int i;
+
+    char w[FS_2048];
+    octet W = {0, sizeof(w), w};
+
+    FF_2048_toOctet(&W, x, FFLEN_2048);
+
+    for (i = 0; i < W.len; i++)
+    {
+        HASH256_process(sha, W.val[i]);
+    }
+}
+
+// Process an octet
+static void hash_oct(hash256 *sha, const octet *O)
+{
+    int i;
+
+    for (i = 0; i < O->len; i++)
+    {
+        HASH256_process(sha, O->val[i]);
+    }
+}
+
+// Challenge bit for the i-th repetition
+static int dlog_challenge_bit(const octet *E, int i)
+{
+    return (E->val[i / 8] >> (7 - (i % 8))) & 1;
+}
+
+// Compute A = b^r mod N using the CRT, where bp = b mod P and bq = b mod Q.
+// Since b is in G_pq, r is reduced mod p and q
+static void dlog_crt_pow(COMMITMENTS_BC_priv_modulus *m, BIG_1024_58 *A, BIG_1024_58 *bp, BIG_1024_58 *bq, BIG_1024_58 *r, BIG_1024_58 *p, BIG_1024_58 *q)
+{
+    BIG_1024_58 rp[HFLEN_2048];
+    BIG_1024_58 rq[HFLEN_2048];
+    BIG_1024_58 ap[HFLEN_2048];
+    BIG_1024_58 aq[HFLEN_2048];
+
+    FF_2048_dmod(rp, r, p, HFLEN_2048);
+    FF_2048_dmod(rq, r, q, HFLEN_2048);
+
+    FF_2048_ct_pow(ap, bp, rp, m->P, HFLEN_2048, HFLEN_2048);
+    FF_2048_ct_pow(aq, bq, rq, m->Q, HFLEN_2048, HFLEN_2048);
+
+    FF_2048_crt(A, ap, aq, m->P, m->invPQ, m->N, HFLEN_2048);
+
+    // Clean memory
+    FF_2048_zero(rp, HFLEN_2048);
+    FF_2048_zero(rq, HFLEN_2048);
+}
+
+void COMMITMENTS_BC_DLOG_prove(csprng *RNG, COMMITMENTS_BC_priv_modulus *m, const octet *ID, const octet *AD, octet *E, octet *Z)
+{
+    int i;
+    int j;
+
+    hash256 sha;
+
+    BIG_1024_58 p[HFLEN_2048];
+    BIG_1024_58 q[HFLEN_2048];
+    BIG_1024_58 bp[2][HFLEN_2048];
+    BIG_1024_58 bq[2][HFLEN_2048];
+    BIG_1024_58 r[FFLEN_2048];
+    BIG_1024_58 a[FFLEN_2048];
+
+    char w[FS_2048];
+    octet W = {0, sizeof(w), w};
+
+    octet Zi;
+
+    // DLOG of the relations b1 = b0^alpha and b0 = b1^ialpha
+    BIG_1024_58 *x[2] = {m->alpha, m->ialpha};
+
+    // Orders of G_p and G_q. Since P, Q are odd, P>>1 == (P-1) / 2
+    FF_2048_copy(p, m->P, HFLEN_2048);
+    FF_2048_shr(p, HFLEN_2048);
+    FF_2048_copy(q, m->Q, HFLEN_2048);
+    FF_2048_shr(q, HFLEN_2048);
+
+    // Bases of the relations mod P and Q
+    FF_2048_dmod(bp[0], m->b0, m->P, HFLEN_2048);
+    FF_2048_dmod(bq[0], m->b0, m->Q, HFLEN_2048);
+    FF_2048_dmod(bp[1], m->b1, m->P, HFLEN_2048);
+    FF_2048_dmod(bq[1], m->b1, m->Q, HFLEN_2048);
+
+    HASH256_init(&sha);
+    hash_ff_2048(&sha, m->N);
+    hash_ff_2048(&sha, m->b0);
+    hash_ff_2048(&sha, m->b1);
+
+    // Commit to the random values. They are kept
+    // in Z until the challenge is known
+    Z->len = 0;
+
+    for (j = 0; j < 2; j++)
+    {
+        for (i = 0; i < COMMITMENTS_BC_DLOG_ROUNDS; i++)
+        {
+            FF_2048_randomnum(r, m->pq, RNG, FFLEN_2048);
+            dlog_crt_pow(m, a, bp[j], bq[j], r, p, q);
+            hash_ff_2048(&sha, a);
+
+            FF_2048_toOctet(&W, r, FFLEN_2048);
+            OCT_joctet(Z, &W);
+        }
+    }
+
+    hash_oct(&sha, ID);
+    if (AD != NULL)
+    {
+        hash_oct(&sha, AD);
+    }
+
+    HASH256_hash(&sha, E->val);
+    E->len = SHA256;
+
+    // Compute the responses in place
+    for (i = 0; i < 2 * COMMITMENTS_BC_DLOG_ROUNDS; i++)
+    {
+        Zi.len = FS_2048;
+        Zi.max = FS_2048;
+        Zi.val = Z->val + i * FS_2048;
+
+        FF_2048_fromOctet(r, &Zi, FFLEN_2048);
+
+        if (dlog_challenge_bit(E, i))
+        {
+            FF_2048_add(r, r, x[i / COMMITMENTS_BC_DLOG_ROUNDS], FFLEN_2048);
+            FF_2048_norm(r, FFLEN_2048);
+            FF_2048_mod(r, m->pq, FFLEN_2048);
+        }
+
+        FF_2048_toOctet(&Zi, r, FFLEN_2048);
+    }
+
+    // Clean memory
+    FF_2048_zero(p, HFLEN_2048);
+    FF_2048_zero(q, HFLEN_2048);
+    FF_2048_zero(r, FFLEN_2048);
+    OCT_clear(&W);
+}
+
+int COMMITMENTS_BC_DLOG_verify(COMMITMENTS_BC_pub_modulus *m, const octet *ID, const octet *AD, octet *E, octet *Z)
+{
+    int i;
+    int j;
+
+    hash256 sha;
+
+    BIG_1024_58 e[FFLEN_2048];
+    BIG_1024_58 hi[FFLEN_2048];
+    BIG_1024_58 ti[FFLEN_2048];
+    BIG_1024_58 z[FFLEN_2048];
+    BIG_1024_58 a[FFLEN_2048];
+    BIG_1024_58 c[HFLEN_2048];
+
+    char d[SHA256];
+    octet D = {0, sizeof(d), d};
+
+    octet Zi;
+
+    // Bases and targets of the relations b1 = b0^alpha and b0 = b1^ialpha
+    BIG_1024_58 *b[2] = {m->b0, m->b1};
+    BIG_1024_58 *t[2] = {m->b1, m->b0};
+
+    if (E->len != SHA256 || Z->len != COMMITMENTS_BC_DLOG_Z_SIZE)
+    {
+        return COMMITMENTS_FAIL;
+    }
+
+    if (FF_2048_isunity(m->b0, FFLEN_2048) || FF_2048_isunity(m->b1, FFLEN_2048))
+    {
+        return COMMITMENTS_FAIL;
+    }
+
+    // Split the responses as z = z_lo + 2^1024 z_hi
+    FF_2048_zero(e, FFLEN_2048);
+    BIG_1024_58_one(e[HFLEN_2048]);
+
+    HASH256_init(&sha);
+    hash_ff_2048(&sha, m->N);
+    hash_ff_2048(&sha, m->b0);
+    hash_ff_2048(&sha, m->b1);
+
+    for (j = 0; j < 2; j++)
+    {
+        // Values shared by all the repetitions for the relation
+        FF_2048_nt_pow(hi, b[j], e, m->N, FFLEN_2048, FFLEN_2048);
+
+        FF_2048_invmodp(ti, t[j], m->N, FFLEN_2048);
+        if (FF_2048_iszilch(ti, FFLEN_2048))
+        {
+            return COMMITMENTS_FAIL;
+        }
+
+        for (i = 0; i < COMMITMENTS_BC_DLOG_ROUNDS; i++)
+        {
+            Zi.len = FS_2048;
+            Zi.max = FS_2048;
+            Zi.val = Z->val + (j * COMMITMENTS_BC_DLOG_ROUNDS + i) * FS_2048;
+
+            FF_2048_fromOctet(z, &Zi, FFLEN_2048);
+
+            FF_2048_zero(c, HFLEN_2048);
+            if (dlog_challenge_bit(E, j * COMMITMENTS_BC_DLOG_ROUNDS + i))
+            {
+                FF_2048_one(c, HFLEN_2048);
+            }
+
+            // A = b^z_lo * (b^2^1024)^z_hi * t^-c mod N
+            FF_2048_nt_pow_3(a, b[j], z, hi, z + HFLEN_2048, ti, c, m->N, FFLEN_2048, HFLEN_2048);
+            hash_ff_2048(&sha, a);
+        }
+    }
+
+    hash_oct(&sha, ID);
+    if (AD != NULL)
+    {
+        hash_oct(&sha, AD);
+    }
+
+    HASH256_hash(&sha, D.val);
+    D.len = SHA256;
+
+    if (!OCT_comp(E, &D))
+    {
+        return COMMITMENTS_FAIL;
+    }
+
+    return COMMITMENTS_OK;
+}
@@ -44,6 +44,17 @@ static void hash_oct(hash256 *sha, const octet *O)
     }
 }
 
+// Process the segments AD_1, ..., AD_n in place
+static void hash_segments(hash256 *sha, int n, octet *AD[])
+{
+    int i;
+
+    for (i = 0; i < n; i++)
+    {
+        hash_oct(sha, AD[i]);
+    }
+}
+
 // Compute generator bytes with MGF1 using SHA256.
 // sha should be already initialized and contain the
 // partial seed N, the seed is then completed with I2OSP(k, 4).
@@ -92,8 +103,10 @@ void generator(hash256 *sha, int k, octet *O)
  *  X  = H(Z1^r, Z2^r)
  *  e  = H'(N, Z1, Z2, X, ID, AD)
  *  y  = r + (N - phi(N)) * e
+ *
+ *  The additional data is either AD or the segments ADS
  */
-void FACTORING_ZK_prove(csprng *RNG, FACTORING_ZK_modulus *m, const octet *ID, const octet *AD, octet *R, octet *E, octet *Y)
+static void prove(csprng *RNG, FACTORING_ZK_modulus *m, const octet *ID, const octet *AD, int nad, octet *ADS[], octet *R, octet *E, octet *Y)
 {
     int i;
 
@@ -190,6 +203,8 @@ void FACTORING_ZK_prove(csprng *RNG, FACTORING_ZK_modulus *m, const octet *ID, c
         hash_oct(&sha_prime, AD);
     }
 
+    hash_segments(&sha_prime, nad, ADS);
+
     HASH256_hash(&sha_prime, W.val);
     W.len = FACTORING_ZK_B;
 
@@ -219,7 +234,7 @@ void FACTORING_ZK_prove(csprng *RNG, FACTORING_ZK_modulus *m, const octet *ID, c
     FF_2048_zero(hws,   HFLEN_2048);
 }
 
-int FACTORING_ZK_verify(octet *N, octet *E, octet *Y, const octet *ID, const octet *AD)
+static int verify(octet *N, octet *E, octet *Y, const octet *ID, const octet *AD, int nad, octet *ADS[])
 {
     int i;
 
@@ -309,6 +324,8 @@ int FACTORING_ZK_verify(octet *N, octet *E, octet *Y, const octet *ID, const oct
         hash_oct(&sha_prime, AD);
     }
 
+    hash_segments(&sha_prime, nad, ADS);
+
     HASH256_hash(&sha_prime, W.val);
     W.len = FACTORING_ZK_B;
 
@@ -320,6 +337,26 @@ int FACTORING_ZK_verify(octet *N, octet *E, octet *Y, const octet *ID, const oct
     return FACTORING_ZK_OK;
 }
 
+void FACTORING_ZK_prove(csprng *RNG, FACTORING_ZK_modulus *m, const octet *ID, const octet *AD, octet *R, octet *E, octet *Y)
+{
+    prove(RNG, m, ID, AD, 0, NULL, R, E, Y);
+}
+
+void FACTORING_ZK_prove_v(csprng *RNG, FACTORING_ZK_modulus *m, const octet *ID, int n, octet *AD[], octet *R, octet *E, octet *Y)
+{
+    prove(RNG, m, ID, NULL, n, AD, R, E, Y);
+}
+
+int FACTORING_ZK_verify(octet *N, octet *E, octet *Y, const octet *ID, const octet *AD)
+{
+    return verify(N, E, Y, ID, AD, 0, NULL);
+}
+
+int FACTORING_ZK_verify_v(octet *N, octet *E, octet *Y, const octet *ID, int n, octet *AD[])
+{
+    return verify(N, E, Y, ID, NULL, n, AD);
+}
+
 void FACTORING_ZK_modulus_kill(FACTORING_ZK_modulus *m)
 {
     FF_2048_zero(m->p,     HFLEN_2048);
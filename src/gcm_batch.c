@@ -0,0 +1,76 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/* Batch AES-GCM encryption definitions */
+
+#include <string.h>
+#include "amcl/gcm_batch.h"
+
+// Encrypt or decrypt a single record
+static void gcm_record(gcm *g, int decrypt, octet *K, octet *IV, octet *H, octet *IN, octet *OUT, octet *T)
+{
+    GCM_init(g, K->len, K->val, IV->len, IV->val);
+
+    if (H != NULL)
+    {
+        GCM_add_header(g, H->val, H->len);
+    }
+
+    if (decrypt)
+    {
+        GCM_add_cipher(g, OUT->val, IN->val, IN->len);
+    }
+    else
+    {
+        GCM_add_plain(g, OUT->val, IN->val, IN->len);
+    }
+
+    OUT->len = IN->len;
+
+    GCM_finish(g, T->val);
+    T->len = GCM_BATCH_TAG_SIZE;
+}
+
+void GCM_BATCH_encrypt(octet *K, int n, octet *IV[], octet *H[], octet *P[], octet *C[], octet *T[])
+{
+    int i;
+    gcm g;
+
+    for (i = 0; i < n; i++)
+    {
+        gcm_record(&g, 0, K, IV[i], H == NULL ? NULL : H[i], P[i], C[i], T[i]);
+    }
+
+    // Clean memory
+    memset(&g, 0, sizeof(gcm));
+}
+
+void GCM_BATCH_decrypt(octet *K, int n, octet *IV[], octet *H[], octet *C[], octet *P[], octet *T[])
+{
+    int i;
+    gcm g;
+
+    for (i = 0; i < n; i++)
+    {
+        gcm_record(&g, 1, K, IV[i], H == NULL ? NULL : H[i], C[i], P[i], T[i]);
+    }
+
+    // Clean memory
+    memset(&g, 0, sizeof(gcm));
+}
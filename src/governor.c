@@ -0,0 +1,286 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/* Load-adaptive governor for background precomputation definitions */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <float.h>
+#include "amcl/governor.h"
+
+#define LINE_LEN 64
+
+// Close the current window if it is over, updating the moving averages
+static void roll(GOVERNOR_state *g, unsigned long now)
+{
+    int i;
+    unsigned long elapsed = now - g->start;
+
+    GOVERNOR_pool *p;
+
+    if (elapsed < g->window)
+    {
+        return;
+    }
+
+    g->rate += GOVERNOR_WEIGHT * ((double)g->requests / elapsed - g->rate);
+
+    // Without online requests the latency can not be measured and
+    // it decays, so a quiet period resumes offline work
+    if (g->requests == 0)
+    {
+        g->latency *= 1 - GOVERNOR_WEIGHT;
+        if (g->paused && 4 * g->latency < 3 * (double)g->target)
+        {
+            g->paused = 0;
+        }
+    }
+
+    for (i = 0; i < g->n; i++)
+    {
+        p = &(g->pools[i]);
+        p->rate += GOVERNOR_WEIGHT * ((double)p->consumed / elapsed - p->rate);
+        p->consumed = 0;
+    }
+
+    g->start = now - elapsed % g->window;
+    g->used = 0;
+    g->requests = 0;
+}
+
+// Pool closest to running dry among the ones below target
+static int choose(GOVERNOR_state *g)
+{
+    int i;
+    int best = GOVERNOR_IDLE;
+
+    double tte;
+    double fill;
+    double best_tte = DBL_MAX;
+    double best_fill = DBL_MAX;
+
+    GOVERNOR_pool *p;
+
+    for (i = 0; i < g->n; i++)
+    {
+        p = &(g->pools[i]);
+
+        if (p->level >= p->target)
+        {
+            continue;
+        }
+
+        // An empty pool forces the online path to compute the items,
+        // so it is refilled even when offline work is paused
+        if (g->paused && p->level > 0)
+        {
+            continue;
+        }
+
+        tte = (p->rate > 0) ? p->level / p->rate : DBL_MAX;
+        fill = (double)p->level / p->target;
+
+        if (tte < best_tte || (tte == best_tte && fill < best_fill))
+        {
+            best = i;
+            best_tte = tte;
+            best_fill = fill;
+        }
+    }
+
+    return best;
+}
+
+int GOVERNOR_init(GOVERNOR_state *g, unsigned long now, unsigned long budget, unsigned long window, unsigned long target)
+{
+    if (window == 0)
+    {
+        return GOVERNOR_FAIL;
+    }
+
+    memset(g, 0, sizeof(GOVERNOR_state));
+
+    g->budget = budget;
+    g->window = window;
+    g->target = target;
+    g->start = now;
+
+    return GOVERNOR_OK;
+}
+
+int GOVERNOR_add_pool(GOVERNOR_state *g, const char *name, int level, int target)
+{
+    GOVERNOR_pool *p;
+
+    if (g->n >= GOVERNOR_MAX_POOLS || level < 0 || target < 1)
+    {
+        return GOVERNOR_IDLE;
+    }
+
+    p = &(g->pools[g->n]);
+    memset(p, 0, sizeof(GOVERNOR_pool));
+
+    p->name = name;
+    p->level = level;
+    p->target = target;
+
+    return g->n++;
+}
+
+void GOVERNOR_online(GOVERNOR_state *g, unsigned long now, unsigned long latency)
+{
+    roll(g, now);
+
+    g->requests++;
+    g->latency += GOVERNOR_WEIGHT * ((double)latency - g->latency);
+
+    // A target of zero disables the pause
+    if (g->target == 0)
+    {
+        return;
+    }
+
+    // Resume below 3/4 of the target, so the governor does not
+    // oscillate around it
+    if (!g->paused && g->latency > g->target)
+    {
+        g->paused = 1;
+        g->pauses++;
+    }
+    else if (g->paused && 4 * g->latency < 3 * (double)g->target)
+    {
+        g->paused = 0;
+    }
+}
+
+int GOVERNOR_consume(GOVERNOR_state *g, int pool, int n)
+{
+    int taken = n;
+
+    GOVERNOR_pool *p = &(g->pools[pool]);
+
+    // The demand is recorded in full, including the items the
+    // pool could not provide
+    p->consumed += n;
+
+    if (taken > p->level)
+    {
+        taken = p->level;
+        p->dry += n - taken;
+    }
+
+    p->level -= taken;
+
+    return taken;
+}
+
+int GOVERNOR_next(GOVERNOR_state *g, unsigned long now)
+{
+    roll(g, now);
+
+    if (g->used >= g->budget)
+    {
+        g->throttled++;
+        return GOVERNOR_IDLE;
+    }
+
+    return choose(g);
+}
+
+void GOVERNOR_done(GOVERNOR_state *g, int pool, int n, unsigned long cpu)
+{
+    GOVERNOR_pool *p = &(g->pools[pool]);
+
+    p->level += n;
+    p->refilled += n;
+
+    g->used += cpu;
+}
+
+void GOVERNOR_get_stats(GOVERNOR_state *g, unsigned long now, GOVERNOR_stats *s)
+{
+    roll(g, now);
+
+    s->budget = g->budget;
+    s->used = g->used;
+    s->rate = g->rate;
+    s->latency = g->latency;
+    s->paused = g->paused;
+    s->throttled = g->throttled;
+    s->pauses = g->pauses;
+    s->next = (g->used >= g->budget) ? GOVERNOR_IDLE : choose(g);
+    s->n = g->n;
+
+    memcpy(s->pools, g->pools, g->n * sizeof(GOVERNOR_pool));
+}
+
+int GOVERNOR_cgroup_budget(const char *path, int ncpu, int permille, unsigned long *budget, unsigned long *window)
+{
+    unsigned long quota;
+    unsigned long period;
+
+    FILE *fp;
+    char line[LINE_LEN];
+    char max[LINE_LEN];
+    char *end;
+
+    if (ncpu < 1 || permille < 0 || permille > 1000)
+    {
+        return GOVERNOR_FAIL;
+    }
+
+    fp = fopen(path, "r");
+    if (fp == NULL)
+    {
+        return GOVERNOR_FAIL;
+    }
+
+    if (fgets(line, LINE_LEN, fp) == NULL)
+    {
+        fclose(fp);
+        return GOVERNOR_FAIL;
+    }
+
+    fclose(fp);
+
+    // The line is either "quota period" or "max period"
+    if (sscanf(line, "%63s %lu", max, &period) != 2 || period == 0)
+    {
+        return GOVERNOR_FAIL;
+    }
+
+    if (!strcmp(max, "max"))
+    {
+        quota = ncpu * period;
+    }
+    else
+    {
+        quota = strtoul(max, &end, 10);
+        if (*end != '\0')
+        {
+            return GOVERNOR_FAIL;
+        }
+    }
+
+    *budget = quota * permille / 1000;
+    *window = period;
+
+    return GOVERNOR_OK;
+}
@@ -0,0 +1,248 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/* Bulk ECDSA key share generation definitions */
+
+#include "amcl/keygen.h"
+
+// Copy T[d] in P scanning all the entries, so the access pattern
+// does not depend on d
+static void select_entry(ECP_SECP256K1 *P, ECP_SECP256K1 *T, int d)
+{
+    int i;
+    int k;
+
+    chunk mask;
+    chunk *dst = (chunk *)P;
+    chunk *src;
+
+    for (k = 0; k < KEYGEN_ENTRIES; k++)
+    {
+        // mask is all ones if k == d, zero otherwise
+        mask = -(chunk)(((unsigned int)(k ^ d) - 1) >> (8 * sizeof(unsigned int) - 1));
+        src = (chunk *)&T[k];
+
+        for (i = 0; i < (int)(sizeof(ECP_SECP256K1) / sizeof(chunk)); i++)
+        {
+            dst[i] ^= mask & (dst[i] ^ src[i]);
+        }
+    }
+}
+
+// Normalise the points with a single inversion using
+// Montgomery's trick. Points at infinity are left unchanged.
+static void normalise(ECP_SECP256K1 *P, int n)
+{
+    int i;
+
+    FP_SECP256K1 acc;
+    FP_SECP256K1 inv;
+    FP_SECP256K1 zi;
+    FP_SECP256K1 prefix[2 * KEYGEN_CHUNK];
+
+    // prefix[i] = z_0 * ... * z_{i-1}
+    FP_SECP256K1_one(&acc);
+    for (i = 0; i < n; i++)
+    {
+        FP_SECP256K1_copy(&prefix[i], &acc);
+
+        if (!FP_SECP256K1_iszilch(&(P[i].z)))
+        {
+            FP_SECP256K1_mul(&acc, &acc, &(P[i].z));
+        }
+    }
+
+    FP_SECP256K1_inv(&inv, &acc);
+
+    for (i = n - 1; i >= 0; i--)
+    {
+        if (FP_SECP256K1_iszilch(&(P[i].z)))
+        {
+            continue;
+        }
+
+        // zi = z_i^-1 and inv = (z_0 * ... * z_{i-1})^-1
+        FP_SECP256K1_mul(&zi, &inv, &prefix[i]);
+        FP_SECP256K1_mul(&inv, &inv, &(P[i].z));
+
+        FP_SECP256K1_mul(&(P[i].x), &(P[i].x), &zi);
+        FP_SECP256K1_reduce(&(P[i].x));
+        FP_SECP256K1_mul(&(P[i].y), &(P[i].y), &zi);
+        FP_SECP256K1_reduce(&(P[i].y));
+        FP_SECP256K1_one(&(P[i].z));
+    }
+}
+
+void KEYGEN_table_init(KEYGEN_table *t)
+{
+    int j;
+    int d;
+
+    ECP_SECP256K1 B;
+
+    // B = 2^(wj).G
+    ECP_SECP256K1_generator(&B);
+
+    for (j = 0; j < KEYGEN_DIGITS; j++)
+    {
+        ECP_SECP256K1_inf(&(t->T[j][0]));
+
+        for (d = 1; d < KEYGEN_ENTRIES; d++)
+        {
+            ECP_SECP256K1_copy(&(t->T[j][d]), &(t->T[j][d-1]));
+            ECP_SECP256K1_add(&(t->T[j][d]), &B);
+        }
+
+        for (d = 0; d < KEYGEN_WINDOW; d++)
+        {
+            ECP_SECP256K1_dbl(&B);
+        }
+    }
+}
+
+void KEYGEN_table_mul(KEYGEN_table *t, ECP_SECP256K1 *P, BIG_256_56 s)
+{
+    int j;
+    int k;
+    int d;
+
+    ECP_SECP256K1 Q;
+
+    ECP_SECP256K1_inf(P);
+    ECP_SECP256K1_inf(&Q);
+
+    for (j = 0; j < KEYGEN_DIGITS; j++)
+    {
+        d = 0;
+        for (k = KEYGEN_WINDOW - 1; k >= 0; k--)
+        {
+            d = (d << 1) | BIG_256_56_bit(s, j * KEYGEN_WINDOW + k);
+        }
+
+        select_entry(&Q, t->T[j], d);
+        ECP_SECP256K1_add(P, &Q);
+    }
+
+    // Clean memory
+    ECP_SECP256K1_inf(&Q);
+}
+
+int KEYGEN_generate(csprng *RNG, KEYGEN_table *t, int n, const octet *ID, const octet *AD, octet *S, octet *W, octet *C, octet *P)
+{
+    int i;
+    int k;
+    int m;
+
+    BIG_256_56 q;
+    BIG_256_56 s;
+    BIG_256_56 r[KEYGEN_CHUNK];
+
+    ECP_SECP256K1 points[2 * KEYGEN_CHUNK];
+
+    char rb[EGS_SECP256K1];
+    octet RB = {0, sizeof(rb), rb};
+
+    char e[EGS_SECP256K1];
+    octet E = {0, sizeof(e), e};
+
+    octet SI;
+    octet WI;
+    octet CI;
+    octet PI;
+
+    if (n < 1)
+    {
+        return KEYGEN_FAIL;
+    }
+
+    if (S->max < n * EGS_SECP256K1 || P->max < n * EGS_SECP256K1 ||
+            W->max < n * KEYGEN_W_SIZE || C->max < n * KEYGEN_W_SIZE)
+    {
+        return KEYGEN_FAIL;
+    }
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+
+    for (k = 0; k < n; k += KEYGEN_CHUNK)
+    {
+        m = n - k;
+        if (m > KEYGEN_CHUNK)
+        {
+            m = KEYGEN_CHUNK;
+        }
+
+        // Generate the shares and the commitments. The public
+        // shares are in points[0..m-1], the commitments in points[m..2m-1]
+        for (i = 0; i < m; i++)
+        {
+            BIG_256_56_randomnum(s, q, RNG);
+            BIG_256_56_toBytes(S->val + (k + i) * EGS_SECP256K1, s);
+            KEYGEN_table_mul(t, &points[i], s);
+
+            BIG_256_56_randomnum(r[i], q, RNG);
+            KEYGEN_table_mul(t, &points[m + i], r[i]);
+        }
+
+        normalise(points, 2 * m);
+
+        // Output the public values and the Schnorr's Proofs
+        for (i = 0; i < m; i++)
+        {
+            SI.len = EGS_SECP256K1;
+            SI.max = EGS_SECP256K1;
+            SI.val = S->val + (k + i) * EGS_SECP256K1;
+
+            PI.len = 0;
+            PI.max = EGS_SECP256K1;
+            PI.val = P->val + (k + i) * EGS_SECP256K1;
+
+            WI.len = 0;
+            WI.max = KEYGEN_W_SIZE;
+            WI.val = W->val + (k + i) * KEYGEN_W_SIZE;
+
+            CI.len = 0;
+            CI.max = KEYGEN_W_SIZE;
+            CI.val = C->val + (k + i) * KEYGEN_W_SIZE;
+
+            ECP_SECP256K1_toOctet(&WI, &points[i], true);
+            ECP_SECP256K1_toOctet(&CI, &points[m + i], true);
+
+            BIG_256_56_toBytes(RB.val, r[i]);
+            RB.len = EGS_SECP256K1;
+
+            SCHNORR_challenge(&WI, &CI, ID, AD, &E);
+            SCHNORR_prove(&RB, &E, &SI, &PI);
+        }
+    }
+
+    S->len = n * EGS_SECP256K1;
+    P->len = n * EGS_SECP256K1;
+    W->len = n * KEYGEN_W_SIZE;
+    C->len = n * KEYGEN_W_SIZE;
+
+    // Clean memory
+    BIG_256_56_zero(s);
+    for (i = 0; i < KEYGEN_CHUNK; i++)
+    {
+        BIG_256_56_zero(r[i]);
+    }
+    OCT_clear(&RB);
+
+    return KEYGEN_OK;
+}
@@ -0,0 +1,566 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/* Round-batched signing definitions */
+
+#include "amcl/lockstep.h"
+
+// Record the index of the first failure
+static int fail_at(int i, int rc, int *failed)
+{
+    if (failed != NULL)
+    {
+        *failed = i;
+    }
+
+    return rc;
+}
+
+// Resolve the default encryption backend
+static const MTA_BACKEND *backend_or_default(const MTA_BACKEND *backend)
+{
+    if (backend == NULL)
+    {
+        return MTA_BACKEND_DEFAULT;
+    }
+
+    return backend;
+}
+
+/* Message packing definitions */
+
+int LOCKSTEP_pack(int n, octet *V[], octet *M)
+{
+    int i;
+    int len = 0;
+
+    for (i = 0; i < n; i++)
+    {
+        if (V[i]->len > 0xFFFF)
+        {
+            return LOCKSTEP_FAIL;
+        }
+
+        len += 2 + V[i]->len;
+    }
+
+    if (len > M->max)
+    {
+        return LOCKSTEP_FAIL;
+    }
+
+    OCT_clear(M);
+
+    for (i = 0; i < n; i++)
+    {
+        OCT_jint(M, V[i]->len, 2);
+        OCT_joctet(M, V[i]);
+    }
+
+    return LOCKSTEP_OK;
+}
+
+int LOCKSTEP_unpack(octet *M, int n, octet *V[])
+{
+    int i;
+    int len;
+    int offset = 0;
+
+    for (i = 0; i < n; i++)
+    {
+        if (offset + 2 > M->len)
+        {
+            return LOCKSTEP_FAIL;
+        }
+
+        len = ((M->val[offset] & 0xFF) << 8) | (M->val[offset + 1] & 0xFF);
+        offset += 2;
+
+        if (offset + len > M->len || len > V[i]->max)
+        {
+            return LOCKSTEP_FAIL;
+        }
+
+        OCT_clear(V[i]);
+        OCT_jbytes(V[i], M->val + offset, len);
+        offset += len;
+    }
+
+    // Trailing bytes are not allowed
+    if (offset != M->len)
+    {
+        return LOCKSTEP_FAIL;
+    }
+
+    return LOCKSTEP_OK;
+}
+
+/* MTA definitions */
+
+void LOCKSTEP_MTA_CLIENT1(csprng *RNG, PAILLIER_private_key *PRIV, int n, octet *A[], octet *CA[], octet *R[])
+{
+    int i;
+
+    for (i = 0; i < n; i++)
+    {
+        MPC_MTA_CLIENT1_CRT(RNG, PRIV, A[i], CA[i], R[i]);
+    }
+}
+
+void LOCKSTEP_MTA_SERVER(csprng *RNG, PAILLIER_public_key *PUB, int n, octet *B[], octet *CA[], octet *Z[], octet *R[], octet *CB[], octet *BETA[])
+{
+    int i;
+
+    for (i = 0; i < n; i++)
+    {
+        MPC_MTA_SERVER(RNG, PUB, B[i], CA[i], Z[i], R[i], CB[i], BETA[i]);
+    }
+}
+
+void LOCKSTEP_MTA_CLIENT2(PAILLIER_private_key *PRIV, int n, octet *CB[], octet *ALPHA[])
+{
+    int i;
+
+    for (i = 0; i < n; i++)
+    {
+        MPC_MTA_CLIENT2(PRIV, CB[i], ALPHA[i]);
+    }
+}
+
+int LOCKSTEP_MTA_RP_prove(csprng *RNG, PAILLIER_public_key *PUB, PAILLIER_private_key *PRIV, COMMITMENTS_BC_pub_modulus *mod, const MTA_params *params, int n, octet *M[], octet *R[], octet *CT[], MTA_RP_commitment c[], MTA_RP_proof p[])
+{
+    int i;
+    int rc;
+
+    char e[MODBYTES_256_56];
+    octet E = {0, sizeof(e), e};
+
+    MTA_RP_commitment_rv rv;
+
+    for (i = 0; i < n; i++)
+    {
+        rc = MTA_RP_commit_params(RNG, PRIV, mod, params, M[i], &c[i], &rv);
+        if (rc != MTA_OK)
+        {
+            return rc;
+        }
+
+        MTA_RP_challenge_params(PUB, mod, params, CT[i], &c[i], &E);
+        MTA_RP_prove(PRIV, &rv, M[i], R[i], &E, &p[i]);
+
+        // Clean memory
+        MTA_RP_commitment_rv_kill(&rv);
+    }
+
+    return MTA_OK;
+}
+
+int LOCKSTEP_MTA_RP_verify(PAILLIER_public_key *PUB, COMMITMENTS_BC_priv_modulus *mod, const MTA_params *params, int n, octet *CT[], MTA_RP_commitment c[], MTA_RP_proof p[], int *failed)
+{
+    int i;
+    int rc;
+
+    char e[MODBYTES_256_56];
+    octet E = {0, sizeof(e), e};
+
+    COMMITMENTS_BC_pub_modulus pub_mod;
+
+    COMMITMENTS_BC_export_public_modulus(&pub_mod, mod);
+
+    for (i = 0; i < n; i++)
+    {
+        MTA_RP_challenge_params(PUB, &pub_mod, params, CT[i], &c[i], &E);
+
+        rc = MTA_RP_verify_params(PUB, mod, params, CT[i], &E, &c[i], &p[i]);
+        if (rc != MTA_OK)
+        {
+            return fail_at(i, rc, failed);
+        }
+    }
+
+    return MTA_OK;
+}
+
+int LOCKSTEP_MTA_ZK_prove(csprng *RNG, PAILLIER_public_key *PUB, COMMITMENTS_BC_pub_modulus *mod, const MTA_params *params, int n, octet *B[], octet *Z[], octet *R[], octet *CA[], octet *CB[], MTA_ZK_commitment c[], MTA_ZK_proof p[])
+{
+    int i;
+    int rc;
+
+    char e[MODBYTES_256_56];
+    octet E = {0, sizeof(e), e};
+
+    MTA_ZK_commitment_rv rv;
+
+    for (i = 0; i < n; i++)
+    {
+        rc = MTA_ZK_commit_params(RNG, PUB, mod, params, B[i], Z[i], CA[i], &c[i], &rv);
+        if (rc != MTA_OK)
+        {
+            return rc;
+        }
+
+        MTA_ZK_challenge_params(PUB, mod, params, CA[i], CB[i], &c[i], &E);
+        MTA_ZK_prove(PUB, &rv, B[i], Z[i], R[i], &E, &p[i]);
+
+        // Clean memory
+        MTA_ZK_commitment_rv_kill(&rv);
+    }
+
+    return MTA_OK;
+}
+
+int LOCKSTEP_MTA_ZK_verify(PAILLIER_public_key *PUB, PAILLIER_private_key *PRIV, COMMITMENTS_BC_priv_modulus *mod, const MTA_params *params, int n, octet *CA[], octet *CB[], MTA_ZK_commitment c[], MTA_ZK_proof p[], int *failed)
+{
+    int i;
+    int rc;
+
+    char e[MODBYTES_256_56];
+    octet E = {0, sizeof(e), e};
+
+    COMMITMENTS_BC_pub_modulus pub_mod;
+
+    COMMITMENTS_BC_export_public_modulus(&pub_mod, mod);
+
+    for (i = 0; i < n; i++)
+    {
+        MTA_ZK_challenge_params(PUB, &pub_mod, params, CA[i], CB[i], &c[i], &E);
+
+        rc = MTA_ZK_verify_params(PRIV, mod, params, CA[i], CB[i], &E, &c[i], &p[i]);
+        if (rc != MTA_OK)
+        {
+            return fail_at(i, rc, failed);
+        }
+    }
+
+    return MTA_OK;
+}
+
+int LOCKSTEP_MTA_ZKWC_prove(csprng *RNG, PAILLIER_public_key *PUB, COMMITMENTS_BC_pub_modulus *mod, const MTA_params *params, int n, octet *B[], octet *Z[], octet *R[], octet *CA[], octet *CB[], octet *X[], MTA_ZKWC_commitment c[], MTA_ZKWC_proof p[])
+{
+    int i;
+    int rc;
+
+    char e[MODBYTES_256_56];
+    octet E = {0, sizeof(e), e};
+
+    MTA_ZKWC_commitment_rv rv;
+
+    for (i = 0; i < n; i++)
+    {
+        rc = MTA_ZKWC_commit_params(RNG, PUB, mod, params, B[i], Z[i], CA[i], &c[i], &rv);
+        if (rc != MTA_OK)
+        {
+            return rc;
+        }
+
+        MTA_ZKWC_challenge_params(PUB, mod, params, CA[i], CB[i], X[i], &c[i], &E);
+        MTA_ZKWC_prove(PUB, &rv, B[i], Z[i], R[i], &E, &p[i]);
+
+        // Clean memory
+        MTA_ZKWC_commitment_rv_kill(&rv);
+    }
+
+    return MTA_OK;
+}
+
+int LOCKSTEP_MTA_ZKWC_verify(PAILLIER_public_key *PUB, PAILLIER_private_key *PRIV, COMMITMENTS_BC_priv_modulus *mod, const MTA_params *params, int n, octet *CA[], octet *CB[], octet *X[], MTA_ZKWC_commitment c[], MTA_ZKWC_proof p[], int *failed)
+{
+    int i;
+    int rc;
+
+    char e[MODBYTES_256_56];
+    octet E = {0, sizeof(e), e};
+
+    COMMITMENTS_BC_pub_modulus pub_mod;
+
+    COMMITMENTS_BC_export_public_modulus(&pub_mod, mod);
+
+    for (i = 0; i < n; i++)
+    {
+        MTA_ZKWC_challenge_params(PUB, &pub_mod, params, CA[i], CB[i], X[i], &c[i], &E);
+
+        rc = MTA_ZKWC_verify_params(PRIV, mod, params, CA[i], CB[i], X[i], &E, &c[i], &p[i]);
+        if (rc != MTA_OK)
+        {
+            return fail_at(i, rc, failed);
+        }
+    }
+
+    return MTA_OK;
+}
+
+/* Backend MTA definitions */
+
+void LOCKSTEP_MTA_BACKEND_CLIENT1(const MTA_BACKEND *backend, csprng *RNG, void *pub, int n, octet *A[], octet *CA[], octet *R[])
+{
+    int i;
+
+    backend = backend_or_default(backend);
+
+    for (i = 0; i < n; i++)
+    {
+        backend->client1(RNG, pub, A[i], CA[i], R[i]);
+    }
+}
+
+void LOCKSTEP_MTA_BACKEND_SERVER(const MTA_BACKEND *backend, csprng *RNG, void *pub, int n, octet *B[], octet *CA[], octet *Z[], octet *R[], octet *CB[], octet *BETA[])
+{
+    int i;
+
+    backend = backend_or_default(backend);
+
+    for (i = 0; i < n; i++)
+    {
+        backend->server(RNG, pub, B[i], CA[i], Z[i], R[i], CB[i], BETA[i]);
+    }
+}
+
+void LOCKSTEP_MTA_BACKEND_CLIENT2(const MTA_BACKEND *backend, void *priv, int n, octet *CB[], octet *ALPHA[])
+{
+    int i;
+
+    backend = backend_or_default(backend);
+
+    for (i = 0; i < n; i++)
+    {
+        backend->client2(priv, CB[i], ALPHA[i]);
+    }
+}
+
+int LOCKSTEP_MTA_BACKEND_CLIENT1_prove(const MTA_BACKEND *backend, csprng *RNG, void *pub, void *priv, void *vpub, const MTA_params *params, int n, octet *A[], octet *R[], octet *CA[], void *P[])
+{
+    int i;
+    int rc;
+
+    backend = backend_or_default(backend);
+
+    for (i = 0; i < n; i++)
+    {
+        rc = backend->client1_prove(RNG, pub, priv, vpub, params, A[i], R[i], CA[i], P[i]);
+        if (rc != MTA_OK)
+        {
+            return rc;
+        }
+    }
+
+    return MTA_OK;
+}
+
+int LOCKSTEP_MTA_BACKEND_CLIENT1_verify(const MTA_BACKEND *backend, void *pub, void *vpriv, const MTA_params *params, int n, octet *CA[], void *P[], int *failed)
+{
+    int i;
+    int rc;
+
+    backend = backend_or_default(backend);
+
+    for (i = 0; i < n; i++)
+    {
+        rc = backend->client1_verify(pub, vpriv, params, CA[i], P[i]);
+        if (rc != MTA_OK)
+        {
+            return fail_at(i, rc, failed);
+        }
+    }
+
+    return MTA_OK;
+}
+
+int LOCKSTEP_MTA_BACKEND_SERVER_prove(const MTA_BACKEND *backend, csprng *RNG, void *pub, void *vpub, const MTA_params *params, int n, octet *B[], octet *Z[], octet *R[], octet *CA[], octet *CB[], octet *X[], void *P[])
+{
+    int i;
+    int rc;
+
+    backend = backend_or_default(backend);
+
+    for (i = 0; i < n; i++)
+    {
+        rc = backend->server_prove(RNG, pub, vpub, params, B[i], Z[i], R[i], CA[i], CB[i], X == NULL ? NULL : X[i], P[i]);
+        if (rc != MTA_OK)
+        {
+            return rc;
+        }
+    }
+
+    return MTA_OK;
+}
+
+int LOCKSTEP_MTA_BACKEND_SERVER_verify(const MTA_BACKEND *backend, void *pub, void *priv, void *vpriv, const MTA_params *params, int n, octet *CA[], octet *CB[], octet *X[], void *P[], int *failed)
+{
+    int i;
+    int rc;
+
+    backend = backend_or_default(backend);
+
+    for (i = 0; i < n; i++)
+    {
+        rc = backend->server_verify(pub, priv, vpriv, params, CA[i], CB[i], X == NULL ? NULL : X[i], P[i]);
+        if (rc != MTA_OK)
+        {
+            return fail_at(i, rc, failed);
+        }
+    }
+
+    return MTA_OK;
+}
+
+/* MPC definitions */
+
+int LOCKSTEP_INVKGAMMA(int n, octet *KGAMMA1[], octet *KGAMMA2[], octet *INVKGAMMA[])
+{
+    int i;
+
+    BIG_256_56 q;
+    BIG_256_56 w;
+    BIG_256_56 inv;
+    BIG_256_56 kgamma[LOCKSTEP_MAX_SIGNATURES];
+    BIG_256_56 prefix[LOCKSTEP_MAX_SIGNATURES];
+
+    if (n < 1 || n > LOCKSTEP_MAX_SIGNATURES)
+    {
+        return LOCKSTEP_FAIL;
+    }
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+
+    // kgamma = kgamma1 + kgamma2 mod q
+    for (i = 0; i < n; i++)
+    {
+        BIG_256_56_fromBytesLen(kgamma[i], KGAMMA1[i]->val, KGAMMA1[i]->len);
+        BIG_256_56_fromBytesLen(w, KGAMMA2[i]->val, KGAMMA2[i]->len);
+
+        BIG_256_56_add(kgamma[i], kgamma[i], w);
+        BIG_256_56_mod(kgamma[i], q);
+
+        if (BIG_256_56_iszilch(kgamma[i]))
+        {
+            return LOCKSTEP_FAIL;
+        }
+
+        if (i == 0)
+        {
+            BIG_256_56_copy(prefix[0], kgamma[0]);
+        }
+        else
+        {
+            BIG_256_56_modmul(prefix[i], prefix[i-1], kgamma[i], q);
+        }
+    }
+
+    // Invert all the sums with a single inversion
+    BIG_256_56_invmodp(inv, prefix[n-1], q);
+
+    for (i = n - 1; i > 0; i--)
+    {
+        BIG_256_56_modmul(w, inv, prefix[i-1], q);
+        BIG_256_56_modmul(inv, inv, kgamma[i], q);
+
+        BIG_256_56_toBytes(INVKGAMMA[i]->val, w);
+        INVKGAMMA[i]->len = EGS_SECP256K1;
+    }
+
+    BIG_256_56_toBytes(INVKGAMMA[0]->val, inv);
+    INVKGAMMA[0]->len = EGS_SECP256K1;
+
+    return LOCKSTEP_OK;
+}
+
+int LOCKSTEP_R(int n, octet *INVKGAMMA[], octet *GAMMAPT1[], octet *GAMMAPT2[], octet *R[], octet *RP[], int *failed)
+{
+    int i;
+    int rc;
+
+    for (i = 0; i < n; i++)
+    {
+        rc = MPC_R(INVKGAMMA[i], GAMMAPT1[i], GAMMAPT2[i], R[i], RP == NULL ? NULL : RP[i]);
+        if (rc != MPC_OK)
+        {
+            return fail_at(i, rc, failed);
+        }
+    }
+
+    return MPC_OK;
+}
+
+int LOCKSTEP_S(int n, octet *HM[], octet *R[], octet *K[], octet *SIGMA[], octet *S[], int *failed)
+{
+    int i;
+    int rc;
+
+    for (i = 0; i < n; i++)
+    {
+        rc = MPC_S(HM[i], R[i], K[i], SIGMA[i], S[i]);
+        if (rc != MPC_OK)
+        {
+            return fail_at(i, rc, failed);
+        }
+    }
+
+    return MPC_OK;
+}
+
+int LOCKSTEP_PHASE5_commit(csprng *RNG, int n, octet *R[], octet *S[], octet *PHI[], octet *RHO[], octet *V[], octet *A[], int *failed)
+{
+    int i;
+    int rc;
+
+    for (i = 0; i < n; i++)
+    {
+        rc = MPC_PHASE5_commit(RNG, R[i], S[i], PHI[i], RHO[i], V[i], A[i]);
+        if (rc != MPC_OK)
+        {
+            return fail_at(i, rc, failed);
+        }
+    }
+
+    return MPC_OK;
+}
+
+int LOCKSTEP_PHASE5_prove(int n, octet *PHI[], octet *RHO[], octet *V[][2], octet *A[][2], octet *PK, octet *HM[], octet *RX[], octet *U[], octet *T[], int *failed)
+{
+    int i;
+    int rc;
+
+    for (i = 0; i < n; i++)
+    {
+        rc = MPC_PHASE5_prove(PHI[i], RHO[i], V[i], A[i], PK, HM[i], RX[i], U[i], T[i]);
+        if (rc != MPC_OK)
+        {
+            return fail_at(i, rc, failed);
+        }
+    }
+
+    return MPC_OK;
+}
+
+int LOCKSTEP_PHASE5_verify(int n, octet *U[][2], octet *T[][2], int *failed)
+{
+    int i;
+    int rc;
+
+    for (i = 0; i < n; i++)
+    {
+        rc = MPC_PHASE5_verify(U[i], T[i]);
+        if (rc != MPC_OK)
+        {
+            return fail_at(i, rc, failed);
+        }
+    }
+
+    return MPC_OK;
+}
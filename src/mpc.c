@@ -228,6 +228,14 @@ void MPC_INVKGAMMA(const octet *KGAMMA1, const octet *KGAMMA2, octet *INVKGAMMA)
 /* Calculate the r component of the signature */
 int MPC_R(const octet *INVKGAMMA, octet *GAMMAPT1, octet *GAMMAPT2, octet *R, octet *RP)
 {
+    return MPC_R_RECID(INVKGAMMA, GAMMAPT1, GAMMAPT2, R, RP, NULL);
+}
+
+/* Calculate the r component of the signature and its recovery id */
+int MPC_R_RECID(const octet *INVKGAMMA, octet *GAMMAPT1, octet *GAMMAPT2, octet *R, octet *RP, int *RECID)
+{
+    int parity;
+
     BIG_256_56 invkgamma;
     BIG_256_56 q;
     BIG_256_56 rx;
@@ -254,9 +262,19 @@ int MPC_R(const octet *INVKGAMMA, octet *GAMMAPT1, octet *GAMMAPT2, octet *R, oc
     // gammapt1 + gammapt2
     ECP_SECP256K1_add(&gammapt1, &gammapt2);
 
-    // rx, ry = k^{-1}.G
+    // rx, ry = k^{-1}.G. The parity of ry is returned by get
     ECP_SECP256K1_mul(&gammapt1, invkgamma);
-    ECP_SECP256K1_get(rx, rx, &gammapt1);
+    parity = ECP_SECP256K1_get(rx, rx, &gammapt1);
+
+    if (RECID != NULL)
+    {
+        *RECID = parity & 1;
+
+        if (BIG_256_56_comp(rx, q) >= 0)
+        {
+            *RECID |= 2;
+        }
+    }
 
     // r = rx mod q
     BIG_256_56_mod(rx, q);
@@ -349,6 +367,31 @@ void MPC_SUM_S(const octet *S1, const octet *S2, octet *S)
     BIG_256_56_toBytes(S->val, s);
 }
 
+/* Calculate sum of s components of signature with low-s normalisation */
+void MPC_SUM_S_RECID(const octet *S1, const octet *S2, octet *S, int *RECID)
+{
+    BIG_256_56 s;
+    BIG_256_56 q;
+    BIG_256_56 hq;
+
+    // Curve order and its half
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+    BIG_256_56_copy(hq, q);
+    BIG_256_56_shr(hq, 1);
+
+    MPC_SUM_S(S1, S2, S);
+
+    // s = q - s if s > q/2. This negates R, flipping the parity of ry
+    BIG_256_56_fromBytes(s, S->val);
+    if (BIG_256_56_comp(s, hq) > 0)
+    {
+        BIG_256_56_sub(s, q, s);
+        BIG_256_56_toBytes(S->val, s);
+
+        *RECID ^= 1;
+    }
+}
+
 // Add the ECDSA public keys shares
 int MPC_SUM_PK(octet *PK1, octet *PK2, octet *PK)
 {
@@ -41,6 +41,9 @@ static char* curve_order_hex = "fffffffffffffffffffffffffffffffebaaedce6af48a03b
  * used (respectively) to reduce random numbers of size 1024, 3096
  * and 3096. Each of these random numbers has at least 256 bits of
  * extra entropy, making the exploitation of this bias not viable.
+ *
+ * These are the sizes for MTA_PARAMS_DEFAULT. The other parameter
+ * sets replace q^3 with a smaller qES, which only adds entropy.
  */
 
 /* Octet manipulation utilities */
@@ -55,6 +58,96 @@ static void OCT_hash(hash256 *sha, const octet *O)
     }
 }
 
+/* Statistical security parameters */
+
+const MTA_params MTA_PARAMS_DEFAULT = {MTA_PARAMS_BITS_Q, MTA_PARAMS_BITS_Q, 2048};
+const MTA_params MTA_PARAMS_REDUCED = {128, 80, 2048};
+
+int MTA_params_check(const MTA_params *p)
+{
+    if (p->modulus_bits != 8 * FS_2048)
+    {
+        return MTA_FAIL;
+    }
+
+    if (p->challenge_bits < MTA_PARAMS_MIN_CHALLENGE || p->challenge_bits > MTA_PARAMS_BITS_Q)
+    {
+        return MTA_FAIL;
+    }
+
+    if (p->slack_bits < MTA_PARAMS_MIN_SLACK || p->slack_bits > MTA_PARAMS_BITS_Q)
+    {
+        return MTA_FAIL;
+    }
+
+    return MTA_OK;
+}
+
+// Parameters for a run. NULL stands for MTA_PARAMS_DEFAULT
+static const MTA_params *MTA_params_or_default(const MTA_params *p)
+{
+    if (p == NULL)
+    {
+        return &MTA_PARAMS_DEFAULT;
+    }
+
+    return p;
+}
+
+// Factor of the bounds for a bit length. q for MTA_PARAMS_BITS_Q, 2^bits otherwise
+static void MTA_bound_factor(BIG_1024_58 *f, BIG_1024_58 *q, int bits)
+{
+    char oct[HFS_2048];
+    octet OCT = {HFS_2048, sizeof(oct), oct};
+
+    if (bits == MTA_PARAMS_BITS_Q)
+    {
+        FF_2048_copy(f, q, HFLEN_2048);
+        return;
+    }
+
+    memset(oct, 0, sizeof(oct));
+    oct[HFS_2048 - 1 - bits / 8] = 1 << (bits % 8);
+    FF_2048_fromOctet(f, &OCT, HFLEN_2048);
+}
+
+// Bound qES of the secrets hidden by alpha. b has length FFLEN_2048
+// and the bound always fits in its lower HFLEN_2048
+static void MTA_alpha_bound(BIG_1024_58 *b, BIG_1024_58 *q, const MTA_params *params)
+{
+    BIG_1024_58 f[HFLEN_2048];
+    BIG_1024_58 ws[FFLEN_2048];
+
+    MTA_bound_factor(f, q, params->challenge_bits);
+    FF_2048_mul(ws, q, f, HFLEN_2048);
+
+    MTA_bound_factor(f, q, params->slack_bits);
+    FF_2048_mul(b, ws, f, HFLEN_2048);
+}
+
+// Truncate a challenge to the configured length. The challenge
+// is already reduced modulo q, which is the default length
+static void MTA_truncate_challenge(octet *E, const MTA_params *params)
+{
+    int i;
+    int bits = params->challenge_bits;
+
+    if (bits == MTA_PARAMS_BITS_Q)
+    {
+        return;
+    }
+
+    for (i = 0; i < E->len - (bits + 7) / 8; i++)
+    {
+        E->val[i] = 0;
+    }
+
+    if (bits % 8 != 0)
+    {
+        E->val[i] &= (1 << (bits % 8)) - 1;
+    }
+}
+
 /* FF manipulation utilities
  *
  * These might be nice additions to milagro-crypto-c ff API
@@ -113,10 +206,44 @@ void FF_2048_amod(BIG_1024_58 *r, BIG_1024_58 *x, int xlen, BIG_1024_58 *p, int
     FF_2048_copy(r, t, plen);
 }
 
+/* Paillier manipulation utilities
+ *
+ * These might be nice additions to milagro-crypto-c paillier API
+ */
+
+// Compute r^N mod p^2 for the Paillier modulus N = pq.
+//
+// The map r -> r^p mod p^2 only depends on r mod p and it is
+// multiplicative, so the fixed exponent N can be split as
+//
+// r^N = (r^q)^p = ((r mod p)^q mod p)^p mod p^2
+//
+// replacing a 2048 bit exponentiation mod p^2 with a 1024 bit
+// exponentiation mod p and a 1024 bit exponentiation mod p^2.
+// The exponentiations are constant time, since r is usually secret.
+//
+// r has length FFLEN_2048. rn can be the same as r
+void MTA_npow(BIG_1024_58 *rn, BIG_1024_58 *r, BIG_1024_58 *p, BIG_1024_58 *q, BIG_1024_58 *p2)
+{
+    BIG_1024_58 hws[HFLEN_2048];
+
+    // hws = (r mod p)^q mod p
+    FF_2048_dmod(hws, r, p, HFLEN_2048);
+    FF_2048_ct_pow(hws, hws, q, p, HFLEN_2048, HFLEN_2048);
+
+    // rn = hws^p mod p^2
+    FF_2048_zero(rn, FFLEN_2048);
+    FF_2048_copy(rn, hws, HFLEN_2048);
+    FF_2048_ct_pow(rn, rn, p, p2, FFLEN_2048, HFLEN_2048);
+
+    // Clean memory
+    FF_2048_zero(hws, HFLEN_2048);
+}
+
 /* Utilities to hash data for the RP/ZK challenge functions */
 
 // Update the provided has with the public parameters for a RP/ZK run
-void hash_RP_params(hash256 *sha, PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod, BIG_256_56 q)
+void hash_RP_params(hash256 *sha, PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod, const MTA_params *params, BIG_256_56 q)
 {
     char oct[FS_2048];
     octet OCT = {0, sizeof(oct), oct};
@@ -144,6 +271,27 @@ void hash_RP_params(hash256 *sha, PAILLIER_public_key *key, COMMITMENTS_BC_pub_m
     BIG_256_56_toBytes(OCT.val, q);
     OCT.len = EGS_SECP256K1;
     OCT_hash(sha, &OCT);
+
+    // Process the statistical security parameters. The default
+    // parameters are implicit, to keep the original challenges
+    if (params->challenge_bits != MTA_PARAMS_BITS_Q || params->slack_bits != MTA_PARAMS_BITS_Q)
+    {
+        HASH256_process(sha, params->challenge_bits >> 8);
+        HASH256_process(sha, params->challenge_bits & 0xff);
+        HASH256_process(sha, params->slack_bits >> 8);
+        HASH256_process(sha, params->slack_bits & 0xff);
+    }
+}
+
+// Update the provided hash with the segments AD_1, ..., AD_n
+static void hash_segments(hash256 *sha, int n, octet *AD[])
+{
+    int i;
+
+    for (i = 0; i < n; i++)
+    {
+        OCT_hash(sha, AD[i]);
+    }
 }
 
 // Update the provided hash with the data for the MTA ZK commitment
@@ -185,6 +333,88 @@ void MPC_MTA_CLIENT1(csprng *RNG,  PAILLIER_public_key *PUB, octet *A, octet *CA
     OCT_clear(&A1);
 }
 
+// Client MTA first pass using the Paillier private key
+void MPC_MTA_CLIENT1_CRT(csprng *RNG, PAILLIER_private_key *PRIV, octet *A, octet *CA, octet *R)
+{
+    BIG_1024_58 n[FFLEN_2048];
+    BIG_1024_58 n2[2 * FFLEN_2048];
+    BIG_1024_58 invp2q2[FFLEN_2048];
+
+    BIG_1024_58 a[FFLEN_2048];
+    BIG_1024_58 r[2 * FFLEN_2048];
+    BIG_1024_58 cp[FFLEN_2048];
+    BIG_1024_58 cq[FFLEN_2048];
+
+    BIG_1024_58 ws[FFLEN_2048];
+    BIG_1024_58 dws[2 * FFLEN_2048];
+
+    char oct[FS_2048];
+    octet OCT = {0, sizeof(oct), oct};
+
+    FF_2048_mul(n, PRIV->p, PRIV->q, HFLEN_2048);
+    FF_2048_sqr(n2, n, FFLEN_2048);
+    FF_2048_norm(n2, 2 * FFLEN_2048);
+    FF_2048_invmodp(invp2q2, PRIV->p2, PRIV->q2, FFLEN_2048);
+
+    // Read or generate r in [0, .., N]. The ciphertext only
+    // depends on r mod N, so this matches PAILLIER_ENCRYPT
+    FF_2048_zero(r, 2 * FFLEN_2048);
+
+    if (RNG != NULL)
+    {
+        FF_2048_randomnum(r, n, RNG, FFLEN_2048);
+    }
+    else
+    {
+        FF_2048_fromOctet(dws, R, 2 * FFLEN_2048);
+        FF_2048_dmod(r, dws, n, FFLEN_2048);
+    }
+
+    // Read a
+    OCT_copy(&OCT, A);
+    OCT_pad(&OCT, FS_2048);
+    FF_2048_fromOctet(a, &OCT, FFLEN_2048);
+
+    // Compute g^a * r^N mod p^2, with g^a = 1 + aN
+    FF_2048_mul(dws, a, n, FFLEN_2048);
+    FF_2048_dmod(ws, dws, PRIV->p2, FFLEN_2048);
+    FF_2048_inc(ws, 1, FFLEN_2048);
+    FF_2048_norm(ws, FFLEN_2048);
+
+    MTA_npow(cp, r, PRIV->p, PRIV->q, PRIV->p2);
+    FF_2048_mul(dws, cp, ws, FFLEN_2048);
+    FF_2048_dmod(cp, dws, PRIV->p2, FFLEN_2048);
+
+    // Compute g^a * r^N mod q^2, with g^a = 1 + aN
+    FF_2048_mul(dws, a, n, FFLEN_2048);
+    FF_2048_dmod(ws, dws, PRIV->q2, FFLEN_2048);
+    FF_2048_inc(ws, 1, FFLEN_2048);
+    FF_2048_norm(ws, FFLEN_2048);
+
+    MTA_npow(cq, r, PRIV->q, PRIV->p, PRIV->q2);
+    FF_2048_mul(dws, cq, ws, FFLEN_2048);
+    FF_2048_dmod(cq, dws, PRIV->q2, FFLEN_2048);
+
+    // Combine the ciphertext mod N^2 using CRT
+    FF_2048_crt(dws, cp, cq, PRIV->p2, invp2q2, n2, FFLEN_2048);
+    FF_2048_toOctet(CA, dws, 2 * FFLEN_2048);
+
+    // Output R for Debug
+    if (R != NULL && RNG != NULL)
+    {
+        FF_2048_toOctet(R, r, 2 * FFLEN_2048);
+    }
+
+    // Clean memory
+    FF_2048_zero(a,   FFLEN_2048);
+    FF_2048_zero(r,   2 * FFLEN_2048);
+    FF_2048_zero(cp,  FFLEN_2048);
+    FF_2048_zero(cq,  FFLEN_2048);
+    FF_2048_zero(ws,  FFLEN_2048);
+    FF_2048_zero(dws, 2 * FFLEN_2048);
+    OCT_clear(&OCT);
+}
+
 // Client MtA second pass
 void MPC_MTA_CLIENT2(PAILLIER_private_key *PRIV, octet *CB, octet *ALPHA)
 {
@@ -327,18 +557,37 @@ void MPC_SUM_MTA(const octet *A, const octet *B, const octet *ALPHA, const octet
 }
 
 void MTA_ZK_random_challenge(csprng *RNG, octet *E)
+{
+    MTA_ZK_random_challenge_params(RNG, &MTA_PARAMS_DEFAULT, E);
+}
+
+int MTA_ZK_random_challenge_params(csprng *RNG, const MTA_params *params, octet *E)
 {
     BIG_256_56 e;
     BIG_256_56 q;
 
+    params = MTA_params_or_default(params);
+    if (MTA_params_check(params) != MTA_OK)
+    {
+        return MTA_FAIL;
+    }
+
     BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
     BIG_256_56_randomnum(e, q, RNG);
 
     BIG_256_56_toBytes(E->val, e);
     E->len = EGS_SECP256K1;
+    MTA_truncate_challenge(E, params);
+
+    return MTA_OK;
+}
+
+void MTA_RP_commit(csprng *RNG, PAILLIER_private_key *key, COMMITMENTS_BC_pub_modulus *mod, octet *M, MTA_RP_commitment *c, MTA_RP_commitment_rv *rv)
+{
+    MTA_RP_commit_params(RNG, key, mod, &MTA_PARAMS_DEFAULT, M, c, rv);
 }
 
-void MTA_RP_commit(csprng *RNG, PAILLIER_private_key *key, COMMITMENTS_BC_pub_modulus *mod,  octet *M, MTA_RP_commitment *c, MTA_RP_commitment_rv *rv)
+int MTA_RP_commit_params(csprng *RNG, PAILLIER_private_key *key, COMMITMENTS_BC_pub_modulus *mod, const MTA_params *params, octet *M, MTA_RP_commitment *c, MTA_RP_commitment_rv *rv)
 {
     BIG_1024_58 n[FFLEN_2048];
     BIG_1024_58 q[HFLEN_2048];
@@ -354,6 +603,12 @@ void MTA_RP_commit(csprng *RNG, PAILLIER_private_key *key, COMMITMENTS_BC_pub_mo
     char oct[2 * FS_2048];
     octet OCT = {0, sizeof(oct), oct};
 
+    params = MTA_params_or_default(params);
+    if (MTA_params_check(params) != MTA_OK)
+    {
+        return MTA_FAIL;
+    }
+
     // Curve order
     OCT_fromHex(&OCT, curve_order_hex);
     OCT_pad(&OCT, HFS_2048);
@@ -366,10 +621,9 @@ void MTA_RP_commit(csprng *RNG, PAILLIER_private_key *key, COMMITMENTS_BC_pub_mo
 
     if (RNG != NULL)
     {
-        FF_2048_sqr(ws1, q, HFLEN_2048);
-        FF_2048_mul(ws2, q, ws1, HFLEN_2048);
+        MTA_alpha_bound(ws2, q, params);
 
-        // Generate alpha in [0, .., q^3]
+        // Generate alpha in [0, .., qES]
         // See Remark 1 at the top for more information
         FF_2048_zero(rv->alpha, FFLEN_2048);
         FF_2048_random(rv->alpha, RNG, HFLEN_2048);
@@ -378,7 +632,7 @@ void MTA_RP_commit(csprng *RNG, PAILLIER_private_key *key, COMMITMENTS_BC_pub_mo
         // Generate beta in [0, .., N]
         FF_2048_randomnum(rv->beta, n, RNG, FFLEN_2048);
 
-        // Generate gamma in [0, .., Nt * q^3]
+        // Generate gamma in [0, .., Nt * qES]
         // See Remark 1 at the top for more information
         FF_2048_amul(dws1, ws2, HFLEN_2048, mod->N, FFLEN_2048);
         FF_2048_random(rv->gamma, RNG, FFLEN_2048 + HFLEN_2048);
@@ -407,14 +661,14 @@ void MTA_RP_commit(csprng *RNG, PAILLIER_private_key *key, COMMITMENTS_BC_pub_mo
     FF_2048_zero(dws2, 2 * FFLEN_2048);
     FF_2048_amul(dws2, rv->alpha, HFLEN_2048, n, FFLEN_2048);
 
-    FF_2048_ct_pow(ws1, rv->beta, n, key->p2, FFLEN_2048, FFLEN_2048);
+    MTA_npow(ws1, rv->beta, key->p, key->q, key->p2);
     FF_2048_dmod(ws3, dws2, key->p2, FFLEN_2048);
     FF_2048_inc(ws3, 1, FFLEN_2048);
     FF_2048_norm(ws3, FFLEN_2048);
     FF_2048_mul(dws1, ws1, ws3, FFLEN_2048);
     FF_2048_dmod(ws1, dws1, key->p2, FFLEN_2048);
 
-    FF_2048_ct_pow(ws2, rv->beta, n, key->q2, FFLEN_2048, FFLEN_2048);
+    MTA_npow(ws2, rv->beta, key->q, key->p, key->q2);
     FF_2048_dmod(ws3, dws2, key->q2, FFLEN_2048);
     FF_2048_inc(ws3, 1, FFLEN_2048);
     FF_2048_norm(ws3, FFLEN_2048);
@@ -432,9 +686,26 @@ void MTA_RP_commit(csprng *RNG, PAILLIER_private_key *key, COMMITMENTS_BC_pub_mo
     FF_2048_zero(ws1, HFLEN_2048);
     FF_2048_zero(ws2, HFLEN_2048);
     FF_2048_zero(ws3, HFLEN_2048);
+
+    return MTA_OK;
 }
 
 void MTA_RP_challenge(PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod, const octet *CT, MTA_RP_commitment *c, octet *E)
+{
+    MTA_RP_challenge_params(key, mod, &MTA_PARAMS_DEFAULT, CT, c, E);
+}
+
+int MTA_RP_challenge_params(PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod, const MTA_params *params, const octet *CT, MTA_RP_commitment *c, octet *E)
+{
+    return MTA_RP_challenge_v_params(key, mod, params, CT, c, 0, NULL, E);
+}
+
+void MTA_RP_challenge_v(PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod, const octet *CT, MTA_RP_commitment *c, int n, octet *AD[], octet *E)
+{
+    MTA_RP_challenge_v_params(key, mod, &MTA_PARAMS_DEFAULT, CT, c, n, AD, E);
+}
+
+int MTA_RP_challenge_v_params(PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod, const MTA_params *params, const octet *CT, MTA_RP_commitment *c, int n, octet *AD[], octet *E)
 {
     hash256 sha;
 
@@ -444,13 +715,19 @@ void MTA_RP_challenge(PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod,
     BIG_256_56 q;
     BIG_256_56 t;
 
+    params = MTA_params_or_default(params);
+    if (MTA_params_check(params) != MTA_OK)
+    {
+        return MTA_FAIL;
+    }
+
     // Load curve order
     BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
 
     HASH256_init(&sha);
 
     /* Bind to public parameters */
-    hash_RP_params(&sha, key, mod, q);
+    hash_RP_params(&sha, key, mod, params, q);
 
     /* Bind to proof input */
 
@@ -471,6 +748,9 @@ void MTA_RP_challenge(PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod,
     FF_2048_toOctet(&OCT, c->w, FFLEN_2048);
     OCT_hash(&sha, &OCT);
 
+    /* Bind to additional data */
+    hash_segments(&sha, n, AD);
+
     /* Output */
     HASH256_hash(&sha, OCT.val);
     BIG_256_56_fromBytesLen(t, OCT.val, SHA256);
@@ -478,6 +758,10 @@ void MTA_RP_challenge(PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod,
 
     BIG_256_56_toBytes(E->val, t);
     E->len = EGS_SECP256K1;
+
+    MTA_truncate_challenge(E, params);
+
+    return MTA_OK;
 }
 
 void MTA_RP_prove(PAILLIER_private_key *key, MTA_RP_commitment_rv *rv, octet *M, octet *R, octet *E, MTA_RP_proof *p)
@@ -553,15 +837,13 @@ void MTA_RP_prove(PAILLIER_private_key *key, MTA_RP_commitment_rv *rv, octet *M,
 // Utility function to compute the triple power for verification purposes.
 // h1^s1 * h2^s2 * z^(-e) mod P
 //
-// h1, h2 are reduced modulo P
+// h1, h2 and z must be already reduced modulo P
 // s1 is reduced modulo P-1 if indicated
 // s2 is reduced modulo P-1
-// z is reduced and inverted modulo P
 // e is left as is
-void MTA_triple_power(BIG_1024_58 *proof, BIG_1024_58 *h1, BIG_1024_58 *h2, BIG_1024_58 *s1, BIG_1024_58 *s2, BIG_1024_58 *z, BIG_1024_58 *e, BIG_1024_58 *p, int reduce_s1)
+void MTA_triple_power_reduced(BIG_1024_58 *proof, BIG_1024_58 *h1, BIG_1024_58 *h2, BIG_1024_58 *s1, BIG_1024_58 *s2, BIG_1024_58 *z, BIG_1024_58 *e, BIG_1024_58 *p, int reduce_s1)
 {
     BIG_1024_58 hws1[HFLEN_2048];
-    BIG_1024_58 hws2[HFLEN_2048];
     BIG_1024_58 hws3[HFLEN_2048];
     BIG_1024_58 hws4[HFLEN_2048];
     BIG_1024_58 eneg[HFLEN_2048];
@@ -581,26 +863,56 @@ void MTA_triple_power(BIG_1024_58 *proof, BIG_1024_58 *h1, BIG_1024_58 *h2, BIG_
         FF_2048_copy(hws3, s1, HFLEN_2048);
     }
 
-    FF_2048_dmod(hws1, h1, p, HFLEN_2048);
-    FF_2048_dmod(hws2, h2, p, HFLEN_2048);
-
-    FF_2048_dmod(proof, z, p, HFLEN_2048);
-    FF_2048_ct_pow_3(proof, hws1, hws3, hws2, hws4, proof, eneg, p, HFLEN_2048, HFLEN_2048);
+    FF_2048_ct_pow_3(proof, h1, hws3, h2, hws4, z, eneg, p, HFLEN_2048, HFLEN_2048);
 
     // Clean memory
     FF_2048_zero(hws1, HFLEN_2048);
-    FF_2048_zero(hws2, HFLEN_2048);
     FF_2048_zero(hws3, HFLEN_2048);
     FF_2048_zero(hws4, HFLEN_2048);
 }
 
-int MTA_RP_verify(PAILLIER_public_key *key, COMMITMENTS_BC_priv_modulus *mod, octet *CT, octet *E, MTA_RP_commitment *co, MTA_RP_proof *p)
+void MTA_RP_verify_prepare(PAILLIER_public_key *key, COMMITMENTS_BC_priv_modulus *mod, octet *CT, MTA_RP_commitment *c, MTA_RP_verify_ctx *ctx)
+{
+    MTA_RP_verify_prepare_params(key, mod, &MTA_PARAMS_DEFAULT, CT, c, ctx);
+}
+
+int MTA_RP_verify_prepare_params(PAILLIER_public_key *key, COMMITMENTS_BC_priv_modulus *mod, const MTA_params *params, octet *CT, MTA_RP_commitment *c, MTA_RP_verify_ctx *ctx)
+{
+    // Keep the parameters for MTA_RP_verify_finish
+    params = MTA_params_or_default(params);
+    ctx->params = *params;
+
+    if (MTA_params_check(params) != MTA_OK)
+    {
+        return MTA_FAIL;
+    }
+
+    // Reduce the BC modulus bases and the commitment modulo P and Q
+    FF_2048_dmod(ctx->b0p, mod->b0, mod->P, HFLEN_2048);
+    FF_2048_dmod(ctx->b1p, mod->b1, mod->P, HFLEN_2048);
+    FF_2048_dmod(ctx->zp,  c->z,    mod->P, HFLEN_2048);
+    FF_2048_dmod(ctx->wp,  c->w,    mod->P, HFLEN_2048);
+
+    FF_2048_dmod(ctx->b0q, mod->b0, mod->Q, HFLEN_2048);
+    FF_2048_dmod(ctx->b1q, mod->b1, mod->Q, HFLEN_2048);
+    FF_2048_dmod(ctx->zq,  c->z,    mod->Q, HFLEN_2048);
+    FF_2048_dmod(ctx->wq,  c->w,    mod->Q, HFLEN_2048);
+
+    // Invert the ciphertext modulo N^2
+    FF_4096_fromOctet(ctx->ctinv, CT, FFLEN_4096);
+    FF_4096_invmodp(ctx->ctinv, ctx->ctinv, key->n2, FFLEN_4096);
+
+    FF_4096_copy(ctx->u, c->u, FFLEN_4096);
+
+    return MTA_OK;
+}
+
+int MTA_RP_verify_finish(PAILLIER_public_key *key, COMMITMENTS_BC_priv_modulus *mod, octet *E, MTA_RP_verify_ctx *ctx, MTA_RP_proof *p)
 {
     int fail;
 
     BIG_1024_58 ws[FFLEN_2048];
-    BIG_1024_58 hws1[HFLEN_2048];
-    BIG_1024_58 hws2[HFLEN_2048];
+    BIG_1024_58 hws[HFLEN_2048];
 
     BIG_1024_58 wp_proof[HFLEN_2048];
     BIG_1024_58 wq_proof[HFLEN_2048];
@@ -616,6 +928,11 @@ int MTA_RP_verify(PAILLIER_public_key *key, COMMITMENTS_BC_priv_modulus *mod, oc
     char oct[FS_2048];
     octet OCT = {0, sizeof(oct), oct};
 
+    if (MTA_params_check(&(ctx->params)) != MTA_OK)
+    {
+        return MTA_FAIL;
+    }
+
     // Read challenge
     OCT_copy(&OCT, E);
     OCT_pad(&OCT, HFS_2048);
@@ -623,12 +940,11 @@ int MTA_RP_verify(PAILLIER_public_key *key, COMMITMENTS_BC_priv_modulus *mod, oc
     OCT_pad(&OCT, HFS_4096);
     FF_4096_fromOctet(e_4096, &OCT, HFLEN_4096);
 
-    // Read q and compute q^3
+    // Read q and compute qES
     OCT_fromHex(&OCT, curve_order_hex);
     OCT_pad(&OCT, HFS_2048);
-    FF_2048_fromOctet(hws1, &OCT, HFLEN_2048);
-    FF_2048_sqr(ws, hws1, HFLEN_2048);
-    FF_2048_mul(ws, ws, hws1, HFLEN_2048);
+    FF_2048_fromOctet(hws, &OCT, HFLEN_2048);
+    MTA_alpha_bound(ws, hws, &(ctx->params));
 
     if (FF_2048_comp(p->s1, ws, FFLEN_2048) > 0)
     {
@@ -636,20 +952,14 @@ int MTA_RP_verify(PAILLIER_public_key *key, COMMITMENTS_BC_priv_modulus *mod, oc
     }
 
     // Split computation of proof for w using CRT.
-    MTA_triple_power(wp_proof, mod->b0, mod->b1, p->s1, p->s2, co->z, e, mod->P, false);
-    MTA_triple_power(wq_proof, mod->b0, mod->b1, p->s1, p->s2, co->z, e, mod->Q, false);
-
-    // Reduce w mod P and Q for comparison
-    FF_2048_dmod(hws1, co->w, mod->P, HFLEN_2048);
-    FF_2048_dmod(hws2, co->w, mod->Q, HFLEN_2048);
+    MTA_triple_power_reduced(wp_proof, ctx->b0p, ctx->b1p, p->s1, p->s2, ctx->zp, e, mod->P, false);
+    MTA_triple_power_reduced(wq_proof, ctx->b0q, ctx->b1q, p->s1, p->s2, ctx->zq, e, mod->Q, false);
 
     // Compare the results modulo P and Q
     // since w == w' mod PQ <==> w == w' mod P & w == w' mod Q
-    fail = (FF_2048_comp(hws1, wp_proof, HFLEN_2048) != 0) || (FF_2048_comp(hws2, wq_proof, HFLEN_2048) != 0);
+    fail = (FF_2048_comp(ctx->wp, wp_proof, HFLEN_2048) != 0) || (FF_2048_comp(ctx->wq, wq_proof, HFLEN_2048) != 0);
 
     // Clean memory
-    FF_2048_zero(hws1, HFLEN_2048);
-    FF_2048_zero(hws2, HFLEN_2048);
     FF_2048_zero(wp_proof, HFLEN_2048);
     FF_2048_zero(wq_proof, HFLEN_2048);
 
@@ -663,18 +973,15 @@ int MTA_RP_verify(PAILLIER_public_key *key, COMMITMENTS_BC_priv_modulus *mod, oc
     OCT_pad(&OCT, HFS_4096);
     FF_4096_fromOctet(s1, &OCT, HFLEN_4096);
 
-    FF_4096_fromOctet(ws1_4096, CT, FFLEN_4096);
-    FF_4096_invmodp(ws1_4096, ws1_4096, key->n2, FFLEN_4096);
-
     // u_proof = g^s1 * s^N * c^(-e) mod N^2
     FF_4096_mul(ws2_4096, key->n, s1, HFLEN_4096);
     FF_4096_inc(ws2_4096, 1, FFLEN_4096);
     FF_4096_norm(ws2_4096, FFLEN_4096);
-    FF_4096_nt_pow_2(ws1_4096, p->s, key->n, ws1_4096, e_4096, key->n2, FFLEN_4096, HFLEN_4096);
+    FF_4096_nt_pow_2(ws1_4096, p->s, key->n, ctx->ctinv, e_4096, key->n2, FFLEN_4096, HFLEN_4096);
     FF_4096_mul(dws_4096, ws1_4096, ws2_4096, FFLEN_4096);
     FF_4096_dmod(ws1_4096, dws_4096, key->n2, FFLEN_4096);
 
-    if(FF_4096_comp(ws1_4096, co->u, FFLEN_4096) != 0)
+    if(FF_4096_comp(ws1_4096, ctx->u, FFLEN_4096) != 0)
     {
         return MTA_FAIL;
     }
@@ -682,6 +989,41 @@ int MTA_RP_verify(PAILLIER_public_key *key, COMMITMENTS_BC_priv_modulus *mod, oc
     return MTA_OK;
 }
 
+int MTA_RP_verify(PAILLIER_public_key *key, COMMITMENTS_BC_priv_modulus *mod, octet *CT, octet *E, MTA_RP_commitment *co, MTA_RP_proof *p)
+{
+    return MTA_RP_verify_params(key, mod, &MTA_PARAMS_DEFAULT, CT, E, co, p);
+}
+
+int MTA_RP_verify_params(PAILLIER_public_key *key, COMMITMENTS_BC_priv_modulus *mod, const MTA_params *params, octet *CT, octet *E, MTA_RP_commitment *co, MTA_RP_proof *p)
+{
+    int rc;
+
+    MTA_RP_verify_ctx ctx;
+
+    rc = MTA_RP_verify_prepare_params(key, mod, params, CT, co, &ctx);
+    if (rc == MTA_OK)
+    {
+        rc = MTA_RP_verify_finish(key, mod, E, &ctx, p);
+    }
+
+    // Clean memory
+    MTA_RP_verify_ctx_kill(&ctx);
+
+    return rc;
+}
+
+void MTA_RP_verify_ctx_kill(MTA_RP_verify_ctx *ctx)
+{
+    FF_2048_zero(ctx->b0p, HFLEN_2048);
+    FF_2048_zero(ctx->b1p, HFLEN_2048);
+    FF_2048_zero(ctx->zp,  HFLEN_2048);
+    FF_2048_zero(ctx->wp,  HFLEN_2048);
+    FF_2048_zero(ctx->b0q, HFLEN_2048);
+    FF_2048_zero(ctx->b1q, HFLEN_2048);
+    FF_2048_zero(ctx->zq,  HFLEN_2048);
+    FF_2048_zero(ctx->wq,  HFLEN_2048);
+}
+
 void MTA_RP_commitment_toOctets(octet *Z, octet *U, octet *W, MTA_RP_commitment *c)
 {
     FF_2048_toOctet(Z, c->z, FFLEN_2048);
@@ -721,7 +1063,12 @@ void MTA_RP_commitment_rv_kill(MTA_RP_commitment_rv *rv)
     FF_2048_zero(rv->rho,   FFLEN_2048 + HFLEN_2048);
 }
 
-void MTA_ZK_commit(csprng *RNG, PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod,  octet *X, octet *Y, octet *C1, MTA_ZK_commitment *c, MTA_ZK_commitment_rv *rv)
+void MTA_ZK_commit(csprng *RNG, PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod, octet *X, octet *Y, octet *C1, MTA_ZK_commitment *c, MTA_ZK_commitment_rv *rv)
+{
+    MTA_ZK_commit_params(RNG, key, mod, &MTA_PARAMS_DEFAULT, X, Y, C1, c, rv);
+}
+
+int MTA_ZK_commit_params(csprng *RNG, PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod, const MTA_params *params, octet *X, octet *Y, octet *C1, MTA_ZK_commitment *c, MTA_ZK_commitment_rv *rv)
 {
     BIG_1024_58 q[HFLEN_2048];
     BIG_1024_58 q3[FFLEN_2048];
@@ -737,6 +1084,12 @@ void MTA_ZK_commit(csprng *RNG, PAILLIER_public_key *key, COMMITMENTS_BC_pub_mod
     char oct[2 * FS_2048];
     octet OCT = {0, sizeof(oct), oct};
 
+    params = MTA_params_or_default(params);
+    if (MTA_params_check(params) != MTA_OK)
+    {
+        return MTA_FAIL;
+    }
+
     // Curve order
     OCT_fromHex(&OCT, curve_order_hex);
     OCT_pad(&OCT, HFS_2048);
@@ -747,10 +1100,9 @@ void MTA_ZK_commit(csprng *RNG, PAILLIER_public_key *key, COMMITMENTS_BC_pub_mod
 
     if (RNG != NULL)
     {
-        FF_2048_sqr(q3, q, HFLEN_2048);
-        FF_2048_mul(q3, q, q3, HFLEN_2048);
+        MTA_alpha_bound(q3, q, params);
 
-        // Generate alpha in [0, .., q^3]
+        // Generate alpha in [0, .., qES]
         // See Remark 1 at the top for more information
         FF_2048_zero(rv->alpha, FFLEN_2048);
         FF_2048_random(rv->alpha, RNG, HFLEN_2048);
@@ -778,7 +1130,7 @@ void MTA_ZK_commit(csprng *RNG, PAILLIER_public_key *key, COMMITMENTS_BC_pub_mod
         FF_2048_random(rv->sigma, RNG, FFLEN_2048 + HFLEN_2048);
         FF_2048_mod(rv->sigma, tws, FFLEN_2048 + HFLEN_2048);
 
-        // Generate rho1 in [0, .., Nt * q^3]
+        // Generate rho1 in [0, .., Nt * qES]
         // See Remark 1 at the top for more information
         FF_2048_amul(tws, q3, HFLEN_2048, mod->N, FFLEN_2048);
         FF_2048_random(rv->rho1, RNG, FFLEN_2048 + HFLEN_2048);
@@ -835,9 +1187,26 @@ void MTA_ZK_commit(csprng *RNG, PAILLIER_public_key *key, COMMITMENTS_BC_pub_mod
     FF_4096_zero(alpha, HFLEN_4096);
     FF_4096_zero(beta,  FFLEN_4096);
     FF_4096_zero(gamma, HFLEN_4096);
+
+    return MTA_OK;
 }
 
 void MTA_ZK_challenge(PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod, const octet *C1, const octet *C2, MTA_ZK_commitment *c, octet *E)
+{
+    MTA_ZK_challenge_params(key, mod, &MTA_PARAMS_DEFAULT, C1, C2, c, E);
+}
+
+int MTA_ZK_challenge_params(PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod, const MTA_params *params, const octet *C1, const octet *C2, MTA_ZK_commitment *c, octet *E)
+{
+    return MTA_ZK_challenge_v_params(key, mod, params, C1, C2, c, 0, NULL, E);
+}
+
+void MTA_ZK_challenge_v(PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod, const octet *C1, const octet *C2, MTA_ZK_commitment *c, int n, octet *AD[], octet *E)
+{
+    MTA_ZK_challenge_v_params(key, mod, &MTA_PARAMS_DEFAULT, C1, C2, c, n, AD, E);
+}
+
+int MTA_ZK_challenge_v_params(PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod, const MTA_params *params, const octet *C1, const octet *C2, MTA_ZK_commitment *c, int n, octet *AD[], octet *E)
 {
     hash256 sha;
     char digest[SHA256];
@@ -845,13 +1214,19 @@ void MTA_ZK_challenge(PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod,
     BIG_256_56 q;
     BIG_256_56 t;
 
+    params = MTA_params_or_default(params);
+    if (MTA_params_check(params) != MTA_OK)
+    {
+        return MTA_FAIL;
+    }
+
     // Load curve order
     BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
 
     HASH256_init(&sha);
 
     /* Bind to public parameters */
-    hash_RP_params(&sha, key, mod, q);
+    hash_RP_params(&sha, key, mod, params, q);
 
     /* Bind to proof input */
     OCT_hash(&sha, C1);
@@ -860,6 +1235,9 @@ void MTA_ZK_challenge(PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod,
     /* Bind to proof commitment */
     hash_ZK_commitment(&sha, c);
 
+    /* Bind to additional data */
+    hash_segments(&sha, n, AD);
+
     /* Output */
     HASH256_hash(&sha, digest);
     BIG_256_56_fromBytesLen(t, digest, SHA256);
@@ -867,6 +1245,10 @@ void MTA_ZK_challenge(PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod,
 
     BIG_256_56_toBytes(E->val, t);
     E->len = EGS_SECP256K1;
+
+    MTA_truncate_challenge(E, params);
+
+    return MTA_OK;
 }
 
 void MTA_ZK_prove(PAILLIER_public_key *key, MTA_ZK_commitment_rv *rv, octet *X, octet *Y, octet *R, octet *E, MTA_ZK_proof *p)
@@ -937,24 +1319,68 @@ void MTA_ZK_prove(PAILLIER_public_key *key, MTA_ZK_commitment_rv *rv, octet *X,
     FF_2048_zero(dws, 2 * FFLEN_2048);
 }
 
-int MTA_ZK_verify(PAILLIER_private_key *key, COMMITMENTS_BC_priv_modulus *mod, octet *C1, octet *C2, octet *E, MTA_ZK_commitment *c, MTA_ZK_proof *p)
+void MTA_ZK_verify_prepare(PAILLIER_private_key *key, COMMITMENTS_BC_priv_modulus *mod, octet *C1, octet *C2, MTA_ZK_commitment *c, MTA_ZK_verify_ctx *ctx)
+{
+    MTA_ZK_verify_prepare_params(key, mod, &MTA_PARAMS_DEFAULT, C1, C2, c, ctx);
+}
+
+int MTA_ZK_verify_prepare_params(PAILLIER_private_key *key, COMMITMENTS_BC_priv_modulus *mod, const MTA_params *params, octet *C1, octet *C2, MTA_ZK_commitment *c, MTA_ZK_verify_ctx *ctx)
+{
+    BIG_1024_58 c1[2 * FFLEN_2048];
+    BIG_1024_58 c2[2 * FFLEN_2048];
+
+    // Keep the parameters for MTA_ZK_verify_finish
+    params = MTA_params_or_default(params);
+    ctx->params = *params;
+
+    if (MTA_params_check(params) != MTA_OK)
+    {
+        return MTA_FAIL;
+    }
+
+    // Reduce the BC modulus bases and the commitment modulo P and Q
+    FF_2048_dmod(ctx->b0p, mod->b0, mod->P, HFLEN_2048);
+    FF_2048_dmod(ctx->b1p, mod->b1, mod->P, HFLEN_2048);
+    FF_2048_dmod(ctx->zp,  c->z,    mod->P, HFLEN_2048);
+    FF_2048_dmod(ctx->z1p, c->z1,   mod->P, HFLEN_2048);
+    FF_2048_dmod(ctx->tp,  c->t,    mod->P, HFLEN_2048);
+    FF_2048_dmod(ctx->wp,  c->w,    mod->P, HFLEN_2048);
+
+    FF_2048_dmod(ctx->b0q, mod->b0, mod->Q, HFLEN_2048);
+    FF_2048_dmod(ctx->b1q, mod->b1, mod->Q, HFLEN_2048);
+    FF_2048_dmod(ctx->zq,  c->z,    mod->Q, HFLEN_2048);
+    FF_2048_dmod(ctx->z1q, c->z1,   mod->Q, HFLEN_2048);
+    FF_2048_dmod(ctx->tq,  c->t,    mod->Q, HFLEN_2048);
+    FF_2048_dmod(ctx->wq,  c->w,    mod->Q, HFLEN_2048);
+
+    // Reduce the ciphertexts and the commitment modulo p^2 and q^2
+    FF_2048_mul(ctx->n, key->p, key->q, HFLEN_2048);
+
+    FF_2048_fromOctet(c1, C1, 2 * FFLEN_2048);
+    FF_2048_fromOctet(c2, C2, 2 * FFLEN_2048);
+
+    FF_2048_dmod(ctx->c1p, c1,   key->p2, FFLEN_2048);
+    FF_2048_dmod(ctx->c2p, c2,   key->p2, FFLEN_2048);
+    FF_2048_dmod(ctx->vp,  c->v, key->p2, FFLEN_2048);
+
+    FF_2048_dmod(ctx->c1q, c1,   key->q2, FFLEN_2048);
+    FF_2048_dmod(ctx->c2q, c2,   key->q2, FFLEN_2048);
+    FF_2048_dmod(ctx->vq,  c->v, key->q2, FFLEN_2048);
+
+    return MTA_OK;
+}
+
+int MTA_ZK_verify_finish(PAILLIER_private_key *key, COMMITMENTS_BC_priv_modulus *mod, octet *E, MTA_ZK_verify_ctx *ctx, MTA_ZK_proof *p)
 {
     int fail;
 
     BIG_1024_58 e[FFLEN_2048];
     BIG_1024_58 q[HFLEN_2048];
-    BIG_1024_58 n[FFLEN_2048];
 
     BIG_1024_58 p_proof[FFLEN_2048];
     BIG_1024_58 q_proof[FFLEN_2048];
-    BIG_1024_58 p_gt[FFLEN_2048];
-    BIG_1024_58 q_gt[FFLEN_2048];
-
-    BIG_1024_58 c1[2 * FFLEN_2048];
-    BIG_1024_58 c2[2 * FFLEN_2048];
 
     BIG_1024_58 ws1[FFLEN_2048];
-    BIG_1024_58 ws2[FFLEN_2048];
     BIG_1024_58 ws3[FFLEN_2048];
 
     BIG_1024_58 dws[2 * FFLEN_2048];
@@ -962,12 +1388,16 @@ int MTA_ZK_verify(PAILLIER_private_key *key, COMMITMENTS_BC_priv_modulus *mod, o
     char oct[2*FS_2048];
     octet OCT = {0, sizeof(oct), oct};
 
-    // Check if s1 < q^3
+    if (MTA_params_check(&(ctx->params)) != MTA_OK)
+    {
+        return MTA_FAIL;
+    }
+
+    // Check if s1 < qES
     OCT_fromHex(&OCT, curve_order_hex);
     OCT_pad(&OCT, HFS_2048);
     FF_2048_fromOctet(q, &OCT, HFLEN_2048);
-    FF_2048_sqr(ws1, q, HFLEN_2048);
-    FF_2048_mul(ws1, ws1, q, HFLEN_2048);
+    MTA_alpha_bound(ws1, q, &(ctx->params));
 
     if (FF_2048_comp(p->s1, ws1, HFLEN_2048) > 0)
     {
@@ -979,19 +1409,14 @@ int MTA_ZK_verify(PAILLIER_private_key *key, COMMITMENTS_BC_priv_modulus *mod, o
     FF_2048_fromOctet(e, &OCT, FFLEN_2048);
 
     // Split check b0^s1 * b1^s2 * z^(-e) == z1 mod PQ using CRT
-    MTA_triple_power(p_proof, mod->b0, mod->b1, p->s1, p->s2, c->z, e, mod->P, false);
-    MTA_triple_power(q_proof, mod->b0, mod->b1, p->s1, p->s2, c->z, e, mod->Q, false);
-
-    FF_2048_dmod(p_gt, c->z1, mod->P, HFLEN_2048);
-    FF_2048_dmod(q_gt, c->z1, mod->Q, HFLEN_2048);
+    MTA_triple_power_reduced(p_proof, ctx->b0p, ctx->b1p, p->s1, p->s2, ctx->zp, e, mod->P, false);
+    MTA_triple_power_reduced(q_proof, ctx->b0q, ctx->b1q, p->s1, p->s2, ctx->zq, e, mod->Q, false);
 
-    fail = (FF_2048_comp(p_gt, p_proof, HFLEN_2048) != 0) || (FF_2048_comp(q_gt, q_proof, HFLEN_2048) != 0);
+    fail = (FF_2048_comp(ctx->z1p, p_proof, HFLEN_2048) != 0) || (FF_2048_comp(ctx->z1q, q_proof, HFLEN_2048) != 0);
 
     if (fail)
     {
         // Clean memory
-        FF_2048_zero(p_gt, HFLEN_2048);
-        FF_2048_zero(q_gt, HFLEN_2048);
         FF_2048_zero(p_proof, HFLEN_2048);
         FF_2048_zero(q_proof, HFLEN_2048);
 
@@ -999,19 +1424,14 @@ int MTA_ZK_verify(PAILLIER_private_key *key, COMMITMENTS_BC_priv_modulus *mod, o
     }
 
     // Split check if b0^t1 * b1^t2 * t^(-e) == w mod PQ using CRT
-    MTA_triple_power(p_proof, mod->b0, mod->b1, p->t1, p->t2, c->t, e, mod->P, 1);
-    MTA_triple_power(q_proof, mod->b0, mod->b1, p->t1, p->t2, c->t, e, mod->Q, 1);
+    MTA_triple_power_reduced(p_proof, ctx->b0p, ctx->b1p, p->t1, p->t2, ctx->tp, e, mod->P, 1);
+    MTA_triple_power_reduced(q_proof, ctx->b0q, ctx->b1q, p->t1, p->t2, ctx->tq, e, mod->Q, 1);
 
-    FF_2048_dmod(p_gt, c->w, mod->P, HFLEN_2048);
-    FF_2048_dmod(q_gt, c->w, mod->Q, HFLEN_2048);
-
-    fail = (FF_2048_comp(p_gt, p_proof, HFLEN_2048) != 0) || (FF_2048_comp(q_gt, q_proof, HFLEN_2048) != 0);
+    fail = (FF_2048_comp(ctx->wp, p_proof, HFLEN_2048) != 0) || (FF_2048_comp(ctx->wq, q_proof, HFLEN_2048) != 0);
 
     if (fail)
     {
         // Clean memory
-        FF_2048_zero(p_gt, HFLEN_2048);
-        FF_2048_zero(q_gt, HFLEN_2048);
         FF_2048_zero(p_proof, HFLEN_2048);
         FF_2048_zero(q_proof, HFLEN_2048);
 
@@ -1019,10 +1439,6 @@ int MTA_ZK_verify(PAILLIER_private_key *key, COMMITMENTS_BC_priv_modulus *mod, o
     }
 
     // Split check c1^s1 * s^N * g^t1 * c2^(-e) == v mod N^2 using CRT
-    FF_2048_mul(n, key->p, key->q, HFLEN_2048);
-
-    FF_2048_fromOctet(c1, C1, 2 * FFLEN_2048);
-    FF_2048_fromOctet(c2, C2, 2 * FFLEN_2048);
 
     // Compute check modulo p^2
     FF_2048_copy(ws3, key->p2, FFLEN_2048);
@@ -1032,12 +1448,9 @@ int MTA_ZK_verify(PAILLIER_private_key *key, COMMITMENTS_BC_priv_modulus *mod, o
     FF_2048_sub(ws3, ws3, e, FFLEN_2048);
     FF_2048_norm(ws3, FFLEN_2048);
 
-    FF_2048_dmod(ws1, c1, key->p2, FFLEN_2048);
-    FF_2048_dmod(ws2, c2, key->p2, FFLEN_2048);
+    FF_2048_ct_pow_3(p_proof, ctx->c1p, p->s1, p->s, ctx->n, ctx->c2p, ws3, key->p2, FFLEN_2048, FFLEN_2048);
 
-    FF_2048_ct_pow_3(p_proof, ws1, p->s1, p->s, n, ws2, ws3, key->p2, FFLEN_2048, FFLEN_2048);
-
-    FF_2048_mul(dws, n, p->t1, FFLEN_2048);
+    FF_2048_mul(dws, ctx->n, p->t1, FFLEN_2048);
     FF_2048_dmod(ws1, dws, key->p2, FFLEN_2048);
     FF_2048_inc(ws1, 1, FFLEN_2048);
     FF_2048_norm(ws1, FFLEN_2048);
@@ -1053,30 +1466,21 @@ int MTA_ZK_verify(PAILLIER_private_key *key, COMMITMENTS_BC_priv_modulus *mod, o
     FF_2048_sub(ws3, ws3, e, FFLEN_2048);
     FF_2048_norm(ws3, FFLEN_2048);
 
-    FF_2048_dmod(ws1, c1, key->q2, FFLEN_2048);
-    FF_2048_dmod(ws2, c2, key->q2, FFLEN_2048);
-
-    FF_2048_ct_pow_3(q_proof, ws1, p->s1, p->s, n, ws2, ws3, key->q2, FFLEN_2048, FFLEN_2048);
+    FF_2048_ct_pow_3(q_proof, ctx->c1q, p->s1, p->s, ctx->n, ctx->c2q, ws3, key->q2, FFLEN_2048, FFLEN_2048);
 
-    FF_2048_mul(dws, n, p->t1, FFLEN_2048);
+    FF_2048_mul(dws, ctx->n, p->t1, FFLEN_2048);
     FF_2048_dmod(ws1, dws, key->q2, FFLEN_2048);
     FF_2048_inc(ws1, 1, FFLEN_2048);
 
     FF_2048_mul(dws, q_proof, ws1, FFLEN_2048);
     FF_2048_dmod(q_proof, dws, key->q2, FFLEN_2048);
 
-    FF_2048_dmod(p_gt, c->v, key->p2, FFLEN_2048);
-    FF_2048_dmod(q_gt, c->v, key->q2, FFLEN_2048);
-
-    fail = (FF_2048_comp(p_gt, p_proof, FFLEN_2048) != 0) || (FF_2048_comp(q_gt, q_proof, FFLEN_2048) != 0);
+    fail = (FF_2048_comp(ctx->vp, p_proof, FFLEN_2048) != 0) || (FF_2048_comp(ctx->vq, q_proof, FFLEN_2048) != 0);
 
     // Clean memory
-    FF_2048_zero(p_gt, FFLEN_2048);
-    FF_2048_zero(q_gt, FFLEN_2048);
     FF_2048_zero(p_proof, FFLEN_2048);
     FF_2048_zero(q_proof, FFLEN_2048);
     FF_2048_zero(ws1, FFLEN_2048);
-    FF_2048_zero(ws2, FFLEN_2048);
     FF_2048_zero(ws3, FFLEN_2048);
     FF_2048_zero(dws, 2 * FFLEN_2048);
 
@@ -1088,6 +1492,51 @@ int MTA_ZK_verify(PAILLIER_private_key *key, COMMITMENTS_BC_priv_modulus *mod, o
     return MTA_OK;
 }
 
+int MTA_ZK_verify(PAILLIER_private_key *key, COMMITMENTS_BC_priv_modulus *mod, octet *C1, octet *C2, octet *E, MTA_ZK_commitment *c, MTA_ZK_proof *p)
+{
+    return MTA_ZK_verify_params(key, mod, &MTA_PARAMS_DEFAULT, C1, C2, E, c, p);
+}
+
+int MTA_ZK_verify_params(PAILLIER_private_key *key, COMMITMENTS_BC_priv_modulus *mod, const MTA_params *params, octet *C1, octet *C2, octet *E, MTA_ZK_commitment *c, MTA_ZK_proof *p)
+{
+    int rc;
+
+    MTA_ZK_verify_ctx ctx;
+
+    rc = MTA_ZK_verify_prepare_params(key, mod, params, C1, C2, c, &ctx);
+    if (rc == MTA_OK)
+    {
+        rc = MTA_ZK_verify_finish(key, mod, E, &ctx, p);
+    }
+
+    // Clean memory
+    MTA_ZK_verify_ctx_kill(&ctx);
+
+    return rc;
+}
+
+void MTA_ZK_verify_ctx_kill(MTA_ZK_verify_ctx *ctx)
+{
+    FF_2048_zero(ctx->b0p, HFLEN_2048);
+    FF_2048_zero(ctx->b1p, HFLEN_2048);
+    FF_2048_zero(ctx->zp,  HFLEN_2048);
+    FF_2048_zero(ctx->z1p, HFLEN_2048);
+    FF_2048_zero(ctx->tp,  HFLEN_2048);
+    FF_2048_zero(ctx->wp,  HFLEN_2048);
+    FF_2048_zero(ctx->b0q, HFLEN_2048);
+    FF_2048_zero(ctx->b1q, HFLEN_2048);
+    FF_2048_zero(ctx->zq,  HFLEN_2048);
+    FF_2048_zero(ctx->z1q, HFLEN_2048);
+    FF_2048_zero(ctx->tq,  HFLEN_2048);
+    FF_2048_zero(ctx->wq,  HFLEN_2048);
+    FF_2048_zero(ctx->c1p, FFLEN_2048);
+    FF_2048_zero(ctx->c2p, FFLEN_2048);
+    FF_2048_zero(ctx->vp,  FFLEN_2048);
+    FF_2048_zero(ctx->c1q, FFLEN_2048);
+    FF_2048_zero(ctx->c2q, FFLEN_2048);
+    FF_2048_zero(ctx->vq,  FFLEN_2048);
+}
+
 void MTA_ZK_commitment_toOctets(octet *Z, octet *Z1, octet *T, octet *V, octet *W, MTA_ZK_commitment *c)
 {
     FF_2048_toOctet(Z,  c->z, FFLEN_2048);
@@ -1137,8 +1586,15 @@ void MTA_ZK_commitment_rv_kill(MTA_ZK_commitment_rv *rv)
     FF_2048_zero(rv->tau,   FFLEN_2048 + HFLEN_2048);
 }
 
-void MTA_ZKWC_commit(csprng *RNG, PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod,  octet *X, octet *Y, octet *C1, MTA_ZKWC_commitment *c, MTA_ZKWC_commitment_rv *rv)
+void MTA_ZKWC_commit(csprng *RNG, PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod, octet *X, octet *Y, octet *C1, MTA_ZKWC_commitment *c, MTA_ZKWC_commitment_rv *rv)
 {
+    MTA_ZKWC_commit_params(RNG, key, mod, &MTA_PARAMS_DEFAULT, X, Y, C1, c, rv);
+}
+
+int MTA_ZKWC_commit_params(csprng *RNG, PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod, const MTA_params *params, octet *X, octet *Y, octet *C1, MTA_ZKWC_commitment *c, MTA_ZKWC_commitment_rv *rv)
+{
+    int rc;
+
     BIG_1024_58 ff_alpha[HFLEN_2048];
     BIG_1024_58 ff_q[HFLEN_2048];
 
@@ -1152,7 +1608,11 @@ void MTA_ZKWC_commit(csprng *RNG, PAILLIER_public_key *key, COMMITMENTS_BC_pub_m
 
     /* Compute base commitment for the range and knowledge ZKP */
 
-    MTA_ZK_commit(RNG, key, mod, X, Y, C1, &(c->zkc), rv);
+    rc = MTA_ZK_commit_params(RNG, key, mod, params, X, Y, C1, &(c->zkc), rv);
+    if (rc != MTA_OK)
+    {
+        return rc;
+    }
 
     /* Compute commitment for DLOG knowledge ZKP */
 
@@ -1170,9 +1630,26 @@ void MTA_ZKWC_commit(csprng *RNG, PAILLIER_public_key *key, COMMITMENTS_BC_pub_m
     // Commit to U = alpha.G
     ECP_SECP256K1_generator(&(c->U));
     ECP_SECP256K1_mul(&(c->U), alpha);
+
+    return MTA_OK;
 }
 
 void MTA_ZKWC_challenge(PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod, const octet *C1, const octet *C2, const octet *X, MTA_ZKWC_commitment *c, octet *E)
+{
+    MTA_ZKWC_challenge_params(key, mod, &MTA_PARAMS_DEFAULT, C1, C2, X, c, E);
+}
+
+int MTA_ZKWC_challenge_params(PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod, const MTA_params *params, const octet *C1, const octet *C2, const octet *X, MTA_ZKWC_commitment *c, octet *E)
+{
+    return MTA_ZKWC_challenge_v_params(key, mod, params, C1, C2, X, c, 0, NULL, E);
+}
+
+void MTA_ZKWC_challenge_v(PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod, const octet *C1, const octet *C2, const octet *X, MTA_ZKWC_commitment *c, int n, octet *AD[], octet *E)
+{
+    MTA_ZKWC_challenge_v_params(key, mod, &MTA_PARAMS_DEFAULT, C1, C2, X, c, n, AD, E);
+}
+
+int MTA_ZKWC_challenge_v_params(PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mod, const MTA_params *params, const octet *C1, const octet *C2, const octet *X, MTA_ZKWC_commitment *c, int n, octet *AD[], octet *E)
 {
     hash256 sha;
     char digest[SHA256];
@@ -1183,13 +1660,19 @@ void MTA_ZKWC_challenge(PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mo
     BIG_256_56 q;
     BIG_256_56 t;
 
+    params = MTA_params_or_default(params);
+    if (MTA_params_check(params) != MTA_OK)
+    {
+        return MTA_FAIL;
+    }
+
     // Load curve order
     BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
 
     HASH256_init(&sha);
 
     /* Bind to public parameters */
-    hash_RP_params(&sha, key, mod, q);
+    hash_RP_params(&sha, key, mod, params, q);
 
     /* Bind to proof input */
     OCT_hash(&sha, C1);
@@ -1203,6 +1686,9 @@ void MTA_ZKWC_challenge(PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mo
     /* Bind to proof commitment for Receiver ZK */
     hash_ZK_commitment(&sha, &(c->zkc));
 
+    /* Bind to additional data */
+    hash_segments(&sha, n, AD);
+
     /* Output */
     HASH256_hash(&sha, digest);
     BIG_256_56_fromBytesLen(t, digest, SHA256);
@@ -1210,6 +1696,10 @@ void MTA_ZKWC_challenge(PAILLIER_public_key *key, COMMITMENTS_BC_pub_modulus *mo
 
     BIG_256_56_toBytes(E->val, t);
     E->len = EGS_SECP256K1;
+
+    MTA_truncate_challenge(E, params);
+
+    return MTA_OK;
 }
 
 void MTA_ZKWC_prove(PAILLIER_public_key *key, MTA_ZKWC_commitment_rv *rv, octet *X, octet *Y, octet *R, octet *E, MTA_ZKWC_proof *p)
@@ -1218,6 +1708,11 @@ void MTA_ZKWC_prove(PAILLIER_public_key *key, MTA_ZKWC_commitment_rv *rv, octet
 }
 
 int MTA_ZKWC_verify(PAILLIER_private_key *key, COMMITMENTS_BC_priv_modulus *mod, octet *C1, octet *C2, octet *X, octet *E, MTA_ZKWC_commitment *c, MTA_ZKWC_proof *p)
+{
+    return MTA_ZKWC_verify_params(key, mod, &MTA_PARAMS_DEFAULT, C1, C2, X, E, c, p);
+}
+
+int MTA_ZKWC_verify_params(PAILLIER_private_key *key, COMMITMENTS_BC_priv_modulus *mod, const MTA_params *params, octet *C1, octet *C2, octet *X, octet *E, MTA_ZKWC_commitment *c, MTA_ZKWC_proof *p)
 {
     int rc;
 
@@ -1245,7 +1740,7 @@ int MTA_ZKWC_verify(PAILLIER_private_key *key, COMMITMENTS_BC_priv_modulus *mod,
 
     /* Verify base Receiver ZKP */
 
-    rc = MTA_ZK_verify(key, mod, C1, C2, E, &(c->zkc), p);
+    rc = MTA_ZK_verify_params(key, mod, params, C1, C2, E, &(c->zkc), p);
     if (rc != MTA_OK)
     {
         return MTA_FAIL;
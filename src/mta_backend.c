@@ -0,0 +1,245 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/* Pluggable encryption backends for the MTA definitions */
+
+#include <string.h>
+#include "amcl/mta.h"
+#include "amcl/mta_backend.h"
+
+/* Paillier backend */
+
+// Client proof. Range Proof of the ciphertext
+typedef struct
+{
+    MTA_RP_commitment c;
+    MTA_RP_proof p;
+} paillier_cproof;
+
+// Server proof. Receiver ZKP, with check if X is given
+typedef struct
+{
+    MTA_ZKWC_commitment c;
+    MTA_ZKWC_proof p;
+} paillier_sproof;
+
+static void paillier_keygen(csprng *RNG, void *pub, void *priv)
+{
+    PAILLIER_KEY_PAIR(RNG, NULL, NULL, (PAILLIER_public_key *)pub, (PAILLIER_private_key *)priv);
+}
+
+static void paillier_kill(void *priv)
+{
+    PAILLIER_PRIVATE_KEY_KILL((PAILLIER_private_key *)priv);
+}
+
+static void paillier_pk_toOctet(octet *PK, void *pub)
+{
+    PAILLIER_PK_toOctet(PK, (PAILLIER_public_key *)pub);
+}
+
+static void paillier_pk_fromOctet(void *pub, octet *PK)
+{
+    PAILLIER_PK_fromOctet((PAILLIER_public_key *)pub, PK);
+}
+
+static void paillier_client1(csprng *RNG, void *pub, octet *A, octet *CA, octet *R)
+{
+    MPC_MTA_CLIENT1(RNG, (PAILLIER_public_key *)pub, A, CA, R);
+}
+
+static void paillier_server(csprng *RNG, void *pub, octet *B, octet *CA, octet *Z, octet *R, octet *CB, octet *BETA)
+{
+    MPC_MTA_SERVER(RNG, (PAILLIER_public_key *)pub, B, CA, Z, R, CB, BETA);
+}
+
+static void paillier_client2(void *priv, octet *CB, octet *ALPHA)
+{
+    MPC_MTA_CLIENT2((PAILLIER_private_key *)priv, CB, ALPHA);
+}
+
+static int paillier_client1_prove(csprng *RNG, void *pub, void *priv, void *vpub, const MTA_params *params, octet *A, octet *R, octet *CA, void *proof)
+{
+    int rc;
+
+    paillier_cproof *cp = (paillier_cproof *)proof;
+
+    char e[MODBYTES_256_56];
+    octet E = {0, sizeof(e), e};
+
+    MTA_RP_commitment_rv rv;
+
+    rc = MTA_RP_commit_params(RNG, (PAILLIER_private_key *)priv, (COMMITMENTS_BC_pub_modulus *)vpub, params, A, &(cp->c), &rv);
+    if (rc != MTA_OK)
+    {
+        return rc;
+    }
+
+    MTA_RP_challenge_params((PAILLIER_public_key *)pub, (COMMITMENTS_BC_pub_modulus *)vpub, params, CA, &(cp->c), &E);
+    MTA_RP_prove((PAILLIER_private_key *)priv, &rv, A, R, &E, &(cp->p));
+
+    // Clean memory
+    MTA_RP_commitment_rv_kill(&rv);
+
+    return MTA_OK;
+}
+
+static int paillier_client1_verify(void *pub, void *vpriv, const MTA_params *params, octet *CA, void *proof)
+{
+    paillier_cproof *cp = (paillier_cproof *)proof;
+
+    char e[MODBYTES_256_56];
+    octet E = {0, sizeof(e), e};
+
+    COMMITMENTS_BC_pub_modulus vpub;
+
+    COMMITMENTS_BC_export_public_modulus(&vpub, (COMMITMENTS_BC_priv_modulus *)vpriv);
+
+    MTA_RP_challenge_params((PAILLIER_public_key *)pub, &vpub, params, CA, &(cp->c), &E);
+
+    return MTA_RP_verify_params((PAILLIER_public_key *)pub, (COMMITMENTS_BC_priv_modulus *)vpriv, params, CA, &E, &(cp->c), &(cp->p));
+}
+
+static int paillier_server_prove(csprng *RNG, void *pub, void *vpub, const MTA_params *params, octet *B, octet *Z, octet *R, octet *CA, octet *CB, octet *X, void *proof)
+{
+    int rc;
+
+    paillier_sproof *sp = (paillier_sproof *)proof;
+
+    char e[MODBYTES_256_56];
+    octet E = {0, sizeof(e), e};
+
+    MTA_ZKWC_commitment_rv rv;
+
+    if (X == NULL)
+    {
+        rc = MTA_ZK_commit_params(RNG, (PAILLIER_public_key *)pub, (COMMITMENTS_BC_pub_modulus *)vpub, params, B, Z, CA, &(sp->c.zkc), &rv);
+        if (rc == MTA_OK)
+        {
+            MTA_ZK_challenge_params((PAILLIER_public_key *)pub, (COMMITMENTS_BC_pub_modulus *)vpub, params, CA, CB, &(sp->c.zkc), &E);
+            MTA_ZK_prove((PAILLIER_public_key *)pub, &rv, B, Z, R, &E, &(sp->p));
+        }
+    }
+    else
+    {
+        rc = MTA_ZKWC_commit_params(RNG, (PAILLIER_public_key *)pub, (COMMITMENTS_BC_pub_modulus *)vpub, params, B, Z, CA, &(sp->c), &rv);
+        if (rc == MTA_OK)
+        {
+            MTA_ZKWC_challenge_params((PAILLIER_public_key *)pub, (COMMITMENTS_BC_pub_modulus *)vpub, params, CA, CB, X, &(sp->c), &E);
+            MTA_ZKWC_prove((PAILLIER_public_key *)pub, &rv, B, Z, R, &E, &(sp->p));
+        }
+    }
+
+    // Clean memory
+    MTA_ZKWC_commitment_rv_kill(&rv);
+
+    return rc;
+}
+
+static int paillier_server_verify(void *pub, void *priv, void *vpriv, const MTA_params *params, octet *CA, octet *CB, octet *X, void *proof)
+{
+    paillier_sproof *sp = (paillier_sproof *)proof;
+
+    char e[MODBYTES_256_56];
+    octet E = {0, sizeof(e), e};
+
+    COMMITMENTS_BC_pub_modulus vpub;
+
+    COMMITMENTS_BC_export_public_modulus(&vpub, (COMMITMENTS_BC_priv_modulus *)vpriv);
+
+    if (X == NULL)
+    {
+        MTA_ZK_challenge_params((PAILLIER_public_key *)pub, &vpub, params, CA, CB, &(sp->c.zkc), &E);
+
+        return MTA_ZK_verify_params((PAILLIER_private_key *)priv, (COMMITMENTS_BC_priv_modulus *)vpriv, params, CA, CB, &E, &(sp->c.zkc), &(sp->p));
+    }
+
+    MTA_ZKWC_challenge_params((PAILLIER_public_key *)pub, &vpub, params, CA, CB, X, &(sp->c), &E);
+
+    return MTA_ZKWC_verify_params((PAILLIER_private_key *)priv, (COMMITMENTS_BC_priv_modulus *)vpriv, params, CA, CB, X, &E, &(sp->c), &(sp->p));
+}
+
+const MTA_BACKEND MTA_BACKEND_paillier =
+{
+    "paillier",
+    sizeof(PAILLIER_public_key),
+    sizeof(PAILLIER_private_key),
+    HFS_4096,
+    FS_4096,
+    sizeof(paillier_cproof),
+    sizeof(paillier_sproof),
+    paillier_keygen,
+    paillier_kill,
+    paillier_pk_toOctet,
+    paillier_pk_fromOctet,
+    paillier_client1,
+    paillier_server,
+    paillier_client2,
+    paillier_client1_prove,
+    paillier_client1_verify,
+    paillier_server_prove,
+    paillier_server_verify
+};
+
+/* Registry */
+
+static const MTA_BACKEND *registry[MTA_BACKEND_MAX] = {MTA_BACKEND_DEFAULT};
+static int registered = 1;
+
+int MTA_BACKEND_register(const MTA_BACKEND *b)
+{
+    if (registered == MTA_BACKEND_MAX || MTA_BACKEND_find(b->name) != NULL)
+    {
+        return MTA_BACKEND_FAIL;
+    }
+
+    registry[registered++] = b;
+
+    return MTA_BACKEND_OK;
+}
+
+int MTA_BACKEND_count(void)
+{
+    return registered;
+}
+
+const MTA_BACKEND *MTA_BACKEND_get(int i)
+{
+    if (i < 0 || i >= registered)
+    {
+        return NULL;
+    }
+
+    return registry[i];
+}
+
+const MTA_BACKEND *MTA_BACKEND_find(const char *name)
+{
+    int i;
+
+    for (i = 0; i < registered; i++)
+    {
+        if (strcmp(registry[i]->name, name) == 0)
+        {
+            return registry[i];
+        }
+    }
+
+    return NULL;
+}
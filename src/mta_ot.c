@@ -0,0 +1,854 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/* Oblivious transfer based MTA definitions */
+
+#include <string.h>
+#include "amcl/mta_ot.h"
+
+// Size of a compressed ECP
+#define ECP_SIZE (EFS_SECP256K1 + 1)
+
+// Domain separation of the gadget vector
+#define GADGET_LABEL "MTA_OT gadget"
+
+static void hash_bytes(hash256 *sha, const char *b, int n)
+{
+    int i;
+
+    for (i = 0; i < n; i++)
+    {
+        HASH256_process(sha, b[i]);
+    }
+}
+
+static void hash_u32(hash256 *sha, unsign32 x)
+{
+    HASH256_process(sha, (x >> 24) & 0xff);
+    HASH256_process(sha, (x >> 16) & 0xff);
+    HASH256_process(sha, (x >> 8) & 0xff);
+    HASH256_process(sha, x & 0xff);
+}
+
+// Key of the i-th base OT. k = H(i, S, R, P)
+static void base_key(char *k, int i, const octet *S, const char *R, ECP_SECP256K1 *P)
+{
+    hash256 sha;
+
+    char o[ECP_SIZE];
+    octet O = {0, sizeof(o), o};
+
+    char h[SHA256];
+
+    ECP_SECP256K1_toOctet(&O, P, true);
+
+    HASH256_init(&sha);
+    hash_u32(&sha, i);
+    hash_bytes(&sha, S->val, S->len);
+    hash_bytes(&sha, R, ECP_SIZE);
+    hash_bytes(&sha, O.val, O.len);
+    HASH256_hash(&sha, h);
+
+    memcpy(k, h, MTA_OT_KBYTES);
+
+    // Clean memory
+    OCT_clear(&O);
+    memset(h, 0, sizeof(h));
+}
+
+// Expand a base key into a column of the extension. G(k, counter)
+static void prg(char *col, const char *k, unsign32 counter)
+{
+    int i;
+    sha3 sh;
+
+    SHA3_init(&sh, SHAKE256);
+
+    for (i = 0; i < MTA_OT_KBYTES; i++)
+    {
+        SHA3_process(&sh, k[i]);
+    }
+
+    SHA3_process(&sh, (counter >> 24) & 0xff);
+    SHA3_process(&sh, (counter >> 16) & 0xff);
+    SHA3_process(&sh, (counter >> 8) & 0xff);
+    SHA3_process(&sh, counter & 0xff);
+
+    SHA3_shake(&sh, col, MTA_OT_MBYTES);
+}
+
+// Challenge of the consistency check. chi = H(counter, u)
+static void challenge(char *chi, unsign32 counter, const char *u)
+{
+    int i;
+    sha3 sh;
+
+    SHA3_init(&sh, SHAKE256);
+
+    SHA3_process(&sh, (counter >> 24) & 0xff);
+    SHA3_process(&sh, (counter >> 16) & 0xff);
+    SHA3_process(&sh, (counter >> 8) & 0xff);
+    SHA3_process(&sh, counter & 0xff);
+
+    for (i = 0; i < MTA_OT_KAPPA * MTA_OT_MBYTES; i++)
+    {
+        SHA3_process(&sh, u[i]);
+    }
+
+    SHA3_shake(&sh, chi, MTA_OT_M * MTA_OT_KBYTES);
+}
+
+// Hash a row of the extension into Z/qZ for the product k.
+// x = H(counter, k, j, row) mod q
+static void row_hash(BIG_256_56 x, BIG_256_56 q, unsign32 counter, int k, int j, const char *row)
+{
+    hash256 sha;
+
+    char h[SHA256];
+
+    HASH256_init(&sha);
+    hash_u32(&sha, counter);
+    hash_u32(&sha, k);
+    hash_u32(&sha, j);
+    hash_bytes(&sha, row, MTA_OT_KBYTES);
+    HASH256_hash(&sha, h);
+
+    BIG_256_56_fromBytesLen(x, h, SHA256);
+    BIG_256_56_mod(x, q);
+
+    // Clean memory
+    memset(h, 0, sizeof(h));
+}
+
+// Element of the gadget vector for the random part of the encoding.
+// g = H(j) mod q
+static void gadget(BIG_256_56 g, BIG_256_56 q, int j)
+{
+    hash256 sha;
+
+    char h[SHA256];
+
+    HASH256_init(&sha);
+    hash_bytes(&sha, GADGET_LABEL, sizeof(GADGET_LABEL) - 1);
+    hash_u32(&sha, j);
+    HASH256_hash(&sha, h);
+
+    BIG_256_56_fromBytesLen(g, h, SHA256);
+    BIG_256_56_mod(g, q);
+}
+
+// z = x.y in GF(2^128) with modulus x^128 + x^7 + x^2 + x + 1.
+// Bit i of the element is bit i%8 of byte i/8. Constant time
+static void gf128_mul(char *z, const char *x, const char *y)
+{
+    int i;
+    int j;
+    unsigned char mask;
+    unsigned char carry;
+
+    unsigned char v[MTA_OT_KBYTES];
+    unsigned char acc[MTA_OT_KBYTES] = {0};
+
+    memcpy(v, x, MTA_OT_KBYTES);
+
+    for (i = 0; i < MTA_OT_KAPPA; i++)
+    {
+        mask = -(((unsigned char)y[i / 8] >> (i % 8)) & 1);
+
+        for (j = 0; j < MTA_OT_KBYTES; j++)
+        {
+            acc[j] ^= v[j] & mask;
+        }
+
+        // v = v.x
+        carry = v[MTA_OT_KBYTES - 1] >> 7;
+        for (j = MTA_OT_KBYTES - 1; j > 0; j--)
+        {
+            v[j] = (v[j] << 1) | (v[j - 1] >> 7);
+        }
+        v[0] = (v[0] << 1) ^ (0x87 & -carry);
+    }
+
+    memcpy(z, acc, MTA_OT_KBYTES);
+
+    // Clean memory
+    memset(v, 0, sizeof(v));
+    memset(acc, 0, sizeof(acc));
+}
+
+// Rows of the extension from its columns
+static void transpose(char rows[MTA_OT_M][MTA_OT_KBYTES], char cols[MTA_OT_KAPPA][MTA_OT_MBYTES])
+{
+    int i;
+    int j;
+    unsigned char bit;
+
+    memset(rows, 0, MTA_OT_M * MTA_OT_KBYTES);
+
+    for (i = 0; i < MTA_OT_KAPPA; i++)
+    {
+        for (j = 0; j < MTA_OT_M; j++)
+        {
+            bit = ((unsigned char)cols[i][j / 8] >> (j % 8)) & 1;
+            rows[j][i / 8] |= bit << (i % 8);
+        }
+    }
+}
+
+/* Setup API */
+
+void MTA_OT_setup_client1(csprng *RNG, MTA_OT_client *c, octet *S)
+{
+    BIG_256_56 q;
+    BIG_256_56 y;
+
+    ECP_SECP256K1 G;
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+    BIG_256_56_randomnum(y, q, RNG);
+    BIG_256_56_toBytes(c->y, y);
+
+    // S = y.G
+    ECP_SECP256K1_generator(&G);
+    ECP_SECP256K1_mul(&G, y);
+    ECP_SECP256K1_toOctet(S, &G, true);
+
+    c->counter = 0;
+
+    // Clean memory
+    BIG_256_56_zero(y);
+}
+
+int MTA_OT_setup_server(csprng *RNG, MTA_OT_server *s, octet *S, octet *R)
+{
+    int i;
+    int j;
+    unsigned char mask;
+
+    BIG_256_56 q;
+    BIG_256_56 x;
+
+    ECP_SECP256K1 SP;
+    ECP_SECP256K1 P;
+    ECP_SECP256K1 XS;
+
+    char r0[ECP_SIZE];
+    octet R0 = {0, sizeof(r0), r0};
+
+    char r1[ECP_SIZE];
+    octet R1 = {0, sizeof(r1), r1};
+
+    char *ri;
+
+    if (!ECP_SECP256K1_fromOctet(&SP, S))
+    {
+        return MTA_OT_INVALID_ECP;
+    }
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+
+    for (i = 0; i < MTA_OT_KBYTES; i++)
+    {
+        s->s[i] = RAND_byte(RNG);
+    }
+
+    for (i = 0; i < MTA_OT_KAPPA; i++)
+    {
+        ri = R->val + i * ECP_SIZE;
+
+        BIG_256_56_randomnum(x, q, RNG);
+
+        // R_i = x_i.G + s_i.S. Both candidates are computed and
+        // the selection does not depend on s_i
+        ECP_SECP256K1_generator(&P);
+        ECP_SECP256K1_mul(&P, x);
+        ECP_SECP256K1_toOctet(&R0, &P, true);
+
+        ECP_SECP256K1_add(&P, &SP);
+        ECP_SECP256K1_toOctet(&R1, &P, true);
+
+        mask = -(((unsigned char)s->s[i / 8] >> (i % 8)) & 1);
+        for (j = 0; j < ECP_SIZE; j++)
+        {
+            ri[j] = (r0[j] & ~mask) | (r1[j] & mask);
+        }
+
+        // k_i = H(i, S, R_i, x_i.S)
+        ECP_SECP256K1_copy(&XS, &SP);
+        ECP_SECP256K1_mul(&XS, x);
+        base_key(s->ks[i], i, S, ri, &XS);
+    }
+
+    R->len = MTA_OT_R_SIZE;
+    s->counter = 0;
+    s->failed = 0;
+
+    // Clean memory
+    BIG_256_56_zero(x);
+    OCT_clear(&R0);
+    OCT_clear(&R1);
+
+    return MTA_OT_OK;
+}
+
+int MTA_OT_setup_client2(MTA_OT_client *c, octet *R)
+{
+    int i;
+
+    BIG_256_56 y;
+
+    ECP_SECP256K1 SP;
+    ECP_SECP256K1 RP;
+    ECP_SECP256K1 P;
+
+    char s[ECP_SIZE];
+    octet S = {0, sizeof(s), s};
+
+    char ri[ECP_SIZE];
+    octet RI = {0, sizeof(ri), ri};
+
+    if (R->len != MTA_OT_R_SIZE)
+    {
+        return MTA_OT_INVALID_ECP;
+    }
+
+    BIG_256_56_fromBytes(y, c->y);
+
+    // Recompute S = y.G
+    ECP_SECP256K1_generator(&SP);
+    ECP_SECP256K1_mul(&SP, y);
+    ECP_SECP256K1_toOctet(&S, &SP, true);
+
+    for (i = 0; i < MTA_OT_KAPPA; i++)
+    {
+        OCT_clear(&RI);
+        OCT_jbytes(&RI, R->val + i * ECP_SIZE, ECP_SIZE);
+
+        if (!ECP_SECP256K1_fromOctet(&RP, &RI))
+        {
+            BIG_256_56_zero(y);
+            return MTA_OT_INVALID_ECP;
+        }
+
+        // k0_i = H(i, S, R_i, y.R_i)
+        ECP_SECP256K1_copy(&P, &RP);
+        ECP_SECP256K1_mul(&P, y);
+        base_key(c->k0[i], i, &S, ri, &P);
+
+        // k1_i = H(i, S, R_i, y.(R_i - S))
+        ECP_SECP256K1_sub(&RP, &SP);
+        ECP_SECP256K1_mul(&RP, y);
+        base_key(c->k1[i], i, &S, ri, &RP);
+    }
+
+    c->counter = 0;
+
+    // Clean memory
+    BIG_256_56_zero(y);
+    memset(c->y, 0, sizeof(c->y));
+
+    return MTA_OT_OK;
+}
+
+void MTA_OT_client_kill(MTA_OT_client *c)
+{
+    memset(c->y, 0, sizeof(c->y));
+    memset(c->k0, 0, sizeof(c->k0));
+    memset(c->k1, 0, sizeof(c->k1));
+}
+
+void MTA_OT_server_kill(MTA_OT_server *s)
+{
+    memset(s->s, 0, sizeof(s->s));
+    memset(s->ks, 0, sizeof(s->ks));
+    s->failed = 1;
+}
+
+/* MTA protocol API */
+
+void MPC_MTA_OT_CLIENT1(csprng *RNG, MTA_OT_client *c, const octet *A, MTA_OT_client_state *st, octet *CA)
+{
+    int i;
+    int j;
+    int k;
+    unsigned char mask;
+
+    BIG_256_56 q;
+    BIG_256_56 a;
+    BIG_256_56 ga;
+    BIG_256_56 d;
+
+    char t[MTA_OT_KAPPA][MTA_OT_MBYTES];
+    char g[MTA_OT_MBYTES];
+    char chi[MTA_OT_M * MTA_OT_KBYTES];
+    char p[MTA_OT_KBYTES];
+    char ab[EGS_SECP256K1];
+
+    char *u = CA->val + 4;
+    char *x = u + MTA_OT_KAPPA * MTA_OT_MBYTES;
+    char *tt = x + MTA_OT_KBYTES;
+
+    st->counter = c->counter++;
+
+    // r = a' || gamma || rho. Bit j of r is bit j of a', least
+    // significant first, followed by the random bits gamma and rho
+    for (j = MTA_OT_BITS / 8; j < MTA_OT_MBYTES; j++)
+    {
+        st->r[j] = RAND_byte(RNG);
+    }
+
+    // a' = a - sum g_j.gamma_j. The selection does not depend on gamma
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+    BIG_256_56_fromBytesLen(a, A->val, A->len);
+    BIG_256_56_mod(a, q);
+
+    for (j = MTA_OT_BITS; j < MTA_OT_CHOICE; j++)
+    {
+        gadget(ga, q, j);
+        BIG_256_56_modneg(ga, ga, q);
+        BIG_256_56_add(d, a, ga);
+        BIG_256_56_mod(d, q);
+        BIG_256_56_cmove(a, d, ((unsigned char)st->r[j / 8] >> (j % 8)) & 1);
+    }
+
+    BIG_256_56_toBytes(ab, a);
+    for (j = 0; j < MTA_OT_BITS / 8; j++)
+    {
+        st->r[j] = ab[EGS_SECP256K1 - 1 - j];
+    }
+
+    CA->val[0] = (st->counter >> 24) & 0xff;
+    CA->val[1] = (st->counter >> 16) & 0xff;
+    CA->val[2] = (st->counter >> 8) & 0xff;
+    CA->val[3] = st->counter & 0xff;
+
+    // t^i = G(k0_i), u^i = t^i + G(k1_i) + r
+    for (i = 0; i < MTA_OT_KAPPA; i++)
+    {
+        prg(t[i], c->k0[i], st->counter);
+        prg(g, c->k1[i], st->counter);
+
+        for (j = 0; j < MTA_OT_MBYTES; j++)
+        {
+            u[i * MTA_OT_MBYTES + j] = t[i][j] ^ g[j] ^ st->r[j];
+        }
+    }
+
+    transpose(st->t, t);
+
+    // x = sum r_j.chi_j, t = sum chi_j.t_j
+    challenge(chi, st->counter, u);
+
+    memset(x, 0, MTA_OT_KBYTES);
+    memset(tt, 0, MTA_OT_KBYTES);
+
+    for (j = 0; j < MTA_OT_M; j++)
+    {
+        mask = -(((unsigned char)st->r[j / 8] >> (j % 8)) & 1);
+
+        gf128_mul(p, chi + j * MTA_OT_KBYTES, st->t[j]);
+
+        for (k = 0; k < MTA_OT_KBYTES; k++)
+        {
+            x[k] ^= chi[j * MTA_OT_KBYTES + k] & mask;
+            tt[k] ^= p[k];
+        }
+    }
+
+    CA->len = MTA_OT_CA_SIZE;
+
+    // Clean memory
+    BIG_256_56_zero(a);
+    BIG_256_56_zero(d);
+    memset(ab, 0, sizeof(ab));
+    memset(t, 0, sizeof(t));
+    memset(g, 0, sizeof(g));
+    memset(p, 0, sizeof(p));
+}
+
+// Check the consistency of the extension in CA and compute its rows
+static int server_extend(MTA_OT_server *s, const octet *CA, char qr[MTA_OT_M][MTA_OT_KBYTES], unsign32 *counter)
+{
+    int i;
+    int j;
+    unsigned char mask;
+    unsigned char diff = 0;
+
+    char qc[MTA_OT_KAPPA][MTA_OT_MBYTES];
+    char chi[MTA_OT_M * MTA_OT_KBYTES];
+    char p[MTA_OT_KBYTES];
+    char acc[MTA_OT_KBYTES] = {0};
+
+    const char *u = CA->val + 4;
+    const char *x = u + MTA_OT_KAPPA * MTA_OT_MBYTES;
+    const char *tt = x + MTA_OT_KBYTES;
+
+    if (s->failed || CA->len != MTA_OT_CA_SIZE)
+    {
+        return MTA_OT_FAIL;
+    }
+
+    // The extension must be fresh. The counter is consumed even
+    // if the check fails, so the columns are never reused
+    *counter = ((unsign32)(unsigned char)CA->val[0] << 24) |
+               ((unsign32)(unsigned char)CA->val[1] << 16) |
+               ((unsign32)(unsigned char)CA->val[2] << 8) |
+               (unsign32)(unsigned char)CA->val[3];
+
+    if (*counter != s->counter)
+    {
+        return MTA_OT_FAIL;
+    }
+
+    s->counter++;
+
+    // q^i = G(k_i) + s_i.u^i
+    for (i = 0; i < MTA_OT_KAPPA; i++)
+    {
+        prg(qc[i], s->ks[i], *counter);
+
+        mask = -(((unsigned char)s->s[i / 8] >> (i % 8)) & 1);
+        for (j = 0; j < MTA_OT_MBYTES; j++)
+        {
+            qc[i][j] ^= u[i * MTA_OT_MBYTES + j] & mask;
+        }
+    }
+
+    transpose(qr, qc);
+
+    // sum chi_j.q_j = t + x.s
+    challenge(chi, *counter, u);
+
+    for (j = 0; j < MTA_OT_M; j++)
+    {
+        gf128_mul(p, chi + j * MTA_OT_KBYTES, qr[j]);
+
+        for (i = 0; i < MTA_OT_KBYTES; i++)
+        {
+            acc[i] ^= p[i];
+        }
+    }
+
+    gf128_mul(p, x, s->s);
+
+    for (i = 0; i < MTA_OT_KBYTES; i++)
+    {
+        diff |= acc[i] ^ tt[i] ^ p[i];
+    }
+
+    // Clean memory
+    memset(qc, 0, sizeof(qc));
+    memset(p, 0, sizeof(p));
+
+    // The outcome of the check leaks a bit of s. Disable the setup
+    // so a client can not probe s over several extensions
+    if (diff != 0)
+    {
+        MTA_OT_server_kill(s);
+        memset(qr, 0, MTA_OT_M * MTA_OT_KBYTES);
+        return MTA_OT_FAIL;
+    }
+
+    return MTA_OT_OK;
+}
+
+// Corrections for the product k of the extension. CB is MTA_OT_CB_SIZE bytes
+static void server_product(MTA_OT_server *s, char qr[MTA_OT_M][MTA_OT_KBYTES], unsign32 counter, int k, const octet *B, char *CB, octet *BETA)
+{
+    int i;
+    int j;
+
+    BIG_256_56 q;
+    BIG_256_56 b;
+    BIG_256_56 x0;
+    BIG_256_56 x1;
+    BIG_256_56 tau;
+    BIG_256_56 g;
+    BIG_256_56 beta;
+    BIG_256_56 gamma;
+
+    char p[MTA_OT_KBYTES];
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+    BIG_256_56_fromBytesLen(b, B->val, B->len);
+    BIG_256_56_mod(b, q);
+
+    // tau_j = x0_j + b - x1_j, beta = -sum g_j x0_j. The powers of 2
+    // are summed in beta and the rest of the gadget vector in gamma
+    BIG_256_56_zero(beta);
+    BIG_256_56_zero(gamma);
+
+    for (j = MTA_OT_CHOICE - 1; j >= 0; j--)
+    {
+        row_hash(x0, q, counter, k, j, qr[j]);
+
+        for (i = 0; i < MTA_OT_KBYTES; i++)
+        {
+            p[i] = qr[j][i] ^ s->s[i];
+        }
+
+        row_hash(x1, q, counter, k, j, p);
+
+        BIG_256_56_modneg(x1, x1, q);
+        BIG_256_56_add(tau, x0, b);
+        BIG_256_56_add(tau, tau, x1);
+        BIG_256_56_mod(tau, q);
+
+        BIG_256_56_toBytes(CB + j * EGS_SECP256K1, tau);
+
+        if (j >= MTA_OT_BITS)
+        {
+            gadget(g, q, j);
+            BIG_256_56_modmul(x0, x0, g, q);
+            BIG_256_56_add(gamma, gamma, x0);
+            BIG_256_56_mod(gamma, q);
+            continue;
+        }
+
+        // Horner step
+        BIG_256_56_add(beta, beta, beta);
+        BIG_256_56_add(beta, beta, x0);
+        BIG_256_56_mod(beta, q);
+    }
+
+    BIG_256_56_add(beta, beta, gamma);
+    BIG_256_56_mod(beta, q);
+    BIG_256_56_modneg(beta, beta, q);
+
+    BETA->len = EGS_SECP256K1;
+    BIG_256_56_toBytes(BETA->val, beta);
+
+    // Clean memory
+    BIG_256_56_zero(b);
+    BIG_256_56_zero(x0);
+    BIG_256_56_zero(x1);
+    BIG_256_56_zero(beta);
+    BIG_256_56_zero(gamma);
+    memset(p, 0, sizeof(p));
+}
+
+int MPC_MTA_OT_SERVER(MTA_OT_server *s, const octet *B, const octet *CA, octet *CB, octet *BETA)
+{
+    int rc;
+    unsign32 counter;
+
+    char qr[MTA_OT_M][MTA_OT_KBYTES];
+
+    rc = server_extend(s, CA, qr, &counter);
+    if (rc != MTA_OT_OK)
+    {
+        return rc;
+    }
+
+    server_product(s, qr, counter, 0, B, CB->val, BETA);
+    CB->len = MTA_OT_CB_SIZE;
+
+    // Clean memory
+    memset(qr, 0, sizeof(qr));
+
+    return MTA_OT_OK;
+}
+
+int MPC_MTA_OT_SERVER_MULTI(MTA_OT_server *s, int n, octet *B[], const octet *CA, octet *CB, octet *BETA[])
+{
+    int k;
+    int rc;
+    unsign32 counter;
+
+    char qr[MTA_OT_M][MTA_OT_KBYTES];
+
+    if (n < 1 || n > MTA_OT_MAX_PRODUCTS || CB->max < n * MTA_OT_CB_SIZE)
+    {
+        return MTA_OT_FAIL;
+    }
+
+    rc = server_extend(s, CA, qr, &counter);
+    if (rc != MTA_OT_OK)
+    {
+        return rc;
+    }
+
+    for (k = 0; k < n; k++)
+    {
+        server_product(s, qr, counter, k, B[k], CB->val + k * MTA_OT_CB_SIZE, BETA[k]);
+    }
+
+    CB->len = n * MTA_OT_CB_SIZE;
+
+    // Clean memory
+    memset(qr, 0, sizeof(qr));
+
+    return MTA_OT_OK;
+}
+
+// Additive share for the product k of the extension. CB is MTA_OT_CB_SIZE bytes
+static void client_product(MTA_OT_client_state *st, int k, char *CB, octet *ALPHA)
+{
+    int j;
+
+    BIG_256_56 q;
+    BIG_256_56 y;
+    BIG_256_56 tau;
+    BIG_256_56 g;
+    BIG_256_56 alpha;
+    BIG_256_56 gamma;
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+
+    // y_j = H(j, t_j) + r_j.tau_j, alpha = sum g_j y_j. The powers
+    // of 2 are summed in alpha and the rest of the gadget vector in gamma
+    BIG_256_56_zero(alpha);
+    BIG_256_56_zero(gamma);
+
+    for (j = MTA_OT_CHOICE - 1; j >= 0; j--)
+    {
+        row_hash(y, q, st->counter, k, j, st->t[j]);
+
+        BIG_256_56_fromBytes(tau, CB + j * EGS_SECP256K1);
+        BIG_256_56_add(tau, tau, y);
+        BIG_256_56_mod(tau, q);
+        BIG_256_56_cmove(y, tau, ((unsigned char)st->r[j / 8] >> (j % 8)) & 1);
+
+        if (j >= MTA_OT_BITS)
+        {
+            gadget(g, q, j);
+            BIG_256_56_modmul(y, y, g, q);
+            BIG_256_56_add(gamma, gamma, y);
+            BIG_256_56_mod(gamma, q);
+            continue;
+        }
+
+        // Horner step
+        BIG_256_56_add(alpha, alpha, alpha);
+        BIG_256_56_add(alpha, alpha, y);
+        BIG_256_56_mod(alpha, q);
+    }
+
+    BIG_256_56_add(alpha, alpha, gamma);
+    BIG_256_56_mod(alpha, q);
+
+    ALPHA->len = EGS_SECP256K1;
+    BIG_256_56_toBytes(ALPHA->val, alpha);
+
+    // Clean memory
+    BIG_256_56_zero(y);
+    BIG_256_56_zero(tau);
+    BIG_256_56_zero(alpha);
+    BIG_256_56_zero(gamma);
+}
+
+int MPC_MTA_OT_CLIENT2(MTA_OT_client_state *st, const octet *CB, octet *ALPHA)
+{
+    if (CB->len != MTA_OT_CB_SIZE)
+    {
+        MTA_OT_client_state_kill(st);
+        return MTA_OT_FAIL;
+    }
+
+    client_product(st, 0, CB->val, ALPHA);
+
+    // Clean memory
+    MTA_OT_client_state_kill(st);
+
+    return MTA_OT_OK;
+}
+
+int MPC_MTA_OT_CLIENT2_MULTI(MTA_OT_client_state *st, int n, const octet *CB, octet *ALPHA[])
+{
+    int k;
+
+    if (n < 1 || n > MTA_OT_MAX_PRODUCTS || CB->len != n * MTA_OT_CB_SIZE)
+    {
+        MTA_OT_client_state_kill(st);
+        return MTA_OT_FAIL;
+    }
+
+    for (k = 0; k < n; k++)
+    {
+        client_product(st, k, CB->val + k * MTA_OT_CB_SIZE, ALPHA[k]);
+    }
+
+    // Clean memory
+    MTA_OT_client_state_kill(st);
+
+    return MTA_OT_OK;
+}
+
+void MPC_MTA_OT_WC_COMMIT(octet *BETA, octet *BG)
+{
+    BIG_256_56 beta;
+
+    ECP_SECP256K1 G;
+
+    BIG_256_56_fromBytesLen(beta, BETA->val, BETA->len);
+
+    ECP_SECP256K1_generator(&G);
+    ECP_SECP256K1_mul(&G, beta);
+    ECP_SECP256K1_toOctet(BG, &G, true);
+
+    // Clean memory
+    BIG_256_56_zero(beta);
+}
+
+int MPC_MTA_OT_WC_VERIFY(octet *A, octet *ALPHA, octet *W, octet *BG)
+{
+    BIG_256_56 q;
+    BIG_256_56 a;
+    BIG_256_56 alpha;
+
+    ECP_SECP256K1 G;
+    ECP_SECP256K1 WP;
+    ECP_SECP256K1 BP;
+
+    if (!ECP_SECP256K1_fromOctet(&WP, W) || !ECP_SECP256K1_fromOctet(&BP, BG))
+    {
+        return MTA_OT_INVALID_ECP;
+    }
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+
+    BIG_256_56_fromBytesLen(a, A->val, A->len);
+    BIG_256_56_mod(a, q);
+    BIG_256_56_fromBytesLen(alpha, ALPHA->val, ALPHA->len);
+    BIG_256_56_mod(alpha, q);
+
+    // alpha.G + BG = a.W
+    ECP_SECP256K1_generator(&G);
+    ECP_SECP256K1_mul(&G, alpha);
+    ECP_SECP256K1_add(&G, &BP);
+
+    ECP_SECP256K1_mul(&WP, a);
+
+    // Clean memory
+    BIG_256_56_zero(a);
+    BIG_256_56_zero(alpha);
+
+    if (!ECP_SECP256K1_equals(&G, &WP))
+    {
+        return MTA_OT_FAIL;
+    }
+
+    return MTA_OT_OK;
+}
+
+void MTA_OT_client_state_kill(MTA_OT_client_state *st)
+{
+    memset(st->r, 0, sizeof(st->r));
+    memset(st->t, 0, sizeof(st->t));
+}
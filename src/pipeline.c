@@ -0,0 +1,240 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/* Dependency graph scheduling of protocol messages definitions */
+
+#include "amcl/pipeline.h"
+
+// Length of the header of a frame entry
+#define ENTRY_HEADER 3
+
+void PIPELINE_init(PIPELINE_graph *g, void *session, PIPELINE_receiver recv)
+{
+    g->session = session;
+    g->recv = recv;
+    g->n = 0;
+    g->available = 0;
+}
+
+int PIPELINE_add_step(PIPELINE_graph *g, unsigned long deps, int peer, PIPELINE_function f)
+{
+    int id = g->n;
+
+    if (id == PIPELINE_MAX_VALUES || f == NULL)
+    {
+        return -1;
+    }
+
+    if (peer != PIPELINE_LOCAL && (peer < 0 || peer >= PIPELINE_MAX_PEERS))
+    {
+        return -1;
+    }
+
+    // A step can only depend on values already in the graph,
+    // so the graph has no cycles
+    if (deps >> id)
+    {
+        return -1;
+    }
+
+    g->values[id].deps = deps;
+    g->values[id].peer = peer;
+    g->values[id].f = f;
+    g->n++;
+
+    return id;
+}
+
+int PIPELINE_add_input(PIPELINE_graph *g, int peer)
+{
+    int id = g->n;
+
+    if (id == PIPELINE_MAX_VALUES)
+    {
+        return -1;
+    }
+
+    if (peer < 0 || peer >= PIPELINE_MAX_PEERS)
+    {
+        return -1;
+    }
+
+    g->values[id].deps = 0;
+    g->values[id].peer = peer;
+    g->values[id].f = NULL;
+    g->n++;
+
+    return id;
+}
+
+int PIPELINE_run(PIPELINE_graph *g, octet *FRAMES[])
+{
+    int i;
+    int rc;
+    int progress;
+
+    octet *F;
+    octet OUT;
+    PIPELINE_value *v;
+
+    do
+    {
+        progress = 0;
+
+        for (i = 0; i < g->n; i++)
+        {
+            v = &(g->values[i]);
+
+            if (v->f == NULL || (g->available >> i) & 1UL || (g->available & v->deps) != v->deps)
+            {
+                continue;
+            }
+
+            if (v->peer == PIPELINE_LOCAL)
+            {
+                rc = v->f(g->session, i, NULL);
+                if (rc != 0)
+                {
+                    return rc;
+                }
+            }
+            else
+            {
+                F = FRAMES[v->peer];
+                if (F->max - F->len < ENTRY_HEADER)
+                {
+                    return PIPELINE_FAIL;
+                }
+
+                // Write the message after the entry header
+                OUT.len = 0;
+                OUT.max = F->max - F->len - ENTRY_HEADER;
+                if (OUT.max > 0xFFFF)
+                {
+                    OUT.max = 0xFFFF;
+                }
+                OUT.val = F->val + F->len + ENTRY_HEADER;
+
+                rc = v->f(g->session, i, &OUT);
+                if (rc != 0)
+                {
+                    return rc;
+                }
+
+                F->val[F->len]     = (char)i;
+                F->val[F->len + 1] = (char)((OUT.len >> 8) & 0xFF);
+                F->val[F->len + 2] = (char)(OUT.len & 0xFF);
+                F->len += ENTRY_HEADER + OUT.len;
+            }
+
+            g->available |= 1UL << i;
+            progress = 1;
+        }
+    }
+    while (progress);
+
+    return PIPELINE_OK;
+}
+
+// Read the header of the entry at offset. Return the offset of the
+// message or -1 if the entry does not fit in the frame
+static int read_entry(const octet *FRAME, int offset, int *id, int *len)
+{
+    if (offset + ENTRY_HEADER > FRAME->len)
+    {
+        return -1;
+    }
+
+    *id = FRAME->val[offset] & 0xFF;
+    *len = ((FRAME->val[offset + 1] & 0xFF) << 8) | (FRAME->val[offset + 2] & 0xFF);
+    offset += ENTRY_HEADER;
+
+    if (offset + *len > FRAME->len)
+    {
+        return -1;
+    }
+
+    return offset;
+}
+
+int PIPELINE_receive(PIPELINE_graph *g, int peer, octet *FRAME)
+{
+    int id;
+    int len;
+    int rc;
+    int offset;
+    unsigned long seen = 0;
+
+    octet IN;
+
+    // Validate the whole frame before delivering any value,
+    // so a malformed frame leaves the graph untouched
+    offset = 0;
+    while (offset < FRAME->len)
+    {
+        offset = read_entry(FRAME, offset, &id, &len);
+        if (offset < 0)
+        {
+            return PIPELINE_FAIL;
+        }
+
+        // Only values declared as inputs from this peer can be received, and only once
+        if (id >= g->n || g->values[id].f != NULL || g->values[id].peer != peer || ((g->available | seen) >> id) & 1UL)
+        {
+            return PIPELINE_FAIL;
+        }
+
+        seen |= 1UL << id;
+        offset += len;
+    }
+
+    offset = 0;
+    while (offset < FRAME->len)
+    {
+        offset = read_entry(FRAME, offset, &id, &len);
+
+        IN.len = len;
+        IN.max = len;
+        IN.val = FRAME->val + offset;
+
+        rc = g->recv(g->session, id, &IN);
+        if (rc != 0)
+        {
+            return rc;
+        }
+
+        g->available |= 1UL << id;
+        offset += len;
+    }
+
+    return PIPELINE_OK;
+}
+
+int PIPELINE_done(const PIPELINE_graph *g)
+{
+    unsigned long all = 0;
+
+    if (g->n > 0)
+    {
+        // Avoid shifting by the width of the type
+        all = ((1UL << (g->n - 1)) << 1) - 1;
+    }
+
+    return (g->available & all) == all;
+}
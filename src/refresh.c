@@ -0,0 +1,196 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/* Proactive refresh of the ECDSA key shares definitions */
+
+#include "amcl/refresh.h"
+
+int REFRESH_offsets(csprng *RNG, int n, octet *D[], octet *DG[])
+{
+    int i;
+
+    BIG_256_56 q;
+    BIG_256_56 d;
+    BIG_256_56 sum;
+
+    ECP_SECP256K1 G;
+
+    if (n < 1 || n > REFRESH_MAX_PARTIES)
+    {
+        return REFRESH_FAIL;
+    }
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+    BIG_256_56_zero(sum);
+
+    for (i = 0; i < n; i++)
+    {
+        if (i < n - 1)
+        {
+            BIG_256_56_randomnum(d, q, RNG);
+
+            BIG_256_56_add(sum, sum, d);
+            BIG_256_56_mod(sum, q);
+        }
+        else
+        {
+            // The last offset makes the sum zero
+            BIG_256_56_modneg(d, sum, q);
+        }
+
+        BIG_256_56_toBytes(D[i]->val, d);
+        D[i]->len = EGS_SECP256K1;
+
+        ECP_SECP256K1_generator(&G);
+        ECP_SECP256K1_mul(&G, d);
+        ECP_SECP256K1_toOctet(DG[i], &G, true);
+    }
+
+    // Clean memory
+    BIG_256_56_zero(d);
+    BIG_256_56_zero(sum);
+
+    return REFRESH_OK;
+}
+
+void REFRESH_commit(csprng *RNG, int n, octet *DG[], octet *R, octet *C)
+{
+    COMMITMENTS_NM_commit_v(RNG, n, DG, R, C);
+}
+
+int REFRESH_decommit(int n, octet *DG[], octet *R, octet *C)
+{
+    int i;
+
+    ECP_SECP256K1 P;
+    ECP_SECP256K1 SUM;
+
+    if (n < 1 || n > REFRESH_MAX_PARTIES)
+    {
+        return REFRESH_FAIL;
+    }
+
+    if (COMMITMENTS_NM_decommit_v(n, DG, R, C) != COMMITMENTS_OK)
+    {
+        return REFRESH_FAIL;
+    }
+
+    // The offsets must sum to zero so the public key is unchanged
+    ECP_SECP256K1_inf(&SUM);
+
+    for (i = 0; i < n; i++)
+    {
+        if (!ECP_SECP256K1_fromOctet(&P, DG[i]))
+        {
+            return REFRESH_INVALID_ECP;
+        }
+
+        ECP_SECP256K1_add(&SUM, &P);
+    }
+
+    if (!ECP_SECP256K1_isinf(&SUM))
+    {
+        return REFRESH_FAIL;
+    }
+
+    return REFRESH_OK;
+}
+
+int REFRESH_verify_offset(octet *D, octet *DG)
+{
+    BIG_256_56 d;
+
+    ECP_SECP256K1 G;
+    ECP_SECP256K1 P;
+
+    if (!ECP_SECP256K1_fromOctet(&P, DG))
+    {
+        return REFRESH_INVALID_ECP;
+    }
+
+    BIG_256_56_fromBytesLen(d, D->val, D->len);
+
+    ECP_SECP256K1_generator(&G);
+    ECP_SECP256K1_mul(&G, d);
+
+    // Clean memory
+    BIG_256_56_zero(d);
+
+    if (!ECP_SECP256K1_equals(&G, &P))
+    {
+        return REFRESH_FAIL;
+    }
+
+    return REFRESH_OK;
+}
+
+void REFRESH_update_share(int n, octet *S, octet *D[], octet *NS)
+{
+    int i;
+
+    BIG_256_56 q;
+    BIG_256_56 s;
+    BIG_256_56 d;
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+
+    BIG_256_56_fromBytesLen(s, S->val, S->len);
+
+    for (i = 0; i < n; i++)
+    {
+        BIG_256_56_fromBytesLen(d, D[i]->val, D[i]->len);
+
+        BIG_256_56_add(s, s, d);
+        BIG_256_56_mod(s, q);
+    }
+
+    BIG_256_56_toBytes(NS->val, s);
+    NS->len = EGS_SECP256K1;
+
+    // Clean memory
+    BIG_256_56_zero(s);
+    BIG_256_56_zero(d);
+}
+
+int REFRESH_update_public(int n, octet *X, octet *DG[], octet *NX)
+{
+    int i;
+
+    ECP_SECP256K1 P;
+    ECP_SECP256K1 SUM;
+
+    if (!ECP_SECP256K1_fromOctet(&SUM, X))
+    {
+        return REFRESH_INVALID_ECP;
+    }
+
+    for (i = 0; i < n; i++)
+    {
+        if (!ECP_SECP256K1_fromOctet(&P, DG[i]))
+        {
+            return REFRESH_INVALID_ECP;
+        }
+
+        ECP_SECP256K1_add(&SUM, &P);
+    }
+
+    ECP_SECP256K1_toOctet(NX, &SUM, true);
+
+    return REFRESH_OK;
+}
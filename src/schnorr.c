@@ -29,6 +29,51 @@ static void hash_octet(hash256 *sha, const octet *O)
     }
 }
 
+// Process the segments AD_1, ..., AD_n in place
+static void hash_segments(hash256 *sha, int n, octet *AD[])
+{
+    int i;
+
+    for (i = 0; i < n; i++)
+    {
+        hash_octet(sha, AD[i]);
+    }
+}
+
+// Initialise the challenge hash and process the generator G
+static void challenge_init(hash256 *sha)
+{
+    ECP_SECP256K1 G;
+
+    char o[SFS_SECP256K1 + 1];
+    octet O = {0, sizeof(o), o};
+
+    ECP_SECP256K1_generator(&G);
+    ECP_SECP256K1_toOctet(&O, &G, true);
+
+    HASH256_init(sha);
+    hash_octet(sha, &O);
+}
+
+// Output the challenge H(...) mod q
+static void challenge_finish(hash256 *sha, octet *E)
+{
+    BIG_256_56 e;
+    BIG_256_56 q;
+
+    char o[SHA256];
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+
+    HASH256_hash(sha, o);
+
+    BIG_256_56_fromBytesLen(e, o, SHA256);
+    BIG_256_56_mod(e, q);
+
+    BIG_256_56_toBytes(E->val, e);
+    E->len = SGS_SECP256K1;
+}
+
 void SCHNORR_random_challenge(csprng *RNG, octet *E)
 {
     BIG_256_56 e;
@@ -79,21 +124,8 @@ void SCHNORR_challenge(const octet *V, const octet *C, const octet *ID, const oc
 {
     hash256 sha;
 
-    BIG_256_56 e;
-    BIG_256_56 q;
-    ECP_SECP256K1 G;
-
-    char o[SFS_SECP256K1 + 1];
-    octet O = {0, sizeof(o), o};
-
-    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
-
-    ECP_SECP256K1_generator(&G);
-    ECP_SECP256K1_toOctet(&O, &G, true);
-
     // e = H(G,C,V,ID,AD) mod q
-    HASH256_init(&sha);
-    hash_octet(&sha, &O);
+    challenge_init(&sha);
     hash_octet(&sha, C);
     hash_octet(&sha, V);
     hash_octet(&sha, ID);
@@ -103,13 +135,21 @@ void SCHNORR_challenge(const octet *V, const octet *C, const octet *ID, const oc
         hash_octet(&sha, AD);
     }
 
-    HASH256_hash(&sha, o);
+    challenge_finish(&sha, E);
+}
 
-    BIG_256_56_fromBytesLen(e, o, SHA256);
-    BIG_256_56_mod(e, q);
+void SCHNORR_challenge_v(const octet *V, const octet *C, const octet *ID, int n, octet *AD[], octet *E)
+{
+    hash256 sha;
 
-    BIG_256_56_toBytes(E->val, e);
-    E->len = SGS_SECP256K1;
+    // e = H(G,C,V,ID,AD_1,...,AD_n) mod q
+    challenge_init(&sha);
+    hash_octet(&sha, C);
+    hash_octet(&sha, V);
+    hash_octet(&sha, ID);
+    hash_segments(&sha, n, AD);
+
+    challenge_finish(&sha, E);
 }
 
 void SCHNORR_prove(const octet *R, const octet *E, const octet *X, octet *P)
@@ -182,6 +222,224 @@ int SCHNORR_verify(octet *V, octet*C, const octet *E, const octet *P)
     return SCHNORR_OK;
 }
 
+/* Batch verification of classic Schnorr's Proofs */
+
+// Compute R = s_0.P_0 + ... + s_{n-1}.P_{n-1} using the bucket method.
+// The scalars are processed w bits at a time and the
+// points with the same window value are summed before being scaled.
+// The computation is not constant time, only use with public values.
+static void msm(ECP_SECP256K1 *R, ECP_SECP256K1 *P, BIG_256_56 *s, int n, int w)
+{
+    int i;
+    int j;
+    int k;
+    int d;
+    int nbits = 0;
+
+    ECP_SECP256K1 B[1 << SCHNORR_MSM_MAX_WINDOW];
+    ECP_SECP256K1 S;
+    ECP_SECP256K1 T;
+
+    for (i = 0; i < n; i++)
+    {
+        j = BIG_256_56_nbits(s[i]);
+        if (j > nbits)
+        {
+            nbits = j;
+        }
+    }
+
+    ECP_SECP256K1_inf(R);
+
+    for (j = (nbits + w - 1) / w - 1; j >= 0; j--)
+    {
+        for (k = 0; k < w; k++)
+        {
+            ECP_SECP256K1_dbl(R);
+        }
+
+        for (d = 1; d < (1 << w); d++)
+        {
+            ECP_SECP256K1_inf(&B[d]);
+        }
+
+        // Sort the points in the buckets
+        for (i = 0; i < n; i++)
+        {
+            d = 0;
+            for (k = w - 1; k >= 0; k--)
+            {
+                d = (d << 1) | BIG_256_56_bit(s[i], j * w + k);
+            }
+
+            if (d != 0)
+            {
+                ECP_SECP256K1_add(&B[d], &P[i]);
+            }
+        }
+
+        // Compute sum d.B[d] with running sums
+        ECP_SECP256K1_inf(&S);
+        ECP_SECP256K1_inf(&T);
+        for (d = (1 << w) - 1; d > 0; d--)
+        {
+            ECP_SECP256K1_add(&S, &B[d]);
+            ECP_SECP256K1_add(&T, &S);
+        }
+
+        ECP_SECP256K1_add(R, &T);
+    }
+}
+
+int SCHNORR_batch_verify(csprng *RNG, int w, int n, octet *V[], octet *C[], octet *E[], octet *P[])
+{
+    int i;
+    int rc;
+
+    BIG_256_56 q;
+    BIG_256_56 e;
+    BIG_256_56 p;
+    BIG_256_56 rho;
+    BIG_256_56 s[2 * SCHNORR_BATCH_MAX + 1];
+
+    ECP_SECP256K1 R;
+    ECP_SECP256K1 points[2 * SCHNORR_BATCH_MAX + 1];
+
+    if (w < 1 || w > SCHNORR_MSM_MAX_WINDOW)
+    {
+        return SCHNORR_FAIL;
+    }
+
+    // Combine the proofs in chunks
+    if (n > SCHNORR_BATCH_MAX)
+    {
+        rc = SCHNORR_batch_verify(RNG, w, SCHNORR_BATCH_MAX, V, C, E, P);
+        if (rc != SCHNORR_OK)
+        {
+            return rc;
+        }
+
+        n -= SCHNORR_BATCH_MAX;
+        return SCHNORR_batch_verify(RNG, w, n, V + SCHNORR_BATCH_MAX, C + SCHNORR_BATCH_MAX, E + SCHNORR_BATCH_MAX, P + SCHNORR_BATCH_MAX);
+    }
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+
+    // The generator coefficient is accumulated in s[0]
+    ECP_SECP256K1_generator(&points[0]);
+    BIG_256_56_zero(s[0]);
+
+    for (i = 0; i < n; i++)
+    {
+        // Read octets
+        if (!ECP_SECP256K1_fromOctet(&points[2*i + 1], V[i]))
+        {
+            return SCHNORR_INVALID_ECP;
+        }
+
+        if (!ECP_SECP256K1_fromOctet(&points[2*i + 2], C[i]))
+        {
+            return SCHNORR_INVALID_ECP;
+        }
+
+        BIG_256_56_fromBytesLen(e, E[i]->val, E[i]->len);
+        BIG_256_56_fromBytesLen(p, P[i]->val, P[i]->len);
+
+        BIG_256_56_randomnum(rho, q, RNG);
+
+        // Accumulate rho_i * p_i for G
+        BIG_256_56_modmul(p, p, rho, q);
+        BIG_256_56_add(s[0], s[0], p);
+        BIG_256_56_mod(s[0], q);
+
+        // Coefficients rho_i * e_i for V_i and -rho_i for C_i
+        BIG_256_56_modmul(s[2*i + 1], e, rho, q);
+        BIG_256_56_modneg(s[2*i + 2], rho, q);
+    }
+
+    // Check sum rho_i * (p_i.G + e_i.V_i - C_i) == O
+    msm(&R, points, s, 2*n + 1, w);
+
+    if (!ECP_SECP256K1_isinf(&R))
+    {
+        return SCHNORR_FAIL;
+    }
+
+    return SCHNORR_OK;
+}
+
+/* Multi-statement Schnorr's Proof Definitions */
+
+void SCHNORR_M_commit(csprng *RNG, int m, octet *R[], octet *C[])
+{
+    int i;
+
+    for (i = 0; i < m; i++)
+    {
+        SCHNORR_commit(RNG, R[i], C[i]);
+    }
+}
+
+void SCHNORR_M_challenge(int m, octet *V[], octet *C[], const octet *ID, const octet *AD, octet *E)
+{
+    int i;
+
+    hash256 sha;
+
+    // e = H(G,C_1,...,C_m,V_1,...,V_m,ID,AD) mod q
+    challenge_init(&sha);
+
+    for (i = 0; i < m; i++)
+    {
+        hash_octet(&sha, C[i]);
+    }
+
+    for (i = 0; i < m; i++)
+    {
+        hash_octet(&sha, V[i]);
+    }
+
+    hash_octet(&sha, ID);
+
+    if (AD != NULL)
+    {
+        hash_octet(&sha, AD);
+    }
+
+    challenge_finish(&sha, E);
+}
+
+void SCHNORR_M_prove(int m, octet *R[], const octet *E, octet *X[], octet *P[])
+{
+    int i;
+
+    for (i = 0; i < m; i++)
+    {
+        SCHNORR_prove(R[i], E, X[i], P[i]);
+    }
+}
+
+int SCHNORR_M_verify(csprng *RNG, int m, octet *V[], octet *C[], octet *E, octet *P[])
+{
+    int i;
+
+    octet *EV[SCHNORR_M_MAX];
+
+    if (m < 1 || m > SCHNORR_M_MAX)
+    {
+        return SCHNORR_FAIL;
+    }
+
+    // The statements share the challenge, so the proof
+    // is checked as a batch of classic Schnorr's Proofs
+    for (i = 0; i < m; i++)
+    {
+        EV[i] = E;
+    }
+
+    return SCHNORR_batch_verify(RNG, SCHNORR_MSM_WINDOW, m, V, C, EV, P);
+}
+
 int SCHNORR_D_commit(csprng *RNG, octet *R, octet *A, octet *B, octet *C)
 {
     BIG_256_56 a;
@@ -230,21 +488,8 @@ void SCHNORR_D_challenge(const octet *R, const octet *V, const octet *C, const o
 {
     hash256 sha;
 
-    BIG_256_56 e;
-    BIG_256_56 q;
-    ECP_SECP256K1 G;
-
-    char o[SFS_SECP256K1 + 1];
-    octet O = {0, sizeof(o), o};
-
-    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
-
-    ECP_SECP256K1_generator(&G);
-    ECP_SECP256K1_toOctet(&O, &G, true);
-
     // e = H(G,R,C,V,ID,AD) mod q
-    HASH256_init(&sha);
-    hash_octet(&sha, &O);
+    challenge_init(&sha);
     hash_octet(&sha, R);
     hash_octet(&sha, C);
     hash_octet(&sha, V);
@@ -255,13 +500,22 @@ void SCHNORR_D_challenge(const octet *R, const octet *V, const octet *C, const o
         hash_octet(&sha, AD);
     }
 
-    HASH256_hash(&sha, o);
+    challenge_finish(&sha, E);
+}
 
-    BIG_256_56_fromBytesLen(e, o, SHA256);
-    BIG_256_56_mod(e, q);
+void SCHNORR_D_challenge_v(const octet *R, const octet *V, const octet *C, const octet *ID, int n, octet *AD[], octet *E)
+{
+    hash256 sha;
 
-    BIG_256_56_toBytes(E->val, e);
-    E->len = MODBYTES_256_56;
+    // e = H(G,R,C,V,ID,AD_1,...,AD_n) mod q
+    challenge_init(&sha);
+    hash_octet(&sha, R);
+    hash_octet(&sha, C);
+    hash_octet(&sha, V);
+    hash_octet(&sha, ID);
+    hash_segments(&sha, n, AD);
+
+    challenge_finish(&sha, E);
 }
 
 void SCHNORR_D_prove(const octet *A, const octet *B, const octet *E, const octet *S, const octet *L, octet *T, octet *U)
@@ -349,3 +603,336 @@ int SCHNORR_D_verify(octet *R, octet *V, octet *C, const octet *E, const octet *
 
     return SCHNORR_OK;
 }
+
+/* Phase 5 Schnorr's Proofs */
+
+// Read the two ECPs of a commitment
+static int p5_read_commitment(ECP_SECP256K1 *C1, ECP_SECP256K1 *C2, const octet *C)
+{
+    octet O = {SFS_SECP256K1 + 1, SFS_SECP256K1 + 1, NULL};
+
+    if (C->len != SCHNORR_P5_C_SIZE)
+    {
+        return SCHNORR_INVALID_ECP;
+    }
+
+    O.val = C->val;
+    if (!ECP_SECP256K1_fromOctet(C1, &O))
+    {
+        return SCHNORR_INVALID_ECP;
+    }
+
+    O.val = C->val + SFS_SECP256K1 + 1;
+    if (!ECP_SECP256K1_fromOctet(C2, &O))
+    {
+        return SCHNORR_INVALID_ECP;
+    }
+
+    return SCHNORR_OK;
+}
+
+// Read the three scalars of a proof
+static int p5_read_proof(BIG_256_56 t, BIG_256_56 u, BIG_256_56 w, const octet *P)
+{
+    if (P->len != SCHNORR_P5_P_SIZE)
+    {
+        return SCHNORR_FAIL;
+    }
+
+    BIG_256_56_fromBytesLen(t, P->val, SGS_SECP256K1);
+    BIG_256_56_fromBytesLen(u, P->val + SGS_SECP256K1, SGS_SECP256K1);
+    BIG_256_56_fromBytesLen(w, P->val + 2 * SGS_SECP256K1, SGS_SECP256K1);
+
+    return SCHNORR_OK;
+}
+
+int SCHNORR_P5_commit(csprng *RNG, octet *R, octet *RV, octet *C)
+{
+    int i;
+
+    BIG_256_56 q;
+    BIG_256_56 r[3];
+
+    ECP_SECP256K1 G;
+    ECP_SECP256K1 ECPR;
+
+    char o[SFS_SECP256K1 + 1];
+    octet O = {0, sizeof(o), o};
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+
+    if (!ECP_SECP256K1_fromOctet(&ECPR, R))
+    {
+        return SCHNORR_INVALID_ECP;
+    }
+
+    // Read or generate secrets a, b, c
+    if (RNG != NULL)
+    {
+        for (i = 0; i < 3; i++)
+        {
+            BIG_256_56_randomnum(r[i], q, RNG);
+            BIG_256_56_toBytes(RV->val + i * SGS_SECP256K1, r[i]);
+        }
+
+        RV->len = SCHNORR_P5_RV_SIZE;
+    }
+    else
+    {
+        for (i = 0; i < 3; i++)
+        {
+            BIG_256_56_fromBytesLen(r[i], RV->val + i * SGS_SECP256K1, SGS_SECP256K1);
+        }
+    }
+
+    // C = (a.R + b.G) || c.G
+    ECP_SECP256K1_generator(&G);
+    ECP_SECP256K1_mul2(&ECPR, &G, r[0], r[1]);
+    ECP_SECP256K1_toOctet(C, &ECPR, true);
+
+    ECP_SECP256K1_mul(&G, r[2]);
+    ECP_SECP256K1_toOctet(&O, &G, true);
+    OCT_joctet(C, &O);
+
+    // Clean memory
+    for (i = 0; i < 3; i++)
+    {
+        BIG_256_56_zero(r[i]);
+    }
+
+    return SCHNORR_OK;
+}
+
+void SCHNORR_P5_challenge(const octet *R, const octet *V, const octet *A, const octet *C, const octet *ID, const octet *AD, octet *E)
+{
+    hash256 sha;
+
+    // e = H(G,R,C,V,A,ID,AD) mod q
+    challenge_init(&sha);
+    hash_octet(&sha, R);
+    hash_octet(&sha, C);
+    hash_octet(&sha, V);
+    hash_octet(&sha, A);
+    hash_octet(&sha, ID);
+
+    if (AD != NULL)
+    {
+        hash_octet(&sha, AD);
+    }
+
+    challenge_finish(&sha, E);
+}
+
+void SCHNORR_P5_prove(const octet *RV, const octet *E, const octet *S, const octet *L, const octet *M, octet *P)
+{
+    int i;
+
+    const octet *X[3] = {S, L, M};
+
+    BIG_256_56 r;
+    BIG_256_56 e;
+    BIG_256_56 x;
+    BIG_256_56 q;
+    DBIG_256_56 d;
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+    BIG_256_56_fromBytesLen(e, E->val, E->len);
+
+    // Generate t, u, w as secret + (e * exponent) mod the curve order
+    for (i = 0; i < 3; i++)
+    {
+        BIG_256_56_fromBytesLen(x, X[i]->val, X[i]->len);
+        BIG_256_56_fromBytesLen(r, RV->val + i * SGS_SECP256K1, SGS_SECP256K1);
+
+        BIG_256_56_mul(d, e, x);
+        BIG_256_56_dmod(x, d, q);
+        BIG_256_56_add(x, x, r);
+        BIG_256_56_mod(x, q);
+
+        BIG_256_56_toBytes(P->val + i * SGS_SECP256K1, x);
+    }
+
+    P->len = SCHNORR_P5_P_SIZE;
+
+    // Clean memory
+    BIG_256_56_zero(r);
+    BIG_256_56_zero(x);
+    BIG_256_56_dzero(d);
+}
+
+int SCHNORR_P5_verify(octet *R, octet *V, octet *A, octet *C, const octet *E, const octet *P)
+{
+    int rc;
+
+    ECP_SECP256K1 G;
+    ECP_SECP256K1 ECPR;
+    ECP_SECP256K1 ECPV;
+    ECP_SECP256K1 ECPA;
+    ECP_SECP256K1 C1;
+    ECP_SECP256K1 C2;
+
+    BIG_256_56 e;
+    BIG_256_56 t;
+    BIG_256_56 u;
+    BIG_256_56 w;
+
+    // Read octets
+    if (!ECP_SECP256K1_fromOctet(&ECPR, R))
+    {
+        return SCHNORR_INVALID_ECP;
+    }
+
+    if (!ECP_SECP256K1_fromOctet(&ECPV, V))
+    {
+        return SCHNORR_INVALID_ECP;
+    }
+
+    if (!ECP_SECP256K1_fromOctet(&ECPA, A))
+    {
+        return SCHNORR_INVALID_ECP;
+    }
+
+    rc = p5_read_commitment(&C1, &C2, C);
+    if (rc != SCHNORR_OK)
+    {
+        return rc;
+    }
+
+    rc = p5_read_proof(t, u, w, P);
+    if (rc != SCHNORR_OK)
+    {
+        return rc;
+    }
+
+    BIG_256_56_fromBytesLen(e, E->val, E->len);
+
+    // Check t.R + u.G == C1 + e.V
+    ECP_SECP256K1_generator(&G);
+    ECP_SECP256K1_mul2(&ECPR, &G, t, u);
+
+    ECP_SECP256K1_mul(&ECPV, e);
+    ECP_SECP256K1_add(&ECPV, &C1);
+
+    if (!ECP_SECP256K1_equals(&ECPV, &ECPR))
+    {
+        return SCHNORR_FAIL;
+    }
+
+    // Check w.G - e.A == C2
+    BIG_256_56_rcopy(t, CURVE_Order_SECP256K1);
+    BIG_256_56_modneg(e, e, t);
+    ECP_SECP256K1_mul2(&G, &ECPA, w, e);
+
+    if (!ECP_SECP256K1_equals(&G, &C2))
+    {
+        return SCHNORR_FAIL;
+    }
+
+    return SCHNORR_OK;
+}
+
+int SCHNORR_P5_batch_verify(csprng *RNG, int n, octet *R, octet *V[], octet *A[], octet *C[], octet *E[], octet *P[])
+{
+    int i;
+    int rc;
+
+    BIG_256_56 q;
+    BIG_256_56 e;
+    BIG_256_56 t;
+    BIG_256_56 u;
+    BIG_256_56 w;
+    BIG_256_56 rho;
+    BIG_256_56 sigma;
+    BIG_256_56 s[4 * SCHNORR_BATCH_MAX + 2];
+
+    ECP_SECP256K1 S;
+    ECP_SECP256K1 points[4 * SCHNORR_BATCH_MAX + 2];
+
+    // Combine the proofs in chunks
+    if (n > SCHNORR_BATCH_MAX)
+    {
+        rc = SCHNORR_P5_batch_verify(RNG, SCHNORR_BATCH_MAX, R, V, A, C, E, P);
+        if (rc != SCHNORR_OK)
+        {
+            return rc;
+        }
+
+        n -= SCHNORR_BATCH_MAX;
+        return SCHNORR_P5_batch_verify(RNG, n, R, V + SCHNORR_BATCH_MAX, A + SCHNORR_BATCH_MAX, C + SCHNORR_BATCH_MAX, E + SCHNORR_BATCH_MAX, P + SCHNORR_BATCH_MAX);
+    }
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+
+    // The coefficients of R and G are accumulated in s[0] and s[1]
+    if (!ECP_SECP256K1_fromOctet(&points[0], R))
+    {
+        return SCHNORR_INVALID_ECP;
+    }
+
+    ECP_SECP256K1_generator(&points[1]);
+
+    BIG_256_56_zero(s[0]);
+    BIG_256_56_zero(s[1]);
+
+    for (i = 0; i < n; i++)
+    {
+        // Read octets
+        if (!ECP_SECP256K1_fromOctet(&points[4*i + 2], V[i]))
+        {
+            return SCHNORR_INVALID_ECP;
+        }
+
+        if (!ECP_SECP256K1_fromOctet(&points[4*i + 3], A[i]))
+        {
+            return SCHNORR_INVALID_ECP;
+        }
+
+        rc = p5_read_commitment(&points[4*i + 4], &points[4*i + 5], C[i]);
+        if (rc != SCHNORR_OK)
+        {
+            return rc;
+        }
+
+        rc = p5_read_proof(t, u, w, P[i]);
+        if (rc != SCHNORR_OK)
+        {
+            return rc;
+        }
+
+        BIG_256_56_fromBytesLen(e, E[i]->val, E[i]->len);
+
+        BIG_256_56_randomnum(rho, q, RNG);
+        BIG_256_56_randomnum(sigma, q, RNG);
+
+        // Accumulate rho_i * t_i for R
+        BIG_256_56_modmul(t, t, rho, q);
+        BIG_256_56_add(s[0], s[0], t);
+        BIG_256_56_mod(s[0], q);
+
+        // Accumulate rho_i * u_i + sigma_i * w_i for G
+        BIG_256_56_modmul(u, u, rho, q);
+        BIG_256_56_modmul(w, w, sigma, q);
+        BIG_256_56_add(s[1], s[1], u);
+        BIG_256_56_add(s[1], s[1], w);
+        BIG_256_56_mod(s[1], q);
+
+        // Coefficients -rho_i * e_i for V_i and -sigma_i * e_i for A_i
+        BIG_256_56_modmul(s[4*i + 2], e, rho, q);
+        BIG_256_56_modneg(s[4*i + 2], s[4*i + 2], q);
+        BIG_256_56_modmul(s[4*i + 3], e, sigma, q);
+        BIG_256_56_modneg(s[4*i + 3], s[4*i + 3], q);
+
+        // Coefficients -rho_i for C_1,i and -sigma_i for C_2,i
+        BIG_256_56_modneg(s[4*i + 4], rho, q);
+        BIG_256_56_modneg(s[4*i + 5], sigma, q);
+    }
+
+    msm(&S, points, s, 4*n + 2, SCHNORR_MSM_WINDOW);
+
+    if (!ECP_SECP256K1_isinf(&S))
+    {
+        return SCHNORR_FAIL;
+    }
+
+    return SCHNORR_OK;
+}
@@ -0,0 +1,331 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/* Shamir secret sharing for t-of-n signing definitions */
+
+#include "amcl/shamir.h"
+
+// Load a small non negative integer in a BIG
+static void big_from_int(BIG_256_56 x, int i)
+{
+    BIG_256_56_zero(x);
+    BIG_256_56_inc(x, i);
+    BIG_256_56_norm(x);
+}
+
+// Index of the signer id in the subset or -1
+static int subset_index(const SHAMIR_subset *L, int id)
+{
+    int i;
+
+    for (i = 0; i < L->n; i++)
+    {
+        if (L->ids[i] == id)
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+// Bit mask of a set of signers or 0 if the identifiers are not valid
+static unsigned long subset_mask(int n, const int ids[])
+{
+    int i;
+    unsigned long bit;
+    unsigned long mask = 0;
+
+    if (n < 1 || n > SHAMIR_MAX_PARTIES)
+    {
+        return 0;
+    }
+
+    for (i = 0; i < n; i++)
+    {
+        if (ids[i] < 1 || ids[i] > SHAMIR_MAX_PARTIES)
+        {
+            return 0;
+        }
+
+        bit = 1UL << (ids[i] - 1);
+
+        // Identifiers must be distinct
+        if (mask & bit)
+        {
+            return 0;
+        }
+
+        mask |= bit;
+    }
+
+    return mask;
+}
+
+int SHAMIR_make_shares(csprng *RNG, int t, int n, const octet *S, octet *SHARES[])
+{
+    int i;
+    int k;
+
+    BIG_256_56 q;
+    BIG_256_56 x;
+    BIG_256_56 y;
+    BIG_256_56 a[SHAMIR_MAX_PARTIES];
+
+    if (t < 1 || t > n || n > SHAMIR_MAX_PARTIES)
+    {
+        return SHAMIR_FAIL;
+    }
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+
+    // Polynomial with a_0 = s
+    BIG_256_56_fromBytesLen(a[0], S->val, S->len);
+    BIG_256_56_mod(a[0], q);
+
+    for (k = 1; k < t; k++)
+    {
+        BIG_256_56_randomnum(a[k], q, RNG);
+    }
+
+    // Evaluate the polynomial in 1, ..., n using Horner's method
+    for (i = 0; i < n; i++)
+    {
+        big_from_int(x, i + 1);
+
+        BIG_256_56_copy(y, a[t-1]);
+        for (k = t - 2; k >= 0; k--)
+        {
+            BIG_256_56_modmul(y, y, x, q);
+            BIG_256_56_add(y, y, a[k]);
+            BIG_256_56_mod(y, q);
+        }
+
+        BIG_256_56_toBytes(SHARES[i]->val, y);
+        SHARES[i]->len = EGS_SECP256K1;
+    }
+
+    // Clean memory
+    BIG_256_56_zero(y);
+    for (k = 0; k < t; k++)
+    {
+        BIG_256_56_zero(a[k]);
+    }
+
+    return SHAMIR_OK;
+}
+
+int SHAMIR_subset_init(SHAMIR_subset *L, int n, const int ids[], octet *X[])
+{
+    int i;
+    int j;
+
+    unsigned long mask;
+
+    BIG_256_56 q;
+    BIG_256_56 w;
+    BIG_256_56 inv;
+    BIG_256_56 den[SHAMIR_MAX_PARTIES];
+    BIG_256_56 prefix[SHAMIR_MAX_PARTIES];
+
+    mask = subset_mask(n, ids);
+    if (mask == 0)
+    {
+        return SHAMIR_FAIL;
+    }
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+
+    L->n = n;
+    L->mask = mask;
+    L->has_pk = 0;
+
+    // Numerators prod_{j != i} j and denominators prod_{j != i} (j - i)
+    for (i = 0; i < n; i++)
+    {
+        L->ids[i] = ids[i];
+
+        BIG_256_56_one(L->lambda[i]);
+        BIG_256_56_one(den[i]);
+
+        for (j = 0; j < n; j++)
+        {
+            if (j == i)
+            {
+                continue;
+            }
+
+            big_from_int(w, ids[j]);
+            BIG_256_56_modmul(L->lambda[i], L->lambda[i], w, q);
+
+            if (ids[j] > ids[i])
+            {
+                big_from_int(w, ids[j] - ids[i]);
+            }
+            else
+            {
+                big_from_int(w, ids[i] - ids[j]);
+                BIG_256_56_modneg(w, w, q);
+            }
+
+            BIG_256_56_modmul(den[i], den[i], w, q);
+        }
+    }
+
+    // Invert all the denominators with a single inversion
+    BIG_256_56_copy(prefix[0], den[0]);
+    for (i = 1; i < n; i++)
+    {
+        BIG_256_56_modmul(prefix[i], prefix[i-1], den[i], q);
+    }
+
+    BIG_256_56_invmodp(inv, prefix[n-1], q);
+
+    for (i = n - 1; i > 0; i--)
+    {
+        // inv = (den_0 * ... * den_i)^(-1), so den_i^(-1) = inv * prefix_{i-1}
+        BIG_256_56_modmul(w, inv, prefix[i-1], q);
+        BIG_256_56_modmul(inv, inv, den[i], q);
+
+        BIG_256_56_modmul(L->lambda[i], L->lambda[i], w, q);
+    }
+
+    BIG_256_56_modmul(L->lambda[0], L->lambda[0], inv, q);
+
+    // Public additive shares
+    if (X != NULL)
+    {
+        for (i = 0; i < n; i++)
+        {
+            if (!ECP_SECP256K1_fromOctet(&(L->LX[i]), X[i]))
+            {
+                return SHAMIR_INVALID_ECP;
+            }
+
+            ECP_SECP256K1_mul(&(L->LX[i]), L->lambda[i]);
+        }
+
+        L->has_pk = 1;
+    }
+
+    return SHAMIR_OK;
+}
+
+int SHAMIR_to_additive(const SHAMIR_subset *L, int id, const octet *SHARE, octet *SK)
+{
+    int i;
+
+    BIG_256_56 q;
+    BIG_256_56 s;
+    BIG_256_56 lambda;
+
+    i = subset_index(L, id);
+    if (i < 0)
+    {
+        return SHAMIR_FAIL;
+    }
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+    BIG_256_56_copy(lambda, (chunk *)L->lambda[i]);
+
+    BIG_256_56_fromBytesLen(s, SHARE->val, SHARE->len);
+    BIG_256_56_modmul(s, s, lambda, q);
+
+    BIG_256_56_toBytes(SK->val, s);
+    SK->len = EGS_SECP256K1;
+
+    // Clean memory
+    BIG_256_56_zero(s);
+
+    return SHAMIR_OK;
+}
+
+int SHAMIR_additive_pk(SHAMIR_subset *L, int id, octet *PK)
+{
+    int i;
+
+    i = subset_index(L, id);
+    if (i < 0 || !L->has_pk)
+    {
+        return SHAMIR_FAIL;
+    }
+
+    ECP_SECP256K1_toOctet(PK, &(L->LX[i]), true);
+
+    return SHAMIR_OK;
+}
+
+void SHAMIR_cache_init(SHAMIR_cache *c)
+{
+    c->n = 0;
+    c->next = 0;
+}
+
+int SHAMIR_cache_get(SHAMIR_cache *c, int n, const int ids[], octet *X[], SHAMIR_subset **L)
+{
+    int i;
+    int rc;
+
+    unsigned long mask;
+
+    mask = subset_mask(n, ids);
+    if (mask == 0)
+    {
+        return SHAMIR_FAIL;
+    }
+
+    for (i = 0; i < c->n; i++)
+    {
+        if (c->subsets[i].mask == mask)
+        {
+            *L = &(c->subsets[i]);
+
+            // Compute the public additive shares if they are missing
+            if (X != NULL && !(*L)->has_pk)
+            {
+                return SHAMIR_subset_init(*L, n, ids, X);
+            }
+
+            return SHAMIR_OK;
+        }
+    }
+
+    // Use a free slot or evict the oldest subset
+    if (c->n < SHAMIR_CACHE_SIZE)
+    {
+        i = c->n;
+        c->n++;
+    }
+    else
+    {
+        i = c->next;
+        c->next = (c->next + 1) % SHAMIR_CACHE_SIZE;
+    }
+
+    *L = &(c->subsets[i]);
+
+    rc = SHAMIR_subset_init(*L, n, ids, X);
+    if (rc != SHAMIR_OK)
+    {
+        // Do not leave an invalid subset in the cache
+        (*L)->mask = 0;
+    }
+
+    return rc;
+}
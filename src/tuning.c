@@ -0,0 +1,102 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/* Host tuning profile definitions */
+
+#include <stdio.h>
+#include <string.h>
+#include "amcl/tuning.h"
+
+#define LINE_LEN 128
+
+static const char *MSM_WINDOWline = "SCHNORR_MSM_WINDOW";
+static const char *FLUSH_SIZEline = "BATCH_FLUSH_SIZE";
+
+void TUNING_default(TUNING_profile *t)
+{
+    t->schnorr_msm_window = SCHNORR_MSM_WINDOW;
+    t->batch_flush_size = SCHNORR_BATCH_MAX;
+}
+
+int TUNING_load(TUNING_profile *t, const char *path)
+{
+    int value;
+
+    FILE *fp;
+    char line[LINE_LEN];
+    char name[LINE_LEN];
+
+    fp = fopen(path, "r");
+    if (fp == NULL)
+    {
+        return TUNING_FAIL;
+    }
+
+    while (fgets(line, LINE_LEN, fp) != NULL)
+    {
+        if (sscanf(line, "%127s = %d", name, &value) != 2)
+        {
+            continue;
+        }
+
+        if (!strcmp(name, MSM_WINDOWline))
+        {
+            t->schnorr_msm_window = value;
+        }
+        else if (!strcmp(name, FLUSH_SIZEline))
+        {
+            t->batch_flush_size = value;
+        }
+    }
+
+    fclose(fp);
+
+    if (t->schnorr_msm_window < 1 || t->schnorr_msm_window > SCHNORR_MSM_MAX_WINDOW)
+    {
+        return TUNING_FAIL;
+    }
+
+    if (t->batch_flush_size < 1 || t->batch_flush_size > BATCH_MAX_ENTRIES)
+    {
+        return TUNING_FAIL;
+    }
+
+    return TUNING_OK;
+}
+
+int TUNING_save(const TUNING_profile *t, const char *path)
+{
+    FILE *fp;
+
+    fp = fopen(path, "w");
+    if (fp == NULL)
+    {
+        return TUNING_FAIL;
+    }
+
+    fprintf(fp, "%s = %d\n", MSM_WINDOWline, t->schnorr_msm_window);
+    fprintf(fp, "%s = %d\n", FLUSH_SIZEline, t->batch_flush_size);
+
+    if (fclose(fp) != 0)
+    {
+        return TUNING_FAIL;
+    }
+
+    return TUNING_OK;
+}
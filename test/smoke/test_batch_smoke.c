@@ -0,0 +1,164 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+#include "amcl/batch.h"
+
+/* Verification scheduler smoke test */
+
+#define N_PROOFS   9
+#define FLUSH_SIZE 8
+#define DEADLINE   10
+#define BAD_PROOF  3
+
+int results[N_PROOFS];
+
+void callback(void *session, int type, int rc)
+{
+    int i = *(int *)session;
+
+    if (type != BATCH_SCHNORR)
+    {
+        printf("FAILURE callback type %d\n", type);
+        exit(EXIT_FAILURE);
+    }
+
+    results[i] = rc;
+}
+
+int main()
+{
+    int i;
+
+    int sessions[N_PROOFS];
+
+    BIG_256_56 x;
+    BIG_256_56 q;
+    ECP_SECP256K1 G;
+
+    BATCH_scheduler s;
+
+    char id[32];
+    octet ID = {0, sizeof(id), id};
+
+    char x_char[SGS_SECP256K1];
+    octet X = {0, sizeof(x_char), x_char};
+
+    char r[SGS_SECP256K1];
+    octet R = {0, sizeof(r), r};
+
+    char v[N_PROOFS][SFS_SECP256K1+1];
+    char c[N_PROOFS][SFS_SECP256K1+1];
+    char e[N_PROOFS][SGS_SECP256K1];
+    char p[N_PROOFS][SGS_SECP256K1];
+
+    octet V[N_PROOFS];
+    octet C[N_PROOFS];
+    octet E[N_PROOFS];
+    octet P[N_PROOFS];
+
+    // Deterministic RNG for testing
+    char seed[32] = {0};
+    csprng RNG;
+    RAND_seed(&RNG, 32, seed);
+
+    OCT_rand(&ID, &RNG, ID.len);
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+
+    // Generate a proof for each session
+    for (i = 0; i < N_PROOFS; i++)
+    {
+        sessions[i] = i;
+        results[i] = -1;
+
+        V[i].len = 0;
+        V[i].max = sizeof(v[i]);
+        V[i].val = v[i];
+
+        C[i].len = 0;
+        C[i].max = sizeof(c[i]);
+        C[i].val = c[i];
+
+        E[i].len = 0;
+        E[i].max = sizeof(e[i]);
+        E[i].val = e[i];
+
+        P[i].len = 0;
+        P[i].max = sizeof(p[i]);
+        P[i].val = p[i];
+
+        BIG_256_56_randomnum(x, q, &RNG);
+
+        ECP_SECP256K1_generator(&G);
+        ECP_SECP256K1_mul(&G, x);
+
+        BIG_256_56_toBytes(X.val, x);
+        X.len = SGS_SECP256K1;
+
+        ECP_SECP256K1_toOctet(&V[i], &G, 1);
+
+        SCHNORR_commit(&RNG, &R, &C[i]);
+        SCHNORR_challenge(&V[i], &C[i], &ID, NULL, &E[i]);
+        SCHNORR_prove(&R, &E[i], &X, &P[i]);
+    }
+
+    // Invalidate one proof
+    P[BAD_PROOF].val[0] ^= 0x01;
+
+    BATCH_init(&s, &RNG, FLUSH_SIZE, SCHNORR_MSM_WINDOW, DEADLINE);
+
+    // The first FLUSH_SIZE proofs are verified when the queue is full
+    for (i = 0; i < N_PROOFS; i++)
+    {
+        BATCH_add_schnorr(&s, i, &sessions[i], callback, &V[i], &C[i], &E[i], &P[i]);
+    }
+
+    for (i = 0; i < FLUSH_SIZE; i++)
+    {
+        if (results[i] != ((i == BAD_PROOF) ? SCHNORR_FAIL : SCHNORR_OK))
+        {
+            printf("FAILURE BATCH_add_schnorr session %d rc %d\n", i, results[i]);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    // The last proof is verified only after the deadline
+    BATCH_poll(&s, N_PROOFS);
+    if (results[N_PROOFS - 1] != -1)
+    {
+        printf("FAILURE BATCH_poll before deadline\n");
+        exit(EXIT_FAILURE);
+    }
+
+    BATCH_poll(&s, N_PROOFS - 1 + DEADLINE);
+    if (results[N_PROOFS - 1] != SCHNORR_OK)
+    {
+        printf("FAILURE BATCH_poll after deadline. rc %d\n", results[N_PROOFS - 1]);
+        exit(EXIT_FAILURE);
+    }
+
+    if (s.n != 0)
+    {
+        printf("FAILURE %d proofs left in the queue\n", s.n);
+        exit(EXIT_FAILURE);
+    }
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}
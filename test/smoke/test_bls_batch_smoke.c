@@ -0,0 +1,127 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/* BLS aggregation and batch verification smoke test */
+
+#include <stdio.h>
+#include "amcl/bls_BLS381.h"
+#include "amcl/bls_batch.h"
+
+#define N 3
+
+#define G1S (BFS_BLS381 + 1)
+#define G2S (4 * BFS_BLS381)
+
+int main()
+{
+    int i;
+    int rc;
+
+    char sk[N][BGS_BLS381];
+    octet SK[N];
+
+    char pk[N][G2S];
+    octet PK[N];
+    octet *PPK[N];
+
+    char m[N][16];
+    octet M[N];
+    octet *PM[N];
+
+    char sig[N][G1S];
+    octet SIG[N];
+    octet *PSIG[N];
+
+    char agg[G1S];
+    octet AGG = {0, sizeof(agg), agg};
+
+    // Deterministic RNG for testing
+    char seed[32] = {0};
+    csprng RNG;
+    RAND_seed(&RNG, 32, seed);
+
+    for (i = 0; i < N; i++)
+    {
+        SK[i].len = 0;
+        SK[i].max = BGS_BLS381;
+        SK[i].val = sk[i];
+
+        PK[i].len = 0;
+        PK[i].max = G2S;
+        PK[i].val = pk[i];
+        PPK[i] = PK + i;
+
+        M[i].len = snprintf(m[i], sizeof(m[i]), "message %d", i);
+        M[i].max = sizeof(m[i]);
+        M[i].val = m[i];
+        PM[i] = M + i;
+
+        SIG[i].len = 0;
+        SIG[i].max = G1S;
+        SIG[i].val = sig[i];
+        PSIG[i] = SIG + i;
+
+        BLS_BLS381_KEY_PAIR_GENERATE(&RNG, SK + i, PK + i);
+        BLS_BLS381_SIGN(SIG + i, M + i, SK + i);
+    }
+
+    // Aggregate signature on distinct messages
+    rc = BLS_BATCH_aggregate_G1(N, PSIG, &AGG);
+    if (rc != BLS_BATCH_OK)
+    {
+        printf("FAILURE BLS_BATCH_aggregate_G1. rc %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    rc = BLS_BATCH_verify_aggregate(&AGG, N, PM, PPK);
+    if (rc != BLS_BATCH_OK)
+    {
+        printf("FAILURE BLS_BATCH_verify_aggregate. rc %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    rc = BLS_BATCH_verify_aggregate(&AGG, N - 1, PM, PPK);
+    if (rc != BLS_BATCH_FAIL)
+    {
+        printf("FAILURE BLS_BATCH_verify_aggregate missing message. rc %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    // Batch verification
+    rc = BLS_BATCH_verify(&RNG, N, PSIG, PM, PPK);
+    if (rc != BLS_BATCH_OK)
+    {
+        printf("FAILURE BLS_BATCH_verify. rc %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    // Swap two signatures
+    PSIG[0] = SIG + 1;
+    PSIG[1] = SIG;
+
+    rc = BLS_BATCH_verify(&RNG, N, PSIG, PM, PPK);
+    if (rc != BLS_BATCH_FAIL)
+    {
+        printf("FAILURE BLS_BATCH_verify invalid batch. rc %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}
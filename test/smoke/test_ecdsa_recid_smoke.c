@@ -0,0 +1,274 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+// Recoverable signature smoke test
+
+#include <amcl/randapi.h>
+#include <amcl/ecdh_SECP256K1.h>
+#include <amcl/mpc.h>
+
+#define ITERATIONS 16
+
+// Recover the public key from the signature and the recovery id
+int recover(const octet *HM, const octet *R, const octet *S, int recid, ECP_SECP256K1 *Q)
+{
+    BIG_256_56 q;
+    BIG_256_56 x;
+    BIG_256_56 r;
+    BIG_256_56 s;
+    BIG_256_56 z;
+
+    ECP_SECP256K1 G;
+    ECP_SECP256K1 RP;
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+    ECP_SECP256K1_generator(&G);
+
+    BIG_256_56_fromBytes(r, R->val);
+    BIG_256_56_fromBytes(s, S->val);
+    BIG_256_56_fromBytes(z, HM->val);
+    BIG_256_56_mod(z, q);
+
+    // x = r + q if the x coordinate overflowed the curve order
+    BIG_256_56_copy(x, r);
+    if (recid & 2)
+    {
+        BIG_256_56_add(x, x, q);
+        BIG_256_56_norm(x);
+    }
+
+    if (!ECP_SECP256K1_setx(&RP, x, recid & 1))
+    {
+        return 1;
+    }
+
+    // Q = r^{-1}(s.R - z.G)
+    BIG_256_56_invmodp(r, r, q);
+    BIG_256_56_modmul(s, s, r, q);
+    BIG_256_56_modmul(z, z, r, q);
+    BIG_256_56_modneg(z, z, q);
+
+    ECP_SECP256K1_mul2(&RP, &G, s, z);
+    ECP_SECP256K1_copy(Q, &RP);
+
+    return 0;
+}
+
+int test(csprng *RNG)
+{
+    int rc;
+    int recid;
+
+    BIG_256_56 q;
+    BIG_256_56 k;
+    BIG_256_56 sk;
+    BIG_256_56 g1;
+    BIG_256_56 g2;
+    BIG_256_56 t;
+
+    ECP_SECP256K1 PKPT;
+    ECP_SECP256K1 QPT;
+
+    char m[4] = {'t', 'e', 's', 't'};
+    octet M = {sizeof(m), sizeof(m), m};
+
+    char hm[SHA256];
+    octet HM = {0,sizeof(hm),hm};
+
+    char sk_oct[EGS_SECP256K1];
+    octet SK = {0,sizeof(sk_oct),sk_oct};
+
+    char pk[EFS_SECP256K1+1];
+    octet PK = {0,sizeof(pk),pk};
+
+    char k1[EGS_SECP256K1];
+    octet K1 = {0,sizeof(k1),k1};
+
+    char k2[EGS_SECP256K1];
+    octet K2 = {0,sizeof(k2),k2};
+
+    char kgamma1[EGS_SECP256K1];
+    octet KGAMMA1 = {0,sizeof(kgamma1),kgamma1};
+
+    char kgamma2[EGS_SECP256K1];
+    octet KGAMMA2 = {0,sizeof(kgamma2),kgamma2};
+
+    char invkgamma[EGS_SECP256K1];
+    octet INVKGAMMA = {0,sizeof(invkgamma),invkgamma};
+
+    char gammapt1[EFS_SECP256K1+1];
+    octet GAMMAPT1 = {0,sizeof(gammapt1),gammapt1};
+
+    char gammapt2[EFS_SECP256K1+1];
+    octet GAMMAPT2 = {0,sizeof(gammapt2),gammapt2};
+
+    char sigma1[EGS_SECP256K1];
+    octet SIGMA1 = {0,sizeof(sigma1),sigma1};
+
+    char sigma2[EGS_SECP256K1];
+    octet SIGMA2 = {0,sizeof(sigma2),sigma2};
+
+    char sig_r[EGS_SECP256K1];
+    octet SIG_R = {0,sizeof(sig_r),sig_r};
+
+    char sig_s1[EGS_SECP256K1];
+    octet SIG_S1 = {0,sizeof(sig_s1),sig_s1};
+
+    char sig_s2[EGS_SECP256K1];
+    octet SIG_S2 = {0,sizeof(sig_s2),sig_s2};
+
+    char sig_s[EGS_SECP256K1];
+    octet SIG_S = {0,sizeof(sig_s),sig_s};
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+
+    MPC_HASH(HASH_TYPE_SECP256K1, &M, &HM);
+
+    // Key pair of the signer
+    MPC_ECDSA_KEY_PAIR_GENERATE(RNG, &SK, &PK);
+    rc = ECP_SECP256K1_PUBLIC_KEY_VALIDATE(&PK);
+    if (rc != 0)
+    {
+        fprintf(stderr, "FAILURE ECP_SECP256K1_PUBLIC_KEY_VALIDATE rc: %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    ECP_SECP256K1_fromOctet(&PKPT, &PK);
+    BIG_256_56_fromBytes(sk, SK.val);
+
+    // The MtA outputs are simulated collapsing the shares of
+    // k and sigma in the first actor
+    MPC_K_GENERATE(RNG, &K1);
+    BIG_256_56_fromBytes(k, K1.val);
+
+    BIG_256_56_randomnum(g1, q, RNG);
+    BIG_256_56_randomnum(g2, q, RNG);
+
+    ECP_SECP256K1_generator(&QPT);
+    ECP_SECP256K1_mul(&QPT, g1);
+    ECP_SECP256K1_toOctet(&GAMMAPT1, &QPT, false);
+
+    ECP_SECP256K1_generator(&QPT);
+    ECP_SECP256K1_mul(&QPT, g2);
+    ECP_SECP256K1_toOctet(&GAMMAPT2, &QPT, false);
+
+    // kgamma1 = k(gamma1 + gamma2), kgamma2 = 0
+    BIG_256_56_add(t, g1, g2);
+    BIG_256_56_mod(t, q);
+    BIG_256_56_modmul(t, t, k, q);
+    KGAMMA1.len = EGS_SECP256K1;
+    BIG_256_56_toBytes(KGAMMA1.val, t);
+
+    BIG_256_56_zero(t);
+    KGAMMA2.len = EGS_SECP256K1;
+    BIG_256_56_toBytes(KGAMMA2.val, t);
+
+    // sigma1 = k.sk, k2 = sigma2 = 0
+    BIG_256_56_modmul(t, k, sk, q);
+    SIGMA1.len = EGS_SECP256K1;
+    BIG_256_56_toBytes(SIGMA1.val, t);
+
+    OCT_copy(&K2, &KGAMMA2);
+    OCT_copy(&SIGMA2, &KGAMMA2);
+
+    MPC_INVKGAMMA(&KGAMMA1, &KGAMMA2, &INVKGAMMA);
+
+    rc = MPC_R_RECID(&INVKGAMMA, &GAMMAPT1, &GAMMAPT2, &SIG_R, NULL, &recid);
+    if (rc != MPC_OK)
+    {
+        fprintf(stderr, "FAILURE MPC_R_RECID rc: %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    rc = MPC_S(&HM, &SIG_R, &K1, &SIGMA1, &SIG_S1);
+    if (rc != MPC_OK)
+    {
+        fprintf(stderr, "FAILURE MPC_S rc: %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    rc = MPC_S(&HM, &SIG_R, &K2, &SIGMA2, &SIG_S2);
+    if (rc != MPC_OK)
+    {
+        fprintf(stderr, "FAILURE MPC_S rc: %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    MPC_SUM_S_RECID(&SIG_S1, &SIG_S2, &SIG_S, &recid);
+
+    // s must be in the lower half of the range
+    BIG_256_56_fromBytes(t, SIG_S.val);
+    BIG_256_56_shl(t, 1);
+    if (BIG_256_56_comp(t, q) > 0)
+    {
+        fprintf(stderr, "FAILURE MPC_SUM_S_RECID s not normalised\n");
+        exit(EXIT_FAILURE);
+    }
+
+    rc = MPC_ECDSA_VERIFY(&HM, &PK, &SIG_R, &SIG_S);
+    if (rc != 0)
+    {
+        fprintf(stderr, "FAILURE MPC_ECDSA_VERIFY rc: %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    rc = recover(&HM, &SIG_R, &SIG_S, recid, &QPT);
+    if (rc != 0 || !ECP_SECP256K1_equals(&QPT, &PKPT))
+    {
+        fprintf(stderr, "FAILURE public key recovery. recid: %d\n", recid);
+        exit(EXIT_FAILURE);
+    }
+
+    // Clean memory
+    BIG_256_56_zero(k);
+    BIG_256_56_zero(sk);
+    BIG_256_56_zero(t);
+    OCT_clear(&SK);
+    OCT_clear(&K1);
+    OCT_clear(&SIGMA1);
+
+    return 0;
+}
+
+int main()
+{
+    int i;
+
+    char seed[32] = {0};
+    octet SEED = {sizeof(seed),sizeof(seed),seed};
+
+    csprng RNG;
+
+    // non random seed value for reproducibility
+    for (i=0; i<32; i++) SEED.val[i]=i+1;
+
+    CREATE_CSPRNG(&RNG,&SEED);
+
+    printf("Recoverable signature smoke test\n");
+
+    for (i=0; i<ITERATIONS; i++)
+    {
+        test(&RNG);
+    }
+
+    KILL_CSPRNG(&RNG);
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}
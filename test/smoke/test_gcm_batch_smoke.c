@@ -0,0 +1,133 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/* Batch AES-GCM smoke test */
+
+#include <stdio.h>
+#include "amcl/gcm_batch.h"
+
+#define N 3
+
+int main()
+{
+    int i;
+
+    char k[16] = {0};
+    octet K = {sizeof(k), sizeof(k), k};
+
+    char iv[N][12];
+    octet IV[N];
+    octet *PIV[N];
+
+    char h[N][8];
+    octet H[N];
+    octet *PH[N];
+
+    char p[N][40];
+    octet P[N];
+    octet *PP[N];
+
+    char c[N][40];
+    octet C[N];
+    octet *PC[N];
+
+    char d[N][40];
+    octet D[N];
+    octet *PD[N];
+
+    char t1[N][GCM_BATCH_TAG_SIZE];
+    octet T1[N];
+    octet *PT1[N];
+
+    char t2[N][GCM_BATCH_TAG_SIZE];
+    octet T2[N];
+    octet *PT2[N];
+
+    for (i = 0; i < N; i++)
+    {
+        IV[i].len = 0;
+        IV[i].max = sizeof(iv[i]);
+        IV[i].val = iv[i];
+        OCT_jint(IV + i, i, 4);
+        OCT_jbyte(IV + i, 0, 8);
+        PIV[i] = IV + i;
+
+        H[i].len = snprintf(h[i], sizeof(h[i]), "rec %d", i);
+        H[i].max = sizeof(h[i]);
+        H[i].val = h[i];
+        PH[i] = H + i;
+
+        // Records of different lengths, with partial blocks
+        P[i].len = 0;
+        P[i].max = sizeof(p[i]);
+        P[i].val = p[i];
+        OCT_jbyte(P + i, 'a' + i, 17 + 10 * i);
+        PP[i] = P + i;
+
+        C[i].len = 0;
+        C[i].max = sizeof(c[i]);
+        C[i].val = c[i];
+        PC[i] = C + i;
+
+        D[i].len = 0;
+        D[i].max = sizeof(d[i]);
+        D[i].val = d[i];
+        PD[i] = D + i;
+
+        T1[i].len = 0;
+        T1[i].max = sizeof(t1[i]);
+        T1[i].val = t1[i];
+        PT1[i] = T1 + i;
+
+        T2[i].len = 0;
+        T2[i].max = sizeof(t2[i]);
+        T2[i].val = t2[i];
+        PT2[i] = T2 + i;
+    }
+
+    GCM_BATCH_encrypt(&K, N, PIV, PH, PP, PC, PT1);
+    GCM_BATCH_decrypt(&K, N, PIV, PH, PC, PD, PT2);
+
+    for (i = 0; i < N; i++)
+    {
+        if (!OCT_comp(P + i, D + i) || !OCT_comp(T1 + i, T2 + i))
+        {
+            printf("FAILURE GCM_BATCH record %d\n", i);
+            exit(EXIT_FAILURE);
+        }
+
+        if (OCT_comp(P + i, C + i))
+        {
+            printf("FAILURE GCM_BATCH record %d not encrypted\n", i);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    // The header is authenticated
+    GCM_BATCH_decrypt(&K, N, PIV, NULL, PC, PD, PT2);
+
+    if (OCT_comp(T1, T2))
+    {
+        printf("FAILURE GCM_BATCH header not authenticated\n");
+        exit(EXIT_FAILURE);
+    }
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}
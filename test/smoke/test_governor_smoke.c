@@ -0,0 +1,141 @@
+/*
+    Licensed to the Apache Software Foundation (ASF) under one
+    or more contributor license agreements.  See the NOTICE file
+    distributed with this work for additional information
+    regarding copyright ownership.  The ASF licenses this file
+    to you under the Apache License, Version 2.0 (the
+    "License"); you may not use this file except in compliance
+    with the License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing,
+    software distributed under the License is distributed on an
+    "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+    KIND, either express or implied.  See the License for the
+    specific language governing permissions and limitations
+    under the License.
+*/
+
+/* Load-adaptive governor smoke test */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "amcl/governor.h"
+
+#define CPU_MAX_PATH "governor_cpu.max"
+
+static void check(int ok, const char *msg)
+{
+    if (!ok)
+    {
+        printf("FAILURE %s\n", msg);
+        exit(EXIT_FAILURE);
+    }
+}
+
+// Write a cpu.max file and derive the budget from it
+static int cgroup(const char *line, int ncpu, int permille, unsigned long *budget, unsigned long *window)
+{
+    int rc;
+    FILE *fp;
+
+    fp = fopen(CPU_MAX_PATH, "w");
+    check(fp != NULL, "cannot write " CPU_MAX_PATH);
+    fputs(line, fp);
+    fclose(fp);
+
+    rc = GOVERNOR_cgroup_budget(CPU_MAX_PATH, ncpu, permille, budget, window);
+    remove(CPU_MAX_PATH);
+
+    return rc;
+}
+
+int main()
+{
+    int i;
+    int rc;
+    int paillier;
+    int presign;
+    int keys;
+
+    unsigned long now = 0;
+    unsigned long budget;
+    unsigned long window;
+
+    GOVERNOR_state g;
+    GOVERNOR_stats s;
+
+    // 100 units of CPU every 1000, pause above a latency of 50
+    rc = GOVERNOR_init(&g, now, 100, 1000, 50);
+    check(rc == GOVERNOR_OK, "GOVERNOR_init");
+    check(GOVERNOR_init(&g, now, 100, 0, 50) == GOVERNOR_FAIL, "GOVERNOR_init. Empty window accepted");
+    GOVERNOR_init(&g, now, 100, 1000, 50);
+
+    paillier = GOVERNOR_add_pool(&g, "paillier", 10, 10);
+    presign  = GOVERNOR_add_pool(&g, "presign",   2, 10);
+    keys     = GOVERNOR_add_pool(&g, "keys",      5, 10);
+    check(paillier == 0 && presign == 1 && keys == 2, "GOVERNOR_add_pool");
+    check(GOVERNOR_add_pool(&g, "invalid", 0, 0) == GOVERNOR_IDLE, "GOVERNOR_add_pool. Invalid target accepted");
+
+    // Without consumption the emptiest pool goes first
+    check(GOVERNOR_next(&g, now) == presign, "GOVERNOR_next. Emptiest pool not chosen");
+
+    // The Paillier pool is drained quickly, so it runs dry first
+    check(GOVERNOR_consume(&g, paillier, 8) == 8, "GOVERNOR_consume");
+    now = 1000;
+    check(GOVERNOR_next(&g, now) == paillier, "GOVERNOR_next. Busiest pool not chosen");
+
+    // Taking more items than available
+    check(GOVERNOR_consume(&g, keys, 7) == 5, "GOVERNOR_consume. Dry pool");
+    check(g.pools[keys].dry == 2, "GOVERNOR_consume. Dry items not counted");
+
+    // The budget stops offline work until the next window
+    GOVERNOR_done(&g, keys, 1, 100);
+    check(GOVERNOR_next(&g, now) == GOVERNOR_IDLE, "GOVERNOR_next. Budget ignored");
+    check(g.throttled == 1, "GOVERNOR_next. Throttling not counted");
+
+    now = 2000;
+    check(GOVERNOR_next(&g, now) != GOVERNOR_IDLE, "GOVERNOR_next. Budget not restored");
+
+    // High online latency pauses offline work but for dry pools
+    for (i = 0; i < 10; i++)
+    {
+        now += 10;
+        GOVERNOR_online(&g, now, 200);
+    }
+    check(g.paused && g.pauses == 1, "GOVERNOR_online. Offline work not paused");
+    check(GOVERNOR_next(&g, now) == GOVERNOR_IDLE, "GOVERNOR_next. Pause ignored");
+
+    GOVERNOR_consume(&g, presign, 2);
+    check(GOVERNOR_next(&g, now) == presign, "GOVERNOR_next. Dry pool not refilled while paused");
+    GOVERNOR_done(&g, presign, 1, 10);
+    check(GOVERNOR_next(&g, now) == GOVERNOR_IDLE, "GOVERNOR_next. Pause ignored after refill");
+
+    // A quiet period resumes offline work
+    for (i = 0; i < 20 && g.paused; i++)
+    {
+        now += 1000;
+        GOVERNOR_next(&g, now);
+    }
+    check(!g.paused, "GOVERNOR_next. Offline work not resumed");
+
+    // Stats
+    GOVERNOR_get_stats(&g, now, &s);
+    check(s.n == 3 && s.budget == 100 && s.pauses == 1, "GOVERNOR_get_stats");
+    check(s.next == GOVERNOR_next(&g, now), "GOVERNOR_get_stats. Next pool");
+    check(s.pools[presign].refilled == 1 && s.pools[keys].refilled == 1, "GOVERNOR_get_stats. Pools");
+
+    // cgroup quota
+    rc = cgroup("200000 100000\n", 1, 250, &budget, &window);
+    check(rc == GOVERNOR_OK && budget == 50000 && window == 100000, "GOVERNOR_cgroup_budget. Quota");
+
+    rc = cgroup("max 100000\n", 4, 500, &budget, &window);
+    check(rc == GOVERNOR_OK && budget == 200000 && window == 100000, "GOVERNOR_cgroup_budget. No quota");
+
+    rc = cgroup("abc 100000\n", 4, 500, &budget, &window);
+    check(rc == GOVERNOR_FAIL, "GOVERNOR_cgroup_budget. Invalid quota accepted");
+
+    printf("SUCCESS");
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,170 @@
+/*
+    Licensed to the Apache Software Foundation (ASF) under one
+    or more contributor license agreements.  See the NOTICE file
+    distributed with this work for additional information
+    regarding copyright ownership.  The ASF licenses this file
+    to you under the Apache License, Version 2.0 (the
+    "License"); you may not use this file except in compliance
+    with the License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing,
+    software distributed under the License is distributed on an
+    "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+    KIND, either express or implied.  See the License for the
+    specific language governing permissions and limitations
+    under the License.
+*/
+
+/* Bulk ECDSA key share generation smoke test */
+
+#include "amcl/keygen.h"
+#include "amcl/mpc.h"
+
+#define N (KEYGEN_CHUNK + 3)
+
+// The table is too large for the stack
+static KEYGEN_table table;
+
+int main()
+{
+    int i;
+    int rc;
+
+    BIG_256_56 q;
+    BIG_256_56 x;
+
+    ECP_SECP256K1 T;
+    ECP_SECP256K1 G;
+
+    char s[N * EGS_SECP256K1];
+    octet S = {0, sizeof(s), s};
+
+    char w[N * KEYGEN_W_SIZE];
+    octet W = {0, sizeof(w), w};
+
+    char c[N * KEYGEN_W_SIZE];
+    octet C = {0, sizeof(c), c};
+
+    char p[N * EGS_SECP256K1];
+    octet P = {0, sizeof(p), p};
+
+    char w2[KEYGEN_W_SIZE];
+    octet W2 = {0, sizeof(w2), w2};
+
+    char e[EGS_SECP256K1];
+    octet E = {0, sizeof(e), e};
+
+    char id[32];
+    octet ID = {0, sizeof(id), id};
+
+    char ad[32];
+    octet AD = {0, sizeof(ad), ad};
+
+    octet SI;
+    octet WI;
+    octet CI;
+    octet PI;
+
+    // Deterministic RNG for testing
+    char seed[32] = {0};
+    csprng RNG;
+    RAND_seed(&RNG, 32, seed);
+
+    OCT_rand(&ID, &RNG, ID.len);
+    OCT_rand(&AD, &RNG, AD.len);
+
+    KEYGEN_table_init(&table);
+
+    // The table multiplication matches the generic one
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+
+    for (i = 0; i < 3; i++)
+    {
+        if (i == 0)
+        {
+            BIG_256_56_one(x);
+        }
+        else if (i == 1)
+        {
+            BIG_256_56_copy(x, q);
+            BIG_256_56_dec(x, 1);
+            BIG_256_56_norm(x);
+        }
+        else
+        {
+            BIG_256_56_randomnum(x, q, &RNG);
+        }
+
+        KEYGEN_table_mul(&table, &T, x);
+
+        ECP_SECP256K1_generator(&G);
+        ECP_SECP256K1_mul(&G, x);
+
+        if (!ECP_SECP256K1_equals(&T, &G))
+        {
+            printf("FAILURE KEYGEN_table_mul. Scalar %d\n", i);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    // Invalid parameters
+    if (KEYGEN_generate(&RNG, &table, 0, &ID, &AD, &S, &W, &C, &P) != KEYGEN_FAIL)
+    {
+        printf("FAILURE KEYGEN_generate. Invalid n accepted\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (KEYGEN_generate(&RNG, &table, N + 1, &ID, &AD, &S, &W, &C, &P) != KEYGEN_FAIL)
+    {
+        printf("FAILURE KEYGEN_generate. Short output accepted\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Generate the shares
+    rc = KEYGEN_generate(&RNG, &table, N, &ID, &AD, &S, &W, &C, &P);
+    if (rc != KEYGEN_OK)
+    {
+        printf("FAILURE KEYGEN_generate. RC %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    for (i = 0; i < N; i++)
+    {
+        SI.len = EGS_SECP256K1;
+        SI.max = EGS_SECP256K1;
+        SI.val = S.val + i * EGS_SECP256K1;
+
+        PI.len = EGS_SECP256K1;
+        PI.max = EGS_SECP256K1;
+        PI.val = P.val + i * EGS_SECP256K1;
+
+        WI.len = KEYGEN_W_SIZE;
+        WI.max = KEYGEN_W_SIZE;
+        WI.val = W.val + i * KEYGEN_W_SIZE;
+
+        CI.len = KEYGEN_W_SIZE;
+        CI.max = KEYGEN_W_SIZE;
+        CI.val = C.val + i * KEYGEN_W_SIZE;
+
+        // W_i = s_i.G
+        MPC_ECDSA_KEY_PAIR_GENERATE(NULL, &SI, &W2);
+        if (!OCT_comp(&WI, &W2))
+        {
+            printf("FAILURE KEYGEN_generate. Invalid public share %d\n", i);
+            exit(EXIT_FAILURE);
+        }
+
+        SCHNORR_challenge(&WI, &CI, &ID, &AD, &E);
+        rc = SCHNORR_verify(&WI, &CI, &E, &PI);
+        if (rc != SCHNORR_OK)
+        {
+            printf("FAILURE KEYGEN_generate. Invalid proof %d. RC %d\n", i, rc);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    printf("SUCCESS");
+    exit(EXIT_SUCCESS);
+}
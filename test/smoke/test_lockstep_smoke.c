@@ -0,0 +1,318 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+// Round-batched signing smoke test
+
+#include <amcl/ecdh_SECP256K1.h>
+#include <amcl/lockstep.h>
+
+#define N 2
+
+// Primes for Paillier key
+char *P_hex = "94f689d07ba20cf7c7ca7ccbed22ae6b40c426db74eaee4ce0ced2b6f52a5e136663f5f1ef379cdbb0c4fdd6e4074d6cff21082d4803d43d89e42fd8dfa82b135aa31a8844ffea25f255f956cbc1b9d8631d01baf1010d028a190b94ce40f3b72897e8196df19edf1ff62e6556f2701d52cef1442e3301db7608ecbdcca703db";
+char *Q_hex = "9a9ad73f246df853e129c589925fdad9df05606a61081e62e72be4fb33f6e5ec492cc734f28bfb71fbe2ba9a11e4c02e2c0d103a5cbb0a9d6402c07de63b1b995dd72ac8f29825d66923a088b421fb4d52b0b855d2f5dde2be9b0ca0cee6f7a94e5566735fe6cff1fcad3199602f88528d19aa8d0263adff8f5053c38254a2a3";
+
+// Safe primes for BC setup
+char *PT_hex = "CA5F37B7C0DDF6530B30A41116588218DE95F1F36B807FD7C28E4C467EE3F35967BC01D28B71F8A627A353675A81C86A1FF03DCECAF1686891183FA317BA34A4A1148D40A89F1F3AC0C200511C6CFE02342CD75354C25A2E069886DD4FB73BD365660D163F1282B143119AB8F375A73875EC16B634F52593B73BC6D875F2D3EF";
+char *QT_hex = "C2FC545C1C803F6C7625FBC4ECF9355734D6B6058FD714816D3ECFB93F1F705C9CE90D4F8796A05148AB5ABC201F90889231CC6BF5F68ED15EE4D901F603930A280EEABF10C613BFCB67A816363C839EB902B02607EB48AB8325E2B72620D4D294A232803217090DFB50AF8C620D4679E77CE3053437ED518F4F68840DCF1AA3";
+
+// Point an array of octets to a buffer
+static void init_octets(octet *O, octet *PO[], char *buf, int size)
+{
+    int i;
+
+    for (i = 0; i < N; i++)
+    {
+        O[i].len = 0;
+        O[i].max = size;
+        O[i].val = buf + i * size;
+        PO[i] = &O[i];
+    }
+}
+
+int main()
+{
+    int i;
+    int rc;
+    int failed;
+
+    BIG_256_56 q;
+    BIG_256_56 a;
+    BIG_256_56 b;
+    BIG_256_56 ab;
+    BIG_256_56 sum;
+
+    PAILLIER_private_key PRIV;
+    PAILLIER_public_key PUB;
+    COMMITMENTS_BC_priv_modulus priv_mod;
+    COMMITMENTS_BC_pub_modulus pub_mod;
+
+    MTA_RP_commitment rp_c[N];
+    MTA_RP_proof rp_p[N];
+    MTA_ZK_commitment zk_c[N];
+    MTA_ZK_proof zk_p[N];
+
+    // Opaque backend proofs
+    const MTA_BACKEND *backend = MTA_BACKEND_DEFAULT;
+    chunk cproof_buf[N][(backend->cproof_size + sizeof(chunk) - 1) / sizeof(chunk)];
+    chunk sproof_buf[N][(backend->sproof_size + sizeof(chunk) - 1) / sizeof(chunk)];
+    void *PCP[N], *PSP[N];
+
+    char p[HFS_2048];
+    octet P = {0, sizeof(p), p};
+
+    char pq[HFS_2048];
+    octet Q = {0, sizeof(pq), pq};
+
+    // Round messages
+    char m[N * (2 + FS_4096)];
+    octet M = {0, sizeof(m), m};
+
+    // Values for the signatures
+    char a_buf[N * EGS_SECP256K1];
+    char b_buf[N * EGS_SECP256K1];
+    char ca_buf[N * FS_4096];
+    char ca_rcv_buf[N * FS_4096];
+    char ra_buf[N * FS_4096];
+    char cb_buf[N * FS_4096];
+    char rb_buf[N * FS_4096];
+    char z_buf[N * EGS_SECP256K1];
+    char alpha_buf[N * EGS_SECP256K1];
+    char beta_buf[N * EGS_SECP256K1];
+    char kg1_buf[N * EGS_SECP256K1];
+    char kg2_buf[N * EGS_SECP256K1];
+    char inv_buf[N * EGS_SECP256K1];
+
+    octet A[N], B[N], CA[N], CA_RCV[N], RA[N], CB[N], RB[N], Z[N], ALPHA[N], BETA[N];
+    octet KG1[N], KG2[N], INV[N];
+
+    octet *PA[N], *PB[N], *PCA[N], *PCA_RCV[N], *PRA[N], *PCB[N], *PRB[N], *PZ[N], *PALPHA[N], *PBETA[N];
+    octet *PKG1[N], *PKG2[N], *PINV[N];
+
+    char inv[EGS_SECP256K1];
+    octet INVGOLDEN = {0, sizeof(inv), inv};
+
+    // Deterministic RNG for testing
+    char seed[32] = {0};
+    csprng RNG;
+    RAND_seed(&RNG, 32, seed);
+
+    init_octets(A, PA, a_buf, EGS_SECP256K1);
+    init_octets(B, PB, b_buf, EGS_SECP256K1);
+    init_octets(CA, PCA, ca_buf, FS_4096);
+    init_octets(CA_RCV, PCA_RCV, ca_rcv_buf, FS_4096);
+    init_octets(RA, PRA, ra_buf, FS_4096);
+    init_octets(CB, PCB, cb_buf, FS_4096);
+    init_octets(RB, PRB, rb_buf, FS_4096);
+    init_octets(Z, PZ, z_buf, EGS_SECP256K1);
+    init_octets(ALPHA, PALPHA, alpha_buf, EGS_SECP256K1);
+    init_octets(BETA, PBETA, beta_buf, EGS_SECP256K1);
+    init_octets(KG1, PKG1, kg1_buf, EGS_SECP256K1);
+    init_octets(KG2, PKG2, kg2_buf, EGS_SECP256K1);
+    init_octets(INV, PINV, inv_buf, EGS_SECP256K1);
+
+    for (i = 0; i < N; i++)
+    {
+        PCP[i] = cproof_buf[i];
+        PSP[i] = sproof_buf[i];
+    }
+
+    // Paillier key and BC modulus
+    OCT_fromHex(&P, P_hex);
+    OCT_fromHex(&Q, Q_hex);
+    PAILLIER_KEY_PAIR(NULL, &P, &Q, &PUB, &PRIV);
+
+    OCT_fromHex(&P, PT_hex);
+    OCT_fromHex(&Q, QT_hex);
+    COMMITMENTS_BC_setup(&RNG, &priv_mod, &P, &Q, NULL, NULL);
+    COMMITMENTS_BC_export_public_modulus(&pub_mod, &priv_mod);
+
+    // Random multiplicative shares
+    for (i = 0; i < N; i++)
+    {
+        MPC_K_GENERATE(&RNG, PA[i]);
+        MPC_K_GENERATE(&RNG, PB[i]);
+    }
+
+    // Client round for all the signatures
+    LOCKSTEP_MTA_CLIENT1(&RNG, &PRIV, N, PA, PCA, PRA);
+    LOCKSTEP_MTA_RP_prove(&RNG, &PUB, &PRIV, &pub_mod, NULL, N, PA, PRA, PCA, rp_c, rp_p);
+
+    rc = LOCKSTEP_pack(N, PCA, &M);
+    if (rc != LOCKSTEP_OK)
+    {
+        printf("FAILURE LOCKSTEP_pack. rc %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    rc = LOCKSTEP_unpack(&M, N, PCA_RCV);
+    if (rc != LOCKSTEP_OK)
+    {
+        printf("FAILURE LOCKSTEP_unpack. rc %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    for (i = 0; i < N; i++)
+    {
+        if (!OCT_comp(PCA[i], PCA_RCV[i]))
+        {
+            printf("FAILURE unpacked ciphertext %d\n", i);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    // Truncated messages are rejected
+    M.len--;
+    rc = LOCKSTEP_unpack(&M, N, PCA_RCV);
+    if (rc != LOCKSTEP_FAIL)
+    {
+        printf("FAILURE LOCKSTEP_unpack truncated message. rc %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+    M.len++;
+
+    // Server round for all the signatures
+    rc = LOCKSTEP_MTA_RP_verify(&PUB, &priv_mod, NULL, N, PCA, rp_c, rp_p, &failed);
+    if (rc != MTA_OK)
+    {
+        printf("FAILURE LOCKSTEP_MTA_RP_verify signature %d. rc %d\n", failed, rc);
+        exit(EXIT_FAILURE);
+    }
+
+    LOCKSTEP_MTA_SERVER(&RNG, &PUB, N, PB, PCA, PZ, PRB, PCB, PBETA);
+    LOCKSTEP_MTA_ZK_prove(&RNG, &PUB, &pub_mod, NULL, N, PB, PZ, PRB, PCA, PCB, zk_c, zk_p);
+
+    // Client completes all the signatures
+    rc = LOCKSTEP_MTA_ZK_verify(&PUB, &PRIV, &priv_mod, NULL, N, PCA, PCB, zk_c, zk_p, &failed);
+    if (rc != MTA_OK)
+    {
+        printf("FAILURE LOCKSTEP_MTA_ZK_verify signature %d. rc %d\n", failed, rc);
+        exit(EXIT_FAILURE);
+    }
+
+    LOCKSTEP_MTA_CLIENT2(&PRIV, N, PCB, PALPHA);
+
+    // alpha + beta = a * b
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+
+    for (i = 0; i < N; i++)
+    {
+        BIG_256_56_fromBytesLen(a, A[i].val, A[i].len);
+        BIG_256_56_fromBytesLen(b, B[i].val, B[i].len);
+        BIG_256_56_modmul(ab, a, b, q);
+
+        BIG_256_56_fromBytesLen(a, ALPHA[i].val, ALPHA[i].len);
+        BIG_256_56_fromBytesLen(b, BETA[i].val, BETA[i].len);
+        BIG_256_56_add(sum, a, b);
+        BIG_256_56_mod(sum, q);
+
+        if (BIG_256_56_comp(sum, ab) != 0)
+        {
+            printf("FAILURE alpha + beta != a * b for signature %d\n", i);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    // A tampered proof is reported with its index
+    OCT_copy(PCB[0], PCB[1]);
+    rc = LOCKSTEP_MTA_ZK_verify(&PUB, &PRIV, &priv_mod, NULL, N, PCA, PCB, zk_c, zk_p, &failed);
+    if (rc != MTA_FAIL || failed != 0)
+    {
+        printf("FAILURE LOCKSTEP_MTA_ZK_verify tampered proof. rc %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    // The same MtA through the backend pointer, with proofs
+    LOCKSTEP_MTA_BACKEND_CLIENT1(backend, &RNG, &PUB, N, PA, PCA, PRA);
+    LOCKSTEP_MTA_BACKEND_CLIENT1_prove(backend, &RNG, &PUB, &PRIV, &pub_mod, NULL, N, PA, PRA, PCA, PCP);
+
+    rc = LOCKSTEP_MTA_BACKEND_CLIENT1_verify(backend, &PUB, &priv_mod, NULL, N, PCA, PCP, &failed);
+    if (rc != MTA_OK)
+    {
+        printf("FAILURE LOCKSTEP_MTA_BACKEND_CLIENT1_verify signature %d. rc %d\n", failed, rc);
+        exit(EXIT_FAILURE);
+    }
+
+    LOCKSTEP_MTA_BACKEND_SERVER(backend, &RNG, &PUB, N, PB, PCA, PZ, PRB, PCB, PBETA);
+    LOCKSTEP_MTA_BACKEND_SERVER_prove(backend, &RNG, &PUB, &pub_mod, NULL, N, PB, PZ, PRB, PCA, PCB, NULL, PSP);
+
+    rc = LOCKSTEP_MTA_BACKEND_SERVER_verify(backend, &PUB, &PRIV, &priv_mod, NULL, N, PCA, PCB, NULL, PSP, &failed);
+    if (rc != MTA_OK)
+    {
+        printf("FAILURE LOCKSTEP_MTA_BACKEND_SERVER_verify signature %d. rc %d\n", failed, rc);
+        exit(EXIT_FAILURE);
+    }
+
+    LOCKSTEP_MTA_BACKEND_CLIENT2(backend, &PRIV, N, PCB, PALPHA);
+
+    for (i = 0; i < N; i++)
+    {
+        BIG_256_56_fromBytesLen(a, A[i].val, A[i].len);
+        BIG_256_56_fromBytesLen(b, B[i].val, B[i].len);
+        BIG_256_56_modmul(ab, a, b, q);
+
+        BIG_256_56_fromBytesLen(a, ALPHA[i].val, ALPHA[i].len);
+        BIG_256_56_fromBytesLen(b, BETA[i].val, BETA[i].len);
+        BIG_256_56_add(sum, a, b);
+        BIG_256_56_mod(sum, q);
+
+        if (BIG_256_56_comp(sum, ab) != 0)
+        {
+            printf("FAILURE backend alpha + beta != a * b for signature %d\n", i);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    // A swapped ciphertext is reported with its index
+    OCT_copy(PCA[1], PCA[0]);
+    rc = LOCKSTEP_MTA_BACKEND_CLIENT1_verify(backend, &PUB, &priv_mod, NULL, N, PCA, PCP, &failed);
+    if (rc != MTA_FAIL || failed != 1)
+    {
+        printf("FAILURE LOCKSTEP_MTA_BACKEND_CLIENT1_verify tampered proof. rc %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    // Batched inversion matches MPC_INVKGAMMA
+    for (i = 0; i < N; i++)
+    {
+        MPC_K_GENERATE(&RNG, PKG1[i]);
+        MPC_K_GENERATE(&RNG, PKG2[i]);
+    }
+
+    rc = LOCKSTEP_INVKGAMMA(N, PKG1, PKG2, PINV);
+    if (rc != LOCKSTEP_OK)
+    {
+        printf("FAILURE LOCKSTEP_INVKGAMMA. rc %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    for (i = 0; i < N; i++)
+    {
+        MPC_INVKGAMMA(PKG1[i], PKG2[i], &INVGOLDEN);
+
+        if (!OCT_comp(&INVGOLDEN, PINV[i]))
+        {
+            printf("FAILURE LOCKSTEP_INVKGAMMA signature %d\n", i);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}
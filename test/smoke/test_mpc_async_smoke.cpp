@@ -0,0 +1,216 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/* C++20 coroutine awaitables smoke test */
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include "amcl/mpc_async.hpp"
+
+using namespace amcl::mpc;
+
+char Phex[] = "CA5F37B7C0DDF6530B30A41116588218DE95F1F36B807FD7C28E4C467EE3F35967BC01D28B71F8A627A353675A81C86A1FF03DCECAF1686891183FA317BA34A4A1148D40A89F1F3AC0C200511C6CFE02342CD75354C25A2E069886DD4FB73BD365660D163F1282B143119AB8F375A73875EC16B634F52593B73BC6D875F2D3EF";
+char Qhex[] = "C2FC545C1C803F6C7625FBC4ECF9355734D6B6058FD714816D3ECFB93F1F705C9CE90D4F8796A05148AB5ABC201F90889231CC6BF5F68ED15EE4D901F603930A280EEABF10C613BFCB67A816363C839EB902B02607EB48AB8325E2B72620D4D294A232803217090DFB50AF8C620D4679E77CE3053437ED518F4F68840DCF1AA3";
+
+static void fail(const char *msg)
+{
+    std::printf("FAILURE %s\n", msg);
+    std::exit(EXIT_FAILURE);
+}
+
+// Single threaded event loop, standing in for the I/O executor
+struct loop
+{
+    std::mutex m;
+    std::deque<std::function<void()>> q;
+
+    void post(std::function<void()> f)
+    {
+        std::lock_guard<std::mutex> lock(m);
+        q.push_back(std::move(f));
+    }
+
+    // Run the posted functions until done is set
+    void run(const std::atomic<int> &done)
+    {
+        std::function<void()> f;
+
+        while (!done)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m);
+                if (q.empty())
+                {
+                    continue;
+                }
+
+                f = std::move(q.front());
+                q.pop_front();
+            }
+
+            f();
+        }
+    }
+};
+
+// Coroutine started eagerly and not awaited
+struct detached
+{
+    struct promise_type
+    {
+        detached get_return_object()
+        {
+            return {};
+        }
+
+        std::suspend_never initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never final_suspend() noexcept
+        {
+            return {};
+        }
+
+        void return_void() {}
+
+        void unhandled_exception()
+        {
+            std::terminate();
+        }
+    };
+};
+
+detached setup(compute_pool &pool, loop &l, std::thread::id io, csprng *RNG, COMMITMENTS_BC_priv_modulus *m, octet *P, octet *Q, std::atomic<int> &done)
+{
+    BIG_1024_58 e[FFLEN_2048];
+
+    int rc = co_await bc_setup(pool, l, std::stop_token(), RNG, m, P, Q, nullptr, nullptr);
+    if (rc != MPC_OK)
+    {
+        fail("bc_setup");
+    }
+
+    if (std::this_thread::get_id() != io)
+    {
+        fail("bc_setup was not resumed on the executor");
+    }
+
+    FF_2048_nt_pow(e, m->b0, m->alpha, m->N, FFLEN_2048, FFLEN_2048);
+    if (FF_2048_comp(e, m->b1, FFLEN_2048) != 0)
+    {
+        fail("bc_setup b1 != b0^alpha");
+    }
+
+    done = 1;
+}
+
+detached block(compute_pool &pool, loop &l, std::atomic<int> &release, std::atomic<int> &done)
+{
+    co_await offload(pool, l, std::stop_token(), [&release]
+    {
+        while (!release)
+        {
+            std::this_thread::yield();
+        }
+    });
+
+    done = 1;
+}
+
+detached queued(compute_pool &pool, loop &l, std::stop_token st, std::atomic<int> &ran, std::atomic<int> &done)
+{
+    int rc = co_await offload(pool, l, st, [&ran] { ran = 1; });
+
+    done = rc;
+}
+
+int main()
+{
+    char p[HFS_2048];
+    octet P = {0, sizeof(p), p};
+
+    char q[HFS_2048];
+    octet Q = {0, sizeof(q), q};
+
+    COMMITMENTS_BC_priv_modulus m;
+
+    std::atomic<int> done{0};
+    std::atomic<int> blocked{0};
+    std::atomic<int> release{0};
+    std::atomic<int> ran{0};
+    std::stop_source ss;
+
+    loop l;
+    compute_pool pool(1);
+
+    // Load values
+    OCT_fromHex(&P, Phex);
+    OCT_fromHex(&Q, Qhex);
+
+    // Deterministic RNG for testing
+    char seed[32] = {0};
+    csprng RNG;
+    RAND_seed(&RNG, 32, seed);
+
+    // Run the setup on the pool and resume on the loop
+    setup(pool, l, std::this_thread::get_id(), &RNG, &m, &P, &Q, done);
+    l.run(done);
+
+    COMMITMENTS_BC_kill_priv_modulus(&m);
+
+    // Cancel a job queued behind a running one
+    done = 0;
+    block(pool, l, release, blocked);
+    queued(pool, l, ss.get_token(), ran, done);
+
+    ss.request_stop();
+    l.run(done);
+
+    if (done != ASYNC_CANCELLED)
+    {
+        fail("queued job was not cancelled");
+    }
+
+    release = 1;
+    l.run(blocked);
+
+    if (ran)
+    {
+        fail("cancelled job was run");
+    }
+
+    // A stopped token cancels without suspending
+    done = 0;
+    queued(pool, l, ss.get_token(), ran, done);
+
+    if (done != ASYNC_CANCELLED || ran)
+    {
+        fail("stopped token");
+    }
+
+    std::printf("SUCCESS\n");
+    std::exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,205 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/* C++ wrappers smoke test */
+
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+#include "amcl/mpc.hpp"
+
+using namespace amcl::mpc;
+
+static const char *P_hex = "94f689d07ba20cf7c7ca7ccbed22ae6b40c426db74eaee4ce0ced2b6f52a5e136663f5f1ef379cdbb0c4fdd6e4074d6cff21082d4803d43d89e42fd8dfa82b135aa31a8844ffea25f255f956cbc1b9d8631d01baf1010d028a190b94ce40f3b72897e8196df19edf1ff62e6556f2701d52cef1442e3301db7608ecbdcca703db";
+
+static const char *Q_hex = "9a9ad73f246df853e129c589925fdad9df05606a61081e62e72be4fb33f6e5ec492cc734f28bfb71fbe2ba9a11e4c02e2c0d103a5cbb0a9d6402c07de63b1b995dd72ac8f29825d66923a088b421fb4d52b0b855d2f5dde2be9b0ca0cee6f7a94e5566735fe6cff1fcad3199602f88528d19aa8d0263adff8f5053c38254a2a3";
+
+static void fail(const char *msg)
+{
+    std::printf("FAILURE %s\n", msg);
+    std::exit(EXIT_FAILURE);
+}
+
+int main()
+{
+    int rc;
+
+    BIG_256_56 x;
+    BIG_256_56 q;
+    ECP_SECP256K1 G;
+
+    rng r;
+    char s[32] = {0};
+
+    secret_scalar X;
+    point V;
+
+    secret_scalar R;
+    point C;
+    scalar E;
+    scalar P;
+
+    nm_rv NR;
+    nm_commitment NC;
+
+    char id[32] = {1};
+
+    buffer<hfs_2048> p;
+    buffer<hfs_2048> q2;
+    PAILLIER_public_key PUB;
+    paillier_private_key PRIV;
+
+    char m[] = "test message";
+    plaintext PT;
+    ciphertext CA;
+    ciphertext CB;
+
+    secret_scalar A;
+    secret_scalar B;
+    secret_scalar ALPHA;
+    secret_scalar BETA;
+    secret_scalar ZERO;
+    secret_scalar AB;
+    secret_scalar SUM;
+
+    secret_scalar SK;
+    secret_scalar K;
+    point PK;
+    digest HM;
+    scalar SIGR;
+    scalar SIGS;
+
+    // Deterministic RNG for testing
+    seed(r, s);
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+    BIG_256_56_randomnum(x, q, r.get());
+    BIG_256_56_toBytes(X.data(), x);
+    X.resize(egs);
+
+    ECP_SECP256K1_generator(&G);
+    ECP_SECP256K1_mul(&G, x);
+    ECP_SECP256K1_toOctet(V.oct(), &G, true);
+
+    BIG_256_56_zero(x);
+
+    // Schnorr's Proof through the wrappers
+    schnorr_commit(r, R, C);
+    schnorr_challenge(V, C, id, bytes(), E);
+    schnorr_prove(R, E, X, P);
+
+    rc = schnorr_verify(V, C, E, P);
+    if (rc != SCHNORR_OK)
+    {
+        fail("schnorr_verify");
+    }
+
+    // Secrets are zeroised when moved from
+    secret_scalar Y = std::move(X);
+    if (X.size() != 0 || Y.size() != egs)
+    {
+        fail("secret_buffer move");
+    }
+
+    for (std::size_t i = 0; i < X.capacity(); i++)
+    {
+        if (X.data()[i] != 0)
+        {
+            fail("secret_buffer move was not zeroised");
+        }
+    }
+
+    // NM commitment of a public value
+    nm_commit(r, V, NR, NC);
+
+    rc = nm_decommit(V, NR, NC);
+    if (rc != COMMITMENTS_OK)
+    {
+        fail("nm_decommit");
+    }
+
+    rc = nm_decommit(C, NR, NC);
+    if (rc != COMMITMENTS_FAIL)
+    {
+        fail("nm_decommit invalid value");
+    }
+
+    // Paillier encryption through the wrappers
+    OCT_fromHex(p.oct(), const_cast<char *>(P_hex));
+    OCT_fromHex(q2.oct(), const_cast<char *>(Q_hex));
+    paillier_key_pair(r, p, q2, PUB, PRIV);
+
+    paillier_encrypt(r, PUB, V, CA);
+    paillier_decrypt(PRIV, CA, PT);
+
+    for (std::size_t i = 0; i < V.size(); i++)
+    {
+        if (PT.data()[PT.size() - V.size() + i] != V.data()[i])
+        {
+            fail("paillier_decrypt");
+        }
+    }
+
+    // MtA through the wrappers. a.b = alpha + beta
+    k_generate(r, A);
+    k_generate(r, B);
+    ZERO.resize(egs);
+
+    mta_client1(r, PUB, A, CA);
+    mta_server(r, PUB, B, CA, CB, BETA);
+    mta_client2(PRIV, CB, ALPHA);
+
+    sum_mta(A, B, ZERO, ZERO, AB);
+    sum_mta(ZERO, ZERO, ALPHA, BETA, SUM);
+
+    for (std::size_t i = 0; i < egs; i++)
+    {
+        if (AB.data()[i] != SUM.data()[i])
+        {
+            fail("mta");
+        }
+    }
+
+    // ECDSA through the wrappers
+    ecdsa_key_pair(r, SK, PK);
+    k_generate(r, K);
+
+    rc = ecdsa_sign(K, SK, bytes(m, sizeof(m) - 1), SIGR, SIGS);
+    if (rc != 0)
+    {
+        fail("ecdsa_sign");
+    }
+
+    hash(bytes(m, sizeof(m) - 1), HM);
+
+    rc = ecdsa_verify(HM, PK, SIGR, SIGS);
+    if (rc != 0)
+    {
+        fail("ecdsa_verify");
+    }
+
+    rc = ecdsa_verify(HM, V, SIGR, SIGS);
+    if (rc == 0)
+    {
+        fail("ecdsa_verify invalid public key");
+    }
+
+    std::printf("SUCCESS\n");
+    std::exit(EXIT_SUCCESS);
+}
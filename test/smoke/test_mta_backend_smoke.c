@@ -0,0 +1,145 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+// MtA backend smoke test
+
+#include <amcl/randapi.h>
+#include <amcl/ecdh_SECP256K1.h>
+#include <amcl/mta_backend.h>
+
+// Run the MtA with the backend and check alpha + beta = a.b mod q
+int test(csprng *RNG, const MTA_BACKEND *backend)
+{
+    BIG_256_56 q;
+    BIG_256_56 a;
+    BIG_256_56 b;
+    BIG_256_56 ab;
+    BIG_256_56 sum;
+
+    // Opaque backend keys
+    chunk pub[(backend->pub_size + sizeof(chunk) - 1) / sizeof(chunk)];
+    chunk priv[(backend->priv_size + sizeof(chunk) - 1) / sizeof(chunk)];
+    chunk pub2[(backend->pub_size + sizeof(chunk) - 1) / sizeof(chunk)];
+
+    char pk[backend->pk_size];
+    octet PK = {0,sizeof(pk),pk};
+
+    char oa[EGS_SECP256K1];
+    octet A = {0,sizeof(oa),oa};
+
+    char ob[EGS_SECP256K1];
+    octet B = {0,sizeof(ob),ob};
+
+    char ca[backend->ct_size];
+    octet CA = {0,sizeof(ca),ca};
+
+    char cb[backend->ct_size];
+    octet CB = {0,sizeof(cb),cb};
+
+    char alpha[EGS_SECP256K1];
+    octet ALPHA = {0,sizeof(alpha),alpha};
+
+    char beta[EGS_SECP256K1];
+    octet BETA = {0,sizeof(beta),beta};
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+
+    BIG_256_56_randomnum(a, q, RNG);
+    BIG_256_56_randomnum(b, q, RNG);
+
+    A.len = EGS_SECP256K1;
+    BIG_256_56_toBytes(A.val, a);
+    B.len = EGS_SECP256K1;
+    BIG_256_56_toBytes(B.val, b);
+
+    backend->keygen(RNG, pub, priv);
+
+    // The server only sees the serialized public key of the client
+    backend->pk_toOctet(&PK, pub);
+    backend->pk_fromOctet(pub2, &PK);
+
+    backend->client1(RNG, pub, &A, &CA, NULL);
+    backend->server(RNG, pub2, &B, &CA, NULL, NULL, &CB, &BETA);
+    backend->client2(priv, &CB, &ALPHA);
+
+    BIG_256_56_modmul(ab, a, b, q);
+
+    BIG_256_56_fromBytes(a, ALPHA.val);
+    BIG_256_56_fromBytes(b, BETA.val);
+    BIG_256_56_add(sum, a, b);
+    BIG_256_56_mod(sum, q);
+
+    if (BIG_256_56_comp(sum, ab) != 0)
+    {
+        fprintf(stderr, "FAILURE backend %s alpha + beta != a.b\n", backend->name);
+        exit(EXIT_FAILURE);
+    }
+
+    // Clean memory
+    backend->kill(priv);
+    BIG_256_56_zero(a);
+    BIG_256_56_zero(b);
+    BIG_256_56_zero(ab);
+    OCT_clear(&A);
+    OCT_clear(&B);
+    OCT_clear(&ALPHA);
+    OCT_clear(&BETA);
+
+    return 0;
+}
+
+int main()
+{
+    int i;
+    int rc;
+
+    char* seedHex = "78d0fb6705ce77dee47d03eb5b9c5d30";
+    char seed[16] = {0};
+    octet SEED = {sizeof(seed),sizeof(seed),seed};
+
+    csprng RNG;
+
+    OCT_fromHex(&SEED,seedHex);
+    CREATE_CSPRNG(&RNG,&SEED);
+
+    printf("MtA backend smoke test\n");
+
+    if (MTA_BACKEND_get(0) != MTA_BACKEND_DEFAULT || MTA_BACKEND_find("paillier") != &MTA_BACKEND_paillier)
+    {
+        fprintf(stderr, "FAILURE default backend not registered\n");
+        exit(EXIT_FAILURE);
+    }
+
+    rc = MTA_BACKEND_register(&MTA_BACKEND_paillier);
+    if (rc != MTA_BACKEND_FAIL)
+    {
+        fprintf(stderr, "FAILURE MTA_BACKEND_register duplicate rc: %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    for (i = 0; i < MTA_BACKEND_count(); i++)
+    {
+        test(&RNG, MTA_BACKEND_get(i));
+    }
+
+    KILL_CSPRNG(&RNG);
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,314 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+// OT based MtA smoke test
+
+#include <amcl/randapi.h>
+#include <amcl/mta_ot.h>
+
+#define ITERATIONS 8
+
+// Setup and state of the pair
+MTA_OT_client client;
+MTA_OT_server server;
+MTA_OT_client_state state;
+
+char ca[MTA_OT_CA_SIZE];
+char cb[MTA_OT_CB_SIZE];
+char cbm[2 * MTA_OT_CB_SIZE];
+
+int main()
+{
+    int i;
+    int rc;
+
+    BIG_256_56 q;
+    BIG_256_56 a;
+    BIG_256_56 b;
+    BIG_256_56 ab;
+    BIG_256_56 sum;
+
+    char* seedHex = "78d0fb6705ce77dee47d03eb5b9c5d30";
+    char seed[16] = {0};
+    octet SEED = {sizeof(seed),sizeof(seed),seed};
+
+    char s[MTA_OT_S_SIZE];
+    octet S = {0,sizeof(s),s};
+
+    char r[MTA_OT_R_SIZE];
+    octet R = {0,sizeof(r),r};
+
+    char oa[EGS_SECP256K1];
+    octet A = {0,sizeof(oa),oa};
+
+    char ob[EGS_SECP256K1];
+    octet B = {0,sizeof(ob),ob};
+
+    octet CA = {0,sizeof(ca),ca};
+    octet CB = {0,sizeof(cb),cb};
+
+    char alpha[EGS_SECP256K1];
+    octet ALPHA = {0,sizeof(alpha),alpha};
+
+    char beta[EGS_SECP256K1];
+    octet BETA = {0,sizeof(beta),beta};
+
+    // Two products on one extension, as for k.gamma and k.w
+    octet CBM = {0,sizeof(cbm),cbm};
+
+    char ob2[EGS_SECP256K1];
+    octet B2 = {0,sizeof(ob2),ob2};
+
+    char alpha2[EGS_SECP256K1];
+    octet ALPHA2 = {0,sizeof(alpha2),alpha2};
+
+    char beta2[EGS_SECP256K1];
+    octet BETA2 = {0,sizeof(beta2),beta2};
+
+    char w[EFS_SECP256K1 + 1];
+    octet W = {0,sizeof(w),w};
+
+    char bg[MTA_OT_BG_SIZE];
+    octet BG = {0,sizeof(bg),bg};
+
+    octet *PB[2] = {&B, &B2};
+    octet *PALPHA[2] = {&ALPHA, &ALPHA2};
+    octet *PBETA[2] = {&BETA, &BETA2};
+
+    ECP_SECP256K1 G;
+
+    csprng RNG;
+
+    OCT_fromHex(&SEED,seedHex);
+    CREATE_CSPRNG(&RNG,&SEED);
+
+    printf("OT based MtA smoke test\n");
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+
+    // Base OTs
+    MTA_OT_setup_client1(&RNG, &client, &S);
+
+    rc = MTA_OT_setup_server(&RNG, &server, &S, &R);
+    if (rc != MTA_OT_OK)
+    {
+        fprintf(stderr, "FAILURE MTA_OT_setup_server rc: %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    rc = MTA_OT_setup_client2(&client, &R);
+    if (rc != MTA_OT_OK)
+    {
+        fprintf(stderr, "FAILURE MTA_OT_setup_client2 rc: %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    // Extended MtAs
+    for (i = 0; i < ITERATIONS; i++)
+    {
+        BIG_256_56_randomnum(a, q, &RNG);
+        BIG_256_56_randomnum(b, q, &RNG);
+
+        A.len = EGS_SECP256K1;
+        BIG_256_56_toBytes(A.val, a);
+        B.len = EGS_SECP256K1;
+        BIG_256_56_toBytes(B.val, b);
+
+        MPC_MTA_OT_CLIENT1(&RNG, &client, &A, &state, &CA);
+
+        rc = MPC_MTA_OT_SERVER(&server, &B, &CA, &CB, &BETA);
+        if (rc != MTA_OT_OK)
+        {
+            fprintf(stderr, "FAILURE MPC_MTA_OT_SERVER rc: %d\n", rc);
+            exit(EXIT_FAILURE);
+        }
+
+        rc = MPC_MTA_OT_CLIENT2(&state, &CB, &ALPHA);
+        if (rc != MTA_OT_OK)
+        {
+            fprintf(stderr, "FAILURE MPC_MTA_OT_CLIENT2 rc: %d\n", rc);
+            exit(EXIT_FAILURE);
+        }
+
+        BIG_256_56_modmul(ab, a, b, q);
+
+        BIG_256_56_fromBytes(a, ALPHA.val);
+        BIG_256_56_fromBytes(b, BETA.val);
+        BIG_256_56_add(sum, a, b);
+        BIG_256_56_mod(sum, q);
+
+        if (BIG_256_56_comp(sum, ab) != 0)
+        {
+            fprintf(stderr, "FAILURE MPC_MTA_OT alpha + beta != a.b. Iteration %d\n", i);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    // One extension for two products with the same client share
+    BIG_256_56_randomnum(a, q, &RNG);
+    BIG_256_56_randomnum(b, q, &RNG);
+
+    A.len = EGS_SECP256K1;
+    BIG_256_56_toBytes(A.val, a);
+    B.len = EGS_SECP256K1;
+    BIG_256_56_toBytes(B.val, b);
+
+    BIG_256_56_randomnum(b, q, &RNG);
+    B2.len = EGS_SECP256K1;
+    BIG_256_56_toBytes(B2.val, b);
+
+    MPC_MTA_OT_CLIENT1(&RNG, &client, &A, &state, &CA);
+
+    rc = MPC_MTA_OT_SERVER_MULTI(&server, 2, PB, &CA, &CBM, PBETA);
+    if (rc != MTA_OT_OK)
+    {
+        fprintf(stderr, "FAILURE MPC_MTA_OT_SERVER_MULTI rc: %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    rc = MPC_MTA_OT_CLIENT2_MULTI(&state, 2, &CBM, PALPHA);
+    if (rc != MTA_OT_OK)
+    {
+        fprintf(stderr, "FAILURE MPC_MTA_OT_CLIENT2_MULTI rc: %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    for (i = 0; i < 2; i++)
+    {
+        BIG_256_56_fromBytes(a, A.val);
+        BIG_256_56_fromBytes(b, PB[i]->val);
+        BIG_256_56_modmul(ab, a, b, q);
+
+        BIG_256_56_fromBytes(a, PALPHA[i]->val);
+        BIG_256_56_fromBytes(b, PBETA[i]->val);
+        BIG_256_56_add(sum, a, b);
+        BIG_256_56_mod(sum, q);
+
+        if (BIG_256_56_comp(sum, ab) != 0)
+        {
+            fprintf(stderr, "FAILURE MPC_MTA_OT_MULTI alpha + beta != a.b. Product %d\n", i);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    // MTAwc check of the second product against W = b.G
+    BIG_256_56_fromBytes(b, B2.val);
+    ECP_SECP256K1_generator(&G);
+    ECP_SECP256K1_mul(&G, b);
+    ECP_SECP256K1_toOctet(&W, &G, true);
+
+    MPC_MTA_OT_WC_COMMIT(&BETA2, &BG);
+
+    rc = MPC_MTA_OT_WC_VERIFY(&A, &ALPHA2, &W, &BG);
+    if (rc != MTA_OT_OK)
+    {
+        fprintf(stderr, "FAILURE MPC_MTA_OT_WC_VERIFY rc: %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    // The first product was not computed with the share of W
+    rc = MPC_MTA_OT_WC_VERIFY(&A, &ALPHA, &W, &BG);
+    if (rc != MTA_OT_FAIL)
+    {
+        fprintf(stderr, "FAILURE MPC_MTA_OT_WC_VERIFY wrong share rc: %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    // Replayed extension
+    MPC_MTA_OT_CLIENT1(&RNG, &client, &A, &state, &CA);
+
+    rc = MPC_MTA_OT_SERVER(&server, &B, &CA, &CB, &BETA);
+    if (rc != MTA_OT_OK)
+    {
+        fprintf(stderr, "FAILURE MPC_MTA_OT_SERVER rc: %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    rc = MPC_MTA_OT_SERVER(&server, &B, &CA, &CB, &BETA);
+    if (rc != MTA_OT_FAIL)
+    {
+        fprintf(stderr, "FAILURE MPC_MTA_OT_SERVER replayed extension rc: %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    // Truncated server message
+    CB.len = EGS_SECP256K1;
+
+    rc = MPC_MTA_OT_CLIENT2(&state, &CB, &ALPHA);
+    if (rc != MTA_OT_FAIL)
+    {
+        fprintf(stderr, "FAILURE MPC_MTA_OT_CLIENT2 truncated message rc: %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    // Inconsistent extension
+    MPC_MTA_OT_CLIENT1(&RNG, &client, &A, &state, &CA);
+    CA.val[4] ^= 0x01;
+
+    rc = MPC_MTA_OT_SERVER(&server, &B, &CA, &CB, &BETA);
+    if (rc != MTA_OT_FAIL)
+    {
+        fprintf(stderr, "FAILURE MPC_MTA_OT_SERVER inconsistent extension rc: %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    // The failed check disables the server setup, also for fresh extensions
+    MPC_MTA_OT_CLIENT1(&RNG, &client, &A, &state, &CA);
+
+    rc = MPC_MTA_OT_SERVER(&server, &B, &CA, &CB, &BETA);
+    if (rc != MTA_OT_FAIL)
+    {
+        fprintf(stderr, "FAILURE MPC_MTA_OT_SERVER after failed check rc: %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    // A new setup restores the pair
+    MTA_OT_setup_client1(&RNG, &client, &S);
+    rc = MTA_OT_setup_server(&RNG, &server, &S, &R);
+    rc |= MTA_OT_setup_client2(&client, &R);
+    if (rc != MTA_OT_OK)
+    {
+        fprintf(stderr, "FAILURE MTA_OT setup after failed check rc: %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    MPC_MTA_OT_CLIENT1(&RNG, &client, &A, &state, &CA);
+
+    rc = MPC_MTA_OT_SERVER(&server, &B, &CA, &CB, &BETA);
+    if (rc != MTA_OT_OK)
+    {
+        fprintf(stderr, "FAILURE MPC_MTA_OT_SERVER after new setup rc: %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    rc = MPC_MTA_OT_CLIENT2(&state, &CB, &ALPHA);
+    if (rc != MTA_OT_OK)
+    {
+        fprintf(stderr, "FAILURE MPC_MTA_OT_CLIENT2 after new setup rc: %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    MTA_OT_client_state_kill(&state);
+    MTA_OT_client_kill(&client);
+    MTA_OT_server_kill(&server);
+    KILL_CSPRNG(&RNG);
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,269 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+#include <stdio.h>
+#include "amcl/pipeline.h"
+
+/* Dependency graph scheduling smoke test
+ *
+ * Two players run a flow shaped like the signature in example_full.c
+ *
+ *  0, 1  NM commitments of Gamma
+ *  2, 3  MTA and MTAwc requests
+ *  4, 5  MTA and MTAwc responses, depending on the requests of the peer
+ *  6, 7  Delta shares and decommitments, depending on the responses of the peer
+ *  8     Local R, depending on the commitment and decommitment of the peer
+ *
+ * The even values are sent by player A and the odd values by player B.
+ * The flow takes three round-trips instead of one per step.
+ */
+
+#define PEER 0
+#define STEPS 9
+
+typedef struct
+{
+    int player;
+    int values[STEPS];
+} session;
+
+static int step(void *s, int id, octet *OUT)
+{
+    session *ss = (session *)s;
+
+    ss->values[id] = 1;
+
+    if (OUT != NULL)
+    {
+        OUT->val[0] = (char)(ss->player * 16 + id);
+        OUT->len = 1;
+    }
+
+    return 0;
+}
+
+static int receive(void *s, int id, octet *IN)
+{
+    session *ss = (session *)s;
+
+    // The message must come from the other player
+    if (IN->len != 1 || IN->val[0] != (char)((1 - ss->player) * 16 + id))
+    {
+        return 1;
+    }
+
+    ss->values[id] = 1;
+
+    return 0;
+}
+
+static void build(PIPELINE_graph *g, session *s, int player)
+{
+    int i;
+
+    // Identifier of the values sent by the other player
+    int o = 1 - player;
+
+    s->player = player;
+    for (i = 0; i < STEPS; i++)
+    {
+        s->values[i] = 0;
+    }
+
+    PIPELINE_init(g, s, receive);
+
+    for (i = 0; i < 8; i += 2)
+    {
+        unsigned long deps = 0;
+
+        if (i == 4)
+        {
+            deps = 1UL << (2 + o);
+        }
+        else if (i == 6)
+        {
+            deps = 1UL << (4 + o);
+        }
+
+        if (player == 0)
+        {
+            PIPELINE_add_step(g, deps, PEER, step);
+            PIPELINE_add_input(g, PEER);
+        }
+        else
+        {
+            PIPELINE_add_input(g, PEER);
+            PIPELINE_add_step(g, deps, PEER, step);
+        }
+    }
+
+    PIPELINE_add_step(g, (1UL << o) | (1UL << (6 + o)), PIPELINE_LOCAL, step);
+}
+
+int main()
+{
+    int i;
+    int rc;
+    int rounds = 0;
+
+    PIPELINE_graph GA;
+    PIPELINE_graph GB;
+    session SA;
+    session SB;
+
+    char fa[256];
+    octet FA = {0, sizeof(fa), fa};
+    octet *FRAMES_A[1] = {&FA};
+
+    char fb[256];
+    octet FB = {0, sizeof(fb), fb};
+    octet *FRAMES_B[1] = {&FB};
+
+    build(&GA, &SA, 0);
+    build(&GB, &SB, 1);
+
+    while (!PIPELINE_done(&GA) || !PIPELINE_done(&GB))
+    {
+        OCT_clear(&FA);
+        OCT_clear(&FB);
+
+        rc = PIPELINE_run(&GA, FRAMES_A);
+        if (rc != PIPELINE_OK)
+        {
+            printf("FAILURE PIPELINE_run A. rc %d\n", rc);
+            exit(EXIT_FAILURE);
+        }
+
+        rc = PIPELINE_run(&GB, FRAMES_B);
+        if (rc != PIPELINE_OK)
+        {
+            printf("FAILURE PIPELINE_run B. rc %d\n", rc);
+            exit(EXIT_FAILURE);
+        }
+
+        if (FA.len == 0 && FB.len == 0)
+        {
+            break;
+        }
+
+        rounds++;
+
+        rc = PIPELINE_receive(&GB, PEER, &FA);
+        if (rc != PIPELINE_OK)
+        {
+            printf("FAILURE PIPELINE_receive B. rc %d\n", rc);
+            exit(EXIT_FAILURE);
+        }
+
+        rc = PIPELINE_receive(&GA, PEER, &FB);
+        if (rc != PIPELINE_OK)
+        {
+            printf("FAILURE PIPELINE_receive A. rc %d\n", rc);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    if (!PIPELINE_done(&GA) || !PIPELINE_done(&GB))
+    {
+        printf("FAILURE graph not completed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (i = 0; i < STEPS; i++)
+    {
+        if (!SA.values[i] || !SB.values[i])
+        {
+            printf("FAILURE value %d missing\n", i);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    if (rounds != 3)
+    {
+        printf("FAILURE %d rounds instead of 3\n", rounds);
+        exit(EXIT_FAILURE);
+    }
+
+    // A value can not be received twice
+    FA.len = 0;
+    OCT_jbyte(&FA, 0, 1);
+    OCT_jint(&FA, 1, 2);
+    OCT_jbyte(&FA, 0, 1);
+
+    rc = PIPELINE_receive(&GB, PEER, &FA);
+    if (rc != PIPELINE_FAIL)
+    {
+        printf("FAILURE PIPELINE_receive repeated value. rc %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    // A value can not be received from another peer
+    build(&GB, &SB, 1);
+
+    rc = PIPELINE_receive(&GB, PEER + 1, &FA);
+    if (rc != PIPELINE_FAIL || SB.values[0])
+    {
+        printf("FAILURE PIPELINE_receive wrong peer. rc %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    rc = PIPELINE_receive(&GB, PEER, &FA);
+    if (rc != PIPELINE_OK || !SB.values[0])
+    {
+        printf("FAILURE PIPELINE_receive right peer. rc %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    // A malformed frame does not deliver any value
+    build(&GB, &SB, 1);
+
+    FA.len = 0;
+    OCT_jbyte(&FA, 0, 1);
+    OCT_jint(&FA, 1, 2);
+    OCT_jbyte(&FA, 0, 1);
+    OCT_jbyte(&FA, 2, 1);
+    OCT_jint(&FA, 2, 2);
+    OCT_jbyte(&FA, 2, 1);
+
+    rc = PIPELINE_receive(&GB, PEER, &FA);
+    if (rc != PIPELINE_FAIL || SB.values[0] || GB.available)
+    {
+        printf("FAILURE PIPELINE_receive truncated frame. rc %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    // A value can not be repeated in a frame
+    FA.len = 0;
+    OCT_jbyte(&FA, 0, 1);
+    OCT_jint(&FA, 1, 2);
+    OCT_jbyte(&FA, 0, 1);
+    OCT_jbyte(&FA, 0, 1);
+    OCT_jint(&FA, 1, 2);
+    OCT_jbyte(&FA, 0, 1);
+
+    rc = PIPELINE_receive(&GB, PEER, &FA);
+    if (rc != PIPELINE_FAIL || SB.values[0] || GB.available)
+    {
+        printf("FAILURE PIPELINE_receive duplicate value. rc %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}
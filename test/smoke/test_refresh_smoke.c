@@ -0,0 +1,234 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+// Proactive refresh smoke test
+
+#include <amcl/ecdh_SECP256K1.h>
+#include <amcl/mpc.h>
+#include <amcl/schnorr.h>
+#include <amcl/refresh.h>
+
+#define N 2
+
+int main()
+{
+    int i;
+    int j;
+    int rc;
+
+    char seed[32] = {0};
+    csprng RNG;
+
+    // Key shares and public key shares of the parties
+    char s[N][EGS_SECP256K1];
+    octet S[N];
+
+    char x[N][EFS_SECP256K1 + 1];
+    octet X[N];
+
+    char old_s[EGS_SECP256K1];
+    octet OLD_S = {0, sizeof(old_s), old_s};
+
+    char pk[EFS_SECP256K1 + 1];
+    octet PK = {0, sizeof(pk), pk};
+
+    char npk[EFS_SECP256K1 + 1];
+    octet NPK = {0, sizeof(npk), npk};
+
+    // Offsets generated by party i for party j
+    char d[N][N][EGS_SECP256K1];
+    octet D[N][N];
+
+    char dg[N][N][EFS_SECP256K1 + 1];
+    octet DG[N][N];
+
+    char r[N][SHA256];
+    octet R[N];
+
+    char c[N][SHA256];
+    octet C[N];
+
+    octet *Di[N];
+    octet *DGi[N];
+
+    // Schnorr's Proof of the new share
+    char sr[EGS_SECP256K1];
+    octet SR = {0, sizeof(sr), sr};
+
+    char sc[EFS_SECP256K1 + 1];
+    octet SC = {0, sizeof(sc), sc};
+
+    char se[EGS_SECP256K1];
+    octet SE = {0, sizeof(se), se};
+
+    char sp[EGS_SECP256K1];
+    octet SP = {0, sizeof(sp), sp};
+
+    char id[32];
+    octet ID = {0, sizeof(id), id};
+
+    for (i = 0; i < N; i++)
+    {
+        S[i].len = 0;
+        S[i].max = sizeof(s[i]);
+        S[i].val = s[i];
+
+        X[i].len = 0;
+        X[i].max = sizeof(x[i]);
+        X[i].val = x[i];
+
+        R[i].len = 0;
+        R[i].max = sizeof(r[i]);
+        R[i].val = r[i];
+
+        C[i].len = 0;
+        C[i].max = sizeof(c[i]);
+        C[i].val = c[i];
+
+        for (j = 0; j < N; j++)
+        {
+            D[i][j].len = 0;
+            D[i][j].max = sizeof(d[i][j]);
+            D[i][j].val = d[i][j];
+
+            DG[i][j].len = 0;
+            DG[i][j].max = sizeof(dg[i][j]);
+            DG[i][j].val = dg[i][j];
+        }
+    }
+
+    // Deterministic RNG for testing
+    RAND_seed(&RNG, 32, seed);
+
+    OCT_rand(&ID, &RNG, ID.len);
+
+    // Existing key shares
+    for (i = 0; i < N; i++)
+    {
+        MPC_ECDSA_KEY_PAIR_GENERATE(&RNG, &S[i], &X[i]);
+    }
+
+    MPC_SUM_PK(&X[0], &X[1], &PK);
+    OCT_copy(&OLD_S, &S[0]);
+
+    // Round 1. Generate offsets and commit to the public offsets
+    for (i = 0; i < N; i++)
+    {
+        for (j = 0; j < N; j++)
+        {
+            Di[j] = &D[i][j];
+            DGi[j] = &DG[i][j];
+        }
+
+        rc = REFRESH_offsets(&RNG, N, Di, DGi);
+        if (rc != REFRESH_OK)
+        {
+            printf("FAILURE REFRESH_offsets party %d. rc %d\n", i, rc);
+            exit(EXIT_FAILURE);
+        }
+
+        REFRESH_commit(&RNG, N, DGi, &R[i], &C[i]);
+    }
+
+    // Round 2. Open the commitments and send the offsets
+    for (i = 0; i < N; i++)
+    {
+        for (j = 0; j < N; j++)
+        {
+            DGi[j] = &DG[i][j];
+        }
+
+        rc = REFRESH_decommit(N, DGi, &R[i], &C[i]);
+        if (rc != REFRESH_OK)
+        {
+            printf("FAILURE REFRESH_decommit party %d. rc %d\n", i, rc);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    // Each party verifies the received offsets and updates the shares
+    for (j = 0; j < N; j++)
+    {
+        for (i = 0; i < N; i++)
+        {
+            rc = REFRESH_verify_offset(&D[i][j], &DG[i][j]);
+            if (rc != REFRESH_OK)
+            {
+                printf("FAILURE REFRESH_verify_offset from %d to %d. rc %d\n", i, j, rc);
+                exit(EXIT_FAILURE);
+            }
+
+            Di[i] = &D[i][j];
+            DGi[i] = &DG[i][j];
+        }
+
+        REFRESH_update_share(N, &S[j], Di, &S[j]);
+
+        rc = REFRESH_update_public(N, &X[j], DGi, &X[j]);
+        if (rc != REFRESH_OK)
+        {
+            printf("FAILURE REFRESH_update_public party %d. rc %d\n", j, rc);
+            exit(EXIT_FAILURE);
+        }
+
+        // Prove knowledge of the new share
+        SCHNORR_commit(&RNG, &SR, &SC);
+        SCHNORR_challenge(&X[j], &SC, &ID, NULL, &SE);
+        SCHNORR_prove(&SR, &SE, &S[j], &SP);
+
+        rc = SCHNORR_verify(&X[j], &SC, &SE, &SP);
+        if (rc != SCHNORR_OK)
+        {
+            printf("FAILURE SCHNORR_verify new share %d. rc %d\n", j, rc);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    // The public key is unchanged and the shares are new
+    MPC_SUM_PK(&X[0], &X[1], &NPK);
+    if (!OCT_comp(&PK, &NPK))
+    {
+        printf("FAILURE public key changed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (OCT_comp(&OLD_S, &S[0]))
+    {
+        printf("FAILURE share not refreshed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Offsets not summing to zero are rejected
+    OCT_copy(&DG[0][0], &DG[0][1]);
+    for (j = 0; j < N; j++)
+    {
+        DGi[j] = &DG[0][j];
+    }
+
+    REFRESH_commit(&RNG, N, DGi, &R[0], &C[0]);
+    rc = REFRESH_decommit(N, DGi, &R[0], &C[0]);
+    if (rc != REFRESH_FAIL)
+    {
+        printf("FAILURE REFRESH_decommit invalid offsets. rc %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}
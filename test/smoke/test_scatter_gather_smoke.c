@@ -0,0 +1,182 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/* Scatter-gather inputs smoke test */
+
+#include "amcl/commitments.h"
+#include "amcl/schnorr.h"
+#include "amcl/factoring_zk.h"
+
+// RSA modulus for the factoring ZKP
+char *P_hex = "e008507e09c24d756280f3d94912fb9ac16c0a8a1757ee01a350736acfc7f65880f87eca55d6680253383fc546d03fd9ebab7d8fa746455180888cb7c17edf58d3327296468e5ab736374bc9a0fa02606ed5d3a4a5fb1677891f87fbf3c655c3e0549a86b17b7ddce07c8f73e253105e59f5d3ed2c7ba5bdf8495df40ae71a7f";
+char *Q_hex = "dbffe278edd44c2655714e5a4cc82e66e46063f9ab69df9d0ed20eb3d7f2d8c7d985df71c28707f32b961d160ca938e9cf909cd77c4f8c630aec34b67714cbfd4942d7147c509db131bc2d6a667eb30df146f64b710f8f5247848b0a75738a38772e31014fd63f0b769209928d586499616dcc90700b393156e12eea7e15a835";
+char *N_hex = "c0870b552afb6c8c09f79e39ad6ca17ca93085c2cd7a726ade69574961ff9ce8ad33c7dda2e0703a3b0010c2e5bb7552c74164ce8dd011d85e5969090df53fe10e39cbe530704da32ff07228a6b6da34a5929e8a231c3080d812dc6e93affd81682339a6aee192927c582da8941bebf46e13c4ea3918a1477951fa66d367e70d8551b1869316d48317e0702d7bce242a326000f3dc763c44eba2044a1df713a94c1339edd464b145dcadf94e6e61be73dc270c878e1a28be720df2209202d00e101c3b255b757eaf547acd863d51eb676b851511b3dadeda926714719dceddd3af7908893ae65f2b95ee5c4d36cc6862cbe6886a62d7c1e2d0db48c399a6d44b";
+
+int main()
+{
+    int rc;
+
+    char x[3][32];
+    octet X1 = {0, sizeof(x[0]), x[0]};
+    octet X2 = {0, sizeof(x[1]), x[1]};
+    octet X3 = {0, sizeof(x[2]), x[2]};
+    octet *XS[3] = {&X1, &X2, &X3};
+
+    char joint[96];
+    octet JOINT = {0, sizeof(joint), joint};
+
+    char r[SHA256];
+    octet R = {0, sizeof(r), r};
+
+    char c[2][SHA256];
+    octet C1 = {0, sizeof(c[0]), c[0]};
+    octet C2 = {0, sizeof(c[1]), c[1]};
+
+    char v[SFS_SECP256K1 + 1];
+    octet V = {0, sizeof(v), v};
+
+    char id[32];
+    octet ID = {0, sizeof(id), id};
+
+    char e[2][SGS_SECP256K1];
+    octet E1 = {0, sizeof(e[0]), e[0]};
+    octet E2 = {0, sizeof(e[1]), e[1]};
+
+    char p[HFS_2048];
+    octet P = {0, sizeof(p), p};
+
+    char q[HFS_2048];
+    octet Q = {0, sizeof(q), q};
+
+    char n[FS_2048];
+    octet N = {0, sizeof(n), n};
+
+    char fe[FACTORING_ZK_B];
+    octet FE = {0, sizeof(fe), fe};
+
+    char y[FS_2048];
+    octet Y = {0, sizeof(y), y};
+
+    FACTORING_ZK_modulus m;
+
+    // Deterministic RNG for testing
+    char seed[32] = {0};
+    csprng RNG;
+    RAND_seed(&RNG, 32, seed);
+
+    OCT_rand(&X1, &RNG, 32);
+    OCT_rand(&X2, &RNG, 17);
+    OCT_rand(&X3, &RNG, 5);
+
+    OCT_copy(&JOINT, &X1);
+    OCT_joctet(&JOINT, &X2);
+    OCT_joctet(&JOINT, &X3);
+
+    OCT_rand(&V,  &RNG, V.max);
+    OCT_rand(&ID, &RNG, ID.len);
+
+    /* NM commitments */
+
+    COMMITMENTS_NM_commit_v(&RNG, 3, XS, &R, &C1);
+    COMMITMENTS_NM_commit(NULL, &JOINT, &R, &C2);
+
+    if (!OCT_comp(&C1, &C2))
+    {
+        printf("FAILURE COMMITMENTS_NM_commit_v. Commitment differs from the concatenation\n");
+        exit(EXIT_FAILURE);
+    }
+
+    rc = COMMITMENTS_NM_decommit_v(3, XS, &R, &C1);
+    if (rc != COMMITMENTS_OK)
+    {
+        printf("FAILURE COMMITMENTS_NM_decommit_v. RC %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    rc = COMMITMENTS_NM_decommit_v(2, XS, &R, &C1);
+    if (rc != COMMITMENTS_FAIL)
+    {
+        printf("FAILURE COMMITMENTS_NM_decommit_v. Missing segment accepted\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* Schnorr challenges */
+
+    SCHNORR_challenge_v(&V, &C1, &ID, 3, XS, &E1);
+    SCHNORR_challenge(&V, &C1, &ID, &JOINT, &E2);
+
+    if (!OCT_comp(&E1, &E2))
+    {
+        printf("FAILURE SCHNORR_challenge_v. Challenge differs from the concatenation\n");
+        exit(EXIT_FAILURE);
+    }
+
+    SCHNORR_challenge_v(&V, &C1, &ID, 0, NULL, &E1);
+    SCHNORR_challenge(&V, &C1, &ID, NULL, &E2);
+
+    if (!OCT_comp(&E1, &E2))
+    {
+        printf("FAILURE SCHNORR_challenge_v. Challenge differs without AD\n");
+        exit(EXIT_FAILURE);
+    }
+
+    SCHNORR_D_challenge_v(&V, &V, &C1, &ID, 3, XS, &E1);
+    SCHNORR_D_challenge(&V, &V, &C1, &ID, &JOINT, &E2);
+
+    if (!OCT_comp(&E1, &E2))
+    {
+        printf("FAILURE SCHNORR_D_challenge_v. Challenge differs from the concatenation\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* Factoring ZKP */
+
+    OCT_fromHex(&P, P_hex);
+    OCT_fromHex(&Q, Q_hex);
+    OCT_fromHex(&N, N_hex);
+
+    FACTORING_ZK_modulus_fromOctets(&m, &P, &Q);
+    FACTORING_ZK_prove_v(&RNG, &m, &ID, 3, XS, NULL, &FE, &Y);
+
+    rc = FACTORING_ZK_verify(&N, &FE, &Y, &ID, &JOINT);
+    if (rc != FACTORING_ZK_OK)
+    {
+        printf("FAILURE FACTORING_ZK_prove_v. RC %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    rc = FACTORING_ZK_verify_v(&N, &FE, &Y, &ID, 3, XS);
+    if (rc != FACTORING_ZK_OK)
+    {
+        printf("FAILURE FACTORING_ZK_verify_v. RC %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    rc = FACTORING_ZK_verify_v(&N, &FE, &Y, &ID, 2, XS);
+    if (rc != FACTORING_ZK_FAIL)
+    {
+        printf("FAILURE FACTORING_ZK_verify_v. Missing segment accepted\n");
+        exit(EXIT_FAILURE);
+    }
+
+    FACTORING_ZK_modulus_kill(&m);
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,159 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+#include "amcl/schnorr.h"
+
+/* Multi-statement Schnorr's proofs smoke test */
+
+#define M 3
+
+int main()
+{
+    int i;
+    int rc;
+
+    BIG_256_56 x;
+    BIG_256_56 q;
+    ECP_SECP256K1 G;
+
+    char id[32];
+    octet ID = {0, sizeof(id), id};
+
+    char ad[32];
+    octet AD = {0, sizeof(ad), ad};
+
+    char x_char[M][SGS_SECP256K1];
+    octet X[M];
+    octet *PX[M];
+
+    char v[M][SFS_SECP256K1+1];
+    octet V[M];
+    octet *PV[M];
+
+    char r[M][SGS_SECP256K1];
+    octet R[M];
+    octet *PR[M];
+
+    char c[M][SFS_SECP256K1+1];
+    octet C[M];
+    octet *PC[M];
+
+    char p[M][SGS_SECP256K1];
+    octet P[M];
+    octet *PP[M];
+
+    char e[SGS_SECP256K1];
+    octet E = {0, sizeof(e), e};
+
+    char e_golden[SGS_SECP256K1];
+    octet E_GOLDEN = {0, sizeof(e_golden), e_golden};
+
+    // Deterministic RNG for testing
+    char seed[32] = {0};
+    csprng RNG;
+    RAND_seed(&RNG, 32, seed);
+
+    OCT_rand(&ID, &RNG, ID.len);
+    OCT_rand(&AD, &RNG, AD.len);
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+
+    for (i = 0; i < M; i++)
+    {
+        X[i].len = 0;
+        X[i].max = SGS_SECP256K1;
+        X[i].val = x_char[i];
+        PX[i] = X + i;
+
+        V[i].len = 0;
+        V[i].max = SFS_SECP256K1+1;
+        V[i].val = v[i];
+        PV[i] = V + i;
+
+        R[i].len = 0;
+        R[i].max = SGS_SECP256K1;
+        R[i].val = r[i];
+        PR[i] = R + i;
+
+        C[i].len = 0;
+        C[i].max = SFS_SECP256K1+1;
+        C[i].val = c[i];
+        PC[i] = C + i;
+
+        P[i].len = 0;
+        P[i].max = SGS_SECP256K1;
+        P[i].val = p[i];
+        PP[i] = P + i;
+
+        BIG_256_56_randomnum(x, q, &RNG);
+
+        ECP_SECP256K1_generator(&G);
+        ECP_SECP256K1_mul(&G, x);
+
+        BIG_256_56_toBytes(X[i].val, x);
+        X[i].len = SGS_SECP256K1;
+
+        ECP_SECP256K1_toOctet(PV[i], &G, 1);
+    }
+
+    SCHNORR_M_commit(&RNG, M, PR, PC);
+
+    SCHNORR_M_challenge(M, PV, PC, &ID, &AD, &E);
+
+    SCHNORR_M_prove(M, PR, &E, PX, PP);
+
+    rc = SCHNORR_M_verify(&RNG, M, PV, PC, &E, PP);
+    if (rc != SCHNORR_OK)
+    {
+        printf("FAILURE SCHNORR_M_verify. RC %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    // Check that an invalid proof for one statement is rejected
+    P[M-1].val[0] ^= 0x01;
+
+    rc = SCHNORR_M_verify(&RNG, M, PV, PC, &E, PP);
+    if (rc != SCHNORR_FAIL)
+    {
+        printf("FAILURE SCHNORR_M_verify invalid proof. RC %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    // Check that a single statement proof is a classic Schnorr's Proof
+    SCHNORR_M_challenge(1, PV, PC, &ID, &AD, &E);
+    SCHNORR_challenge(PV[0], PC[0], &ID, &AD, &E_GOLDEN);
+
+    if (!OCT_comp(&E, &E_GOLDEN))
+    {
+        printf("FAILURE SCHNORR_M_challenge single statement\n");
+        exit(EXIT_FAILURE);
+    }
+
+    SCHNORR_M_prove(1, PR, &E, PX, PP);
+
+    rc = SCHNORR_verify(PV[0], PC[0], &E, PP[0]);
+    if (rc != SCHNORR_OK)
+    {
+        printf("FAILURE SCHNORR_verify single statement. RC %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,159 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+#include "amcl/schnorr.h"
+
+/* Phase 5 Schnorr's proofs smoke test */
+
+#define N 3
+
+int main()
+{
+    int i;
+    int rc;
+
+    BIG_256_56 q;
+    BIG_256_56 x;
+    ECP_SECP256K1 G;
+    ECP_SECP256K1 ECPR;
+    ECP_SECP256K1 ECPV;
+
+    char id[32];
+    octet ID = {0, sizeof(id), id};
+
+    char r[SFS_SECP256K1 + 1];
+    octet R = {0, sizeof(r), r};
+
+    char s[N][SGS_SECP256K1];
+    char l[N][SGS_SECP256K1];
+    char m[N][SGS_SECP256K1];
+    char v[N][SFS_SECP256K1 + 1];
+    char a[N][SFS_SECP256K1 + 1];
+    char rv[N][SCHNORR_P5_RV_SIZE];
+    char c[N][SCHNORR_P5_C_SIZE];
+    char e[N][SGS_SECP256K1];
+    char p[N][SCHNORR_P5_P_SIZE];
+
+    octet S[N], L[N], M[N], V[N], A[N], RV[N], C[N], E[N], P[N];
+    octet *PV[N], *PA[N], *PC[N], *PE[N], *PP[N];
+
+    // Deterministic RNG for testing
+    char seed[32] = {0};
+    csprng RNG;
+    RAND_seed(&RNG, 32, seed);
+
+    OCT_rand(&ID, &RNG, ID.len);
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+
+    // Common base R
+    BIG_256_56_randomnum(x, q, &RNG);
+    ECP_SECP256K1_generator(&ECPR);
+    ECP_SECP256K1_mul(&ECPR, x);
+    ECP_SECP256K1_toOctet(&R, &ECPR, true);
+
+    for (i = 0; i < N; i++)
+    {
+        S[i] = (octet){0, sizeof(s[i]), s[i]};
+        L[i] = (octet){0, sizeof(l[i]), l[i]};
+        M[i] = (octet){0, sizeof(m[i]), m[i]};
+        V[i] = (octet){0, sizeof(v[i]), v[i]};
+        A[i] = (octet){0, sizeof(a[i]), a[i]};
+        RV[i] = (octet){0, sizeof(rv[i]), rv[i]};
+        C[i] = (octet){0, sizeof(c[i]), c[i]};
+        E[i] = (octet){0, sizeof(e[i]), e[i]};
+        P[i] = (octet){0, sizeof(p[i]), p[i]};
+
+        PV[i] = &V[i];
+        PA[i] = &A[i];
+        PC[i] = &C[i];
+        PE[i] = &E[i];
+        PP[i] = &P[i];
+
+        // V = s.R + l.G
+        BIG_256_56_randomnum(x, q, &RNG);
+        BIG_256_56_toBytes(S[i].val, x);
+        S[i].len = SGS_SECP256K1;
+
+        ECP_SECP256K1_copy(&ECPV, &ECPR);
+        ECP_SECP256K1_mul(&ECPV, x);
+
+        BIG_256_56_randomnum(x, q, &RNG);
+        BIG_256_56_toBytes(L[i].val, x);
+        L[i].len = SGS_SECP256K1;
+
+        ECP_SECP256K1_generator(&G);
+        ECP_SECP256K1_mul(&G, x);
+        ECP_SECP256K1_add(&ECPV, &G);
+        ECP_SECP256K1_toOctet(&V[i], &ECPV, true);
+
+        // A = m.G
+        BIG_256_56_randomnum(x, q, &RNG);
+        BIG_256_56_toBytes(M[i].val, x);
+        M[i].len = SGS_SECP256K1;
+
+        ECP_SECP256K1_generator(&G);
+        ECP_SECP256K1_mul(&G, x);
+        ECP_SECP256K1_toOctet(&A[i], &G, true);
+
+        // Prove both relations
+        rc = SCHNORR_P5_commit(&RNG, &R, &RV[i], &C[i]);
+        if (rc != SCHNORR_OK)
+        {
+            printf("FAILURE SCHNORR_P5_commit. RC %d\n", rc);
+            exit(EXIT_FAILURE);
+        }
+
+        SCHNORR_P5_challenge(&R, &V[i], &A[i], &C[i], &ID, NULL, &E[i]);
+        SCHNORR_P5_prove(&RV[i], &E[i], &S[i], &L[i], &M[i], &P[i]);
+
+        rc = SCHNORR_P5_verify(&R, &V[i], &A[i], &C[i], &E[i], &P[i]);
+        if (rc != SCHNORR_OK)
+        {
+            printf("FAILURE SCHNORR_P5_verify player %d. RC %d\n", i, rc);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    rc = SCHNORR_P5_batch_verify(&RNG, N, &R, PV, PA, PC, PE, PP);
+    if (rc != SCHNORR_OK)
+    {
+        printf("FAILURE SCHNORR_P5_batch_verify. RC %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    // A proof for a different A is rejected
+    rc = SCHNORR_P5_verify(&R, &V[0], &A[1], &C[0], &E[0], &P[0]);
+    if (rc != SCHNORR_FAIL)
+    {
+        printf("FAILURE SCHNORR_P5_verify invalid proof. RC %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    OCT_copy(&A[0], &A[1]);
+    rc = SCHNORR_P5_batch_verify(&RNG, N, &R, PV, PA, PC, PE, PP);
+    if (rc != SCHNORR_FAIL)
+    {
+        printf("FAILURE SCHNORR_P5_batch_verify invalid proof. RC %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,184 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+// Shamir secret sharing smoke test
+
+#include <amcl/ecdh_SECP256K1.h>
+#include <amcl/mpc.h>
+#include <amcl/shamir.h>
+
+#define N 3
+#define T 2
+
+// Signer subsets for a 2-of-3 sharing
+int subsets[N][T] =
+{
+    {1, 2},
+    {3, 1},
+    {2, 3}
+};
+
+int main()
+{
+    int i;
+    int j;
+    int rc;
+
+    BIG_256_56 q;
+    BIG_256_56 s;
+    BIG_256_56 sk;
+    BIG_256_56 sum;
+
+    SHAMIR_cache cache;
+    SHAMIR_subset *L;
+    SHAMIR_subset *L2;
+
+    char seed[32] = {0};
+    octet SEED = {sizeof(seed), sizeof(seed), seed};
+    csprng RNG;
+
+    char secret[EGS_SECP256K1];
+    octet S = {0, sizeof(secret), secret};
+
+    char pk[EFS_SECP256K1 + 1];
+    octet PK = {0, sizeof(pk), pk};
+
+    char shares[N][EGS_SECP256K1];
+    octet SHARE[N];
+    octet *SHARES[N];
+
+    char x[N][EFS_SECP256K1 + 1];
+    octet XO[N];
+    octet *X[N];
+
+    char ask[EGS_SECP256K1];
+    octet ASK = {0, sizeof(ask), ask};
+
+    char apk[2][EFS_SECP256K1 + 1];
+    octet APK1 = {0, sizeof(apk[0]), apk[0]};
+    octet APK2 = {0, sizeof(apk[1]), apk[1]};
+
+    char spk[EFS_SECP256K1 + 1];
+    octet SPK = {0, sizeof(spk), spk};
+
+    for (i = 0; i < N; i++)
+    {
+        SHARE[i].len = 0;
+        SHARE[i].max = sizeof(shares[i]);
+        SHARE[i].val = shares[i];
+        SHARES[i] = &SHARE[i];
+
+        XO[i].len = 0;
+        XO[i].max = sizeof(x[i]);
+        XO[i].val = x[i];
+        X[i] = &XO[i];
+    }
+
+    // Deterministic RNG for testing
+    RAND_seed(&RNG, SEED.len, SEED.val);
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+
+    // Shared key and public shares
+    MPC_ECDSA_KEY_PAIR_GENERATE(&RNG, &S, &PK);
+    BIG_256_56_fromBytesLen(s, S.val, S.len);
+
+    rc = SHAMIR_make_shares(&RNG, T, N, &S, SHARES);
+    if (rc != SHAMIR_OK)
+    {
+        printf("FAILURE SHAMIR_make_shares rc: %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    for (i = 0; i < N; i++)
+    {
+        MPC_ECDSA_KEY_PAIR_GENERATE(NULL, SHARES[i], X[i]);
+    }
+
+    SHAMIR_cache_init(&cache);
+
+    for (i = 0; i < N; i++)
+    {
+        octet *XS[T];
+
+        for (j = 0; j < T; j++)
+        {
+            XS[j] = X[subsets[i][j] - 1];
+        }
+
+        rc = SHAMIR_cache_get(&cache, T, subsets[i], XS, &L);
+        if (rc != SHAMIR_OK)
+        {
+            printf("FAILURE SHAMIR_cache_get subset %d rc: %d\n", i, rc);
+            exit(EXIT_FAILURE);
+        }
+
+        // Additive shares sum to the secret
+        BIG_256_56_zero(sum);
+        for (j = 0; j < T; j++)
+        {
+            SHAMIR_to_additive(L, subsets[i][j], SHARES[subsets[i][j] - 1], &ASK);
+
+            BIG_256_56_fromBytesLen(sk, ASK.val, ASK.len);
+            BIG_256_56_add(sum, sum, sk);
+            BIG_256_56_mod(sum, q);
+        }
+
+        if (BIG_256_56_comp(sum, s) != 0)
+        {
+            printf("FAILURE additive shares subset %d\n", i);
+            exit(EXIT_FAILURE);
+        }
+
+        // Additive public shares sum to the public key
+        SHAMIR_additive_pk(L, subsets[i][0], &APK1);
+        SHAMIR_additive_pk(L, subsets[i][1], &APK2);
+
+        rc = MPC_SUM_PK(&APK1, &APK2, &SPK);
+        if (rc != MPC_OK || !OCT_comp(&SPK, &PK))
+        {
+            printf("FAILURE additive public shares subset %d\n", i);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    // The subset is found in the cache regardless of the order of the signers
+    int reversed[T] = {2, 1};
+
+    rc = SHAMIR_cache_get(&cache, T, reversed, NULL, &L2);
+    SHAMIR_cache_get(&cache, T, subsets[0], NULL, &L);
+    if (rc != SHAMIR_OK || L2 != L || cache.n != N)
+    {
+        printf("FAILURE cache lookup\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Invalid subsets are rejected
+    int repeated[T] = {1, 1};
+
+    rc = SHAMIR_cache_get(&cache, T, repeated, NULL, &L);
+    if (rc != SHAMIR_FAIL)
+    {
+        printf("FAILURE repeated signer rc: %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,89 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+#include <stdio.h>
+#include "amcl/tuning.h"
+
+/* Tuning profile smoke test */
+
+char *path = "test_tuning_smoke.txt";
+
+int main()
+{
+    int rc;
+
+    TUNING_profile t;
+    TUNING_profile loaded;
+
+    TUNING_default(&t);
+    t.schnorr_msm_window = 3;
+    t.batch_flush_size = 16;
+
+    rc = TUNING_save(&t, path);
+    if (rc != TUNING_OK)
+    {
+        printf("FAILURE TUNING_save. rc %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    TUNING_default(&loaded);
+    rc = TUNING_load(&loaded, path);
+    remove(path);
+
+    if (rc != TUNING_OK)
+    {
+        printf("FAILURE TUNING_load. rc %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    if (loaded.schnorr_msm_window != t.schnorr_msm_window || loaded.batch_flush_size != t.batch_flush_size)
+    {
+        printf("FAILURE loaded profile differs from saved profile\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Invalid parameters are rejected
+    t.schnorr_msm_window = SCHNORR_MSM_MAX_WINDOW + 1;
+
+    rc = TUNING_save(&t, path);
+    if (rc != TUNING_OK)
+    {
+        printf("FAILURE TUNING_save invalid window. rc %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    rc = TUNING_load(&loaded, path);
+    remove(path);
+
+    if (rc != TUNING_FAIL)
+    {
+        printf("FAILURE TUNING_load invalid window. rc %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    rc = TUNING_load(&loaded, "missing_tuning_profile.txt");
+    if (rc != TUNING_FAIL)
+    {
+        printf("FAILURE TUNING_load missing file. rc %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}
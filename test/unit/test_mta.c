@@ -142,6 +142,9 @@ int main(int argc, char** argv)
             MPC_MTA_CLIENT1(NULL, &PUB, &A, &CA, &R1);
             compare_OCT(fp, testNo, "CA != CAGOLDEN", &CA, &CAGOLDEN);
 
+            MPC_MTA_CLIENT1_CRT(NULL, &PRIV, &A, &CA, &R1);
+            compare_OCT(fp, testNo, "CRT CA != CAGOLDEN", &CA, &CAGOLDEN);
+
             MPC_MTA_SERVER(NULL, &PUB, &B, &CA, &Z, &R2, &CB, &BETA);
             compare_OCT(fp, testNo, "CB != CBGOLDEN", &CB, &CBGOLDEN);
             compare_OCT(fp, testNo, "BETA != BETAGOLDEN", &BETA, &BETAGOLDEN);
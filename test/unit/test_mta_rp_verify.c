@@ -76,6 +76,8 @@ int main(int argc, char **argv)
 
     MTA_RP_proof tmp;
 
+    MTA_RP_verify_ctx ctx;
+
     // Make sure proof is properly zeroed before starting test
     FF_4096_zero(proof.s,  FFLEN_4096);
     FF_2048_zero(proof.s1, FFLEN_2048);
@@ -122,6 +124,12 @@ int main(int argc, char **argv)
             sprintf(err_msg, "MTA_RP_verify OK. rc %d", rc);
             assert_tv(fp, testNo, err_msg, rc == MTA_OK);
 
+            MTA_RP_verify_prepare(&pub, &mod, &C, &co, &ctx);
+            rc = MTA_RP_verify_finish(&pub, &mod, &E, &ctx, &proof);
+
+            sprintf(err_msg, "MTA_RP_verify_finish OK. rc %d", rc);
+            assert_tv(fp, testNo, err_msg, rc == MTA_OK);
+
             // Mark that at least one test vector was executed
             test_run = 1;
         }
@@ -89,6 +89,8 @@ int main(int argc, char **argv)
 
     MTA_ZK_proof tmp;
 
+    MTA_ZK_verify_ctx ctx;
+
     // Make sure proof is properly zeroed before starting test
     FF_2048_zero(proof.s1, FFLEN_2048);
 
@@ -140,6 +142,12 @@ int main(int argc, char **argv)
             sprintf(err_msg, "MTA_ZK_verify OK. rc %d", rc);
             assert_tv(fp, testNo, err_msg, rc == MTA_OK);
 
+            MTA_ZK_verify_prepare(&priv, &mod, &C1, &C2, &c, &ctx);
+            rc = MTA_ZK_verify_finish(&priv, &mod, &E, &ctx, &proof);
+
+            sprintf(err_msg, "MTA_ZK_verify_finish OK. rc %d", rc);
+            assert_tv(fp, testNo, err_msg, rc == MTA_OK);
+
             // Mark that at least one test vector was executed
             test_run = 1;
         }
@@ -0,0 +1,181 @@
+/*
+    Licensed to the Apache Software Foundation (ASF) under one
+    or more contributor license agreements.  See the NOTICE file
+    distributed with this work for additional information
+    regarding copyright ownership.  The ASF licenses this file
+    to you under the Apache License, Version 2.0 (the
+    "License"); you may not use this file except in compliance
+    with the License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing,
+    software distributed under the License is distributed on an
+    "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+    KIND, either express or implied.  See the License for the
+    specific language governing permissions and limitations
+    under the License.
+*/
+
+#include <string.h>
+#include "test.h"
+#include "amcl/schnorr.h"
+
+/* Schnorr's Proof batch verify test */
+
+#define LINE_LEN 256
+#define MAX_VECTORS 16
+
+int main(int argc, char **argv)
+{
+    if (argc != 2)
+    {
+        printf("usage: ./test_schnorr_batch_verify [path to test vector file]\n");
+        exit(EXIT_FAILURE);
+    }
+
+    int rc;
+    int n = 0;
+
+    char err_msg[128];
+
+    FILE *fp;
+    char line[LINE_LEN] = {0};
+
+    const char *TESTline = "TEST = ";
+    int testNo = 0;
+
+    char v[MAX_VECTORS][SFS_SECP256K1+1];
+    octet V[MAX_VECTORS];
+    octet *VS[MAX_VECTORS];
+    const char *Vline = "V = ";
+
+    char c[MAX_VECTORS][SFS_SECP256K1+1];
+    octet C[MAX_VECTORS];
+    octet *CS[MAX_VECTORS];
+    const char *Cline = "C = ";
+
+    char e[MAX_VECTORS][SGS_SECP256K1];
+    octet E[MAX_VECTORS];
+    octet *ES[MAX_VECTORS];
+    const char *Eline = "E = ";
+
+    char p[MAX_VECTORS][SGS_SECP256K1];
+    octet P[MAX_VECTORS];
+    octet *PS[MAX_VECTORS];
+    const char *Pline = "P = ";
+
+    char zero[SFS_SECP256K1+1] = {0};
+    octet ZERO = {0, sizeof(zero), zero};
+
+    // Line terminating a test vector
+    const char *last_line = Pline;
+
+    // Deterministic RNG for testing
+    char seed[32] = {0};
+    csprng RNG;
+    RAND_seed(&RNG, 32, seed);
+
+    for (n = 0; n < MAX_VECTORS; n++)
+    {
+        V[n].len = 0;
+        V[n].max = sizeof(v[n]);
+        V[n].val = v[n];
+        VS[n] = &V[n];
+
+        C[n].len = 0;
+        C[n].max = sizeof(c[n]);
+        C[n].val = c[n];
+        CS[n] = &C[n];
+
+        E[n].len = 0;
+        E[n].max = sizeof(e[n]);
+        E[n].val = e[n];
+        ES[n] = &E[n];
+
+        P[n].len = 0;
+        P[n].max = sizeof(p[n]);
+        P[n].val = p[n];
+        PS[n] = &P[n];
+    }
+
+    fp = fopen(argv[1], "r");
+    if (fp == NULL)
+    {
+        printf("ERROR opening test vector file\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* Read all the test vectors in a single batch */
+    n = 0;
+    while (fgets(line, LINE_LEN, fp) != NULL && n < MAX_VECTORS)
+    {
+        scan_int(&testNo, line, TESTline);
+
+        // Read input
+        scan_OCTET(fp, &V[n], line, Vline);
+        scan_OCTET(fp, &C[n], line, Cline);
+        scan_OCTET(fp, &E[n], line, Eline);
+        scan_OCTET(fp, &P[n], line, Pline);
+
+        if (!strncmp(line, last_line, strlen(last_line)))
+        {
+            n++;
+        }
+    }
+
+    fclose(fp);
+
+    if (n < 2)
+    {
+        printf("ERROR not enough test vectors for a batch\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* Test happy path */
+    rc = SCHNORR_batch_verify(&RNG, SCHNORR_MSM_WINDOW, n, VS, CS, ES, PS);
+    sprintf(err_msg, "SCHNORR_batch_verify. rc %d", rc);
+    assert(NULL, err_msg, rc == SCHNORR_OK);
+
+    // Every valid window size gives the same result
+    rc = SCHNORR_batch_verify(&RNG, 1, n, VS, CS, ES, PS);
+    sprintf(err_msg, "SCHNORR_batch_verify window 1. rc %d", rc);
+    assert(NULL, err_msg, rc == SCHNORR_OK);
+
+    rc = SCHNORR_batch_verify(&RNG, SCHNORR_MSM_MAX_WINDOW, n, VS, CS, ES, PS);
+    sprintf(err_msg, "SCHNORR_batch_verify max window. rc %d", rc);
+    assert(NULL, err_msg, rc == SCHNORR_OK);
+
+    /* Test unhappy path */
+
+    rc = SCHNORR_batch_verify(&RNG, SCHNORR_MSM_MAX_WINDOW + 1, n, VS, CS, ES, PS);
+    sprintf(err_msg, "SCHNORR_batch_verify invalid window. rc %d", rc);
+    assert(NULL, err_msg, rc == SCHNORR_FAIL);
+
+    // Swap two proofs
+    PS[0] = &P[1];
+    PS[1] = &P[0];
+
+    rc = SCHNORR_batch_verify(&RNG, SCHNORR_MSM_WINDOW, n, VS, CS, ES, PS);
+    sprintf(err_msg, "SCHNORR_batch_verify swapped proofs. rc %d", rc);
+    assert(NULL, err_msg, rc == SCHNORR_FAIL);
+
+    PS[0] = &P[0];
+    PS[1] = &P[1];
+
+    VS[n-1] = &ZERO;
+
+    rc = SCHNORR_batch_verify(&RNG, SCHNORR_MSM_WINDOW, n, VS, CS, ES, PS);
+    sprintf(err_msg, "SCHNORR_batch_verify invalid V. rc %d", rc);
+    assert(NULL, err_msg, rc == SCHNORR_INVALID_ECP);
+
+    VS[n-1] = &V[n-1];
+    CS[n-1] = &ZERO;
+
+    rc = SCHNORR_batch_verify(&RNG, SCHNORR_MSM_WINDOW, n, VS, CS, ES, PS);
+    sprintf(err_msg, "SCHNORR_batch_verify invalid C. rc %d", rc);
+    assert(NULL, err_msg, rc == SCHNORR_INVALID_ECP);
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}